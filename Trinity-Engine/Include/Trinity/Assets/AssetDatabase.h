@@ -1,14 +1,19 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <glm/glm.hpp>
+
 #include <Trinity/Core/UUID.h>
 #include <Trinity/Assets/AssetMetadata.h>
 #include <Trinity/Audio/AudioTypes.h>
+#include <Trinity/Renderer/Materials/ResolvedMaterial.h>
 #include <Trinity/Renderer/RHI/GraphicsDevice.h>
 
 namespace Trinity
@@ -46,6 +51,18 @@ namespace Trinity
         TextureHandle ResolveTexture(UUID ID);
         AudioClipHandle ResolveAudioClip(UUID ID);
 
+        // Flattens a material or material instance into a compiled block and returns its stable ID; zero compiles the engine default. The block is reused until the
+        // material, an instance parent or a referenced texture changes
+        uint32_t CompileMaterial(UUID ID);
+
+        // Engine default with only the base color replaced, for submeshes whose slot has no material asset assigned
+        uint32_t CompileFallbackMaterial(const glm::vec4& baseColorFactor);
+
+        const ResolvedMaterial& GetResolvedMaterial(uint32_t materialID) const { return m_CompiledMaterials[materialID].Block; }
+
+        // Marks every compiled block that depends on the asset for recompilation; call after editing a live Material in place
+        void InvalidateMaterial(UUID ID);
+
         const std::unordered_map<UUID, AssetMetadata>& GetAssets() const { return m_Assets; }
         const std::vector<UUID>& GetModified() const { return m_Modified; }
 
@@ -53,8 +70,35 @@ namespace Trinity
         void ScanDirectory();
         UUID RegisterAsset(const std::filesystem::path& sourceFile);
         std::shared_ptr<Material> GetDefaultMaterial();
+        void BuildResolvedMaterial(UUID ID, ResolvedMaterial& block, std::vector<UUID>& dependencies);
 
     private:
+        struct CompiledMaterial
+        {
+            ResolvedMaterial Block;
+
+            // The material itself, every instance parent up the chain and the referenced textures
+            std::vector<UUID> Dependencies;
+            bool Dirty = false;
+        };
+
+        // The color's exact bit pattern; comparing bits rather than floats keeps NaN colors from missing their own entry every call
+        using FallbackColorKey = std::array<uint32_t, 4>;
+
+        struct FallbackColorKeyHash
+        {
+            size_t operator()(const FallbackColorKey& key) const
+            {
+                uint64_t l_Hash = 14695981039346656037ull;
+                for (uint32_t it_Bits : key)
+                {
+                    l_Hash = (l_Hash ^ it_Bits) * 1099511628211ull;
+                }
+
+                return static_cast<size_t>(l_Hash);
+            }
+        };
+
         FileSystem& m_FileSystem;
         MeshLibrary& m_MeshLibrary;
         TextureManager& m_TextureManager;
@@ -67,5 +111,9 @@ namespace Trinity
         std::unordered_map<UUID, std::shared_ptr<MaterialInstance>> m_MaterialInstanceCache;
         std::unordered_map<UUID, AudioClipHandle> m_AudioClipCache;
         std::shared_ptr<Material> m_DefaultMaterial;
+
+        std::vector<CompiledMaterial> m_CompiledMaterials;
+        std::unordered_map<UUID, uint32_t> m_CompiledMaterialLookup;
+        std::unordered_map<FallbackColorKey, uint32_t, FallbackColorKeyHash> m_FallbackMaterialLookup;
     };
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace Trinity
     class Scene;
     class EditorCamera;
     class Camera;
+    class JobSystem;
 
     struct NativeWindowHandle;
 
@@ -88,6 +89,10 @@ namespace Trinity
         PhysicsSystem& GetPhysicsSystem() { return *m_PhysicsSystem; }
         bool HasPhysicsSystem() const { return m_PhysicsSystem != nullptr; }
 
+        // Shared worker pool for parallel scene updates, asset imports, and physics; started before every other subsystem
+        JobSystem& GetJobSystem() { return *m_JobSystem; }
+        bool HasJobSystem() const { return m_JobSystem != nullptr; }
+
         SimulationClock& GetSimulationClock() { return m_SimulationClock; }
         const SimulationClock& GetSimulationClock() const { return m_SimulationClock; }
         float GetInterpolationAlpha() const { return m_SimulationClock.GetAlpha(); }
@@ -104,6 +109,7 @@ namespace Trinity
         bool m_SceneStepRequested = false;
         std::string m_SceneSnapshot;
 
+        std::unique_ptr<JobSystem> m_JobSystem;
         std::unique_ptr<IPlatform> m_Platform;
         std::unique_ptr<GraphicsDevice> m_Device;
         std::unique_ptr<Swapchain> m_Swapchain;
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Trinity
+{
+    struct JobNode;
+
+    // Shared ownership of a scheduled job; stays valid (and answers IsComplete) after the job has run
+    class JobHandle
+    {
+    public:
+        JobHandle() = default;
+        explicit JobHandle(std::shared_ptr<JobNode> node) : m_Node(std::move(node))
+        {
+
+        }
+
+        bool IsValid() const { return m_Node != nullptr; }
+        bool IsComplete() const;
+
+    private:
+        friend class JobSystem;
+
+        std::shared_ptr<JobNode> m_Node;
+    };
+
+    struct JobSystemStats
+    {
+        uint64_t Executed = 0;
+        uint64_t Stolen = 0;
+    };
+
+    // Work-stealing scheduler. Every worker owns a deque it pushes and pops at the back; idle workers steal from the front of the others. Threads that are not workers
+    // (the main thread) share one extra queue and help execute jobs whenever they Wait
+    class JobSystem
+    {
+    public:
+        JobSystem();
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // A worker count of zero sizes the pool to the hardware concurrency minus the calling thread, which participates while it waits
+        bool Initialize(uint32_t workerCount = 0);
+        void Shutdown();
+
+        JobHandle Schedule(std::function<void()> work);
+
+        // Runs once every dependency has completed; invalid handles are ignored
+        JobHandle Schedule(std::function<void()> work, std::span<const JobHandle> dependencies);
+
+        // Continuation: queued the moment the parent completes (immediately if it already has)
+        JobHandle Then(const JobHandle& parent, std::function<void()> work);
+
+        // Executes other queued jobs until the handle completes instead of blocking the calling thread
+        void Wait(const JobHandle& handle);
+        void Wait(std::span<const JobHandle> handles);
+
+        // Splits [0, count) into grain-sized chunks claimed dynamically by the workers and the caller; returns once every chunk has run. The body is called
+        // through a reference rather than copied, and the helper jobs come from a pool, so a steady stream of calls does not allocate
+        template<typename Body>
+        void ParallelFor(uint32_t count, uint32_t grainSize, const Body& body)
+        {
+            ParallelFor(count, grainSize, [](const void* context, uint32_t begin, uint32_t end) { (*static_cast<const Body*>(context))(begin, end); }, &body);
+        }
+
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+        bool IsInitialized() const { return m_Running.load(std::memory_order_acquire); }
+
+        JobSystemStats GetStats() const;
+        void ResetStats();
+
+    private:
+        using ParallelForBody = void (*)(const void* context, uint32_t begin, uint32_t end);
+
+        // Ring buffer that only grows; a deque frees and reallocates its blocks as the ends move, which steady scheduling would pay for every few jobs
+        struct WorkQueue
+        {
+            std::mutex Mutex;
+            std::vector<std::shared_ptr<JobNode>> Slots;
+            size_t Head = 0;
+            size_t Count = 0;
+
+            void PushBack(std::shared_ptr<JobNode> node);
+            std::shared_ptr<JobNode> PopBack();
+            std::shared_ptr<JobNode> PopFront();
+        };
+
+        struct ParallelForBatch;
+
+        void ParallelFor(uint32_t count, uint32_t grainSize, ParallelForBody body, const void* context);
+
+        void WorkerLoop(uint32_t queueIndex);
+        void Enqueue(std::shared_ptr<JobNode> node);
+        bool TryRunOne(uint32_t queueIndex);
+        std::shared_ptr<JobNode> Pop(uint32_t queueIndex);
+        std::shared_ptr<JobNode> Steal(uint32_t thiefIndex);
+        void Execute(const std::shared_ptr<JobNode>& node);
+        void ReleaseDependency(const std::shared_ptr<JobNode>& node);
+        uint32_t CurrentQueueIndex() const;
+
+    private:
+        // Slot 0 belongs to non-worker threads; worker N owns slot N + 1
+        std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+        std::vector<std::thread> m_Workers;
+
+        std::atomic<bool> m_Running{ false };
+        std::atomic<uint32_t> m_QueuedJobs{ 0 };
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCondition;
+
+        // Reused by ParallelFor along with their helper job nodes; one per call in flight
+        std::mutex m_BatchMutex;
+        std::vector<std::unique_ptr<ParallelForBatch>> m_FreeBatches;
+
+        std::atomic<uint64_t> m_Executed{ 0 };
+        std::atomic<uint64_t> m_Stolen{ 0 };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Trinity/Renderer/RHI/CommandList.h>
+
+namespace Trinity
+{
+    class NullDevice;
+
+    enum class NullCommandType : uint8_t
+    {
+        BeginRendering = 0,
+        EndRendering,
+        SetViewport,
+        SetScissor,
+        BindPipeline,
+        BindVertexBuffer,
+        BindIndexBuffer,
+        PushConstants,
+        BindTexture,
+        BindUniformBuffer,
+        BindStorageBuffer,
+        BindDynamicUniformBuffer,
+        BindDynamicStorageBuffer,
+        BindBindlessTextures,
+        Draw,
+        DrawIndexed,
+        CopyTexture,
+        Barrier
+    };
+
+    // One recorded call. Handles are stored packed; fields a command does not use stay zero
+    struct NullCommand
+    {
+        NullCommandType Type = NullCommandType::BeginRendering;
+
+        // The pipeline, buffer or texture the command references; the first color target (or the depth target) for BeginRendering, the destination for CopyTexture
+        uint64_t Resource = 0;
+
+        // The sampler for BindTexture, the source texture for CopyTexture
+        uint64_t Sampler = 0;
+
+        // Buffer range for buffer binds, push constant range for PushConstants, and the states before and after for Barrier
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+
+        // Descriptor set and binding; the stream slot for BindVertexBuffer
+        uint32_t Set = 0;
+        uint32_t Binding = 0;
+
+        // Vertex or index count and instance count for draws; the color attachment count for BeginRendering, the array layer for CopyTexture, the index size
+        // in bytes for BindIndexBuffer
+        uint32_t Count = 0;
+        uint32_t Instances = 0;
+    };
+
+    struct NullCommandStats
+    {
+        uint64_t RenderPasses = 0;
+        uint64_t PipelineBinds = 0;
+
+        // Vertex, index, descriptor and bindless table binds; push constants are counted on their own
+        uint64_t ResourceBinds = 0;
+        uint64_t PushConstants = 0;
+
+        uint64_t Draws = 0;
+        uint64_t Instances = 0;
+        uint64_t Vertices = 0;  // Vertex or index count times instances
+        uint64_t Copies = 0;
+
+        uint64_t Barriers = 0;
+        uint64_t BarrierBatches = 0;
+
+        // Commands that referenced a destroyed or never-created resource; a correct frame records none
+        uint64_t InvalidHandles = 0;
+
+        NullCommandStats& operator+=(const NullCommandStats& other);
+    };
+
+    // Records every call into a flat stream instead of a GPU command buffer. Begin clears the stream but keeps its storage, so re-recording a frame of the same
+    // shape allocates nothing. With recording off only the counters are kept, which is all a timing run needs
+    class NullCommandList : public CommandList
+    {
+    public:
+        explicit NullCommandList(NullDevice& device);
+        ~NullCommandList() override = default;
+
+        NullCommandList(const NullCommandList&) = delete;
+        NullCommandList& operator=(const NullCommandList&) = delete;
+
+        void Begin() override;
+        void End() override;
+
+        void BeginRendering(const RenderingInfo& renderingInfo) override;
+        void EndRendering() override;
+
+        void SetViewport(const Viewport& viewport) override;
+        void SetScissor(const Scissor& scissor) override;
+
+        void BindPipeline(PipelineHandle pipeline) override;
+        void BindVertexBuffer(BufferHandle buffer, uint64_t offset = 0, uint32_t slot = 0) override;
+        void BindIndexBuffer(BufferHandle buffer, uint64_t offset = 0, IndexType type = IndexType::UInt32) override;
+
+        void PushConstants(ShaderStage stages, uint32_t offset, uint32_t size, const void* data) override;
+
+        void BindTexture(uint32_t set, uint32_t binding, TextureHandle texture, SamplerHandle sampler) override;
+        void BindUniformBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size) override;
+        void BindStorageBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size) override;
+        void BindDynamicUniformBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation) override;
+        void BindDynamicStorageBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation) override;
+        void BindBindlessTextures(uint32_t set) override;
+
+        void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
+
+        void CopyTexture(TextureHandle source, TextureHandle destination, uint32_t arrayLayer = 0) override;
+
+        void TransitionTexture(TextureHandle texture, ResourceState from, ResourceState to) override;
+        void TransitionTextures(const TextureBarrier* barriers, uint32_t count) override;
+
+        void SetRecording(bool recording) { m_Recording = recording; }
+        bool IsRecording() const { return m_Recording; }
+
+        // Everything recorded since Begin
+        const std::vector<NullCommand>& GetCommands() const { return m_Commands; }
+        const NullCommandStats& GetStats() const { return m_Stats; }
+
+    private:
+        void Record(const NullCommand& command);
+        void BindBuffer(NullCommandType type, uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size);
+        void Barrier(TextureHandle texture, ResourceState from, ResourceState to);
+
+    private:
+        NullDevice& m_Device;
+        std::vector<NullCommand> m_Commands;
+        NullCommandStats m_Stats;
+        bool m_Recording = true;
+        bool m_InsideRendering = false;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Trinity/Renderer/RHI/GraphicsDevice.h>
+#include <Trinity/Renderer/RHI/ResourcePool.h>
+#include <Trinity/Renderer/Backends/Null/NullCommandList.h>
+#include <Trinity/Renderer/Backends/Null/NullImGuiBackend.h>
+
+namespace Trinity
+{
+    struct NullBufferResource
+    {
+        uint64_t Size = 0;
+        BufferUsage Usage = BufferUsage::None;
+        MemoryUsage Memory = MemoryUsage::GpuOnly;
+
+        // Only host-visible buffers get storage, so mapped writes and frame allocations cost what they would on a GPU; device-local contents are never read back
+        std::shared_ptr<std::vector<uint8_t>> Storage;
+        std::string DebugName;
+    };
+
+    struct NullTextureResource
+    {
+        TextureType Type = TextureType::Texture2D;
+        Format Format = Format::Unknown;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        bool Placed = false;
+        uint32_t BindlessIndex = k_InvalidBindlessIndex;
+        std::string DebugName;
+    };
+
+    struct NullSamplerResource
+    {
+        std::string DebugName;
+    };
+
+    struct NullShaderResource
+    {
+        ShaderStage Stage = ShaderStage::None;
+        std::string DebugName;
+    };
+
+    struct NullPipelineResource
+    {
+        uint32_t PushConstantSize = 0;
+        std::string DebugName;
+    };
+
+    struct NullMemoryHeapResource
+    {
+        uint64_t Size = 0;
+        std::string DebugName;
+    };
+
+    // Totals across everything submitted since the device started or the last ResetStats
+    struct NullDeviceStats
+    {
+        NullCommandStats Commands;
+        uint64_t Submissions = 0;
+
+        // Initial contents and UpdateBuffer copies; what the upload path would have moved
+        uint64_t UploadedBytes = 0;
+    };
+
+    // Headless implementation of the RHI. Handles come from the same pools as on the GPU backends, so stale handles fail the same way, but resources are only
+    // bookkeeping and submission just accumulates the command lists' counters. Gives renderer code a deterministic device for CPU benchmarks and checks on
+    // machines without a GPU
+    class NullDevice : public GraphicsDevice
+    {
+    public:
+        NullDevice() = default;
+        ~NullDevice() override;
+
+        NullDevice(const NullDevice&) = delete;
+        NullDevice& operator=(const NullDevice&) = delete;
+
+        bool Initialize() override;
+        void Shutdown() override;
+
+        GraphicsBackend GetBackend() const override { return GraphicsBackend::Null; }
+        const DeviceCapabilities& GetCapabilities() const override { return m_Capabilities; }
+
+        BufferHandle CreateBuffer(const BufferDescription& description) override;
+        TextureHandle CreateTexture(const TextureDescription& description) override;
+        SamplerHandle CreateSampler(const SamplerDescription& description) override;
+        ShaderHandle CreateShader(const ShaderDescription& description) override;
+        PipelineHandle CreatePipeline(const PipelineDescription& description) override;
+
+        void DestroyBuffer(BufferHandle handle) override;
+        void DestroyTexture(TextureHandle handle) override;
+        void DestroySampler(SamplerHandle handle) override;
+        void DestroyShader(ShaderHandle handle) override;
+        void DestroyPipeline(PipelineHandle handle) override;
+
+        void UpdateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset = 0) override;
+        FrameAllocation AllocateFrameMemory(uint64_t size, BufferUsage usage) override;
+
+        MemoryRequirements GetTextureMemoryRequirements(const TextureDescription& description) override;
+        MemoryHeapHandle CreateMemoryHeap(const MemoryHeapDescription& description) override;
+        void DestroyMemoryHeap(MemoryHeapHandle handle) override;
+        TextureHandle CreatePlacedTexture(const TextureDescription& description, MemoryHeapHandle heap, uint64_t offset) override;
+
+        uint32_t RegisterBindlessTexture(TextureHandle texture, SamplerHandle sampler) override;
+
+        std::unique_ptr<Swapchain> CreateSwapchain(const SwapchainDescription& description) override;
+        std::unique_ptr<CommandList> CreateCommandList() override;
+
+        void Submit(CommandList& commandList) override;
+        void WaitIdle() override {}
+
+        void CollectGarbage() override;
+
+        DescriptorCacheStats GetDescriptorCacheStats() const override { return {}; }
+        PipelineCacheStats GetPipelineCacheStats() const override
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+            return m_PipelineStats;
+        }
+        FrameAllocatorStats GetFrameAllocatorStats() const override { return m_FrameHeap.GetStats(); }
+
+        IImGuiRenderBackend& GetImGuiBackend() override { return m_ImGuiBackend; }
+
+        const NullDeviceStats& GetStats() const { return m_Stats; }
+        void ResetStats() { m_Stats = NullDeviceStats{}; }
+
+        // Validity checks for the command lists; a handle is alive from creation until it is destroyed, whatever the frame delay
+        bool IsAlive(BufferHandle handle) { return m_Buffers.Get(handle) != nullptr; }
+        bool IsAlive(TextureHandle handle) { return m_Textures.Get(handle) != nullptr; }
+        bool IsAlive(SamplerHandle handle) { return m_Samplers.Get(handle) != nullptr; }
+        bool IsAlive(PipelineHandle handle)
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+            return m_Pipelines.Get(handle) != nullptr;
+        }
+
+        NullBufferResource* GetBuffer(BufferHandle handle) { return m_Buffers.Get(handle); }
+        NullTextureResource* GetTexture(TextureHandle handle) { return m_Textures.Get(handle); }
+
+        uint64_t GetFrameCounter() const { return m_FrameCounter; }
+        uint64_t GetDeferredFrameDelay() const { return m_DeferredFrameDelay; }
+
+    private:
+        TextureHandle CreateTextureResource(const TextureDescription& description, bool placed);
+        bool GrowFrameHeap(uint64_t minimumSize);
+        void ReportLeaks();
+
+    private:
+        struct DeferredStorage
+        {
+            uint64_t Frame = 0;
+            std::shared_ptr<std::vector<uint8_t>> Storage;
+        };
+
+        bool m_Initialized = false;
+        DeviceCapabilities m_Capabilities;
+
+        ResourcePool<NullBufferResource, BufferTag> m_Buffers;
+        ResourcePool<NullTextureResource, TextureTag> m_Textures;
+        ResourcePool<NullSamplerResource, SamplerTag> m_Samplers;
+        ResourcePool<NullMemoryHeapResource, MemoryHeapTag> m_MemoryHeaps;
+
+        // Guards the shader and pipeline pools and the pipeline counters, which worker threads touch while compiling
+        mutable std::mutex m_PipelineMutex;
+        ResourcePool<NullShaderResource, ShaderTag> m_Shaders;
+        ResourcePool<NullPipelineResource, PipelineTag> m_Pipelines;
+        PipelineCacheStats m_PipelineStats;
+
+        // Bindless slots per array; freed slots are reused before the arrays grow
+        std::vector<uint32_t> m_FreeBindless2D;
+        std::vector<uint32_t> m_FreeBindlessCube;
+        uint32_t m_NextBindless2D = 0;
+        uint32_t m_NextBindlessCube = 0;
+
+        // Host memory of destroyed buffers outlives their handles by the frame delay, as GPU memory does behind the Vulkan backend's deferred releases
+        std::vector<DeferredStorage> m_DeferredStorage;
+        uint64_t m_FrameCounter = 0;
+        uint64_t m_DeferredFrameDelay = 3;
+
+        // Outgrown heaps stay alive until the frame that outgrew them closes, since its earlier allocations still name them
+        FrameAllocator m_FrameHeap;
+        std::vector<BufferHandle> m_RetiredFrameHeaps;
+        NullImGuiBackend m_ImGuiBackend;
+        NullDeviceStats m_Stats;
+    };
+}
\ No newline at end of file
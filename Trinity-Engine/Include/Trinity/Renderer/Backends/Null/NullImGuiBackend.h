@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Trinity/ImGui/IImGuiRenderBackend.h>
+
+namespace Trinity
+{
+    // Headless runs draw no UI; textures get their packed handle as the ImGui ID so panels that display them still work
+    class NullImGuiBackend : public IImGuiRenderBackend
+    {
+    public:
+        bool Initialize(uint32_t, Format) override { return true; }
+        void Shutdown() override {}
+
+        void NewFrame() override {}
+        void RecordDrawData(CommandList&) override {}
+
+        uint64_t RegisterTexture(TextureHandle texture) override { return texture.Pack(); }
+        void UnregisterTexture(uint64_t) override {}
+    };
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Trinity/Renderer/RHI/Swapchain.h>
+
+namespace Trinity
+{
+    class NullDevice;
+
+    // Back buffers are ordinary device textures handed out round-robin; presenting only advances the index. A zero-sized swapchain acquires nothing, like a
+    // minimized window
+    class NullSwapchain : public Swapchain
+    {
+    public:
+        static constexpr uint32_t MaxFramesInFlight = 2;
+
+        NullSwapchain(NullDevice& device, const SwapchainDescription& description);
+        ~NullSwapchain() override;
+
+        NullSwapchain(const NullSwapchain&) = delete;
+        NullSwapchain& operator=(const NullSwapchain&) = delete;
+
+        bool Initialize();
+        void Shutdown();
+
+        bool AcquireNextImage(FrameInfo& outFrame) override;
+        void Present() override;
+        void Resize(uint32_t width, uint32_t height) override;
+
+        uint32_t GetWidth() const override { return m_Width; }
+        uint32_t GetHeight() const override { return m_Height; }
+        Format GetFormat() const override { return m_Description.PreferredFormat; }
+        uint32_t GetImageCount() const override { return static_cast<uint32_t>(m_Images.size()); }
+        uint32_t GetFramesInFlight() const override { return MaxFramesInFlight; }
+
+        uint64_t GetPresentedFrames() const { return m_PresentedFrames; }
+
+    private:
+        bool CreateImages();
+        void DestroyImages();
+
+    private:
+        NullDevice& m_Device;
+        SwapchainDescription m_Description;
+
+        uint32_t m_Width = 0;
+        uint32_t m_Height = 0;
+
+        std::vector<TextureHandle> m_Images;
+        uint32_t m_CurrentImageIndex = 0;
+        bool m_Acquired = false;
+        uint64_t m_PresentedFrames = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace Trinity
+{
+    // One global update-after-bind descriptor set: binding 0 is a Sampler2D array, binding 1 a SamplerCube array. Slots are written once at registration and stay
+    // valid while bound, so draws index textures instead of binding them
+    class VulkanBindlessTable
+    {
+    public:
+        static constexpr uint32_t k_Texture2DBinding = 0;
+        static constexpr uint32_t k_TextureCubeBinding = 1;
+
+        VulkanBindlessTable() = default;
+        ~VulkanBindlessTable();
+
+        VulkanBindlessTable(const VulkanBindlessTable&) = delete;
+        VulkanBindlessTable& operator=(const VulkanBindlessTable&) = delete;
+
+        bool Initialize(VkDevice device, uint32_t texture2DCount, uint32_t textureCubeCount, uint64_t frameDelay);
+        void Shutdown();
+
+        bool IsInitialized() const { return m_Set != VK_NULL_HANDLE; }
+        VkDescriptorSet GetSet() const { return m_Set; }
+
+        // Pipelines create their own copy; identically defined layouts are compatible, so the global set binds against any of them
+        VkDescriptorSetLayout CreateCompatibleLayout() const;
+
+        // Returns UINT32_MAX when the array is full
+        uint32_t Register(VkImageView view, VkSampler sampler, bool cube);
+
+        // The slot is recycled only after every frame that could still sample it has retired
+        void Release(uint32_t index, bool cube);
+        void Collect(uint64_t frame);
+
+    private:
+        struct SlotArray
+        {
+            uint32_t Capacity = 0;
+            uint32_t Next = 0;
+            std::vector<uint32_t> Free;
+            std::vector<std::pair<uint32_t, uint64_t>> Pending;  // slot, frame it was released
+        };
+
+        uint32_t Allocate(SlotArray& slots);
+
+    private:
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_Layout = VK_NULL_HANDLE;
+        VkDescriptorPool m_Pool = VK_NULL_HANDLE;
+        VkDescriptorSet m_Set = VK_NULL_HANDLE;
+
+        SlotArray m_Textures2D;
+        SlotArray m_TexturesCube;
+
+        uint64_t m_FrameDelay = 0;
+        uint64_t m_Frame = 0;
+    };
+}
\ No newline at end of file
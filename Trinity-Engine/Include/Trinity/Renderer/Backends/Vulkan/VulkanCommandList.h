@@ -29,26 +29,37 @@ namespace Trinity
         void SetScissor(const Scissor& scissor) override;
 
         void BindPipeline(PipelineHandle pipeline) override;
-        void BindVertexBuffer(BufferHandle buffer, uint64_t offset = 0) override;
-        void BindIndexBuffer(BufferHandle buffer, uint64_t offset = 0) override;
+        void BindVertexBuffer(BufferHandle buffer, uint64_t offset = 0, uint32_t slot = 0) override;
+        void BindIndexBuffer(BufferHandle buffer, uint64_t offset = 0, IndexType type = IndexType::UInt32) override;
 
         void PushConstants(ShaderStage stages, uint32_t offset, uint32_t size, const void* data) override;
 
         void BindTexture(uint32_t set, uint32_t binding, TextureHandle texture, SamplerHandle sampler) override;
         void BindUniformBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size) override;
+        void BindStorageBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size) override;
+        void BindDynamicUniformBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation) override;
+        void BindDynamicStorageBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation) override;
+        void BindBindlessTextures(uint32_t set) override;
 
         void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
         void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
 
+        void CopyTexture(TextureHandle source, TextureHandle destination, uint32_t arrayLayer = 0) override;
+
         void TransitionTexture(TextureHandle texture, ResourceState from, ResourceState to) override;
+        void TransitionTextures(const TextureBarrier* barriers, uint32_t count) override;
 
         VkCommandBuffer GetHandle() const { return m_CommandBuffer; }
 
+    private:
+        void BindBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size, VkDescriptorType type);
+
     private:
         VulkanDevice& m_Device;
         VkCommandBuffer m_CommandBuffer = VK_NULL_HANDLE;
         VkPipelineLayout m_CurrentLayout = VK_NULL_HANDLE;
-        VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
         std::vector<VkDescriptorSetLayout> m_CurrentSetLayouts;
+        std::vector<VkImageMemoryBarrier2> m_ImageBarriers;  // Scratch for TransitionTextures, kept to avoid reallocating every batch
+        std::vector<VkRenderingAttachmentInfo> m_ColorAttachments;  // Scratch for BeginRendering, kept to avoid reallocating every pass
     };
 }
\ No newline at end of file
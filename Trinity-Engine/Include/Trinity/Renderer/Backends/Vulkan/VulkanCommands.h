@@ -1,7 +1,5 @@
 #pragma once
 
-#include <functional>
-
 #include <vulkan/vulkan.h>
 
 namespace Trinity
@@ -20,12 +18,9 @@ namespace Trinity
 
         VkCommandPool GetPool() const { return m_Pool; }
 
-        void ImmediateSubmit(const std::function<void(VkCommandBuffer)>& recorder);
-
     private:
         VkDevice m_Device = VK_NULL_HANDLE;
         VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
         VkCommandPool m_Pool = VK_NULL_HANDLE;
-        VkFence m_ImmediateFence = VK_NULL_HANDLE;
     };
 }
\ No newline at end of file
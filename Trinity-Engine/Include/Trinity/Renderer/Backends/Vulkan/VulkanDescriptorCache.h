@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include <Trinity/Renderer/RHI/GraphicsDevice.h>
+#include <Trinity/Renderer/RHI/Handle.h>
+
+namespace Trinity
+{
+    // Everything that determines a single-binding descriptor set's contents. Resources are identified by their RHI handle (index + generation), so a recycled slot never
+    // aliases a stale entry
+    struct VulkanDescriptorKey
+    {
+        VkDescriptorSetLayout Layout = VK_NULL_HANDLE;
+        VkDescriptorType Type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        uint32_t Binding = 0;
+        uint64_t Resource = 0;  // Packed TextureHandle for image types, BufferHandle for buffer types
+        uint64_t Sampler = 0;
+        uint64_t Offset = 0;
+        uint64_t Range = 0;
+
+        bool operator==(const VulkanDescriptorKey& other) const
+        {
+            return Layout == other.Layout && Type == other.Type && Binding == other.Binding && Resource == other.Resource && Sampler == other.Sampler
+                && Offset == other.Offset && Range == other.Range;
+        }
+    };
+
+    struct VulkanDescriptorKeyHash
+    {
+        std::size_t operator()(const VulkanDescriptorKey& key) const noexcept;
+    };
+
+    // Device-wide cache of written descriptor sets shared by every command list. Sets persist across frames and are only rewritten on a miss; entries are evicted
+    // least-recently-used once the cache is full, and dropped when a resource they reference is destroyed. A set is never freed while a frame that used it may still be in flight
+    class VulkanDescriptorCache
+    {
+    public:
+        VulkanDescriptorCache() = default;
+        ~VulkanDescriptorCache();
+
+        VulkanDescriptorCache(const VulkanDescriptorCache&) = delete;
+        VulkanDescriptorCache& operator=(const VulkanDescriptorCache&) = delete;
+
+        bool Initialize(VkDevice device, uint32_t capacity, uint64_t frameDelay);
+        void Shutdown();
+
+        // Returns the cached set for the key, or allocates one and applies the write (its dstSet is filled in). VK_NULL_HANDLE only if a fresh pool cannot be created
+        VkDescriptorSet Acquire(const VulkanDescriptorKey& key, VkWriteDescriptorSet write);
+
+        // Called once per frame by the device: advances the in-flight window, drops entries whose resources were destroyed and frees retired sets that are no longer in use
+        void Collect(uint64_t frame);
+
+        void InvalidateTexture(TextureHandle texture) { m_DestroyedTextures.push_back(texture.Pack()); }
+        void InvalidateBuffer(BufferHandle buffer) { m_DestroyedBuffers.push_back(buffer.Pack()); }
+        void InvalidateSampler(SamplerHandle sampler) { m_DestroyedSamplers.push_back(sampler.Pack()); }
+        void InvalidateLayouts(const std::vector<VkDescriptorSetLayout>& layouts) { m_DestroyedLayouts.insert(m_DestroyedLayouts.end(), layouts.begin(), layouts.end()); }
+
+        DescriptorCacheStats GetStats() const;
+        void ResetStats();
+
+    private:
+        struct Entry
+        {
+            VkDescriptorSet Set = VK_NULL_HANDLE;
+            uint32_t Pool = 0;
+            uint64_t LastUsedFrame = 0;
+            std::list<VulkanDescriptorKey>::iterator LruPosition;
+        };
+
+        struct RetiredSet
+        {
+            VkDescriptorSet Set = VK_NULL_HANDLE;
+            uint32_t Pool = 0;
+            uint64_t LastUsedFrame = 0;
+        };
+
+        struct Pool
+        {
+            VkDescriptorPool Handle = VK_NULL_HANDLE;
+            uint32_t Allocated = 0;
+        };
+
+        VkDescriptorSet Allocate(VkDescriptorSetLayout layout, uint32_t& outPool);
+        bool TryAllocate(uint32_t poolIndex, VkDescriptorSetLayout layout, VkDescriptorSet& outSet);
+        bool CreatePool();
+        void Free(VkDescriptorSet set, uint32_t pool);
+        void EvictLeastRecentlyUsed();
+        void DropInvalidated();
+        bool IsReleasable(uint64_t lastUsedFrame) const { return lastUsedFrame + m_FrameDelay <= m_Frame; }
+
+    private:
+        static constexpr uint32_t k_SetsPerPool = 512;
+
+        VkDevice m_Device = VK_NULL_HANDLE;
+        uint32_t m_Capacity = 0;
+        uint64_t m_FrameDelay = 0;
+        uint64_t m_Frame = 0;
+
+        std::vector<Pool> m_Pools;
+        uint32_t m_CurrentPool = 0;
+
+        // Front is the most recently used key
+        std::list<VulkanDescriptorKey> m_Lru;
+        std::unordered_map<VulkanDescriptorKey, Entry, VulkanDescriptorKeyHash> m_Entries;
+        std::vector<RetiredSet> m_Retired;
+
+        std::vector<uint64_t> m_DestroyedTextures;
+        std::vector<uint64_t> m_DestroyedBuffers;
+        std::vector<uint64_t> m_DestroyedSamplers;
+        std::vector<VkDescriptorSetLayout> m_DestroyedLayouts;
+
+        uint64_t m_Hits = 0;
+        uint64_t m_Misses = 0;
+        uint64_t m_Evictions = 0;
+    };
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -10,11 +12,16 @@
 
 #include <Trinity/Platform/PlatformTypes.h>
 #include <Trinity/Renderer/RHI/GraphicsDevice.h>
+#include <Trinity/Renderer/RHI/ResourcePool.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanInstance.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanSurface.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanPhysicalDevice.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanAllocator.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanCommands.h>
+#include <Trinity/Renderer/Backends/Vulkan/VulkanDescriptorCache.h>
+#include <Trinity/Renderer/Backends/Vulkan/VulkanBindlessTable.h>
+#include <Trinity/Renderer/Backends/Vulkan/VulkanPipelineCache.h>
+#include <Trinity/Renderer/Backends/Vulkan/VulkanUploadManager.h>
 
 namespace Trinity
 {
@@ -45,14 +52,25 @@ namespace Trinity
         VkImageView View = VK_NULL_HANDLE;
         VkFormat Format = VK_FORMAT_UNDEFINED;
         VkExtent3D Extent{};
+        uint32_t ArrayLayers = 1;
         VkImageAspectFlags Aspect = VK_IMAGE_ASPECT_COLOR_BIT;
         bool OwnsImage = true;
         bool OwnsView = true;
+        bool OwnsMemory = true;  // False for textures placed in a memory heap
+        bool Cube = false;
+        uint32_t BindlessIndex = k_InvalidBindlessIndex;
         ResourceState CurrentState = ResourceState::Undefined;
         std::vector<VulkanSubresourceView> SubViews;
         std::string DebugName;
     };
 
+    struct VulkanMemoryHeapResource
+    {
+        VmaAllocation Allocation = VK_NULL_HANDLE;
+        uint64_t Size = 0;
+        std::string DebugName;
+    };
+
     struct VulkanSamplerResource
     {
         VkSampler Sampler = VK_NULL_HANDLE;
@@ -83,12 +101,16 @@ namespace Trinity
             Texture,
             Sampler,
             Shader,
-            Pipeline
+            Pipeline,
+            MemoryHeap
         };
 
         uint64_t Frame = 0;
         Kind Type = Kind::Buffer;
 
+        // Upload timeline value that covers every copy into the resource; it is not released before the GPU has passed it
+        uint64_t UploadValue = 0;
+
         VkBuffer Buffer = VK_NULL_HANDLE;
         VkImage Image = VK_NULL_HANDLE;
         VkImageView View = VK_NULL_HANDLE;
@@ -102,93 +124,7 @@ namespace Trinity
 
         bool OwnsImage = true;
         bool OwnsView = true;
-    };
-
-    template<typename Payload, typename Tag>
-    class VulkanResourcePool
-    {
-    public:
-        Handle<Tag> Allocate(const Payload& payload)
-        {
-            uint32_t l_Index;
-
-            if (!m_FreeList.empty())
-            {
-                l_Index = m_FreeList.back();
-                m_FreeList.pop_back();
-                m_Slots[l_Index].Data = payload;
-                m_Slots[l_Index].Alive = true;
-            }
-            else
-            {
-                l_Index = static_cast<uint32_t>(m_Slots.size());
-                m_Slots.push_back({ 1, true, payload });
-            }
-
-            return Handle<Tag>(l_Index, m_Slots[l_Index].Generation);
-        }
-
-        Payload* Get(Handle<Tag> handle)
-        {
-            if (!handle.IsValid())
-            {
-                return nullptr;
-            }
-
-            uint32_t l_Index = handle.GetIndex();
-            if (l_Index >= m_Slots.size())
-            {
-                return nullptr;
-            }
-
-            Slot& l_Slot = m_Slots[l_Index];
-            if (!l_Slot.Alive || l_Slot.Generation != handle.GetGeneration())
-            {
-                return nullptr;
-            }
-
-            return &l_Slot.Data;
-        }
-
-        bool Free(Handle<Tag> handle, Payload& outPayload)
-        {
-            Payload* l_Payload = Get(handle);
-            if (l_Payload == nullptr)
-            {
-                return false;
-            }
-
-            outPayload = *l_Payload;
-            uint32_t l_Index = handle.GetIndex();
-            m_Slots[l_Index].Alive = false;
-            ++m_Slots[l_Index].Generation;
-            m_FreeList.push_back(l_Index);
-
-            return true;
-        }
-
-        template<typename Fn>
-        void ForEachAlive(Fn&& function)
-        {
-            for (Slot& it_Slot : m_Slots)
-            {
-                if (it_Slot.Alive)
-                {
-                    function(it_Slot.Data);
-                }
-            }
-        }
-
-    private:
-        struct Slot
-        {
-            uint32_t Generation = 1;
-            bool Alive = false;
-            Payload Data{};
-        };
-
-        std::vector<Slot> m_Slots;
-        std::vector<uint32_t> m_FreeList;
+        bool OwnsMemory = true;
     };
 
     class VulkanImGuiBackend;
@@ -196,7 +132,8 @@ namespace Trinity
     class VulkanDevice : public GraphicsDevice
     {
     public:
-        VulkanDevice(const NativeWindowHandle& window, const std::string& applicationName, bool enableValidation);
+        // An empty pipeline cache path keeps compiled pipelines for this run only
+        VulkanDevice(const NativeWindowHandle& window, const std::string& applicationName, bool enableValidation, const std::filesystem::path& pipelineCachePath = {});
         ~VulkanDevice() override;
 
         VulkanDevice(const VulkanDevice&) = delete;
@@ -221,6 +158,12 @@ namespace Trinity
         void DestroyPipeline(PipelineHandle handle) override;
 
         void UpdateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset = 0) override;
+        FrameAllocation AllocateFrameMemory(uint64_t size, BufferUsage usage) override;
+
+        MemoryRequirements GetTextureMemoryRequirements(const TextureDescription& description) override;
+        MemoryHeapHandle CreateMemoryHeap(const MemoryHeapDescription& description) override;
+        void DestroyMemoryHeap(MemoryHeapHandle handle) override;
+        TextureHandle CreatePlacedTexture(const TextureDescription& description, MemoryHeapHandle heap, uint64_t offset) override;
 
         std::unique_ptr<Swapchain> CreateSwapchain(const SwapchainDescription& description) override;
         std::unique_ptr<CommandList> CreateCommandList() override;
@@ -230,6 +173,16 @@ namespace Trinity
 
         void CollectGarbage() override;
 
+        DescriptorCacheStats GetDescriptorCacheStats() const override { return m_DescriptorCache.GetStats(); }
+        PipelineCacheStats GetPipelineCacheStats() const override
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+            return m_PipelineCache.GetStats();
+        }
+        FrameAllocatorStats GetFrameAllocatorStats() const override { return m_FrameHeap.GetStats(); }
+        uint32_t RegisterBindlessTexture(TextureHandle texture, SamplerHandle sampler) override;
+
         IImGuiRenderBackend& GetImGuiBackend() override;
 
         TextureHandle RegisterExternalTexture(VkImage image, VkImageView view, VkFormat format, const VkExtent3D& extent, VkImageAspectFlags aspect);
@@ -240,7 +193,23 @@ namespace Trinity
         VulkanTextureResource* GetTexture(TextureHandle handle) { return m_Textures.Get(handle); }
         VkImageView GetRenderTargetView(TextureHandle handle, uint32_t mip, uint32_t layer);
         VulkanSamplerResource* GetSampler(SamplerHandle handle) { return m_Samplers.Get(handle); }
-        VulkanPipelineResource* GetPipeline(PipelineHandle handle) { return m_Pipelines.Get(handle); }
+        // Copies what binding needs while holding the lock, since a worker creating a pipeline may grow the pool; called once per pipeline change, not per draw
+        bool GetPipelineBinding(PipelineHandle handle, VkPipeline& outPipeline, VkPipelineLayout& outLayout, std::vector<VkDescriptorSetLayout>& outSetLayouts)
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+            VulkanPipelineResource* l_Pipeline = m_Pipelines.Get(handle);
+            if (l_Pipeline == nullptr)
+            {
+                return false;
+            }
+
+            outPipeline = l_Pipeline->Pipeline;
+            outLayout = l_Pipeline->Layout;
+            outSetLayouts = l_Pipeline->SetLayouts;
+
+            return true;
+        }
 
         ResourceState GetTextureState(TextureHandle handle)
         {
@@ -255,16 +224,26 @@ namespace Trinity
         VkSurfaceKHR GetSurface() const { return m_Surface.GetHandle(); }
         VulkanAllocator& GetAllocator() { return m_Allocator; }
         VulkanCommands& GetCommands() { return m_Commands; }
+        VulkanDescriptorCache& GetDescriptorCache() { return m_DescriptorCache; }
+        VulkanBindlessTable& GetBindlessTable() { return m_BindlessTable; }
+        const VulkanUploadStats& GetUploadStats() const { return m_Uploads.GetStats(); }
 
         VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
         VkQueue GetPresentQueue() const { return m_PresentQueue; }
         uint32_t GetGraphicsQueueFamily() const { return m_GraphicsQueueFamily; }
         uint32_t GetPresentQueueFamily() const { return m_PresentQueueFamily; }
+        uint32_t GetTransferQueueFamily() const { return m_TransferQueueFamily; }
+
+        // Objects released at a given frame may be destroyed once the counter has advanced by the delay
+        uint64_t GetFrameCounter() const { return m_FrameCounter; }
+        uint64_t GetDeferredFrameDelay() const { return m_DeferredFrameDelay; }
 
     private:
         bool CreateLogicalDevice();
         void QueryCapabilities();
+        TextureHandle CreateTextureResource(const TextureDescription& description, const VulkanMemoryHeapResource* heap, uint64_t offset);
         void ReleaseNow(const DeferredRelease& release);
+        bool GrowFrameHeap(uint64_t minimumSize);
         void ReportLeaks();
         void SetObjectName(uint64_t handle, VkObjectType type, const std::string& name);
 
@@ -273,32 +252,48 @@ namespace Trinity
         std::string m_ApplicationName;
         bool m_EnableValidation = false;
         bool m_Initialized = false;
+        std::filesystem::path m_PipelineCachePath;
 
         VulkanInstance m_Instance;
         VulkanSurface m_Surface;
         VulkanPhysicalDevice m_PhysicalDevice;
         VulkanAllocator m_Allocator;
         VulkanCommands m_Commands;
+        VulkanDescriptorCache m_DescriptorCache;
+        VulkanBindlessTable m_BindlessTable;
+        VulkanPipelineCache m_PipelineCache;
+        VulkanUploadManager m_Uploads;
+        bool m_BindlessSupported = false;
 
         VkDevice m_Device = VK_NULL_HANDLE;
         VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
         VkQueue m_PresentQueue = VK_NULL_HANDLE;
+        VkQueue m_TransferQueue = VK_NULL_HANDLE;
 
         uint32_t m_GraphicsQueueFamily = 0;
         uint32_t m_PresentQueueFamily = 0;
+        uint32_t m_TransferQueueFamily = 0;
 
         DeviceCapabilities m_Capabilities;
 
-        VulkanResourcePool<VulkanBufferResource, BufferTag> m_Buffers;
-        VulkanResourcePool<VulkanTextureResource, TextureTag> m_Textures;
-        VulkanResourcePool<VulkanSamplerResource, SamplerTag> m_Samplers;
-        VulkanResourcePool<VulkanShaderResource, ShaderTag> m_Shaders;
-        VulkanResourcePool<VulkanPipelineResource, PipelineTag> m_Pipelines;
+        ResourcePool<VulkanBufferResource, BufferTag> m_Buffers;
+        ResourcePool<VulkanTextureResource, TextureTag> m_Textures;
+        ResourcePool<VulkanSamplerResource, SamplerTag> m_Samplers;
+        // Shaders and pipelines may be created from worker threads; m_PipelineMutex guards their pools and the pipeline cache statistics
+        ResourcePool<VulkanShaderResource, ShaderTag> m_Shaders;
+        ResourcePool<VulkanPipelineResource, PipelineTag> m_Pipelines;
+        mutable std::mutex m_PipelineMutex;
+        ResourcePool<VulkanMemoryHeapResource, MemoryHeapTag> m_Heaps;
 
         std::vector<DeferredRelease> m_DeferredReleases;
         uint64_t m_FrameCounter = 0;
         uint64_t m_DeferredFrameDelay = 3;
 
+        // Created on first use; a full heap is replaced by one twice the size. Allocations made earlier in the frame still name the old buffer, so its handle lives
+        // until the frame closes and then goes through the deferred releases like any other
+        FrameAllocator m_FrameHeap;
+        std::vector<BufferHandle> m_RetiredFrameHeaps;
+
         PFN_vkSetDebugUtilsObjectNameEXT m_SetObjectName = nullptr;
 
         VulkanSwapchain* m_ActiveSwapchain = nullptr;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include <vulkan/vulkan.h>
 
 #include <Trinity/ImGui/IImGuiRenderBackend.h>
@@ -24,13 +28,18 @@ namespace Trinity
         void RecordDrawData(CommandList& commandList) override;
 
         uint64_t RegisterTexture(TextureHandle texture) override;
+        // The descriptor set is freed once every frame that may have drawn with it has retired
         void UnregisterTexture(uint64_t textureID) override;
 
+    private:
+        void CollectTextures(bool all);
+
     private:
         VulkanDevice& m_Device;
         VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
         VkSampler m_Sampler = VK_NULL_HANDLE;
         VkFormat m_ColorFormat = VK_FORMAT_UNDEFINED;
+        std::vector<std::pair<VkDescriptorSet, uint64_t>> m_PendingRemovals;  // set, frame it was unregistered
         bool m_Initialized = false;
     };
 }
\ No newline at end of file
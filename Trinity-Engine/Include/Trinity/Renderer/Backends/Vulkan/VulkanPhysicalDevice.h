@@ -14,6 +14,9 @@ namespace Trinity
         std::optional<uint32_t> Graphics;
         std::optional<uint32_t> Present;
 
+        // A family that transfers but neither draws nor computes, when the device has one; uploads run there alongside rendering
+        std::optional<uint32_t> Transfer;
+
         bool IsComplete() const
         {
             return Graphics.has_value() && Present.has_value();
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include <Trinity/Renderer/RHI/GraphicsDevice.h>
+
+namespace Trinity
+{
+    // Device-wide VkPipelineCache persisted between runs. The blob on disk is only handed to the driver when its header matches this device's vendor, device and
+    // pipeline cache UUID and the driver version it was written with; anything else (another GPU, a driver update, a truncated write) starts an empty cache
+    class VulkanPipelineCache
+    {
+    public:
+        VulkanPipelineCache() = default;
+        ~VulkanPipelineCache();
+
+        VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+        VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+        // An empty path keeps the cache in memory only
+        bool Initialize(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::filesystem::path& path);
+        void Shutdown();
+
+        VkPipelineCache GetHandle() const { return m_Cache; }
+
+        // Accounts a pipeline built through the cache; the cache is saved again once it holds pipelines the file does not
+        void RecordCreation(double milliseconds);
+
+        // Writes the cache if pipelines were added since the last save. Returns false only when a write was attempted and failed
+        bool Save();
+
+        // Save in three steps for callers that hold a lock around the cache. Snapshot copies the driver's data behind its file header into outFile, leaving it empty
+        // when nothing was added; WriteFile touches only the path fixed at Initialize, so the slow disk write can run without the lock; RecordSave accounts a
+        // snapshot that reached the disk
+        bool Snapshot(std::vector<uint8_t>& outFile);
+        bool WriteFile(const std::vector<uint8_t>& file) const;
+        void RecordSave(const std::vector<uint8_t>& file);
+
+        const PipelineCacheStats& GetStats() const { return m_Stats; }
+
+    private:
+        bool Load(std::vector<uint8_t>& outData) const;
+
+    private:
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VkPipelineCache m_Cache = VK_NULL_HANDLE;
+        VkPhysicalDeviceProperties m_Properties{};
+        std::filesystem::path m_Path;
+
+        bool m_Dirty = false;
+        PipelineCacheStats m_Stats;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace Trinity
+{
+    struct VulkanUploadStats
+    {
+        uint64_t Bytes = 0;
+        uint64_t Batches = 0;
+
+        // Uploads that had to wait for an earlier batch to free ring space, and the ones too large for the ring that got a staging buffer of their own
+        uint64_t Stalls = 0;
+        uint64_t DedicatedStaging = 0;
+    };
+
+    // Streams initial resource contents through one persistently mapped staging ring. Copies recorded during a frame go out as a single batch when the frame is
+    // submitted; with a dedicated transfer queue the copies run there and ownership is handed to the graphics queue, which also generates mips. Every batch signals
+    // a timeline semaphore, and the next graphics submission waits on it, so callers never block on an upload. Main thread only
+    class VulkanUploadManager
+    {
+    public:
+        VulkanUploadManager() = default;
+        ~VulkanUploadManager();
+
+        VulkanUploadManager(const VulkanUploadManager&) = delete;
+        VulkanUploadManager& operator=(const VulkanUploadManager&) = delete;
+
+        // A transfer family equal to the graphics family records everything on the graphics queue
+        bool Initialize(VkDevice device, VmaAllocator allocator, uint32_t graphicsFamily, VkQueue graphicsQueue, uint32_t transferFamily, VkQueue transferQueue, uint64_t ringSize);
+        void Shutdown();
+
+        // Initial contents of a buffer nothing has used yet; eligible for the transfer queue
+        bool UploadBuffer(VkBuffer destination, const void* data, uint64_t size);
+
+        // Overwrites part of a buffer that frames already submitted may still be using; the copy runs on the graphics queue behind everything submitted there before
+        // it, so ownership never has to move and no earlier frame sees the new contents
+        bool UpdateBuffer(VkBuffer destination, uint64_t offset, const void* data, uint64_t size);
+
+        // Fills mip 0 of every layer and generates the remaining mips; the image ends in SHADER_READ_ONLY_OPTIMAL
+        bool UploadTexture(VkImage image, VkImageAspectFlags aspect, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, uint32_t layerCount, const void* data, uint64_t size);
+
+        // Submits the open batch, if any. Returns the timeline value the graphics queue must wait on before using anything uploaded so far, or zero when that wait
+        // has already been handed out
+        uint64_t Flush();
+
+        // Submits the open batch without handing out its wait; the next Flush still returns it
+        void Submit();
+
+        // Timeline values covering every upload recorded so far, every upload submitted so far, and every upload the GPU has finished
+        uint64_t GetRecordedValue() const { return m_Recording ? m_LastValue + 2 : m_LastValue; }
+        uint64_t GetSubmittedValue() const { return m_LastValue; }
+        uint64_t GetCompletedValue() const;
+
+        // Recycles staging space and command buffers of batches the GPU has finished
+        void Retire();
+
+        VkSemaphore GetTimeline() const { return m_Timeline; }
+        const VulkanUploadStats& GetStats() const { return m_Stats; }
+
+    private:
+        struct StagingBuffer
+        {
+            VkBuffer Buffer = VK_NULL_HANDLE;
+            VmaAllocation Allocation = VK_NULL_HANDLE;
+        };
+
+        struct Batch
+        {
+            VkCommandBuffer Transfer = VK_NULL_HANDLE;
+            VkCommandBuffer Graphics = VK_NULL_HANDLE;
+            uint64_t Value = 0;
+            uint64_t RingBytes = 0;
+            uint32_t GraphicsCopies = 0;
+            std::vector<StagingBuffer> Dedicated;
+        };
+
+        bool HasTransferQueue() const { return m_TransferFamily != m_GraphicsFamily; }
+
+        // Reserves staging memory in the open batch; falls back to a dedicated buffer when the ring cannot hold the upload
+        bool Stage(const void* data, uint64_t size, VkBuffer& outBuffer, uint64_t& outOffset);
+        bool BeginBatch();
+        void WaitForValue(uint64_t value);
+
+    private:
+        VkDevice m_Device = VK_NULL_HANDLE;
+        VmaAllocator m_Allocator = VK_NULL_HANDLE;
+        uint32_t m_GraphicsFamily = 0;
+        uint32_t m_TransferFamily = 0;
+        VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
+        VkQueue m_TransferQueue = VK_NULL_HANDLE;
+
+        VkCommandPool m_GraphicsPool = VK_NULL_HANDLE;
+        VkCommandPool m_TransferPool = VK_NULL_HANDLE;
+        VkSemaphore m_Timeline = VK_NULL_HANDLE;
+        uint64_t m_LastValue = 0;
+        uint64_t m_PendingWait = 0;
+
+        StagingBuffer m_Ring;
+        uint8_t* m_RingData = nullptr;
+        uint64_t m_RingSize = 0;
+        uint64_t m_RingHead = 0;
+        uint64_t m_RingUsed = 0;
+
+        Batch m_Open;
+        bool m_Recording = false;
+        std::deque<Batch> m_InFlight;
+        std::vector<Batch> m_Recycled;
+
+        VulkanUploadStats m_Stats;
+    };
+}
\ No newline at end of file
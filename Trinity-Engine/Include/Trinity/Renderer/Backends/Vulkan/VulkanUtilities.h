@@ -23,6 +23,7 @@ namespace Trinity
         VkCullModeFlags ToVkCullMode(CullMode mode);
         VkFrontFace ToVkFrontFace(FrontFace face);
         VkCompareOp ToVkCompareOp(CompareOp op);
+        VkIndexType ToVkIndexType(IndexType type);
         VkShaderStageFlags ToVkShaderStages(ShaderStage stages);
     }
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Trinity
+{
+    // Six inward-facing planes (xyz = normal, w = distance) extracted from a zero-to-one depth view-projection
+    struct Frustum
+    {
+        std::array<glm::vec4, 6> Planes{};
+
+        static Frustum FromViewProjection(const glm::mat4& viewProjection);
+
+        bool IntersectsSphere(const glm::vec3& center, float radius) const;
+    };
+
+    // Bounding spheres laid out structure-of-arrays so the cull kernels load four or eight of each component per instruction
+    struct SphereBatch
+    {
+        std::vector<float> CenterX;
+        std::vector<float> CenterY;
+        std::vector<float> CenterZ;
+        std::vector<float> Radius;
+
+        void Clear();
+        void Reserve(size_t count);
+        void Push(const glm::vec4& sphere);
+        size_t Size() const { return Radius.size(); }
+    };
+
+    class FrustumCuller
+    {
+    public:
+        // Writes 1 for every sphere touching the frustum and 0 otherwise; returns the visible count. Uses the widest instruction set the build targets
+        static uint32_t Cull(const Frustum& frustum, const SphereBatch& spheres, std::vector<uint8_t>& visibility);
+
+        // Reference path, also used for the tail the vector kernels leave over
+        static uint32_t CullScalar(const Frustum& frustum, const SphereBatch& spheres, std::vector<uint8_t>& visibility);
+
+        static const char* GetInstructionSet();
+    };
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Trinity
+{
+    class JobSystem;
+
+    // Matches GpuLight in Mesh.slang; used both in the frame uniform (directional lights) and in the clustered light storage buffer
+    struct GpuLight
+    {
+        glm::vec4 PositionType;    // xyz = world position, w = type (0 directional, 1 point, 2 spot)
+        glm::vec4 DirectionRange;  // xyz = normalized direction, w = range
+        glm::vec4 ColorIntensity;  // rgb = color, a = intensity
+        glm::vec4 SpotAngles;      // x = cos(inner), y = cos(outer)
+    };
+
+    // Slice of the flat light index list belonging to one cluster; matches the uint2 records of u_ClusterRanges
+    struct LightClusterRange
+    {
+        uint32_t Offset = 0;
+        uint32_t Count = 0;
+    };
+
+    struct LightClusterStats
+    {
+        uint32_t Lights = 0;
+        uint32_t Indices = 0;
+        uint32_t MaxPerCluster = 0;
+        uint32_t OccupiedClusters = 0;
+    };
+
+    // Bins point and spot lights into view-space froxels: a screen-space tile grid times exponentially spaced depth slices between the camera's near and far
+    // planes. Lights are bounded by the sphere of their range and tested against each candidate cluster's view-space box. Slices are binned independently, so the
+    // work spreads across the job system with no shared writes. Works with perspective and orthographic projections alike. Tile row 0 is the top of the target, matching
+    // the fragment shader's SV_Position
+    class LightClusterBinner
+    {
+    public:
+        static constexpr uint32_t k_DefaultTilesX = 16;
+        static constexpr uint32_t k_DefaultTilesY = 9;
+        static constexpr uint32_t k_DefaultSlices = 24;
+
+        void Configure(uint32_t tilesX, uint32_t tilesY, uint32_t slices);
+
+        // Directional lights in the input are skipped; they affect every cluster and are shaded from the frame uniform instead. A null or uninitialized job system bins serially
+        void Build(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane, const std::vector<GpuLight>& lights, JobSystem* jobSystem);
+
+        const std::vector<LightClusterRange>& GetRanges() const { return m_Ranges; }
+        const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+        const LightClusterStats& GetStats() const { return m_Stats; }
+
+        uint32_t GetTilesX() const { return m_TilesX; }
+        uint32_t GetTilesY() const { return m_TilesY; }
+        uint32_t GetSlices() const { return m_Slices; }
+        uint32_t GetClusterCount() const { return m_TilesX * m_TilesY * m_Slices; }
+
+        // slice = log(viewDepth) * x + y; the same terms the fragment shader uses to find its cluster
+        glm::vec2 GetSliceScaleBias() const { return m_SliceScaleBias; }
+
+    private:
+        struct LightBounds
+        {
+            glm::vec3 Center{ 0.0f };  // View space
+            float Radius = 0.0f;
+            uint32_t MinTileX = 0;
+            uint32_t MaxTileX = 0;
+            uint32_t MinTileY = 0;
+            uint32_t MaxTileY = 0;
+            uint32_t MinSlice = 1;
+            uint32_t MaxSlice = 0;  // Empty when MinSlice > MaxSlice
+        };
+
+        struct ClusterBox
+        {
+            glm::vec3 Min{ 0.0f };  // View space
+            glm::vec3 Max{ 0.0f };
+        };
+
+        void RebuildGrid(const glm::mat4& projection, float nearPlane, float farPlane);
+        void BoundLight(const glm::mat4& view, const glm::mat4& projection, const GpuLight& light, LightBounds& outBounds) const;
+        void BinSlice(uint32_t slice);
+        uint32_t SliceForDepth(float depth) const;
+
+    private:
+        uint32_t m_TilesX = k_DefaultTilesX;
+        uint32_t m_TilesY = k_DefaultTilesY;
+        uint32_t m_Slices = k_DefaultSlices;
+
+        // The grid only depends on the projection, so it is rebuilt when that changes rather than every frame
+        glm::mat4 m_GridProjection{ 0.0f };
+        float m_GridNear = 0.0f;
+        float m_GridFar = 0.0f;
+        std::vector<ClusterBox> m_Boxes;
+        glm::vec2 m_SliceScaleBias{ 0.0f };
+
+        std::vector<LightBounds> m_Bounds;
+        std::vector<std::vector<uint32_t>> m_SliceIndices;
+        std::vector<std::vector<uint32_t>> m_SliceLights;  // Per-slice scratch: lights whose depth range reaches the slice
+        std::vector<std::vector<uint32_t>> m_RowLights;    // Per-slice scratch: the slice's lights covering the tile row being binned
+        std::vector<LightClusterRange> m_Ranges;
+        std::vector<uint32_t> m_Indices;
+        LightClusterStats m_Stats;
+    };
+}
\ No newline at end of file
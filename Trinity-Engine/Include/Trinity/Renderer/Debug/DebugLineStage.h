@@ -8,6 +8,7 @@
 
 #include <Trinity/Renderer/RHI/Handle.h>
 #include <Trinity/Renderer/RHI/GraphicsTypes.h>
+#include <Trinity/Renderer/RHI/FrameAllocator.h>
 #include <Trinity/Physics/DebugPhysicsDraw.h>
 
 namespace Trinity
@@ -29,11 +30,12 @@ namespace Trinity
         DebugLineStage(const DebugLineStage&) = delete;
         DebugLineStage& operator=(const DebugLineStage&) = delete;
 
-        bool Initialize(GraphicsDevice& device, ShaderCompiler& compiler, const std::filesystem::path& shaderDirectory, Format colorFormat, Format depthFormat, uint32_t framesInFlight);
+        bool Initialize(GraphicsDevice& device, ShaderCompiler& compiler, const std::filesystem::path& shaderDirectory, Format colorFormat, Format depthFormat);
         void Shutdown();
 
-        void Upload(uint32_t frameIndex, const std::vector<DebugLine>& lines);
-        void Record(CommandList& commandList, uint32_t frameIndex, const glm::mat4& viewProjection);
+        // Writes the vertices into frame memory; Record must follow within the same frame
+        void Upload(const std::vector<DebugLine>& lines);
+        void Record(CommandList& commandList, const glm::mat4& viewProjection);
 
     private:
         // Deliberately not MeshVertex: this stage only needs position + color, and sharing the mesh layout would couple it to every future MeshVertex change
@@ -48,9 +50,8 @@ namespace Trinity
         ShaderHandle m_FragmentShader;
         PipelineHandle m_Pipeline;
 
-        std::vector<BufferHandle> m_VertexBuffers;
-        std::vector<uint32_t> m_VertexCounts;
-        std::vector<LineVertex> m_ScratchVertices;
+        FrameAllocation m_Vertices;
+        uint32_t m_VertexCount = 0;
 
         bool m_OverflowWarned = false;
     };
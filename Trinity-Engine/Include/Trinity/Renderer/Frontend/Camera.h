@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -38,11 +40,17 @@ namespace Trinity
         float GetNear() const { return m_Near; }
         float GetFar() const { return m_Far; }
 
+        // Chosen by the caller to tell apart views of the same scene, such as a game camera and the editor's, so state the renderer keeps per view is not shared.
+        // Stays with the view however often the Camera object itself is rebuilt
+        void SetViewId(uint32_t viewId) { m_ViewId = viewId; }
+        uint32_t GetViewId() const { return m_ViewId; }
+
     private:
         glm::mat4 m_View{ 1.0f };
         glm::mat4 m_Projection{ 1.0f };
         glm::vec3 m_Position{ 0.0f };
         float m_Near = 0.1f;
         float m_Far = 1000.0f;
+        uint32_t m_ViewId = 0;
     };
 }
\ No newline at end of file
@@ -1,11 +1,44 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include <glm/glm.hpp>
 
 #include <Trinity/Renderer/RHI/Pipeline.h>
 
 namespace Trinity
 {
+    // How an uploaded mesh stores its vertex streams. Quantized meshes need the TR_QUANTIZED shader variants and the per-mesh dequantization range
+    enum class MeshVertexFormat : uint8_t
+    {
+        Float = 0,
+        Quantized
+    };
+
+    // Everything but the position; uploaded meshes keep these in a second stream so depth-only passes never fetch them. Tangent w is the handedness
+    struct MeshVertexAttributes
+    {
+        glm::vec3 Normal;
+        glm::vec4 Tangent;
+        glm::vec2 UV;
+    };
+
+    // Position stream of a quantized mesh: xyz are 16-bit unorm offsets inside the mesh's quantization box, w holds the tangent handedness (0 for +1, 1
+    // for -1) in what would otherwise be padding
+    struct QuantizedMeshPosition
+    {
+        uint16_t Value[4];
+    };
+
+    // Attribute stream of a quantized mesh: octahedral normal and tangent as 16-bit snorm, and half-float UVs
+    struct QuantizedMeshVertexAttributes
+    {
+        int16_t Normal[2];
+        int16_t Tangent[2];
+        uint16_t UV[2];
+    };
+
     struct MeshVertex
     {
         glm::vec3 Position;
@@ -13,11 +46,45 @@ namespace Trinity
         glm::vec3 Tangent;
         glm::vec2 UV;
 
-        static VertexLayout GetLayout()
+        // +1 when the bitangent is cross(Normal, Tangent), -1 for mirrored UVs
+        float TangentSign = 1.0f;
+
+        // Layout of an uploaded mesh: tightly packed positions in slot 0, the remaining attributes in slot 1
+        static VertexLayout GetLayout(MeshVertexFormat format = MeshVertexFormat::Float)
+        {
+            VertexLayout l_Layout = GetPositionLayout(format);
+            if (format == MeshVertexFormat::Quantized)
+            {
+                l_Layout.StreamStrides = { sizeof(QuantizedMeshVertexAttributes) };
+                l_Layout.Attributes.push_back({ 1, offsetof(QuantizedMeshVertexAttributes, Normal), Format::RG16_SNORM, 1 });
+                l_Layout.Attributes.push_back({ 2, offsetof(QuantizedMeshVertexAttributes, Tangent), Format::RG16_SNORM, 1 });
+                l_Layout.Attributes.push_back({ 3, offsetof(QuantizedMeshVertexAttributes, UV), Format::RG16_SFLOAT, 1 });
+
+                return l_Layout;
+            }
+
+            l_Layout.StreamStrides = { sizeof(MeshVertexAttributes) };
+            l_Layout.Attributes.push_back({ 1, offsetof(MeshVertexAttributes, Normal), Format::RGB32_SFLOAT, 1 });
+            l_Layout.Attributes.push_back({ 2, offsetof(MeshVertexAttributes, Tangent), Format::RGBA32_SFLOAT, 1 });
+            l_Layout.Attributes.push_back({ 3, offsetof(MeshVertexAttributes, UV), Format::RG32_SFLOAT, 1 });
+
+            return l_Layout;
+        }
+
+        // Position stream alone, for the depth, shadow and overdraw passes
+        static VertexLayout GetPositionLayout(MeshVertexFormat format = MeshVertexFormat::Float)
         {
             VertexLayout l_Layout;
-            l_Layout.Stride = sizeof(MeshVertex);
-            l_Layout.Attributes = { { 0, offsetof(MeshVertex, Position), Format::RGB32_SFLOAT }, { 1, offsetof(MeshVertex, Normal), Format::RGB32_SFLOAT }, { 2, offsetof(MeshVertex, Tangent), Format::RGB32_SFLOAT }, { 3, offsetof(MeshVertex, UV), Format::RG32_SFLOAT } };
+            if (format == MeshVertexFormat::Quantized)
+            {
+                l_Layout.Stride = sizeof(QuantizedMeshPosition);
+                l_Layout.Attributes = { { 0, 0, Format::RGBA16_UNORM } };
+
+                return l_Layout;
+            }
+
+            l_Layout.Stride = sizeof(glm::vec3);
+            l_Layout.Attributes = { { 0, 0, Format::RGB32_SFLOAT } };
 
             return l_Layout;
         }
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include <Trinity/Renderer/Materials/ResolvedMaterial.h>
+
+namespace Trinity
+{
+    class Mesh;
+
+    // One submesh draw extracted from the scene. The passes walk packets in SortKey order so consecutive draws share as much bound state as possible
+    struct RenderPacket
+    {
+        uint64_t SortKey = 0;
+        const Mesh* MeshSource = nullptr;
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+        int32_t BaseVertex = 0;
+
+        // Index range the shadow cascades draw; the same detail level as above or a coarser one
+        uint32_t ShadowFirstIndex = 0;
+        uint32_t ShadowIndexCount = 0;
+        uint32_t Material = 0;  // AssetDatabase compiled material ID
+        glm::mat4 World{ 1.0f };
+        glm::vec4 WorldSphere{ 0.0f };  // xyz = center, w = radius
+
+        // The entity moved within the last few frames; such casters are kept out of the cached static shadow layer
+        bool Dynamic = false;
+    };
+
+    // Per-instance record in the frame's instance storage buffer; matches the std430 InstanceData struct in Mesh.slang and Shadow.slang
+    struct GpuInstance
+    {
+        glm::mat4 Model{ 1.0f };
+        MaterialFactorBlock Material;
+    };
+
+    static_assert(sizeof(GpuInstance) == sizeof(glm::mat4) + sizeof(MaterialFactorBlock), "GpuInstance must stay tightly packed");
+
+    // A run of consecutive visible packets sharing mesh, index range and material, drawn with a single instanced call. FirstInstance indexes the frame's instance
+    // buffer
+    struct InstanceBatch
+    {
+        uint32_t Packet = 0;  // First packet of the run; supplies the mesh and material
+        uint32_t FirstInstance = 0;
+        uint32_t InstanceCount = 0;
+
+        // The packet's lit or shadow index range, whichever the batch was built for
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+    };
+
+    // Key layout, most significant first: pipeline (8 bits), material (24 bits), mesh (32 bits)
+    inline uint64_t MakeRenderSortKey(uint32_t pipeline, uint32_t material, uint32_t mesh)
+    {
+        return (static_cast<uint64_t>(pipeline & 0xFFu) << 56) | (static_cast<uint64_t>(material & 0xFFFFFFu) << 32) | static_cast<uint64_t>(mesh);
+    }
+}
\ No newline at end of file
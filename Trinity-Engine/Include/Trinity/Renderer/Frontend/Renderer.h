@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <filesystem>
 
@@ -10,7 +12,11 @@
 #include <Trinity/Renderer/RHI/CommandList.h>
 #include <Trinity/Core/Timer.h>
 #include <Trinity/Renderer/Frontend/Camera.h>
+#include <Trinity/Renderer/Frontend/RenderPacket.h>
+#include <Trinity/Renderer/Culling/Frustum.h>
+#include <Trinity/Renderer/Culling/LightClusters.h>
 #include <Trinity/Renderer/Shaders/ShaderCompiler.h>
+#include <Trinity/Renderer/Shaders/PipelineCompiler.h>
 #include <Trinity/Renderer/Textures/TextureManager.h>
 #include <Trinity/Renderer/Meshes/MeshLibrary.h>
 #include <Trinity/Renderer/PostProcess/PostProcessStage.h>
@@ -26,6 +32,7 @@ namespace Trinity
     class Scene;
     class ImGuiLayer;
     class AssetDatabase;
+    class JobSystem;
 
     struct DebugRenderTarget
     {
@@ -40,14 +47,65 @@ namespace Trinity
     {
         uint32_t DrawCalls = 0;
         uint32_t ShadowDrawCalls = 0;
+        uint32_t PrepassDrawCalls = 0;
+
+        // Packets submitted through the instanced draws above; Instances / DrawCalls is the average batch size
+        uint32_t Instances = 0;
+        uint32_t ShadowInstances = 0;
+        uint32_t PrepassInstances = 0;
+
         uint32_t Triangles = 0;
         uint32_t Meshes = 0;
+        uint32_t Packets = 0;
+
+        // Packets extracted at a simplified detail level for the camera, and those drawn coarser still in the shadow cascades
+        uint32_t LodPackets = 0;
+        uint32_t ShadowLodPackets = 0;
+
+        // Estimated vertex stream reads, one vertex per index per instance with no post-transform cache; Saved is what the depth-only passes avoided by
+        // reading the position stream instead of full vertices
+        uint64_t VertexFetchBytes = 0;
+        uint64_t VertexFetchBytesSaved = 0;
+
+        // Vertex/index buffer and material texture binds issued by the mesh passes, and the ones elided because the previous packet already had them bound
+        uint32_t Binds = 0;
+        uint32_t BindsSkipped = 0;
+
+        // Mesh or material switches between consecutive packets
+        uint32_t StateChanges = 0;
+
+        // Packets rejected by the camera and light frustum tests; the drawn counterparts are Instances and ShadowInstances
+        uint32_t Culled = 0;
+        uint32_t ShadowCulled = 0;
+
+        // Point and spot lights binned into clusters, the light index entries that produced, and the fullest cluster's light count
+        uint32_t Lights = 0;
+        uint32_t LightIndices = 0;
+        uint32_t MaxLightsPerCluster = 0;
+
+        // Counted per active cascade, so the first two add up to the cascade count: cascades redrawn this frame, and those whose cached depth was kept because
+        // nothing they show changed or they were not due. With caster layers, the redrawn cascades that reused their static layer and drew only moving casters
+        uint32_t ShadowUpdates = 0;
+        uint32_t ShadowCacheHits = 0;
+        uint32_t ShadowStaticCacheHits = 0;
+
+        // Pipeline compiles still running on the job system; the passes waiting on them are skipped meanwhile
+        uint32_t PendingPipelines = 0;
+
+        // CPU time of the frame's stages: gathering packets from the scene, sorting them, culling and batching both views, and recording the command list
+        float ExtractMilliseconds = 0.0f;
+        float SortMilliseconds = 0.0f;
+        float CullMilliseconds = 0.0f;
+        float RecordMilliseconds = 0.0f;
     };
 
     class Renderer
     {
     public:
-        Renderer(GraphicsDevice& device, Swapchain& swapchain, FileSystem& fileSystem);
+        static constexpr uint32_t k_ShadowCascadeCount = 4;
+
+        // Light binning spreads across the job system when one is given
+        Renderer(GraphicsDevice& device, Swapchain& swapchain, FileSystem& fileSystem, JobSystem* jobSystem = nullptr);
         ~Renderer();
 
         Renderer(const Renderer&) = delete;
@@ -59,6 +117,9 @@ namespace Trinity
         void RenderFrame(Scene& scene, AssetDatabase& assetDatabase, const Camera& camera, ImGuiLayer* imgui = nullptr);
         void Resize(uint32_t width, uint32_t height);
 
+        // Drops the state kept for the scene's views; call before clearing or destroying a scene that was rendered
+        void ReleaseScene(const Scene& scene);
+
         MeshLibrary& GetMeshLibrary() { return m_MeshLibrary; }
         TextureManager& GetTextureManager() { return m_TextureManager; }
 
@@ -66,9 +127,44 @@ namespace Trinity
         uint64_t GetViewportTextureID() const { return m_ViewportTextureID; }
         void SetDepthVisualizationEnabled(bool enabled) { m_DepthVisualize = enabled; }
 
+        // Opt-in: material textures are sampled from the device's bindless table instead of bound per draw. The mesh pipeline is rebuilt in the background and swapped in
+        // once it is ready; devices without descriptor indexing keep the bound path
+        void SetBindlessEnabled(bool enabled) { m_BindlessRequested = enabled; }
+        bool IsBindlessActive() const { return m_BindlessActive; }
+
+        // On by default: the shadow map is only redrawn when the light or a caster changed. With caster layers on, settled casters go into a separate static depth
+        // map that is copied under the moving ones, so a moving object no longer redraws the whole scene into the shadow map
+        void SetShadowCachingEnabled(bool enabled) { m_ShadowCaching = enabled; }
+        bool IsShadowCachingEnabled() const { return m_ShadowCaching; }
+        void SetShadowCasterLayersEnabled(bool enabled) { m_ShadowCasterLayers = enabled; }
+        bool AreShadowCasterLayersEnabled() const { return m_ShadowCasterLayers; }
+
+        // View distance the cascades cover; the splits between them are placed along it by the practical split scheme
+        void SetShadowDistance(float distance) { m_ShadowDistance = distance; }
+        float GetShadowDistance() const { return m_ShadowDistance; }
+
+        // Opt-in: visible packets are first drawn depth-only, front to back, and the lit pass then shades each pixel's nearest surface once with an equal depth
+        // test. Its pipelines are built the first time it is enabled; until they land the scene renders without it
+        void SetDepthPrepassEnabled(bool enabled) { m_DepthPrepass = enabled; }
+        bool IsDepthPrepassEnabled() const { return m_DepthPrepass; }
+
+        // Submeshes with generated detail levels draw the coarsest one whose simplification error projects to at most this many pixels; 0 keeps full detail.
+        // A level only changes once its error is clearly past the threshold, so instances near a boundary do not flicker between two
+        void SetLodThreshold(float pixels) { m_LodThreshold = pixels; }
+        float GetLodThreshold() const { return m_LodThreshold; }
+
+        // Extra levels the shadow cascades drop below the camera's choice; shadow texels are coarser than screen pixels and hide the difference
+        void SetShadowLodBias(uint32_t levels) { m_ShadowLodBias = levels; }
+        uint32_t GetShadowLodBias() const { return m_ShadowLodBias; }
+
+        // Adds an Overdraw target to the render-target viewer that counts the fragments the lit pass shades per pixel
+        void SetOverdrawVisualizationEnabled(bool enabled) { m_OverdrawVisualize = enabled; }
+        bool IsOverdrawVisualizationEnabled() const { return m_OverdrawVisualize; }
+
         // Lines accumulate across submissions, draw depth-tested inside the scene pass of the next rendered frame, and clear afterwards — resubmit every frame while visualization is wanted
         void SubmitDebugLines(const DebugDrawBuffer& buffer);
         const RenderGraph& GetRenderGraph() const { return m_RenderGraph; }
+        void SetRenderGraphCachingEnabled(bool enabled) { m_RenderGraph.SetCachingEnabled(enabled); }
         void ApplyViewportResize();
 
         // Color render targets exposed for the editor's render-target viewer.
@@ -78,34 +174,72 @@ namespace Trinity
         const RenderStats& GetStats() const { return m_Stats; }
 
     private:
-        bool CreatePipeline();
-        bool BuildPipeline(ShaderHandle& vertexShader, ShaderHandle& fragmentShader, PipelineHandle& pipeline);
+        // Pipelines that get a twin for the quantized vertex layout
+        enum class QuantizedPipeline : uint32_t
+        {
+            Mesh = 0,
+            Equal,
+            Shadow,
+            Prepass,
+            Overdraw,
+            Count
+        };
+
+        void CreatePipeline();
+        PipelineCompileRequest DescribeMeshPipeline(bool bindless, bool depthEqual) const;
+        PipelineCompileRequest DescribeShadowPipeline() const;
+        PipelineCompileRequest DescribePrepassPipeline() const;
+        PipelineCompileRequest DescribeOverdrawPipeline(bool afterPrepass) const;
+        PipelineCompileRequest DescribeQuantizedPipeline(QuantizedPipeline pipeline, bool variant) const;
+        void CompileQuantizedPipeline(QuantizedPipeline pipeline, bool variant);
+        PipelineHandle GetQuantizedPipeline(QuantizedPipeline pipeline) const;
         void ReloadShaders();
+        void UpdatePipelines();
         void CheckHotReload();
         bool CreateTextureResources();
         void LoadEnvironmentMap();
         bool CreateIBLResources();
         bool CreateShadowResources();
-        bool ComputeShadowLight(Scene& scene, glm::mat4& outMatrix);
-        glm::mat4 ComputeLightMatrix(const glm::vec3& direction) const;
-        void DrawSceneDepth(CommandList& commandList, Scene& scene, const glm::mat4& lightViewProjection);
-        bool CreateSceneTargets(uint32_t width, uint32_t height);
-        void DestroySceneTargets();
-        bool CreateViewportOutput(uint32_t width, uint32_t height);
-        void DestroyViewportOutput();
+        bool CreateShadowStaticMap();
+        void PlanShadowUpdate();
+        bool ComputeShadowLight(Scene& scene, glm::vec3& outDirection);
+        void FitShadowCascades(const Camera& camera, const glm::vec3& direction);
+        void DrawShadowCascades(CommandList& commandList, TextureHandle target, bool staticLayer, bool clear);
+        void ExtractRenderPackets(Scene& scene, AssetDatabase& assetDatabase, const Camera& camera);
+        void BuildInstanceBatches(const AssetDatabase& assetDatabase, const Camera& camera);
+        void AppendInstanceBatches(const std::vector<uint8_t>& visibility, bool matchMaterial, bool shadowDetail, std::vector<InstanceBatch>& outBatches, const AssetDatabase& assetDatabase);
+        void AppendInstance(uint32_t packet, bool matchMaterial, bool shadowDetail, std::vector<InstanceBatch>& outBatches, const AssetDatabase& assetDatabase);
+        void SortPrepassPackets(const Camera& camera);
+        bool UploadLightClusters(const Camera& camera);
+        void DrawSceneDepth(CommandList& commandList, PipelineHandle pipeline, PipelineHandle quantizedPipeline, const glm::mat4& viewProjection, const std::vector<InstanceBatch>& batches, uint32_t& drawCalls, uint32_t& instances);
+        void RefreshViewportTexture();
         void DrawScene(CommandList& commandList, Scene& scene, AssetDatabase& assetDatabase, const Camera& camera);
 
     private:
         GraphicsDevice& m_Device;
         Swapchain& m_Swapchain;
         FileSystem& m_FileSystem;
+        JobSystem* m_JobSystem = nullptr;
         ShaderCompiler m_ShaderCompiler;
+        PipelineCompiler m_PipelineCompiler;
         TextureManager m_TextureManager;
 
         ShaderHandle m_VertexShader;
         ShaderHandle m_FragmentShader;
         PipelineHandle m_Pipeline;
         MeshLibrary m_MeshLibrary;
+        bool m_BindlessRequested = false;
+        bool m_BindlessActive = false;
+
+        // Compiles in flight; until one lands the previous pipeline keeps drawing, or the pass is skipped if there is none yet
+        PipelineFuture m_PendingPipeline;
+        bool m_PendingBindless = false;
+        PipelineFuture m_PendingShadowPipeline;
+        PipelineFuture m_PendingPrepassPipeline;
+        PipelineFuture m_PendingEqualPipeline;
+        bool m_PendingEqualBindless = false;
+        PipelineFuture m_PendingOverdrawPipeline;
+        bool m_PendingOverdrawPrepass = false;
 
         PostProcessStage m_PostProcess;
         DepthVisualizeStage m_DepthVisualizeStage;
@@ -127,11 +261,141 @@ namespace Trinity
         ShaderHandle m_ShadowVertex;
         ShaderHandle m_ShadowFragment;
         PipelineHandle m_ShadowPipeline;
-        glm::mat4 m_ShadowLightViewProjection{ 1.0f };
         bool m_ShadowActive = false;
 
+        // Depth pre-pass: the shadow shaders with the camera's matrix, and the lit pipeline built for after it, which tests for equal depth and leaves depth
+        // alone. The latter is only used while its bindless mode matches the main one's
+        ShaderHandle m_PrepassVertex;
+        ShaderHandle m_PrepassFragment;
+        PipelineHandle m_PrepassPipeline;
+        ShaderHandle m_EqualVertexShader;
+        ShaderHandle m_EqualFragmentShader;
+        PipelineHandle m_EqualPipeline;
+        bool m_EqualBindless = false;
+        bool m_DepthPrepass = false;
+        bool m_PrepassRequested = false;
+        bool m_PrepassActive = false;
+
+        // Camera-visible packets ordered front to back by coarse depth bucket, then geometry, so nearby copies of a mesh still batch
+        std::vector<uint32_t> m_PrepassOrder;
+        std::vector<uint64_t> m_PrepassKeys;
+        std::vector<InstanceBatch> m_PrepassBatches;
+
+        ShaderHandle m_OverdrawVertex;
+        ShaderHandle m_OverdrawFragment;
+        PipelineHandle m_OverdrawPipeline;
+        TextureHandle m_Overdraw;
+        bool m_OverdrawVisualize = false;
+        bool m_OverdrawRequested = false;
+
+        // Whether the overdraw pipeline replays the post-pre-pass equal test; it is only used while that matches the frame's pre-pass mode
+        bool m_OverdrawPrepass = false;
+
+        float m_LodThreshold = 1.0f;
+        uint32_t m_ShadowLodBias = 1;
+
+        // Fraction of the threshold a level's projected error must move past before the selection leaves it
+        static constexpr float k_LodHysteresis = 0.25f;
+
+        // Detail level each submesh was drawn at, 0 being full detail, for the hysteresis. Kept per view, a scene instance seen through a camera view id, so views
+        // never steer each other's selection; keyed by entity and submesh index. Views go with ReleaseScene; entries and views not drawn for a while are dropped
+        struct LodEntry
+        {
+            uint8_t Level = 0;
+            uint64_t Frame = 0;
+        };
+
+        struct LodView
+        {
+            uint64_t SceneId = 0;
+            uint32_t ViewId = 0;
+            uint64_t Frame = 0;
+            std::unordered_map<uint64_t, LodEntry> Levels;
+        };
+
+        LodView& AcquireLodView(const Scene& scene, const Camera& camera);
+
+        std::vector<LodView> m_LodViews;
+        uint64_t m_LodFrame = 0;
+
+        // The pipelines above rebuilt for meshes stored in MeshVertexFormat::Quantized. Each shares its float counterpart's bindings and push constant range,
+        // so a pass switches between the two without rebinding anything. Built the first time a quantized mesh is extracted, and only for pipelines already
+        // asked for; quantized batches are skipped while their twin is missing
+        struct QuantizedTwin
+        {
+            PipelineHandle Pipeline;
+            ShaderHandle VertexShader;
+            ShaderHandle FragmentShader;
+            PipelineFuture Pending;
+            bool Requested = false;
+
+            // Bindless mode of the lit twins, or pre-pass mode of the overdraw twin, built and in flight; such a twin is only used while it matches the active one
+            bool Variant = false;
+            bool PendingVariant = false;
+        };
+
+        std::array<QuantizedTwin, static_cast<size_t>(QuantizedPipeline::Count)> m_QuantizedPipelines;
+        bool m_QuantizedMeshes = false;
+
+        // What a cascade layer was last rendered from: the hash of the light and its casters, the float and quantized pipelines that drew them, and the matrix
+        // and bias the lit pass must sample it with, which lag the fitted ones while a cascade waits for its turn to update
+        struct ShadowCacheState
+        {
+            uint64_t Hash = 0;
+            PipelineHandle Pipeline;
+            PipelineHandle QuantizedShadowPipeline;
+            glm::mat4 LightViewProjection{ 1.0f };
+            float Bias = 0.0f;
+            bool Valid = false;
+        };
+
+        struct ShadowCascade
+        {
+            // Fitted to this frame's camera: the light matrix, the view depth the cascade ends at, and the depth bias worth a fixed number of its texels
+            glm::mat4 LightViewProjection{ 1.0f };
+            float SplitDistance = 0.0f;
+            float Bias = 0.0f;
+
+            ShadowCacheState Cache;
+            ShadowCacheState StaticCache;
+
+            // Casters inside this cascade's light frustum; with caster layers on the settled ones move into StaticVisibility
+            std::vector<uint8_t> Visibility;
+            std::vector<uint8_t> StaticVisibility;
+            std::vector<InstanceBatch> Batches;
+            std::vector<InstanceBatch> StaticBatches;
+
+            // This frame's plan from PlanShadowUpdate
+            bool Draw = false;
+            bool DrawStatic = false;
+        };
+
+        // One array layer per cascade. The static map holds the settled casters, drawn once and copied under the dynamic ones; allocated the first time caster
+        // layers are used
+        TextureHandle m_ShadowStaticMap;
+        std::array<ShadowCascade, k_ShadowCascadeCount> m_ShadowCascades;
+        float m_ShadowDistance = 150.0f;
+        bool m_ShadowCaching = true;
+        bool m_ShadowCasterLayers = false;
+        bool m_ShadowLayered = false;
+        uint64_t m_ShadowFrame = 0;
+
+        // Set once a map has been through a frame, after which every frame hands it back in ShaderResource; kept layers are imported in that state
+        bool m_ShadowMapReady = false;
+        bool m_ShadowStaticMapReady = false;
+
         static constexpr uint32_t k_ShadowMapSize = 2048;
-        static constexpr float k_ShadowBias = 0.0015f;
+
+        // Weight of the logarithmic split over the uniform one, how far behind a cascade casters are still caught, its depth bias in texels, the depth step its
+        // light is snapped to, and the frames between updates of each cascade; far cascades show changes less and wait longer
+        static constexpr float k_ShadowSplitBlend = 0.75f;
+        static constexpr float k_ShadowCasterReach = 100.0f;
+        static constexpr float k_ShadowBiasTexels = 1.5f;
+        static constexpr float k_ShadowDepthStep = 1.0f;
+        static constexpr std::array<uint32_t, k_ShadowCascadeCount> k_ShadowCascadeIntervals = { 1, 1, 2, 4 };
+
+        // Frames a caster must stay still before it moves into the static shadow layer, so objects that pause briefly do not invalidate it twice
+        static constexpr uint32_t k_ShadowSettleFrames = 30;
 
         static constexpr uint32_t k_IrradianceSize = 32;
         static constexpr uint32_t k_PrefilterSize = 128;
@@ -139,8 +403,22 @@ namespace Trinity
         static constexpr uint32_t k_BrdfLutSize = 512;
         RenderGraph m_RenderGraph;
 
-        std::vector<BufferHandle> m_FrameUniforms;
+        // GpuInstance records for both the scene and shadow batches, in this frame's slice of the device frame heap
+        FrameAllocation m_InstanceMemory;
+
+        // Clustered lighting data for this frame: point and spot lights, one range per cluster, and the flat light index list the ranges point into
+        struct ClusterMemory
+        {
+            FrameAllocation Lights;
+            FrameAllocation Ranges;
+            FrameAllocation Indices;
+        };
 
+        LightClusterBinner m_LightClusters;
+        std::vector<GpuLight> m_ClusteredLights;
+        ClusterMemory m_ClusterMemory;
+
+        // Resolved from the render graph after every compile; invalid while the graph has not placed them
         TextureHandle m_SceneColor;
         TextureHandle m_SceneDepth;
         TextureHandle m_DepthVis;
@@ -155,12 +433,31 @@ namespace Trinity
         uint32_t m_PendingHeight = 0;
         bool m_ViewportDirty = false;
         uint64_t m_ViewportTextureID = 0;
+        TextureHandle m_ViewportTextureSource;
 
         float m_Exposure = 1.0f;
 
         std::vector<std::unique_ptr<CommandList>> m_CommandLists;
         uint32_t m_FrameIndex = 0;
 
+        // Packets are sorted through a compact key array and gathered into the scratch vector, which then swaps with m_Packets; moving 16-byte entries
+        // during the sort is far cheaper than moving whole packets
+        struct PacketSortEntry
+        {
+            uint64_t Key = 0;
+            uint32_t FirstIndex = 0;
+            uint32_t Packet = 0;
+        };
+
+        // Rebuilt every frame by ExtractRenderPackets; the containers keep their capacity so steady-state extraction does not allocate
+        std::vector<RenderPacket> m_Packets;
+        std::vector<RenderPacket> m_PacketScratch;
+        std::vector<PacketSortEntry> m_PacketOrder;
+        SphereBatch m_PacketSpheres;
+        std::vector<uint8_t> m_CameraVisibility;
+        std::vector<GpuInstance> m_Instances;
+        std::vector<InstanceBatch> m_SceneBatches;
+
         Timer m_Timer;
         RenderStats m_Stats;
 
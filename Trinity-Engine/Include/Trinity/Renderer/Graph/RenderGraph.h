@@ -1,19 +1,114 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <deque>
-#include <functional>
+#include <new>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <Trinity/Renderer/RHI/GraphicsTypes.h>
+#include <Trinity/Renderer/RHI/GraphicsDevice.h>
 #include <Trinity/Renderer/RHI/Handle.h>
+#include <Trinity/Renderer/RHI/CommandList.h>
+#include <Trinity/Renderer/RHI/Texture.h>
 
 namespace Trinity
 {
-    class CommandList;
+    // Pass callback stored inline, so declaring a pass never allocates. Captures that do not fit are a compile error rather than a silent heap spill
+    class RenderGraphExecute
+    {
+    public:
+        static constexpr size_t k_Capacity = 128;
+
+        RenderGraphExecute() = default;
+        ~RenderGraphExecute() { Reset(); }
+
+        RenderGraphExecute(const RenderGraphExecute&) = delete;
+        RenderGraphExecute& operator=(const RenderGraphExecute&) = delete;
+
+        RenderGraphExecute(RenderGraphExecute&& other) noexcept { MoveFrom(other); }
+
+        RenderGraphExecute& operator=(RenderGraphExecute&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+
+            return *this;
+        }
 
-    using RenderGraphExecute = std::function<void(CommandList&)>;
+        template<typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, RenderGraphExecute>>>
+        RenderGraphExecute& operator=(Fn&& function)
+        {
+            using Callable = std::decay_t<Fn>;
+            static_assert(sizeof(Callable) <= k_Capacity, "Render graph pass captures exceed the inline callback storage");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Render graph pass captures are over-aligned");
+
+            Reset();
+            new (m_Storage) Callable(std::forward<Fn>(function));
+            m_Invoke = [](void* storage, CommandList& commandList) { (*static_cast<Callable*>(storage))(commandList); };
+            m_Relocate = [](void* destination, void* source)
+                {
+                    new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+                    static_cast<Callable*>(source)->~Callable();
+                };
+            m_Destroy = [](void* storage) { static_cast<Callable*>(storage)->~Callable(); };
+
+            return *this;
+        }
+
+        RenderGraphExecute& operator=(std::nullptr_t)
+        {
+            Reset();
+
+            return *this;
+        }
+
+        void operator()(CommandList& commandList) { m_Invoke(m_Storage, commandList); }
+        explicit operator bool() const { return m_Invoke != nullptr; }
+
+        void Reset()
+        {
+            if (m_Destroy != nullptr)
+            {
+                m_Destroy(m_Storage);
+            }
+
+            m_Invoke = nullptr;
+            m_Relocate = nullptr;
+            m_Destroy = nullptr;
+        }
+
+    private:
+        void MoveFrom(RenderGraphExecute& other)
+        {
+            if (other.m_Invoke == nullptr)
+            {
+                return;
+            }
+
+            other.m_Relocate(m_Storage, other.m_Storage);
+            m_Invoke = other.m_Invoke;
+            m_Relocate = other.m_Relocate;
+            m_Destroy = other.m_Destroy;
+
+            other.m_Invoke = nullptr;
+            other.m_Relocate = nullptr;
+            other.m_Destroy = nullptr;
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char m_Storage[k_Capacity];
+        void (*m_Invoke)(void*, CommandList&) = nullptr;
+        void (*m_Relocate)(void*, void*) = nullptr;
+        void (*m_Destroy)(void*) = nullptr;
+    };
 
     struct RenderGraphColorTarget
     {
@@ -37,12 +132,42 @@ namespace Trinity
         float DepthClearValue = 1.0f;
         bool ManageRendering = true;
 
+        // Kept even when nothing consumes its outputs, for passes whose effects the graph cannot see
+        bool NeverCull = false;
+
         uint32_t Width = 0;
         uint32_t Height = 0;
 
         RenderGraphExecute Execute;
     };
 
+    struct RenderGraphStats
+    {
+        uint32_t Passes = 0;
+        uint32_t CulledPasses = 0;
+
+        // Individual texture transitions, and the pipeline barrier calls they were merged into
+        uint32_t Barriers = 0;
+        uint32_t BarrierBatches = 0;
+
+        // Transient textures placed this frame and the heaps backing them; memory is the peak footprint with and without aliasing
+        uint32_t TransientTextures = 0;
+        uint32_t TransientHeaps = 0;
+        uint64_t TransientMemory = 0;
+        uint64_t TransientMemoryUnaliased = 0;
+
+        // The frame's topology matched the cached plan, so Compile only patched per-frame handles
+        bool Reused = false;
+        uint64_t Compilations = 0;
+    };
+
+    // A frame runs in three phases: setup (Reset, Import, CreateTransient, AddPass, SetPresent), Compile, and Execute. Compile walks the declared reads and writes to
+    // find each pass's producers, culls passes that nothing presented or exported depends on, places transient textures in shared memory heaps so those whose
+    // lifetimes never overlap alias each other, and precomputes the transitions every surviving pass needs as one barrier batch.
+    //
+    // The compiled plan refers to resources by declaration order rather than by handle and is kept across frames. Compile hashes the declared topology and, when
+    // it matches the cached plan, only the handles imported this frame and the pass callbacks change. Pass slots, their vectors and names are recycled by Reset, so
+    // a frame that declares the same graph as the last one does not allocate.
     class RenderGraph
     {
     public:
@@ -51,52 +176,166 @@ namespace Trinity
             std::string Name;
             std::vector<std::string> Reads;
             std::vector<std::string> Writes;
+            std::vector<std::string> DependsOn;
             bool Managed = true;
+            bool Culled = false;
+            uint32_t Barriers = 0;
         };
 
+        // Transient textures are created by the graph itself; without a device they never resolve.
+        void Initialize(GraphicsDevice& device);
+        void Shutdown();
+
         // Start a new frame: clears passes and resource state tracking.
         void Reset();
 
         // Register an external resource and its state at the start of the frame.
-        void Import(TextureHandle handle, ResourceState initialState, const std::string& name = "");
+        void Import(TextureHandle handle, ResourceState initialState, std::string_view name = {});
+
+        // Declare a texture that only lives for this frame. The returned handle is virtual: passes reference it like any other texture, Compile places it, and
+        // callbacks resolve it through GetTexture(). Its contents start undefined every frame.
+        TextureHandle CreateTransient(const TextureDescription& description);
+
+        // Physical texture behind a handle. Imported handles resolve to themselves; transients to the texture the last Compile placed, invalid while culled.
+        TextureHandle GetTexture(TextureHandle handle) const;
 
         // Add a pass. The reference is stable until the next Reset().
-        RenderGraphPass& AddPass(const std::string& name);
+        RenderGraphPass& AddPass(std::string_view name);
 
         // Resource transitioned to Present after all passes have executed.
         void SetPresent(TextureHandle handle);
 
-        // Record every pass into the command list (call between Begin and End).
+        // Resource whose final contents are used outside the graph, so the passes producing it survive culling
+        void Export(TextureHandle handle);
+
+        // Build the dependency graph, cull unused passes and batch their transitions, or reuse the cached plan when the topology is unchanged. Execute compiles
+        // first if this was not called.
+        void Compile();
+
+        // Record every surviving pass into the command list (call between Begin and End).
         void Execute(CommandList& commandList);
 
-        // Last-executed pass list, for debugging and editor inspection.
+        // Enabled by default; when off every Compile rebuilds the plan from scratch.
+        void SetCachingEnabled(bool enabled) { m_CachingEnabled = enabled; }
+        bool IsCachingEnabled() const { return m_CachingEnabled; }
+
+        // Last-compiled pass list including culled passes, for debugging and editor inspection.
         const std::vector<PassInfo>& GetPasses() const { return m_PassInfo; }
+        const RenderGraphStats& GetStats() const { return m_Stats; }
 
     private:
-        struct ResourceEntry
+        // Resource indices a pass touches, as ranges into m_PassResources
+        struct PassResources
         {
-            TextureHandle Handle;
-            ResourceState State = ResourceState::Undefined;
+            uint32_t FirstRead = 0;
+            uint32_t ReadCount = 0;
+            uint32_t FirstWrite = 0;
+            uint32_t WriteCount = 0;
+            uint32_t FirstLoad = 0;
+            uint32_t LoadCount = 0;
+            uint32_t Depth = UINT32_MAX;
+        };
+
+        struct CompiledBarrier
+        {
+            uint32_t Resource = 0;
+            ResourceState From = ResourceState::Undefined;
+            ResourceState To = ResourceState::Undefined;
+            bool Aliased = false;
         };
 
-        struct ResourceName
+        struct CompiledPass
         {
+            bool Culled = false;
+            uint32_t FirstBarrier = 0;
+            uint32_t BarrierCount = 0;
+        };
+
+        struct TransientTexture
+        {
+            TextureDescription Description;
+            MemoryRequirements Requirements;
+            uint32_t FirstPass = UINT32_MAX;
+            uint32_t LastPass = 0;
+            uint32_t Heap = UINT32_MAX;
+            uint64_t Offset = 0;
+            TextureHandle Physical;
+        };
+
+        struct TransientHeap
+        {
+            MemoryHeapHandle Handle;
+            uint64_t Size = 0;
+            uint64_t Alignment = 1;
+            uint32_t TypeBits = 0;
+            uint64_t RetiredFrame = 0;
+        };
+
+        struct PooledTexture
+        {
+            TextureDescription Description;
+            uint32_t Heap = 0;
+            uint64_t Offset = 0;
             TextureHandle Handle;
-            std::string Name;
         };
 
-        ResourceState GetState(TextureHandle handle) const;
-        void SetState(TextureHandle handle, ResourceState state);
-        void Transition(CommandList& commandList, TextureHandle handle, ResourceState target);
-        std::string NameOf(TextureHandle handle) const;
+        uint32_t ResourceIndex(TextureHandle handle);
+        uint32_t& ResourceSlot(TextureHandle handle);
+        std::string NameOf(uint32_t resource) const;
+        bool IsTransient(TextureHandle handle) const { return handle.IsValid() && handle.GetGeneration() == 0 && handle.GetIndex() < m_TransientCount; }
+        TextureHandle Resolve(uint32_t resource) const { return GetTexture(m_Resources[resource]); }
+        uint64_t GatherTopology();
+        void BuildPlan();
+        void PlaceTransients();
+        void RealizeTransients();
+        void CollectRetiredHeaps();
+        void ReleasePool();
+        void RecordPass(CommandList& commandList, RenderGraphPass& pass);
 
     private:
+        GraphicsDevice* m_Device = nullptr;
+        uint64_t m_Frame = 0;
+
+        // Slots past the counts are kept from earlier frames so their strings and vectors can be reused
         std::deque<RenderGraphPass> m_Passes;
-        std::vector<ResourceEntry> m_States;
-        std::vector<ResourceName> m_Names;
-        std::vector<PassInfo> m_PassInfo;
+        uint32_t m_PassCount = 0;
 
-        TextureHandle m_Present;
-        bool m_HasPresent = false;
+        std::vector<TextureHandle> m_Resources;
+        std::vector<ResourceState> m_InitialStates;
+        std::vector<std::string> m_Names;
+        std::vector<uint8_t> m_Exported;
+        uint32_t m_ResourceCount = 0;
+        std::vector<uint32_t> m_ResourceSlots;
+        uint32_t m_Present = UINT32_MAX;
+
+        // Declared this frame; their virtual handles index this array
+        std::vector<TransientTexture> m_Transients;
+        uint32_t m_TransientCount = 0;
+
+        // Gathered every Compile; the plan below is rebuilt from it only when the topology hash changes
+        std::vector<PassResources> m_PassRanges;
+        std::vector<uint32_t> m_PassResources;
+
+        std::vector<CompiledPass> m_Compiled;
+        std::vector<CompiledBarrier> m_Barriers;
+        uint32_t m_FinalBarrierOffset = 0;
+        uint64_t m_PlanHash = 0;
+        bool m_HasPlan = false;
+        bool m_CachingEnabled = true;
+        bool m_IsCompiled = false;
+
+        // Per-frame scratch filled from the plan at execute time
+        std::vector<TextureBarrier> m_FrameBarriers;
+        std::vector<RenderingAttachment> m_FrameAttachments;
+
+        // Physical side of the transients, kept across frames while the placement plan stays the same. Retired heaps wait until no frame can still use them
+        // before they are reused for a new plan or freed
+        std::vector<TransientHeap> m_PlannedHeaps;
+        std::vector<TransientHeap> m_Heaps;
+        std::vector<TransientHeap> m_RetiredHeaps;
+        std::vector<PooledTexture> m_Pool;
+
+        std::vector<PassInfo> m_PassInfo;
+        RenderGraphStats m_Stats;
     };
 }
\ No newline at end of file
@@ -1,14 +1,49 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 
-#include <Trinity/Renderer/Materials/MaterialParameter.h>
+#include <glm/glm.hpp>
+
+#include <Trinity/Core/UUID.h>
+#include <Trinity/Renderer/RHI/Handle.h>
 
 namespace Trinity
 {
+    enum class MaterialTextureSlot : uint32_t
+    {
+        BaseColor = 0,
+        Normal,
+        MetallicRoughness,
+        Emissive,
+        Count
+    };
+
+    // Fixed-offset factor block; the layout matches the material fields of InstanceData in Mesh.slang so each instance copies it verbatim
+    struct MaterialFactorBlock
+    {
+        glm::vec4 BaseColorFactor{ 1.0f };
+        glm::vec4 PbrFactors{ 0.0f, 0.5f, 1.0f, 1.0f };      // x = metallic, y = roughness, z = occlusionStrength, w = normalScale
+        glm::vec4 EmissiveFactor{ 0.0f, 0.0f, 0.0f, 1.0f };  // rgb = emissive color, a = emissive strength
+        glm::uvec4 TextureIndices{ 0u };                     // Bindless slots in MaterialTextureSlot order; only read when the bindless path is active
+    };
+
+    static_assert(sizeof(MaterialFactorBlock) == sizeof(glm::vec4) * 4, "MaterialFactorBlock must stay tightly packed");
+
+    // A Material (with any MaterialInstance overrides applied) flattened into the form the renderer draws with. Compiled and owned by AssetDatabase
     struct ResolvedMaterial
     {
+        static constexpr uint32_t TextureCount = static_cast<uint32_t>(MaterialTextureSlot::Count);
+
+        // Index into the database's compiled table; stable for the session, recompilation happens in place
+        uint32_t ID = 0;
+        UUID Source = UUID(0);
         std::string Shader = "Mesh";
-        MaterialParameterMap Parameters;
+
+        MaterialFactorBlock Factors;
+        std::array<TextureHandle, TextureCount> Textures{};
+
+        TextureHandle GetTexture(MaterialTextureSlot slot) const { return Textures[static_cast<uint32_t>(slot)]; }
     };
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 
+#include <Trinity/Renderer/RHI/GraphicsTypes.h>
 #include <Trinity/Renderer/RHI/Handle.h>
 #include <Trinity/Renderer/Meshes/MeshData.h>
 
@@ -24,22 +25,41 @@ namespace Trinity
 
         bool IsValid() const { return m_VertexBuffer.IsValid() && m_IndexBuffer.IsValid(); }
 
+        // One buffer holding both vertex streams: positions from offset 0, then the attributes from GetAttributeOffset, in the layout GetVertexFormat names
         BufferHandle GetVertexBuffer() const { return m_VertexBuffer; }
+        uint64_t GetAttributeOffset() const { return m_AttributeOffset; }
+        uint32_t GetPositionStride() const { return m_PositionStride; }
+        uint32_t GetAttributeStride() const { return m_AttributeStride; }
+        MeshVertexFormat GetVertexFormat() const { return m_VertexFormat; }
+        const MeshQuantizationBox& GetQuantizationBox() const { return m_QuantizationBox; }
         BufferHandle GetIndexBuffer() const { return m_IndexBuffer; }
+        IndexType GetIndexType() const { return m_IndexType; }
         uint32_t GetVertexCount() const { return m_VertexCount; }
         uint32_t GetIndexCount() const { return m_IndexCount; }
         const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
         const std::vector<MaterialSlot>& GetMaterialSlots() const { return m_MaterialSlots; }
+        const MeshBounds& GetBounds() const { return m_Bounds; }
+
+        // Process-unique and fixed for the mesh's lifetime; the renderer sorts packets of the same material by it
+        uint32_t GetSortID() const { return m_SortID; }
 
     private:
         GraphicsDevice& m_Device;
+        uint32_t m_SortID = 0;
 
         BufferHandle m_VertexBuffer;
         BufferHandle m_IndexBuffer;
+        MeshVertexFormat m_VertexFormat = MeshVertexFormat::Float;
+        IndexType m_IndexType = IndexType::UInt32;
+        MeshQuantizationBox m_QuantizationBox;
+        uint64_t m_AttributeOffset = 0;
+        uint32_t m_PositionStride = 0;
+        uint32_t m_AttributeStride = 0;
         uint32_t m_VertexCount = 0;
         uint32_t m_IndexCount = 0;
 
         std::vector<Submesh> m_Submeshes;
         std::vector<MaterialSlot> m_MaterialSlots;
+        MeshBounds m_Bounds;
     };
 }
\ No newline at end of file
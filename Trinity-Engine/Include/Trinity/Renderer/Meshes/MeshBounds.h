@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include <Trinity/Renderer/Frontend/MeshVertex.h>
+
+namespace Trinity
+{
+    struct MeshData;
+
+    // Object-space bounding volumes of a mesh or submesh, computed once at import
+    struct MeshBounds
+    {
+        glm::vec3 Min{ 0.0f };
+        glm::vec3 Max{ 0.0f };
+        glm::vec3 Center{ 0.0f };
+        float Radius = 0.0f;
+
+        // World-space sphere (xyz = center, w = radius). The radius scales by the largest axis so it stays conservative under non-uniform scale
+        glm::vec4 TransformSphere(const glm::mat4& transform) const;
+    };
+
+    // Bounds of the vertices referenced by indices [firstIndex, firstIndex + indexCount), offset by baseVertex
+    MeshBounds ComputeMeshBounds(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices, uint32_t firstIndex, uint32_t indexCount, uint32_t baseVertex);
+
+    // Fills the bounds of every submesh and of the mesh as a whole
+    void ComputeMeshBounds(MeshData& data);
+}
\ No newline at end of file
@@ -7,9 +7,21 @@
 #include <glm/glm.hpp>
 
 #include <Trinity/Renderer/Frontend/MeshVertex.h>
+#include <Trinity/Renderer/Meshes/MeshBounds.h>
+#include <Trinity/Renderer/Meshes/MeshOptimizer.h>
+#include <Trinity/Renderer/Meshes/MeshQuantization.h>
 
 namespace Trinity
 {
+    // A simplified copy of a submesh's triangles in the mesh's index buffer, drawn with the submesh's BaseVertex. Error bounds, in mesh units, how far the
+    // simplified surface strays from the full-detail one
+    struct SubmeshLod
+    {
+        uint32_t FirstIndex = 0;
+        uint32_t IndexCount = 0;
+        float Error = 0.0f;
+    };
+
     struct Submesh
     {
         uint32_t FirstIndex = 0;
@@ -17,6 +29,10 @@ namespace Trinity
         uint32_t BaseVertex = 0;
         uint32_t MaterialIndex = 0;
         std::string Name;
+        MeshBounds Bounds;
+
+        // Coarser levels after the full-detail range above, in order of decreasing detail and increasing error
+        std::vector<SubmeshLod> Lods;
     };
 
     struct MaterialSlot
@@ -32,6 +48,15 @@ namespace Trinity
         std::string SourceFormat;
         bool GeneratedNormals = false;
         bool GeneratedTangents = false;
+        MeshQuantizationError QuantizationError;
+
+        // Detail levels generated across all submeshes, and the indices they added to the mesh
+        uint32_t LodLevels = 0;
+        uint32_t LodIndices = 0;
+
+        // Cache and overdraw figures of the full-detail ranges as they came out of the source file, and after the optimization stage
+        MeshOptimizeMetrics SourceMetrics;
+        MeshOptimizeMetrics OptimizedMetrics;
         std::vector<std::string> Warnings;
     };
 
@@ -41,6 +66,10 @@ namespace Trinity
         std::vector<uint32_t> Indices;
         std::vector<Submesh> Submeshes;
         std::vector<MaterialSlot> MaterialSlots;
+        MeshBounds Bounds;
+
+        // Layout Mesh::Upload stores the vertices in; the importer picks Quantized when the measured error is within tolerance
+        MeshVertexFormat VertexFormat = MeshVertexFormat::Float;
         MeshImportDiagnostics Diagnostics;
     };
 }
\ No newline at end of file
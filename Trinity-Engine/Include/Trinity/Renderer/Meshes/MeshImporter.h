@@ -5,9 +5,20 @@
 #include <optional>
 
 #include <Trinity/Renderer/Meshes/MeshData.h>
+#include <Trinity/Renderer/Meshes/MeshOptimizer.h>
+#include <Trinity/Renderer/Meshes/MeshSimplifier.h>
 
 namespace Trinity
 {
+    struct MeshImportSettings
+    {
+        // Simplified levels built for every submesh; an empty ratio list imports full detail only
+        MeshLodSettings Lods;
+
+        // Triangle and vertex order; disabled, the mesh keeps the source file's order and only the metrics are measured
+        MeshOptimizeSettings Optimization;
+    };
+
     class MeshImporter
     {
     public:
@@ -17,7 +28,10 @@ namespace Trinity
         MeshImporter(const MeshImporter&) = delete;
         MeshImporter& operator=(const MeshImporter&) = delete;
 
-        std::optional<MeshData> Import(const std::filesystem::path& path);
+        std::optional<MeshData> Import(const std::filesystem::path& path, const MeshImportSettings& settings = {});
+
+        // Whether the importer has a reader for the file's extension
+        bool IsExtensionSupported(const std::filesystem::path& path) const;
 
     private:
         struct Implementation;
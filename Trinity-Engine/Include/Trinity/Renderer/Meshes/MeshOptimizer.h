@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <Trinity/Renderer/Frontend/MeshVertex.h>
+
+namespace Trinity
+{
+    struct MeshData;
+
+    // Triangle and vertex reordering OptimizeMesh applies to every submesh
+    struct MeshOptimizeSettings
+    {
+        bool Enabled = true;
+
+        // Entries of the FIFO post-transform cache the metrics and the overdraw pass simulate
+        uint32_t CacheSize = 16;
+
+        // The overdraw pass may raise ACMR to this multiple of the cache-optimized order; below 1 it is skipped
+        float OverdrawThreshold = 1.05f;
+    };
+
+    struct VertexCacheStatistics
+    {
+        uint32_t VerticesTransformed = 0;
+        uint32_t Triangles = 0;
+        uint32_t Vertices = 0;
+
+        // Vertex shader invocations per triangle, and per vertex the triangles reference
+        float Acmr = 0.0f;
+        float Atvr = 0.0f;
+    };
+
+    struct OverdrawStatistics
+    {
+        uint64_t PixelsCovered = 0;
+        uint64_t PixelsShaded = 0;
+
+        // Fragments that passed the depth test per covered pixel
+        float Overdraw = 0.0f;
+    };
+
+    // Submesh-weighted figures of a mesh's full-detail ranges, as MeshImportDiagnostics reports them
+    struct MeshOptimizeMetrics
+    {
+        float Acmr = 0.0f;
+        float Atvr = 0.0f;
+        float Overdraw = 0.0f;
+    };
+
+    // Runs indices through a FIFO cache of cacheSize entries, the model most GPUs' post-transform reuse behaves close to
+    VertexCacheStatistics AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize);
+
+    // Rasterizes the triangles in order, with a depth test and back faces culled, from the six axis directions at a fixed resolution. A CPU estimate of
+    // how much early depth rejection the order leaves on the table, not a measurement of any particular GPU
+    OverdrawStatistics AnalyzeOverdraw(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices);
+
+    // Tom Forsyth's linear-speed vertex cache optimization: triangles are emitted greedily by a score that favours vertices recently used and vertices
+    // with few remaining triangles, so the order suits any cache size or replacement policy
+    void OptimizeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, std::vector<uint32_t>& outIndices);
+
+    // Splits a cache-optimized order into clusters at cache restarts and wherever a cluster's own ACMR is already within threshold, then draws clusters
+    // facing away from the mesh centre first, since they are the ones likely to occlude the rest. The result is kept only if its ACMR stays within
+    // threshold times that of the input; returns whether indices changed
+    bool OptimizeOverdraw(std::span<const MeshVertex> vertices, std::span<uint32_t> indices, uint32_t cacheSize, float threshold);
+
+    // Reorders the submesh vertex ranges by first use across their full-detail and level ranges and rewrites the indices to match, so vertex fetch walks
+    // memory forwards. Vertices no range references move to the end of their submesh
+    void OptimizeVertexFetch(MeshData& data);
+
+    // Cache and overdraw passes over every index range, full detail and levels alike, followed by the vertex fetch remap. Fills the source and optimized
+    // metrics of data.Diagnostics
+    void OptimizeMesh(MeshData& data, const MeshOptimizeSettings& settings);
+
+    // Submesh-weighted metrics over the full-detail ranges
+    MeshOptimizeMetrics MeasureMeshMetrics(const MeshData& data, uint32_t cacheSize);
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include <Trinity/Renderer/Frontend/MeshVertex.h>
+
+namespace Trinity
+{
+    // Box a quantized mesh's positions are stored in; the shaders rebuild a position as unorm * Scale + Offset
+    struct MeshQuantizationBox
+    {
+        glm::vec3 Scale{ 1.0f };
+        glm::vec3 Offset{ 0.0f };
+    };
+
+    // Worst round-trip error of the quantized layout: object-space distance for positions, radians for normals and tangents, and UV units
+    struct MeshQuantizationError
+    {
+        float Position = 0.0f;
+        float Normal = 0.0f;
+        float Tangent = 0.0f;
+        float UV = 0.0f;
+    };
+
+    // Largest errors a mesh may pick up and still be stored quantized: a millimetre for meshes authored in metres, a tenth of a degree, and a quarter texel
+    // of a 1024 texture, which half floats hold for UVs up to 2
+    struct MeshQuantizationTolerance
+    {
+        float Position = 0.001f;
+        float Angle = 0.00175f;
+        float UV = 1.0f / 4096.0f;
+
+        bool Accepts(const MeshQuantizationError& error) const
+        {
+            return error.Position <= Position && error.Normal <= Angle && error.Tangent <= Angle && error.UV <= UV;
+        }
+    };
+
+    // Smallest box around every vertex, referenced or not, so nothing is clamped
+    MeshQuantizationBox ComputeQuantizationBox(std::span<const MeshVertex> vertices);
+
+    QuantizedMeshPosition QuantizePosition(const MeshVertex& vertex, const MeshQuantizationBox& box);
+    QuantizedMeshVertexAttributes QuantizeAttributes(const MeshVertex& vertex);
+
+    // Encodes and decodes every vertex the way the TR_QUANTIZED shaders do and reports the largest difference
+    MeshQuantizationError MeasureQuantizationError(std::span<const MeshVertex> vertices);
+}
\ No newline at end of file
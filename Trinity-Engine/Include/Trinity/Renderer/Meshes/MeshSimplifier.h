@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <Trinity/Renderer/Frontend/MeshVertex.h>
+
+namespace Trinity
+{
+    struct MeshData;
+
+    // Detail levels GenerateMeshLods builds for every submesh
+    struct MeshLodSettings
+    {
+        // Index count of each level as a fraction of the full-detail submesh, finest first
+        std::vector<float> TargetRatios = { 0.5f, 0.25f, 0.125f };
+
+        // Largest error a level may reach, as a fraction of its submesh's bounding radius; simplification stops short of the ratio rather than exceed it
+        float MaxError = 0.05f;
+
+        // A level has to drop at least this fraction of its predecessor's triangles, or the chain ends there
+        float MinReduction = 0.1f;
+    };
+
+    // Quadric edge-collapse simplification of an indexed triangle list, down to targetIndexCount or until the next collapse would exceed maxError. Collapses
+    // only move a vertex onto a neighbour, so the result indexes the same vertices. Vertices on open borders and attribute seams stay put, which keeps UV and
+    // normal splits from tearing. Returns the error reached: an upper bound, in mesh units, on how far a moved vertex ended up from the planes of the
+    // triangles it started on
+    float SimplifyMesh(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices, uint32_t targetIndexCount, float maxError, std::vector<uint32_t>& outIndices);
+
+    // Appends a chain of coarser index ranges for every submesh to data.Indices and records them in Submesh::Lods. Each level is simplified from the full
+    // detail, so its error is measured against the original surface
+    void GenerateMeshLods(MeshData& data, const MeshLodSettings& settings);
+}
\ No newline at end of file
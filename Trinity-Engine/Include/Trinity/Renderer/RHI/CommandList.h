@@ -4,6 +4,7 @@
 
 #include <Trinity/Renderer/RHI/GraphicsTypes.h>
 #include <Trinity/Renderer/RHI/Handle.h>
+#include <Trinity/Renderer/RHI/FrameAllocator.h>
 
 namespace Trinity
 {
@@ -45,6 +46,8 @@ namespace Trinity
         bool Clear = true;
         
         float ClearDepth = 1.0f;
+
+        uint32_t ArrayLayer = 0;
     };
 
     struct RenderingInfo
@@ -57,6 +60,16 @@ namespace Trinity
         uint32_t Height = 0;
     };
 
+    struct TextureBarrier
+    {
+        TextureHandle Texture;
+        ResourceState From = ResourceState::Undefined;
+        ResourceState To = ResourceState::Undefined;
+
+        // The texture shares memory with others, so all earlier work must finish before its contents are discarded
+        bool Aliased = false;
+    };
+
     class CommandList
     {
     public:
@@ -72,17 +85,29 @@ namespace Trinity
         virtual void SetScissor(const Scissor& scissor) = 0;
 
         virtual void BindPipeline(PipelineHandle pipeline) = 0;
-        virtual void BindVertexBuffer(BufferHandle buffer, uint64_t offset = 0) = 0;
-        virtual void BindIndexBuffer(BufferHandle buffer, uint64_t offset = 0) = 0;
+        virtual void BindVertexBuffer(BufferHandle buffer, uint64_t offset = 0, uint32_t slot = 0) = 0;
+        virtual void BindIndexBuffer(BufferHandle buffer, uint64_t offset = 0, IndexType type = IndexType::UInt32) = 0;
 
         virtual void PushConstants(ShaderStage stages, uint32_t offset, uint32_t size, const void* data) = 0;
 
         virtual void BindTexture(uint32_t set, uint32_t binding, TextureHandle texture, SamplerHandle sampler) = 0;
         virtual void BindUniformBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size) = 0;
+        virtual void BindStorageBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size) = 0;
+        virtual void BindBindlessTextures(uint32_t set) = 0;
+
+        // For bindings declared Dynamic*: the cached set depends only on the heap and the allocation size, and the allocation's offset goes with the bind
+        virtual void BindDynamicUniformBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation) = 0;
+        virtual void BindDynamicStorageBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation) = 0;
 
         virtual void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstCount, uint32_t firstInstance) = 0;
         virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) = 0;
 
+        // Copies one array layer between textures of the same format and extent; source must be in CopySource and destination in CopyDestination
+        virtual void CopyTexture(TextureHandle source, TextureHandle destination, uint32_t arrayLayer = 0) = 0;
+
         virtual void TransitionTexture(TextureHandle texture, ResourceState from, ResourceState to) = 0;
+
+        // Records every transition in one pipeline barrier, so the driver can overlap them instead of serializing one barrier per texture
+        virtual void TransitionTextures(const TextureBarrier* barriers, uint32_t count) = 0;
     };
 }
\ No newline at end of file
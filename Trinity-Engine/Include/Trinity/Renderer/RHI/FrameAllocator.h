@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include <Trinity/Renderer/RHI/Handle.h>
+
+namespace Trinity
+{
+    // Scratch memory handed out for a single frame. Data is host-visible, write-only and only valid until the frame is submitted; the GPU reads it at Buffer + Offset
+    struct FrameAllocation
+    {
+        BufferHandle Buffer;
+        uint64_t Offset = 0;
+        uint64_t Size = 0;
+        void* Data = nullptr;
+
+        bool IsValid() const { return Data != nullptr; }
+    };
+
+    struct FrameAllocatorStats
+    {
+        uint64_t Capacity = 0;
+
+        // Bytes taken by the frame being recorded, alignment padding included, and the most any frame has needed
+        uint64_t FrameBytes = 0;
+        uint64_t PeakFrameBytes = 0;
+
+        // Bytes still held by earlier frames the GPU may be reading
+        uint64_t InFlightBytes = 0;
+
+        uint32_t Allocations = 0;
+        uint32_t Grows = 0;
+    };
+
+    // Ring bookkeeping for a persistently mapped per-frame heap. Allocating is a pointer bump; nothing is freed individually, instead each frame's span is returned
+    // as a whole once the frame retires. Backends own the buffer and decide when frames retire; this class never touches the GPU
+    class FrameAllocator
+    {
+    public:
+        // Starts over on a new heap. Spans on the previous one are forgotten, so that buffer must stay alive until the frames using it retire
+        void Reset(BufferHandle buffer, void* data, uint64_t capacity);
+
+        // Invalid when the ring cannot fit the request before older frames retire; the backend is expected to grow the heap and retry
+        FrameAllocation Allocate(uint64_t size, uint64_t alignment);
+
+        // Closes the span of the frame recorded so far and reclaims every span whose frame is at or before retiredFrame
+        void BeginFrame(uint64_t frame, uint64_t retiredFrame);
+
+        BufferHandle GetBuffer() const { return m_Buffer; }
+        uint64_t GetCapacity() const { return m_Capacity; }
+        const FrameAllocatorStats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Span
+        {
+            uint64_t Frame = 0;
+            uint64_t Bytes = 0;
+        };
+
+        BufferHandle m_Buffer;
+        uint8_t* m_Data = nullptr;
+        uint64_t m_Capacity = 0;
+        uint64_t m_Head = 0;
+        uint64_t m_Used = 0;
+
+        uint64_t m_Frame = 0;
+        uint64_t m_FrameBytes = 0;
+        std::deque<Span> m_Spans;
+
+        FrameAllocatorStats m_Stats;
+    };
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <string>
 
@@ -15,6 +16,9 @@ namespace Trinity
 
         std::string ApplicationName;
         bool EnableValidation = false;
+
+        // Where compiled pipelines persist between runs; empty keeps them in memory only
+        std::filesystem::path PipelineCachePath;
     };
 
     class GraphicsBackendFactory
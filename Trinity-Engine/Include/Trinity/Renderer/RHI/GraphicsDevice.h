@@ -12,11 +12,14 @@
 #include <Trinity/Renderer/RHI/Pipeline.h>
 #include <Trinity/Renderer/RHI/CommandList.h>
 #include <Trinity/Renderer/RHI/Swapchain.h>
+#include <Trinity/Renderer/RHI/FrameAllocator.h>
 
 namespace Trinity
 {
     class IImGuiRenderBackend;
 
+    inline constexpr uint32_t k_InvalidBindlessIndex = 0xFFFFFFFF;
+
     struct DeviceCapabilities
     {
         std::string DeviceName;
@@ -28,6 +31,44 @@ namespace Trinity
 
         bool SupportsAnisotropy = false;
         bool SupportsRayTracing = false;
+
+        // Descriptor indexing with update-after-bind; required for RegisterBindlessTexture and BindBindlessTextures
+        bool SupportsBindless = false;
+    };
+
+    // Cumulative descriptor reuse counters; Hits / (Hits + Misses) is the fraction of binds that skipped allocating and writing a set
+    struct DescriptorCacheStats
+    {
+        uint64_t Hits = 0;
+        uint64_t Misses = 0;
+        uint64_t Evictions = 0;
+        uint32_t LiveSets = 0;
+        uint32_t Pools = 0;
+    };
+
+    // Pipeline creation cost since the device started; with a warm on-disk cache the driver skips most shader compilation
+    struct PipelineCacheStats
+    {
+        uint32_t PipelinesCreated = 0;
+        double CreationMilliseconds = 0.0;
+        uint64_t LoadedBytes = 0;  // Cache data accepted from disk at startup; 0 on a cold start
+        uint64_t SavedBytes = 0;
+    };
+
+    struct MemoryRequirements
+    {
+        uint64_t Size = 0;
+        uint64_t Alignment = 1;
+        uint32_t TypeBits = 0;  // Memory types the resource can live in; heaps shared by several resources use the intersection
+    };
+
+    struct MemoryHeapDescription
+    {
+        uint64_t Size = 0;
+        uint64_t Alignment = 1;
+        uint32_t TypeBits = 0;
+
+        std::string DebugName;
     };
 
     class GraphicsDevice
@@ -44,6 +85,7 @@ namespace Trinity
         virtual BufferHandle CreateBuffer(const BufferDescription& description) = 0;
         virtual TextureHandle CreateTexture(const TextureDescription& description) = 0;
         virtual SamplerHandle CreateSampler(const SamplerDescription& description) = 0;
+        // Shaders and pipelines may be created from worker threads while the main thread records frames; every other call is main-thread only
         virtual ShaderHandle CreateShader(const ShaderDescription& description) = 0;
         virtual PipelineHandle CreatePipeline(const PipelineDescription& description) = 0;
 
@@ -55,6 +97,21 @@ namespace Trinity
 
         virtual void UpdateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset = 0) = 0;
 
+        // Scratch memory for data written once and read only by the frame being recorded: a pointer bump in a persistently mapped ring, aligned for the given usage and
+        // reclaimed once the frame retires. Uniform and storage allocations bind through the dynamic bindings; invalid only when the heap cannot grow
+        virtual FrameAllocation AllocateFrameMemory(uint64_t size, BufferUsage usage) = 0;
+
+        // Placed textures live at an offset inside a caller-owned memory heap instead of their own allocation, so textures whose lifetimes never overlap can alias
+        // the same memory. The heap must outlive every texture placed in it; both are released with the usual frame delay. Placed textures cannot take initial data
+        virtual MemoryRequirements GetTextureMemoryRequirements(const TextureDescription& description) = 0;
+        virtual MemoryHeapHandle CreateMemoryHeap(const MemoryHeapDescription& description) = 0;
+        virtual void DestroyMemoryHeap(MemoryHeapHandle handle) = 0;
+        virtual TextureHandle CreatePlacedTexture(const TextureDescription& description, MemoryHeapHandle heap, uint64_t offset) = 0;
+
+        // Places the texture in the global bindless table and returns its index; 2D and cube textures index separate arrays. Registering again returns the same index
+        // (the first sampler wins). The slot is released when the texture is destroyed. Returns k_InvalidBindlessIndex when unsupported or the table is full
+        virtual uint32_t RegisterBindlessTexture(TextureHandle texture, SamplerHandle sampler) = 0;
+
         virtual std::unique_ptr<Swapchain> CreateSwapchain(const SwapchainDescription& description) = 0;
         virtual std::unique_ptr<CommandList> CreateCommandList() = 0;
 
@@ -63,6 +120,10 @@ namespace Trinity
 
         virtual void CollectGarbage() = 0;
 
+        virtual DescriptorCacheStats GetDescriptorCacheStats() const = 0;
+        virtual PipelineCacheStats GetPipelineCacheStats() const = 0;
+        virtual FrameAllocatorStats GetFrameAllocatorStats() const = 0;
+
         virtual IImGuiRenderBackend& GetImGuiBackend() = 0;
     };
 }
\ No newline at end of file
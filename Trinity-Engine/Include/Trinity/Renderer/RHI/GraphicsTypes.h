@@ -9,7 +9,8 @@ namespace Trinity
         None = 0,
         Vulkan,
         Metal,
-        DirectX12
+        DirectX12,
+        Null  // Headless; records command streams without a GPU
     };
 
     enum class Format
@@ -26,6 +27,8 @@ namespace Trinity
         R16_SFLOAT,
         RG16_SFLOAT,
         RGBA16_SFLOAT,
+        RG16_SNORM,
+        RGBA16_UNORM,
 
         R32_SFLOAT,
         RG32_SFLOAT,
@@ -79,6 +82,12 @@ namespace Trinity
         PointList
     };
 
+    enum class IndexType
+    {
+        UInt32 = 0,
+        UInt16
+    };
+
     enum class CullMode
     {
         None = 0,
@@ -63,12 +63,18 @@ namespace Trinity
 
     };
 
+    struct MemoryHeapTag
+    {
+
+    };
+
     using BufferHandle = Handle<BufferTag>;
     using TextureHandle = Handle<TextureTag>;
     using SamplerHandle = Handle<SamplerTag>;
     using ShaderHandle = Handle<ShaderTag>;
     using PipelineHandle = Handle<PipelineTag>;
     using RenderTargetHandle = Handle<RenderTargetTag>;
+    using MemoryHeapHandle = Handle<MemoryHeapTag>;
 }
 
 namespace std
@@ -15,6 +15,9 @@ namespace Trinity
         uint32_t Offset = 0;
         
         Format Format = Format::RGB32_SFLOAT;
+
+        // Vertex buffer slot the attribute is read from; slot 0 uses Stride, higher slots index StreamStrides
+        uint32_t Binding = 0;
     };
 
     struct VertexLayout
@@ -22,6 +25,9 @@ namespace Trinity
         uint32_t Stride = 0;
 
         std::vector<VertexAttribute> Attributes;
+
+        // Strides of the extra vertex streams, slot 1 first; empty for a single interleaved buffer
+        std::vector<uint32_t> StreamStrides;
     };
 
     struct RasterizerState
@@ -43,6 +49,9 @@ namespace Trinity
     struct BlendState
     {
         bool Enabled = false;
+
+        // Adds the fragment to the target instead of alpha-blending over it
+        bool Additive = false;
     };
 
     enum class ResourceBindingType
@@ -50,7 +59,10 @@ namespace Trinity
         CombinedImageSampler,
         UniformBuffer,
         StorageBuffer,
-        StorageImage
+        DynamicUniformBuffer,  // Bound with a frame allocation; the offset is supplied at bind time, so one descriptor set serves every frame
+        DynamicStorageBuffer,
+        StorageImage,
+        BindlessTextures  // The device's global texture table; occupies the whole set, Binding is ignored
     };
 
     struct ResourceBinding
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Trinity/Renderer/RHI/Handle.h>
+
+namespace Trinity
+{
+    // Slot storage behind every backend's handles. A freed slot bumps its generation before reuse, so a stale handle resolves to nullptr instead of another resource
+    template<typename Payload, typename Tag>
+    class ResourcePool
+    {
+    public:
+        Handle<Tag> Allocate(const Payload& payload)
+        {
+            uint32_t l_Index;
+
+            if (!m_FreeList.empty())
+            {
+                l_Index = m_FreeList.back();
+                m_FreeList.pop_back();
+                m_Slots[l_Index].Data = payload;
+                m_Slots[l_Index].Alive = true;
+            }
+            else
+            {
+                l_Index = static_cast<uint32_t>(m_Slots.size());
+                m_Slots.push_back({ 1, true, payload });
+            }
+
+            return Handle<Tag>(l_Index, m_Slots[l_Index].Generation);
+        }
+
+        Payload* Get(Handle<Tag> handle)
+        {
+            if (!handle.IsValid())
+            {
+                return nullptr;
+            }
+
+            uint32_t l_Index = handle.GetIndex();
+            if (l_Index >= m_Slots.size())
+            {
+                return nullptr;
+            }
+
+            Slot& l_Slot = m_Slots[l_Index];
+            if (!l_Slot.Alive || l_Slot.Generation != handle.GetGeneration())
+            {
+                return nullptr;
+            }
+
+            return &l_Slot.Data;
+        }
+
+        bool Free(Handle<Tag> handle, Payload& outPayload)
+        {
+            Payload* l_Payload = Get(handle);
+            if (l_Payload == nullptr)
+            {
+                return false;
+            }
+
+            outPayload = *l_Payload;
+            uint32_t l_Index = handle.GetIndex();
+            m_Slots[l_Index].Alive = false;
+            ++m_Slots[l_Index].Generation;
+            m_FreeList.push_back(l_Index);
+
+            return true;
+        }
+
+        template<typename Fn>
+        void ForEachAlive(Fn&& function)
+        {
+            for (Slot& it_Slot : m_Slots)
+            {
+                if (it_Slot.Alive)
+                {
+                    function(it_Slot.Data);
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            uint32_t Generation = 1;
+            bool Alive = false;
+            Payload Data{};
+        };
+
+        std::vector<Slot> m_Slots;
+        std::vector<uint32_t> m_FreeList;
+    };
+}
\ No newline at end of file
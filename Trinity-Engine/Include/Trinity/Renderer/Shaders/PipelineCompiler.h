@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Trinity/Core/JobSystem.h>
+#include <Trinity/Renderer/RHI/GraphicsDevice.h>
+#include <Trinity/Renderer/RHI/Pipeline.h>
+#include <Trinity/Renderer/Shaders/ShaderCompiler.h>
+
+namespace Trinity
+{
+    struct PipelineShaderSource
+    {
+        std::string Module;
+        std::string EntryPoint;
+        std::vector<ShaderDefine> Defines;
+    };
+
+    struct PipelineCompileRequest
+    {
+        std::filesystem::path SearchDirectory;
+        PipelineShaderSource Vertex;
+        PipelineShaderSource Fragment;
+
+        // Everything but the shader handles, which the compiler fills in once the modules exist
+        PipelineDescription Description;
+    };
+
+    struct CompiledPipeline
+    {
+        PipelineHandle Pipeline;
+        ShaderHandle VertexShader;
+        ShaderHandle FragmentShader;
+    };
+
+    // Shared view of one compile. Poll IsReady from the main thread; once it is, the result belongs to whoever adopts it, and a result nobody adopts should be handed
+    // back through PipelineCompiler::Discard
+    class PipelineFuture
+    {
+    public:
+        PipelineFuture() = default;
+
+        bool IsValid() const { return m_State != nullptr; }
+        bool IsReady() const { return m_State != nullptr && m_State->Ready.load(std::memory_order_acquire); }
+
+        // Only meaningful once ready
+        bool Succeeded() const { return IsReady() && m_State->Success; }
+        const CompiledPipeline& GetResult() const { return m_State->Result; }
+        const std::string& GetError() const { return m_State->Error; }
+        float GetMilliseconds() const { return m_State->Milliseconds; }
+
+    private:
+        friend class PipelineCompiler;
+
+        struct State
+        {
+            PipelineCompileRequest Request;
+            JobHandle Job;
+
+            std::atomic<bool> Ready{ false };
+            bool Success = false;
+            CompiledPipeline Result;
+            std::string Error;
+            float Milliseconds = 0.0f;
+        };
+
+        std::shared_ptr<State> m_State;
+    };
+
+    // Compiles Slang shaders and builds their pipelines on the job system so the main thread never stalls on a shader. Without a running job system the work happens
+    // inside Compile, which keeps headless tools and early startup working unchanged
+    class PipelineCompiler
+    {
+    public:
+        PipelineCompiler(GraphicsDevice& device, ShaderCompiler& shaderCompiler, JobSystem* jobSystem);
+        ~PipelineCompiler();
+
+        PipelineCompiler(const PipelineCompiler&) = delete;
+        PipelineCompiler& operator=(const PipelineCompiler&) = delete;
+
+        PipelineFuture Compile(PipelineCompileRequest request);
+
+        // Blocks, helping the job system meanwhile; for the few places that cannot proceed without the pipeline
+        void Wait(const PipelineFuture& future);
+
+        // Gives up on a future: whatever it produces is destroyed by Collect once it lands. The future is reset
+        void Discard(PipelineFuture& future);
+
+        // Once per frame on the main thread: destroys the results of discarded compiles that have finished
+        void Collect();
+
+        // Waits for every compile in flight and destroys the discarded ones; call before the device goes away
+        void Shutdown();
+
+        uint32_t GetPendingCount() const;
+
+    private:
+        static void Run(GraphicsDevice& device, ShaderCompiler& shaderCompiler, PipelineFuture::State& state);
+        void Destroy(CompiledPipeline& result);
+
+    private:
+        GraphicsDevice& m_Device;
+        ShaderCompiler& m_ShaderCompiler;
+        JobSystem* m_JobSystem = nullptr;
+
+        // Main thread only
+        std::vector<std::shared_ptr<PipelineFuture::State>> m_InFlight;
+        std::vector<std::shared_ptr<PipelineFuture::State>> m_Discarded;
+    };
+}
\ No newline at end of file
@@ -64,6 +64,13 @@ namespace Trinity
         std::string Message;
     };
 
+    // Preprocessor macro applied to the whole module; variants of one source compile and cache separately
+    struct ShaderDefine
+    {
+        std::string Name;
+        std::string Value = "1";
+    };
+
     struct ShaderCompileResult
     {
         bool Success = false;
@@ -87,7 +94,9 @@ namespace Trinity
 
         void SetCacheDirectory(const std::filesystem::path& directory);
 
-        ShaderCompileResult Compile(const std::filesystem::path& searchDirectory, const std::string& moduleName, const std::string& entryPoint, ShaderTargetFormat target = ShaderTargetFormat::SPIRV);
+        // Safe to call from several threads at once; SetCacheDirectory is not, and must happen before any compile starts
+        ShaderCompileResult Compile(const std::filesystem::path& searchDirectory, const std::string& moduleName, const std::string& entryPoint, ShaderTargetFormat target = ShaderTargetFormat::SPIRV,
+            const std::vector<ShaderDefine>& defines = {});
 
     private:
         struct Implementation;
@@ -31,6 +31,9 @@ namespace Trinity
         TextureHandle Error() const { return m_Error; }
         SamplerHandle DefaultSampler() const { return m_DefaultSampler; }
 
+        // Slot of the texture in the device's bindless table, sampled with the default sampler. Falls back to White's slot when the texture cannot be registered
+        uint32_t GetBindlessIndex(TextureHandle texture);
+
     private:
         TextureHandle CreateFromPixels(const void* pixels, uint64_t size, uint32_t width, uint32_t height, Format format, bool generateMips, const std::string& debugName);
 
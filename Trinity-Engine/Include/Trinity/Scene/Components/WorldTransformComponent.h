@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Trinity
+{
+    // Engine-owned cache of the entity's world matrix. Added alongside every TransformComponent and refreshed by Scene::UpdateWorldTransforms; never authored or serialized
+    struct WorldTransformComponent
+    {
+        glm::mat4 World{ 1.0f };
+
+        // Local TRS the cached matrix was built from. Most writers edit TransformComponent in place, which EnTT cannot observe, so the update compares against this snapshot
+        glm::vec3 Translation{ 0.0f };
+        glm::quat Rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+        glm::vec3 Scale{ 1.0f };
+
+        // Set by the registry signals on transform/hierarchy changes and by Scene::SetParent; forces a rebuild of this entity and its subtree
+        bool Dirty = true;
+
+        // Consecutive UpdateWorldTransforms calls that left World unchanged, saturating; lets per-frame systems tell settled objects from moving ones
+        uint32_t StableUpdates = 0;
+    };
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
@@ -14,8 +17,8 @@ namespace Trinity
     class Scene
     {
     public:
-        Scene() = default;
-        ~Scene() = default;
+        Scene();
+        ~Scene();
 
         Scene(const Scene&) = delete;
         Scene& operator=(const Scene&) = delete;
@@ -26,16 +29,37 @@ namespace Trinity
         void Clear();
 
         void SetParent(Entity child, Entity parent);
+
+        // Walks the hierarchy and rebuilds the matrix from the live TransformComponents. Only for tools that edit transforms mid-frame and need the result immediately
         glm::mat4 GetWorldMatrix(entt::entity entity);
 
+        // Refreshes every WorldTransformComponent parent-before-child, recomputing only entities whose local transform, parent, or ancestors changed since the last call
+        void UpdateWorldTransforms();
+
+        // World matrix as of the last UpdateWorldTransforms; what per-frame systems (renderer, audio, physics sync) should read
+        const glm::mat4& GetCachedWorldMatrix(entt::entity entity) const;
+
         Entity GetPrimaryCameraEntity();
 
         entt::registry& GetRegistry() { return m_Registry; }
         const entt::registry& GetRegistry() const { return m_Registry; }
 
+        // Identifies this scene's contents to systems that keep per-scene state. Never reused within the process, even by a scene at the same address, and renewed
+        // by Clear, since the entities behind any cached handles are gone
+        uint64_t GetInstanceId() const { return m_InstanceId; }
+
+    private:
+        void OnTransformConstructed(entt::registry& registry, entt::entity entity);
+        void OnTransformChanged(entt::registry& registry, entt::entity entity);
+        void OnTransformDestroyed(entt::registry& registry, entt::entity entity);
+
     private:
         friend class Entity;
 
         entt::registry m_Registry;
+        uint64_t m_InstanceId = 0;
+
+        // Scratch stack reused by UpdateWorldTransforms; the flag records whether the parent was rebuilt this pass
+        std::vector<std::pair<entt::entity, bool>> m_TransformStack;
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <Trinity/Assets/AssetDatabase.h>
 
+#include <algorithm>
+#include <cstring>
 #include <optional>
 #include <system_error>
 #include <utility>
@@ -61,7 +63,11 @@ namespace Trinity
 
         ScanDirectory();
 
-
+        // Compiled blocks survive a refresh; only the ones built from a modified source are rebuilt
+        for (UUID it_Modified : m_Modified)
+        {
+            InvalidateMaterial(it_Modified);
+        }
     }
 
     void AssetDatabase::ScanDirectory()
@@ -350,4 +356,183 @@ namespace Trinity
 
         return l_Clip;
     }
+
+    static void AssignBindlessIndices(TextureManager& textureManager, ResolvedMaterial& block)
+    {
+        for (uint32_t l_Slot = 0; l_Slot < ResolvedMaterial::TextureCount; ++l_Slot)
+        {
+            block.Factors.TextureIndices[l_Slot] = textureManager.GetBindlessIndex(block.Textures[l_Slot]);
+        }
+    }
+
+    void AssetDatabase::BuildResolvedMaterial(UUID id, ResolvedMaterial& block, std::vector<UUID>& dependencies)
+    {
+        dependencies.clear();
+        block.Factors = MaterialFactorBlock{};
+        block.Textures[static_cast<uint32_t>(MaterialTextureSlot::BaseColor)] = m_TextureManager.White();
+        block.Textures[static_cast<uint32_t>(MaterialTextureSlot::Normal)] = m_TextureManager.Normal();
+        block.Textures[static_cast<uint32_t>(MaterialTextureSlot::MetallicRoughness)] = m_TextureManager.White();
+        block.Textures[static_cast<uint32_t>(MaterialTextureSlot::Emissive)] = m_TextureManager.White();
+
+        if (static_cast<uint64_t>(id) == 0)
+        {
+            AssignBindlessIndices(m_TextureManager, block);
+
+            return;
+        }
+
+        // Walk the instance chain so an edit to any parent invalidates the flattened result
+        UUID l_Current = id;
+        for (uint32_t l_Depth = 0; l_Depth < 16; ++l_Depth)
+        {
+            dependencies.push_back(l_Current);
+
+            const AssetMetadata* l_Metadata = GetMetadata(l_Current);
+            if (l_Metadata == nullptr || l_Metadata->Type != AssetType::MaterialInstance)
+            {
+                break;
+            }
+
+            std::shared_ptr<MaterialInstance> l_Instance = ResolveMaterialInstance(l_Current);
+            if (l_Instance == nullptr || static_cast<uint64_t>(l_Instance->GetParent()) == 0)
+            {
+                break;
+            }
+
+            l_Current = l_Instance->GetParent();
+        }
+
+        std::shared_ptr<Material> l_Material = ResolveMaterial(id);
+        if (l_Material == nullptr)
+        {
+            AssignBindlessIndices(m_TextureManager, block);
+
+            return;
+        }
+
+        if (const MaterialParameter* l_Factor = l_Material->FindParameter(Material::BaseColorFactor))
+        {
+            block.Factors.BaseColorFactor = l_Factor->AsVec4();
+        }
+
+        if (const MaterialParameter* l_Metallic = l_Material->FindParameter(Material::MetallicFactor))
+        {
+            block.Factors.PbrFactors.x = l_Metallic->AsFloat();
+        }
+
+        if (const MaterialParameter* l_Roughness = l_Material->FindParameter(Material::RoughnessFactor))
+        {
+            block.Factors.PbrFactors.y = l_Roughness->AsFloat();
+        }
+
+        if (const MaterialParameter* l_Occlusion = l_Material->FindParameter(Material::OcclusionStrength))
+        {
+            block.Factors.PbrFactors.z = l_Occlusion->AsFloat();
+        }
+
+        if (const MaterialParameter* l_NormalScale = l_Material->FindParameter(Material::NormalScale))
+        {
+            block.Factors.PbrFactors.w = l_NormalScale->AsFloat();
+        }
+
+        if (const MaterialParameter* l_Emissive = l_Material->FindParameter(Material::EmissiveFactor))
+        {
+            block.Factors.EmissiveFactor = glm::vec4(l_Emissive->AsVec3(), block.Factors.EmissiveFactor.a);
+        }
+
+        if (const MaterialParameter* l_EmissiveStrength = l_Material->FindParameter(Material::EmissiveStrength))
+        {
+            block.Factors.EmissiveFactor.a = l_EmissiveStrength->AsFloat();
+        }
+
+        const std::pair<const char*, MaterialTextureSlot> l_TextureParameters[] =
+        {
+            { Material::BaseColorTexture, MaterialTextureSlot::BaseColor },
+            { Material::NormalTexture, MaterialTextureSlot::Normal },
+            { Material::MetallicRoughnessTexture, MaterialTextureSlot::MetallicRoughness },
+            { Material::EmissiveTexture, MaterialTextureSlot::Emissive }
+        };
+
+        for (const std::pair<const char*, MaterialTextureSlot>& it_Parameter : l_TextureParameters)
+        {
+            const MaterialParameter* l_Texture = l_Material->FindParameter(it_Parameter.first);
+            if (l_Texture == nullptr || static_cast<uint64_t>(l_Texture->AsTexture()) == 0)
+            {
+                continue;
+            }
+
+            block.Textures[static_cast<uint32_t>(it_Parameter.second)] = ResolveTexture(l_Texture->AsTexture());
+            dependencies.push_back(l_Texture->AsTexture());
+        }
+
+        AssignBindlessIndices(m_TextureManager, block);
+    }
+
+    uint32_t AssetDatabase::CompileMaterial(UUID id)
+    {
+        auto it_Found = m_CompiledMaterialLookup.find(id);
+        if (it_Found != m_CompiledMaterialLookup.end())
+        {
+            CompiledMaterial& l_Compiled = m_CompiledMaterials[it_Found->second];
+            if (l_Compiled.Dirty)
+            {
+                BuildResolvedMaterial(id, l_Compiled.Block, l_Compiled.Dependencies);
+                l_Compiled.Dirty = false;
+            }
+
+            return it_Found->second;
+        }
+
+        uint32_t l_Index = static_cast<uint32_t>(m_CompiledMaterials.size());
+
+        CompiledMaterial& l_Compiled = m_CompiledMaterials.emplace_back();
+        l_Compiled.Block.ID = l_Index;
+        l_Compiled.Block.Source = id;
+        BuildResolvedMaterial(id, l_Compiled.Block, l_Compiled.Dependencies);
+        m_CompiledMaterialLookup.emplace(id, l_Index);
+
+        return l_Index;
+    }
+
+    uint32_t AssetDatabase::CompileFallbackMaterial(const glm::vec4& baseColorFactor)
+    {
+        FallbackColorKey l_Key;
+        std::memcpy(l_Key.data(), &baseColorFactor, sizeof(l_Key));
+
+        auto it_Found = m_FallbackMaterialLookup.find(l_Key);
+        if (it_Found != m_FallbackMaterialLookup.end())
+        {
+            return it_Found->second;
+        }
+
+        uint32_t l_Index = static_cast<uint32_t>(m_CompiledMaterials.size());
+
+        CompiledMaterial& l_Compiled = m_CompiledMaterials.emplace_back();
+        l_Compiled.Block.ID = l_Index;
+        BuildResolvedMaterial(UUID(0), l_Compiled.Block, l_Compiled.Dependencies);
+        l_Compiled.Block.Factors.BaseColorFactor = baseColorFactor;
+        m_FallbackMaterialLookup.emplace(l_Key, l_Index);
+
+        return l_Index;
+    }
+
+    void AssetDatabase::InvalidateMaterial(UUID id)
+    {
+        for (CompiledMaterial& it_Compiled : m_CompiledMaterials)
+        {
+            if (std::find(it_Compiled.Dependencies.begin(), it_Compiled.Dependencies.end(), id) == it_Compiled.Dependencies.end())
+            {
+                continue;
+            }
+
+            it_Compiled.Dirty = true;
+
+            // Flattened instances are copies of their parent, so an in-place edit of the parent has to drop them too
+            const AssetMetadata* l_Metadata = GetMetadata(it_Compiled.Block.Source);
+            if (l_Metadata != nullptr && l_Metadata->Type == AssetType::MaterialInstance && static_cast<uint64_t>(it_Compiled.Block.Source) != static_cast<uint64_t>(id))
+            {
+                m_MaterialCache.erase(it_Compiled.Block.Source);
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -186,7 +186,7 @@ namespace Trinity
                 continue;
             }
 
-            glm::mat4 l_World = scene.GetWorldMatrix(l_Entity);
+            const glm::mat4& l_World = scene.GetCachedWorldMatrix(l_Entity);
             glm::vec3 l_Position = glm::vec3(l_World[3]);
             glm::vec3 l_Forward = -glm::normalize(glm::vec3(l_World[2]));
             glm::vec3 l_Up = glm::normalize(glm::vec3(l_World[1]));
@@ -216,7 +216,7 @@ namespace Trinity
 
             if (l_Source.Spatial)
             {
-                SetVoicePosition(l_Source.Runtime, glm::vec3(scene.GetWorldMatrix(l_Entity)[3]));
+                SetVoicePosition(l_Source.Runtime, glm::vec3(scene.GetCachedWorldMatrix(l_Entity)[3]));
             }
         }
 
@@ -3,6 +3,7 @@
 #include <Trinity/Core/Log.h>
 #include <Trinity/Core/Assert.h>
 #include <Trinity/Core/FileManagement.h>
+#include <Trinity/Core/JobSystem.h>
 #include <Trinity/Platform/IPlatform.h>
 #include <Trinity/Platform/FileSystem.h>
 #include <Trinity/Platform/PlatformFactory.h>
@@ -35,6 +36,9 @@ namespace Trinity
     {
         TR_CORE_INFO("INITIALIZING ENGINE");
 
+        m_JobSystem = std::make_unique<JobSystem>();
+        m_JobSystem->Initialize();
+
         m_Platform = PlatformFactory::Create();
         if (m_Platform == nullptr)
         {
@@ -89,6 +93,7 @@ namespace Trinity
         GraphicsDeviceDescription l_DeviceDescription;
         l_DeviceDescription.Window = window;
         l_DeviceDescription.ApplicationName = applicationName;
+        l_DeviceDescription.PipelineCachePath = m_Platform->GetFileSystem().Resolve(BaseDirectory::UserCache, "PipelineCache.bin");
 
 #if defined(TRINITY_DEBUG)
         l_DeviceDescription.EnableValidation = true;
@@ -119,7 +124,7 @@ namespace Trinity
             return false;
         }
 
-        m_Renderer = std::make_unique<Renderer>(*m_Device, *m_Swapchain, m_Platform->GetFileSystem());
+        m_Renderer = std::make_unique<Renderer>(*m_Device, *m_Swapchain, m_Platform->GetFileSystem(), m_JobSystem.get());
         if (!m_Renderer->Initialize())
         {
             TR_CORE_CRITICAL("Failed to create renderer");
@@ -130,6 +135,10 @@ namespace Trinity
             return false;
         }
 
+        // Startup pipeline cost; compare a cold run against a warm one to see what the on-disk cache saves
+        PipelineCacheStats l_Pipelines = m_Device->GetPipelineCacheStats();
+        TR_CORE_INFO("Pipelines: {} created in {:.2f} ms ({} KB loaded from the pipeline cache)", l_Pipelines.PipelinesCreated, l_Pipelines.CreationMilliseconds, l_Pipelines.LoadedBytes / 1024);
+
         m_AssetDatabase = std::make_unique<AssetDatabase>(m_Platform->GetFileSystem(), m_Renderer->GetMeshLibrary(), m_Renderer->GetTextureManager(), *m_AudioEngine);
         m_AssetDatabase->Initialize();
 
@@ -206,16 +215,22 @@ namespace Trinity
             m_Renderer->ApplyViewportResize();
         }
 
-        if (m_AudioEngine != nullptr && m_Scene != nullptr && m_AssetDatabase != nullptr)
-        {
-            m_AudioEngine->Update(*m_Scene, *m_AssetDatabase);
-        }
-
         if (m_PhysicsSystem != nullptr && m_Scene != nullptr && m_ScenePlaying)
         {
             // While paused the scene sits on the last completed tick instead of blending toward one that never arrives.
             m_PhysicsSystem->ApplyInterpolation(*m_Scene, m_ScenePaused ? 1.0f : m_SimulationClock.GetAlpha());
         }
+
+        // Transforms are final for the frame once interpolation has written them; audio and the renderer read the cache from here on
+        if (m_Scene != nullptr)
+        {
+            m_Scene->UpdateWorldTransforms();
+        }
+
+        if (m_AudioEngine != nullptr && m_Scene != nullptr && m_AssetDatabase != nullptr)
+        {
+            m_AudioEngine->Update(*m_Scene, *m_AssetDatabase);
+        }
     }
 
     void Engine::FixedUpdate(Timestep timestep)
@@ -263,6 +278,8 @@ namespace Trinity
     {
         if (m_Renderer != nullptr && m_Scene != nullptr && m_EditorCamera != nullptr && m_AssetDatabase != nullptr)
         {
+            // Editor panels run between Update and here; only the entities they touched are recomputed
+            m_Scene->UpdateWorldTransforms();
             m_Renderer->RenderFrame(*m_Scene, *m_AssetDatabase, m_EditorCamera->GetCamera(), &m_ImGuiLayer);
         }
 
@@ -389,6 +406,11 @@ namespace Trinity
 
         if (m_Scene != nullptr && m_AssetDatabase != nullptr && !m_SceneSnapshot.empty())
         {
+            if (m_Renderer != nullptr)
+            {
+                m_Renderer->ReleaseScene(*m_Scene);
+            }
+
             m_Scene->Clear();
             if (!SceneSerializer::DeserializeFromString(*m_Scene, *m_AssetDatabase, m_SceneSnapshot))
             {
@@ -424,6 +446,11 @@ namespace Trinity
             m_PhysicsSystem.reset();
         }
 
+        if (m_Renderer != nullptr && m_Scene != nullptr)
+        {
+            m_Renderer->ReleaseScene(*m_Scene);
+        }
+
         m_Scene.reset();
         m_EditorCamera.reset();
         m_AssetDatabase.reset();
@@ -445,6 +472,12 @@ namespace Trinity
             m_Device.reset();
         }
 
+        if (m_JobSystem != nullptr)
+        {
+            m_JobSystem->Shutdown();
+            m_JobSystem.reset();
+        }
+
         m_Initialized = false;
 
         TR_CORE_INFO("ENGINE SHUTDOWN COMPLETE");
@@ -0,0 +1,477 @@
+#include <Trinity/Core/JobSystem.h>
+
+#include <algorithm>
+
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    struct JobNode
+    {
+        std::function<void()> Work;
+
+        // Unfinished prerequisites plus one guard reference held by the scheduling call; the job is queued when this reaches zero
+        std::atomic<uint32_t> Dependencies{ 1 };
+        std::atomic<bool> Completed{ false };
+
+        // Guards Continuations against a prerequisite completing while a dependent registers itself
+        std::mutex Mutex;
+        std::vector<std::shared_ptr<JobNode>> Continuations;
+    };
+
+    // Shared cursor and helper nodes of one ParallelFor call. The helpers are only ever handed to Enqueue and waited on by that call, so once they complete
+    // nothing else refers to them and the next call can rearm them
+    struct JobSystem::ParallelForBatch
+    {
+        std::atomic<uint32_t> NextChunk{ 0 };
+        ParallelForBody Body = nullptr;
+        const void* Context = nullptr;
+        uint32_t Count = 0;
+        uint32_t Grain = 0;
+        uint32_t ChunkCount = 0;
+        std::vector<std::shared_ptr<JobNode>> Helpers;
+
+        // Chunks are claimed from the shared cursor rather than pre-assigned, so a helper that starts late or a slow chunk does not stall the others
+        void Drain()
+        {
+            for (;;)
+            {
+                uint32_t l_Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (l_Chunk >= ChunkCount)
+                {
+                    return;
+                }
+
+                uint32_t l_Begin = l_Chunk * Grain;
+                Body(Context, l_Begin, std::min(l_Begin + Grain, Count));
+            }
+        }
+    };
+
+    namespace
+    {
+        thread_local const JobSystem* s_CurrentSystem = nullptr;
+        thread_local uint32_t s_CurrentQueue = 0;
+    }
+
+    bool JobHandle::IsComplete() const
+    {
+        return m_Node == nullptr || m_Node->Completed.load(std::memory_order_acquire);
+    }
+
+    JobSystem::JobSystem() = default;
+
+    JobSystem::~JobSystem()
+    {
+        Shutdown();
+    }
+
+    bool JobSystem::Initialize(uint32_t workerCount)
+    {
+        if (m_Running.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+
+        uint32_t l_WorkerCount = workerCount;
+        if (l_WorkerCount == 0)
+        {
+            uint32_t l_Hardware = std::thread::hardware_concurrency();
+            l_WorkerCount = l_Hardware > 1 ? l_Hardware - 1 : 0;
+        }
+
+        m_Queues.clear();
+        m_Queues.reserve(l_WorkerCount + 1);
+        for (uint32_t l_Index = 0; l_Index < l_WorkerCount + 1; ++l_Index)
+        {
+            m_Queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        m_Running.store(true, std::memory_order_release);
+
+        m_Workers.reserve(l_WorkerCount);
+        for (uint32_t l_Index = 0; l_Index < l_WorkerCount; ++l_Index)
+        {
+            m_Workers.emplace_back([this, l_Index]()
+                {
+                    WorkerLoop(l_Index + 1);
+                });
+        }
+
+        TR_CORE_INFO("Job system started with {} worker threads", l_WorkerCount);
+
+        return true;
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!m_Running.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> l_Lock(m_WakeMutex);
+            m_Running.store(false, std::memory_order_release);
+        }
+        m_WakeCondition.notify_all();
+
+        for (std::thread& it_Worker : m_Workers)
+        {
+            if (it_Worker.joinable())
+            {
+                it_Worker.join();
+            }
+        }
+        m_Workers.clear();
+
+        // Anything still queued runs here so no handle is left pending forever
+        while (TryRunOne(0))
+        {
+
+        }
+
+        m_Queues.clear();
+        m_QueuedJobs.store(0, std::memory_order_release);
+    }
+
+    JobHandle JobSystem::Schedule(std::function<void()> work)
+    {
+        std::shared_ptr<JobNode> l_Node = std::make_shared<JobNode>();
+        l_Node->Work = std::move(work);
+
+        ReleaseDependency(l_Node);
+
+        return JobHandle(std::move(l_Node));
+    }
+
+    JobHandle JobSystem::Schedule(std::function<void()> work, std::span<const JobHandle> dependencies)
+    {
+        std::shared_ptr<JobNode> l_Node = std::make_shared<JobNode>();
+        l_Node->Work = std::move(work);
+        l_Node->Dependencies.store(static_cast<uint32_t>(dependencies.size()) + 1, std::memory_order_relaxed);
+
+        for (const JobHandle& it_Dependency : dependencies)
+        {
+            if (!it_Dependency.IsValid())
+            {
+                l_Node->Dependencies.fetch_sub(1, std::memory_order_acq_rel);
+
+                continue;
+            }
+
+            JobNode& l_Parent = *it_Dependency.m_Node;
+            std::lock_guard<std::mutex> l_Lock(l_Parent.Mutex);
+            if (l_Parent.Completed.load(std::memory_order_acquire))
+            {
+                l_Node->Dependencies.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            else
+            {
+                l_Parent.Continuations.push_back(l_Node);
+            }
+        }
+
+        // Drop the guard last so a prerequisite finishing mid-loop cannot queue the job before every dependency is registered
+        ReleaseDependency(l_Node);
+
+        return JobHandle(std::move(l_Node));
+    }
+
+    JobHandle JobSystem::Then(const JobHandle& parent, std::function<void()> work)
+    {
+        return Schedule(std::move(work), std::span<const JobHandle>(&parent, 1));
+    }
+
+    void JobSystem::Wait(const JobHandle& handle)
+    {
+        uint32_t l_QueueIndex = CurrentQueueIndex();
+
+        while (!handle.IsComplete())
+        {
+            if (!TryRunOne(l_QueueIndex))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::Wait(std::span<const JobHandle> handles)
+    {
+        for (const JobHandle& it_Handle : handles)
+        {
+            Wait(it_Handle);
+        }
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, ParallelForBody body, const void* context)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const uint32_t l_Grain = std::max(grainSize, 1u);
+        const uint32_t l_ChunkCount = (count - 1) / l_Grain + 1;
+
+        if (l_ChunkCount == 1 || m_Workers.empty())
+        {
+            body(context, 0, count);
+
+            return;
+        }
+
+        std::unique_ptr<ParallelForBatch> l_Batch;
+        {
+            std::lock_guard<std::mutex> l_Lock(m_BatchMutex);
+            if (!m_FreeBatches.empty())
+            {
+                l_Batch = std::move(m_FreeBatches.back());
+                m_FreeBatches.pop_back();
+            }
+        }
+
+        if (l_Batch == nullptr)
+        {
+            l_Batch = std::make_unique<ParallelForBatch>();
+        }
+
+        l_Batch->NextChunk.store(0, std::memory_order_relaxed);
+        l_Batch->Body = body;
+        l_Batch->Context = context;
+        l_Batch->Count = count;
+        l_Batch->Grain = l_Grain;
+        l_Batch->ChunkCount = l_ChunkCount;
+
+        const uint32_t l_HelperCount = std::min(GetWorkerCount(), l_ChunkCount - 1);
+        while (l_Batch->Helpers.size() < l_HelperCount)
+        {
+            l_Batch->Helpers.push_back(std::make_shared<JobNode>());
+        }
+
+        ParallelForBatch* l_Drain = l_Batch.get();
+        for (uint32_t l_Index = 0; l_Index < l_HelperCount; ++l_Index)
+        {
+            const std::shared_ptr<JobNode>& l_Helper = l_Batch->Helpers[l_Index];
+            {
+                // The worker that ran the helper last time may still be leaving Execute's critical section
+                std::lock_guard<std::mutex> l_Lock(l_Helper->Mutex);
+                l_Helper->Completed.store(false, std::memory_order_relaxed);
+            }
+
+            // A single pointer capture fits std::function's inline buffer, so rearming the node does not allocate
+            l_Helper->Dependencies.store(0, std::memory_order_relaxed);
+            l_Helper->Work = [l_Drain]()
+                {
+                    l_Drain->Drain();
+                };
+
+            Enqueue(l_Helper);
+        }
+
+        l_Batch->Drain();
+        for (uint32_t l_Index = 0; l_Index < l_HelperCount; ++l_Index)
+        {
+            Wait(JobHandle(l_Batch->Helpers[l_Index]));
+        }
+
+        std::lock_guard<std::mutex> l_Lock(m_BatchMutex);
+        m_FreeBatches.push_back(std::move(l_Batch));
+    }
+
+    JobSystemStats JobSystem::GetStats() const
+    {
+        JobSystemStats l_Stats;
+        l_Stats.Executed = m_Executed.load(std::memory_order_relaxed);
+        l_Stats.Stolen = m_Stolen.load(std::memory_order_relaxed);
+
+        return l_Stats;
+    }
+
+    void JobSystem::ResetStats()
+    {
+        m_Executed.store(0, std::memory_order_relaxed);
+        m_Stolen.store(0, std::memory_order_relaxed);
+    }
+
+    void JobSystem::WorkerLoop(uint32_t queueIndex)
+    {
+        s_CurrentSystem = this;
+        s_CurrentQueue = queueIndex;
+
+        while (m_Running.load(std::memory_order_acquire))
+        {
+            if (TryRunOne(queueIndex))
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> l_Lock(m_WakeMutex);
+            m_WakeCondition.wait(l_Lock, [this]()
+                {
+                    return !m_Running.load(std::memory_order_acquire) || m_QueuedJobs.load(std::memory_order_acquire) > 0;
+                });
+        }
+
+        s_CurrentSystem = nullptr;
+        s_CurrentQueue = 0;
+    }
+
+    void JobSystem::Enqueue(std::shared_ptr<JobNode> node)
+    {
+        // Not initialized (headless tools, early startup): behave as a serial executor
+        if (m_Queues.empty())
+        {
+            Execute(node);
+
+            return;
+        }
+
+        // Counted under the queue lock before the push, so whoever pops the job cannot decrement ahead of the increment and wrap the counter
+        WorkQueue& l_Queue = *m_Queues[CurrentQueueIndex()];
+        {
+            std::lock_guard<std::mutex> l_Lock(l_Queue.Mutex);
+            m_QueuedJobs.fetch_add(1, std::memory_order_acq_rel);
+            l_Queue.PushBack(std::move(node));
+        }
+
+        // Taking the wake mutex before notifying closes the window between a worker's empty check and its wait
+        {
+            std::lock_guard<std::mutex> l_Lock(m_WakeMutex);
+        }
+        m_WakeCondition.notify_one();
+    }
+
+    bool JobSystem::TryRunOne(uint32_t queueIndex)
+    {
+        if (queueIndex >= m_Queues.size())
+        {
+            return false;
+        }
+
+        std::shared_ptr<JobNode> l_Node = Pop(queueIndex);
+        if (l_Node == nullptr)
+        {
+            l_Node = Steal(queueIndex);
+            if (l_Node == nullptr)
+            {
+                return false;
+            }
+
+            m_Stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        Execute(l_Node);
+
+        return true;
+    }
+
+    std::shared_ptr<JobNode> JobSystem::Pop(uint32_t queueIndex)
+    {
+        // Owner works LIFO for cache warmth; thieves take the oldest (usually largest) work from the front
+        WorkQueue& l_Queue = *m_Queues[queueIndex];
+        std::lock_guard<std::mutex> l_Lock(l_Queue.Mutex);
+
+        return l_Queue.PopBack();
+    }
+
+    std::shared_ptr<JobNode> JobSystem::Steal(uint32_t thiefIndex)
+    {
+        const uint32_t l_QueueCount = static_cast<uint32_t>(m_Queues.size());
+        for (uint32_t l_Offset = 1; l_Offset < l_QueueCount; ++l_Offset)
+        {
+            WorkQueue& l_Victim = *m_Queues[(thiefIndex + l_Offset) % l_QueueCount];
+            std::lock_guard<std::mutex> l_Lock(l_Victim.Mutex);
+            if (l_Victim.Count == 0)
+            {
+                continue;
+            }
+
+            return l_Victim.PopFront();
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::WorkQueue::PushBack(std::shared_ptr<JobNode> node)
+    {
+        if (Count == Slots.size())
+        {
+            // Unwraps into a buffer twice the size, oldest job first
+            std::vector<std::shared_ptr<JobNode>> l_Grown(std::max<size_t>(Slots.size() * 2, 64));
+            for (size_t l_Index = 0; l_Index < Count; ++l_Index)
+            {
+                l_Grown[l_Index] = std::move(Slots[(Head + l_Index) % Slots.size()]);
+            }
+
+            Slots.swap(l_Grown);
+            Head = 0;
+        }
+
+        Slots[(Head + Count) % Slots.size()] = std::move(node);
+        ++Count;
+    }
+
+    std::shared_ptr<JobNode> JobSystem::WorkQueue::PopBack()
+    {
+        if (Count == 0)
+        {
+            return nullptr;
+        }
+
+        --Count;
+
+        return std::move(Slots[(Head + Count) % Slots.size()]);
+    }
+
+    std::shared_ptr<JobNode> JobSystem::WorkQueue::PopFront()
+    {
+        if (Count == 0)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<JobNode> l_Node = std::move(Slots[Head]);
+        Head = (Head + 1) % Slots.size();
+        --Count;
+
+        return l_Node;
+    }
+
+    void JobSystem::Execute(const std::shared_ptr<JobNode>& node)
+    {
+        if (node->Work)
+        {
+            node->Work();
+            node->Work = nullptr;
+        }
+
+        m_Executed.fetch_add(1, std::memory_order_relaxed);
+
+        std::vector<std::shared_ptr<JobNode>> l_Continuations;
+        {
+            std::lock_guard<std::mutex> l_Lock(node->Mutex);
+            node->Completed.store(true, std::memory_order_release);
+            l_Continuations.swap(node->Continuations);
+        }
+
+        for (const std::shared_ptr<JobNode>& it_Continuation : l_Continuations)
+        {
+            ReleaseDependency(it_Continuation);
+        }
+    }
+
+    void JobSystem::ReleaseDependency(const std::shared_ptr<JobNode>& node)
+    {
+        if (node->Dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Enqueue(node);
+        }
+    }
+
+    uint32_t JobSystem::CurrentQueueIndex() const
+    {
+        return s_CurrentSystem == this ? s_CurrentQueue : 0;
+    }
+}
\ No newline at end of file
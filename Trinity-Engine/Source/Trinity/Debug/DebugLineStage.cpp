@@ -17,7 +17,7 @@ namespace Trinity
         glm::mat4 ViewProjection;
     };
 
-    bool DebugLineStage::Initialize(GraphicsDevice& device, ShaderCompiler& compiler, const std::filesystem::path& shaderDirectory, Format colorFormat, Format depthFormat, uint32_t framesInFlight)
+    bool DebugLineStage::Initialize(GraphicsDevice& device, ShaderCompiler& compiler, const std::filesystem::path& shaderDirectory, Format colorFormat, Format depthFormat)
     {
         m_Device = &device;
 
@@ -78,27 +78,6 @@ namespace Trinity
             return false;
         }
 
-        m_VertexBuffers.reserve(framesInFlight);
-        m_VertexCounts.assign(framesInFlight, 0);
-        for (uint32_t l_Index = 0; l_Index < framesInFlight; ++l_Index)
-        {
-            BufferDescription l_BufferDescription;
-            l_BufferDescription.Size = static_cast<uint64_t>(MaxLines) * 2u * sizeof(LineVertex);
-            l_BufferDescription.Usage = BufferUsage::Vertex;
-            l_BufferDescription.Memory = MemoryUsage::CpuToGpu;
-            l_BufferDescription.DebugName = "DebugLineVertices";
-
-            BufferHandle l_Buffer = device.CreateBuffer(l_BufferDescription);
-            if (!l_Buffer.IsValid())
-            {
-                Shutdown();
-
-                return false;
-            }
-
-            m_VertexBuffers.push_back(l_Buffer);
-        }
-
         return true;
     }
 
@@ -109,15 +88,8 @@ namespace Trinity
             return;
         }
 
-        for (BufferHandle& it_Buffer : m_VertexBuffers)
-        {
-            if (it_Buffer.IsValid())
-            {
-                m_Device->DestroyBuffer(it_Buffer);
-            }
-        }
-        m_VertexBuffers.clear();
-        m_VertexCounts.clear();
+        m_Vertices = FrameAllocation{};
+        m_VertexCount = 0;
 
         if (m_Pipeline.IsValid())
         {
@@ -138,9 +110,12 @@ namespace Trinity
         }
     }
 
-    void DebugLineStage::Upload(uint32_t frameIndex, const std::vector<DebugLine>& lines)
+    void DebugLineStage::Upload(const std::vector<DebugLine>& lines)
     {
-        if (m_Device == nullptr || frameIndex >= m_VertexBuffers.size())
+        m_Vertices = FrameAllocation{};
+        m_VertexCount = 0;
+
+        if (m_Device == nullptr)
         {
             return;
         }
@@ -161,27 +136,32 @@ namespace Trinity
             m_OverflowWarned = false;
         }
 
-        m_VertexCounts[frameIndex] = l_LineCount * 2;
         if (l_LineCount == 0)
         {
             return;
         }
 
-        m_ScratchVertices.clear();
-        m_ScratchVertices.reserve(static_cast<size_t>(l_LineCount) * 2);
+        // Vertices are written straight into the mapped heap; no staging copy on the CPU side either
+        m_Vertices = m_Device->AllocateFrameMemory(static_cast<uint64_t>(l_LineCount) * 2u * sizeof(LineVertex), BufferUsage::Vertex);
+        if (!m_Vertices.IsValid())
+        {
+            return;
+        }
+
+        LineVertex* l_Vertices = static_cast<LineVertex*>(m_Vertices.Data);
         for (uint32_t l_Index = 0; l_Index < l_LineCount; ++l_Index)
         {
             const DebugLine& l_Line = lines[l_Index];
-            m_ScratchVertices.push_back(LineVertex{ l_Line.Start, l_Line.Color });
-            m_ScratchVertices.push_back(LineVertex{ l_Line.End, l_Line.Color });
+            l_Vertices[l_Index * 2] = LineVertex{ l_Line.Start, l_Line.Color };
+            l_Vertices[l_Index * 2 + 1] = LineVertex{ l_Line.End, l_Line.Color };
         }
 
-        m_Device->UpdateBuffer(m_VertexBuffers[frameIndex], m_ScratchVertices.data(), m_ScratchVertices.size() * sizeof(LineVertex), 0);
+        m_VertexCount = l_LineCount * 2;
     }
 
-    void DebugLineStage::Record(CommandList& commandList, uint32_t frameIndex, const glm::mat4& viewProjection)
+    void DebugLineStage::Record(CommandList& commandList, const glm::mat4& viewProjection)
     {
-        if (!m_Pipeline.IsValid() || frameIndex >= m_VertexBuffers.size() || m_VertexCounts[frameIndex] == 0)
+        if (!m_Pipeline.IsValid() || m_VertexCount == 0)
         {
             return;
         }
@@ -190,8 +170,8 @@ namespace Trinity
         l_Push.ViewProjection = viewProjection;
 
         commandList.BindPipeline(m_Pipeline);
-        commandList.BindVertexBuffer(m_VertexBuffers[frameIndex]);
+        commandList.BindVertexBuffer(m_Vertices.Buffer, m_Vertices.Offset);
         commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, 0, static_cast<uint32_t>(sizeof(DebugLinePush)), &l_Push);
-        commandList.Draw(m_VertexCounts[frameIndex], 1, 0, 0);
+        commandList.Draw(m_VertexCount, 1, 0, 0);
     }
 }
\ No newline at end of file
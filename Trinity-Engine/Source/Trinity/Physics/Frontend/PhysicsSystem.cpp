@@ -401,6 +401,9 @@ namespace Trinity
     {
         entt::registry& l_Registry = scene.GetRegistry();
 
+        // Picks up the previous sub-step's write-back and any edits since the last frame; unchanged entities cost a compare
+        scene.UpdateWorldTransforms();
+
         for (auto& it_Body : m_Bodies2D)
         {
             if (!l_Registry.valid(it_Body.first))
@@ -410,7 +413,7 @@ namespace Trinity
 
             Body2DRecord& l_Record = it_Body.second;
 
-            glm::mat4 l_World = scene.GetWorldMatrix(it_Body.first);
+            const glm::mat4& l_World = scene.GetCachedWorldMatrix(it_Body.first);
             glm::vec2 l_Position = ExtractWorldPosition2D(l_World);
             float l_Rotation = ExtractWorldRotation2D(l_World);
 
@@ -484,6 +487,7 @@ namespace Trinity
             return;
         }
 
+        // Exact walk rather than the cache: a parent body written earlier in the same sync loop has not been propagated yet
         glm::mat4 l_World = scene.GetWorldMatrix(entity);
         glm::vec3 l_WorldScale(glm::max(glm::length(glm::vec3(l_World[0])), 1.0e-6f), glm::max(glm::length(glm::vec3(l_World[1])), 1.0e-6f), glm::max(glm::length(glm::vec3(l_World[2])), 1.0e-6f));
 
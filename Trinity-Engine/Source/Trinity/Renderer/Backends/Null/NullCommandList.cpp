@@ -0,0 +1,319 @@
+#include <Trinity/Renderer/Backends/Null/NullCommandList.h>
+
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    NullCommandStats& NullCommandStats::operator+=(const NullCommandStats& other)
+    {
+        RenderPasses += other.RenderPasses;
+        PipelineBinds += other.PipelineBinds;
+        ResourceBinds += other.ResourceBinds;
+        PushConstants += other.PushConstants;
+        Draws += other.Draws;
+        Instances += other.Instances;
+        Vertices += other.Vertices;
+        Copies += other.Copies;
+        Barriers += other.Barriers;
+        BarrierBatches += other.BarrierBatches;
+        InvalidHandles += other.InvalidHandles;
+
+        return *this;
+    }
+
+    NullCommandList::NullCommandList(NullDevice& device) : m_Device(device)
+    {
+
+    }
+
+    void NullCommandList::Begin()
+    {
+        m_Commands.clear();
+        m_Stats = NullCommandStats{};
+        m_InsideRendering = false;
+    }
+
+    void NullCommandList::End()
+    {
+        if (m_InsideRendering)
+        {
+            TR_CORE_WARN("NullCommandList: ended inside a render pass");
+            m_InsideRendering = false;
+        }
+    }
+
+    void NullCommandList::Record(const NullCommand& command)
+    {
+        if (m_Recording)
+        {
+            m_Commands.push_back(command);
+        }
+    }
+
+    void NullCommandList::BeginRendering(const RenderingInfo& renderingInfo)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::BeginRendering;
+        l_Command.Count = renderingInfo.ColorAttachmentCount;
+
+        for (uint32_t l_Index = 0; l_Index < renderingInfo.ColorAttachmentCount; ++l_Index)
+        {
+            if (!m_Device.IsAlive(renderingInfo.ColorAttachments[l_Index].Target))
+            {
+                ++m_Stats.InvalidHandles;
+            }
+        }
+
+        if (renderingInfo.Depth != nullptr && !m_Device.IsAlive(renderingInfo.Depth->Target))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        if (renderingInfo.ColorAttachmentCount > 0)
+        {
+            l_Command.Resource = renderingInfo.ColorAttachments[0].Target.Pack();
+        }
+        else if (renderingInfo.Depth != nullptr)
+        {
+            l_Command.Resource = renderingInfo.Depth->Target.Pack();
+        }
+
+        ++m_Stats.RenderPasses;
+        m_InsideRendering = true;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::EndRendering()
+    {
+        m_InsideRendering = false;
+
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::EndRendering;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::SetViewport(const Viewport&)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::SetViewport;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::SetScissor(const Scissor&)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::SetScissor;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::BindPipeline(PipelineHandle pipeline)
+    {
+        if (!m_Device.IsAlive(pipeline))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::BindPipeline;
+        l_Command.Resource = pipeline.Pack();
+
+        ++m_Stats.PipelineBinds;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::BindVertexBuffer(BufferHandle buffer, uint64_t offset, uint32_t slot)
+    {
+        BindBuffer(NullCommandType::BindVertexBuffer, 0, slot, buffer, offset, 0);
+    }
+
+    void NullCommandList::BindIndexBuffer(BufferHandle buffer, uint64_t offset, IndexType type)
+    {
+        if (!m_Device.IsAlive(buffer))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::BindIndexBuffer;
+        l_Command.Resource = buffer.Pack();
+        l_Command.Offset = offset;
+        l_Command.Count = type == IndexType::UInt16 ? 2 : 4;
+
+        ++m_Stats.ResourceBinds;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::PushConstants(ShaderStage, uint32_t offset, uint32_t size, const void*)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::PushConstants;
+        l_Command.Offset = offset;
+        l_Command.Size = size;
+
+        ++m_Stats.PushConstants;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::BindTexture(uint32_t set, uint32_t binding, TextureHandle texture, SamplerHandle sampler)
+    {
+        if (!m_Device.IsAlive(texture) || !m_Device.IsAlive(sampler))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::BindTexture;
+        l_Command.Resource = texture.Pack();
+        l_Command.Sampler = sampler.Pack();
+        l_Command.Set = set;
+        l_Command.Binding = binding;
+
+        ++m_Stats.ResourceBinds;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::BindUniformBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size)
+    {
+        BindBuffer(NullCommandType::BindUniformBuffer, set, binding, buffer, offset, size);
+    }
+
+    void NullCommandList::BindStorageBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size)
+    {
+        BindBuffer(NullCommandType::BindStorageBuffer, set, binding, buffer, offset, size);
+    }
+
+    void NullCommandList::BindDynamicUniformBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation)
+    {
+        BindBuffer(NullCommandType::BindDynamicUniformBuffer, set, binding, allocation.Buffer, allocation.Offset, allocation.Size);
+    }
+
+    void NullCommandList::BindDynamicStorageBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation)
+    {
+        BindBuffer(NullCommandType::BindDynamicStorageBuffer, set, binding, allocation.Buffer, allocation.Offset, allocation.Size);
+    }
+
+    void NullCommandList::BindBindlessTextures(uint32_t set)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::BindBindlessTextures;
+        l_Command.Set = set;
+
+        ++m_Stats.ResourceBinds;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::BindBuffer(NullCommandType type, uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size)
+    {
+        if (!m_Device.IsAlive(buffer))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        NullCommand l_Command;
+        l_Command.Type = type;
+        l_Command.Resource = buffer.Pack();
+        l_Command.Offset = offset;
+        l_Command.Size = size;
+        l_Command.Set = set;
+        l_Command.Binding = binding;
+
+        ++m_Stats.ResourceBinds;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t, uint32_t)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::Draw;
+        l_Command.Count = vertexCount;
+        l_Command.Instances = instanceCount;
+
+        ++m_Stats.Draws;
+        m_Stats.Instances += instanceCount;
+        m_Stats.Vertices += static_cast<uint64_t>(vertexCount) * instanceCount;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t, int32_t, uint32_t)
+    {
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::DrawIndexed;
+        l_Command.Count = indexCount;
+        l_Command.Instances = instanceCount;
+
+        ++m_Stats.Draws;
+        m_Stats.Instances += instanceCount;
+        m_Stats.Vertices += static_cast<uint64_t>(indexCount) * instanceCount;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::CopyTexture(TextureHandle source, TextureHandle destination, uint32_t arrayLayer)
+    {
+        if (!m_Device.IsAlive(source) || !m_Device.IsAlive(destination))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::CopyTexture;
+        l_Command.Resource = destination.Pack();
+        l_Command.Sampler = source.Pack();
+        l_Command.Count = arrayLayer;
+
+        ++m_Stats.Copies;
+
+        Record(l_Command);
+    }
+
+    void NullCommandList::TransitionTexture(TextureHandle texture, ResourceState from, ResourceState to)
+    {
+        Barrier(texture, from, to);
+        ++m_Stats.BarrierBatches;
+    }
+
+    void NullCommandList::TransitionTextures(const TextureBarrier* barriers, uint32_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        for (uint32_t l_Index = 0; l_Index < count; ++l_Index)
+        {
+            Barrier(barriers[l_Index].Texture, barriers[l_Index].From, barriers[l_Index].To);
+        }
+
+        ++m_Stats.BarrierBatches;
+    }
+
+    void NullCommandList::Barrier(TextureHandle texture, ResourceState from, ResourceState to)
+    {
+        if (!m_Device.IsAlive(texture))
+        {
+            ++m_Stats.InvalidHandles;
+        }
+
+        NullCommand l_Command;
+        l_Command.Type = NullCommandType::Barrier;
+        l_Command.Resource = texture.Pack();
+        l_Command.Offset = static_cast<uint64_t>(from);
+        l_Command.Size = static_cast<uint64_t>(to);
+
+        ++m_Stats.Barriers;
+
+        Record(l_Command);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,553 @@
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <Trinity/Renderer/Backends/Null/NullSwapchain.h>
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    // Same table sizes as the Vulkan backend, so registration fails at the same point
+    static constexpr uint32_t k_BindlessTexture2DCount = 4096;
+    static constexpr uint32_t k_BindlessTextureCubeCount = 64;
+
+    static constexpr uint64_t k_FrameHeapInitialSize = 4ull << 20;
+
+    // Alignments a typical desktop GPU reports; frame allocations and placed textures are laid out as they would be there
+    static constexpr uint64_t k_UniformOffsetAlignment = 256;
+    static constexpr uint64_t k_StorageOffsetAlignment = 64;
+    static constexpr uint64_t k_TextureAlignment = 4096;
+    static constexpr uint64_t k_RenderTargetAlignment = 65536;
+
+    static uint64_t GetFormatSize(Format format)
+    {
+        switch (format)
+        {
+            case Format::R8_UNORM: return 1;
+            case Format::RG8_UNORM: return 2;
+            case Format::R16_SFLOAT: return 2;
+            case Format::R16_UINT: return 2;
+            case Format::RG16_SFLOAT: return 4;
+            case Format::RG16_SNORM: return 4;
+            case Format::RGBA8_UNORM: return 4;
+            case Format::RGBA8_SRGB: return 4;
+            case Format::BGRA8_UNORM: return 4;
+            case Format::BGRA8_SRGB: return 4;
+            case Format::R32_SFLOAT: return 4;
+            case Format::R32_UINT: return 4;
+            case Format::D32_SFLOAT: return 4;
+            case Format::D24_UNORM_S8_UINT: return 4;
+            case Format::RGBA16_SFLOAT: return 8;
+            case Format::RGBA16_UNORM: return 8;
+            case Format::RG32_SFLOAT: return 8;
+            case Format::D32_SFLOAT_S8_UINT: return 8;
+            case Format::RGB32_SFLOAT: return 12;
+            case Format::RGBA32_SFLOAT: return 16;
+            default: return 0;
+        }
+    }
+
+    NullDevice::~NullDevice()
+    {
+        Shutdown();
+    }
+
+    bool NullDevice::Initialize()
+    {
+        if (m_Initialized)
+        {
+            return true;
+        }
+
+        m_Capabilities.DeviceName = "Null Device";
+        m_Capabilities.DedicatedVideoMemory = 0;
+        m_Capabilities.MaxTexture2DSize = 16384;
+        m_Capabilities.MaxPushConstantSize = 256;
+        m_Capabilities.MaxColorAttachments = 8;
+        m_Capabilities.SupportsAnisotropy = true;
+        m_Capabilities.SupportsRayTracing = false;
+        m_Capabilities.SupportsBindless = true;
+
+        if (!GrowFrameHeap(k_FrameHeapInitialSize))
+        {
+            return false;
+        }
+
+        m_Initialized = true;
+
+        TR_CORE_INFO("Null graphics device initialized");
+
+        return true;
+    }
+
+    void NullDevice::Shutdown()
+    {
+        if (!m_Initialized)
+        {
+            return;
+        }
+
+        for (BufferHandle it_Heap : m_RetiredFrameHeaps)
+        {
+            DestroyBuffer(it_Heap);
+        }
+        m_RetiredFrameHeaps.clear();
+
+        if (m_FrameHeap.GetBuffer().IsValid())
+        {
+            DestroyBuffer(m_FrameHeap.GetBuffer());
+            m_FrameHeap.Reset(BufferHandle{}, nullptr, 0);
+        }
+
+        m_DeferredStorage.clear();
+
+        ReportLeaks();
+
+        m_Initialized = false;
+    }
+
+    void NullDevice::ReportLeaks()
+    {
+        uint32_t l_Total = 0;
+
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+            m_Pipelines.ForEachAlive([&](NullPipelineResource& resource)
+            {
+                ++l_Total;
+                TR_CORE_WARN("Leaked pipeline: {}", resource.DebugName.empty() ? "<unnamed>" : resource.DebugName);
+            });
+
+            m_Shaders.ForEachAlive([&](NullShaderResource& resource)
+            {
+                ++l_Total;
+                TR_CORE_WARN("Leaked shader: {}", resource.DebugName.empty() ? "<unnamed>" : resource.DebugName);
+            });
+        }
+
+        m_Samplers.ForEachAlive([&](NullSamplerResource& resource)
+        {
+            ++l_Total;
+            TR_CORE_WARN("Leaked sampler: {}", resource.DebugName.empty() ? "<unnamed>" : resource.DebugName);
+        });
+
+        m_Textures.ForEachAlive([&](NullTextureResource& resource)
+        {
+            ++l_Total;
+            TR_CORE_WARN("Leaked texture: {}", resource.DebugName.empty() ? "<unnamed>" : resource.DebugName);
+        });
+
+        m_Buffers.ForEachAlive([&](NullBufferResource& resource)
+        {
+            ++l_Total;
+            TR_CORE_WARN("Leaked buffer: {}", resource.DebugName.empty() ? "<unnamed>" : resource.DebugName);
+        });
+
+        m_MemoryHeaps.ForEachAlive([&](NullMemoryHeapResource& resource)
+        {
+            ++l_Total;
+            TR_CORE_WARN("Leaked memory heap: {}", resource.DebugName.empty() ? "<unnamed>" : resource.DebugName);
+        });
+
+        if (l_Total == 0)
+        {
+            TR_CORE_TRACE("No leaked resources");
+        }
+        else
+        {
+            TR_CORE_WARN("{} resources leaked on the null device", l_Total);
+        }
+    }
+
+    BufferHandle NullDevice::CreateBuffer(const BufferDescription& description)
+    {
+        if (description.Size == 0)
+        {
+            TR_CORE_ERROR("Cannot create a buffer of size 0");
+
+            return {};
+        }
+
+        NullBufferResource l_Resource;
+        l_Resource.Size = description.Size;
+        l_Resource.Usage = description.Usage;
+        l_Resource.Memory = description.Memory;
+        l_Resource.DebugName = description.DebugName;
+
+        if (description.Memory != MemoryUsage::GpuOnly)
+        {
+            l_Resource.Storage = std::make_shared<std::vector<uint8_t>>(description.Size);
+        }
+
+        if (description.InitialData != nullptr)
+        {
+            if (l_Resource.Storage)
+            {
+                std::memcpy(l_Resource.Storage->data(), description.InitialData, description.Size);
+            }
+
+            m_Stats.UploadedBytes += description.Size;
+        }
+
+        return m_Buffers.Allocate(l_Resource);
+    }
+
+    TextureHandle NullDevice::CreateTexture(const TextureDescription& description)
+    {
+        TextureHandle l_Handle = CreateTextureResource(description, false);
+        if (l_Handle.IsValid() && description.InitialData != nullptr)
+        {
+            m_Stats.UploadedBytes += description.InitialDataSize;
+        }
+
+        return l_Handle;
+    }
+
+    TextureHandle NullDevice::CreateTextureResource(const TextureDescription& description, bool placed)
+    {
+        if (description.Width == 0 || description.Height == 0 || GetFormatSize(description.Format) == 0)
+        {
+            TR_CORE_ERROR("Invalid texture description for '{}'", description.DebugName);
+
+            return {};
+        }
+
+        NullTextureResource l_Resource;
+        l_Resource.Type = description.Type;
+        l_Resource.Format = description.Format;
+        l_Resource.Width = description.Width;
+        l_Resource.Height = description.Height;
+        l_Resource.Placed = placed;
+        l_Resource.DebugName = description.DebugName;
+
+        return m_Textures.Allocate(l_Resource);
+    }
+
+    SamplerHandle NullDevice::CreateSampler(const SamplerDescription& description)
+    {
+        NullSamplerResource l_Resource;
+        l_Resource.DebugName = description.DebugName;
+
+        return m_Samplers.Allocate(l_Resource);
+    }
+
+    ShaderHandle NullDevice::CreateShader(const ShaderDescription& description)
+    {
+        if (description.Bytecode.empty())
+        {
+            TR_CORE_ERROR("Cannot create shader '{}' without bytecode", description.DebugName);
+
+            return {};
+        }
+
+        NullShaderResource l_Resource;
+        l_Resource.Stage = description.Stage;
+        l_Resource.DebugName = description.DebugName;
+
+        std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+        return m_Shaders.Allocate(l_Resource);
+    }
+
+    PipelineHandle NullDevice::CreatePipeline(const PipelineDescription& description)
+    {
+        std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+        // Pipelines reference their shaders only while being created, as on the GPU backends
+        if (m_Shaders.Get(description.VertexShader) == nullptr || m_Shaders.Get(description.FragmentShader) == nullptr)
+        {
+            TR_CORE_ERROR("Pipeline '{}' references a missing shader", description.DebugName);
+
+            return {};
+        }
+
+        NullPipelineResource l_Resource;
+        l_Resource.PushConstantSize = description.PushConstantSize;
+        l_Resource.DebugName = description.DebugName;
+
+        ++m_PipelineStats.PipelinesCreated;
+
+        return m_Pipelines.Allocate(l_Resource);
+    }
+
+    void NullDevice::DestroyBuffer(BufferHandle handle)
+    {
+        NullBufferResource l_Resource;
+        if (m_Buffers.Free(handle, l_Resource) && l_Resource.Storage)
+        {
+            m_DeferredStorage.push_back({ m_FrameCounter, std::move(l_Resource.Storage) });
+        }
+    }
+
+    void NullDevice::DestroyTexture(TextureHandle handle)
+    {
+        NullTextureResource l_Resource;
+        if (!m_Textures.Free(handle, l_Resource) || l_Resource.BindlessIndex == k_InvalidBindlessIndex)
+        {
+            return;
+        }
+
+        if (l_Resource.Type == TextureType::TextureCube)
+        {
+            m_FreeBindlessCube.push_back(l_Resource.BindlessIndex);
+        }
+        else
+        {
+            m_FreeBindless2D.push_back(l_Resource.BindlessIndex);
+        }
+    }
+
+    void NullDevice::DestroySampler(SamplerHandle handle)
+    {
+        NullSamplerResource l_Resource;
+        m_Samplers.Free(handle, l_Resource);
+    }
+
+    void NullDevice::DestroyShader(ShaderHandle handle)
+    {
+        std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+        NullShaderResource l_Resource;
+        m_Shaders.Free(handle, l_Resource);
+    }
+
+    void NullDevice::DestroyPipeline(PipelineHandle handle)
+    {
+        std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
+        NullPipelineResource l_Resource;
+        m_Pipelines.Free(handle, l_Resource);
+    }
+
+    void NullDevice::UpdateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset)
+    {
+        NullBufferResource* l_Resource = m_Buffers.Get(handle);
+        if (l_Resource == nullptr || data == nullptr || offset + size > l_Resource->Size)
+        {
+            TR_CORE_ERROR("Invalid buffer update");
+
+            return;
+        }
+
+        if (l_Resource->Storage)
+        {
+            std::memcpy(l_Resource->Storage->data() + offset, data, size);
+        }
+
+        m_Stats.UploadedBytes += size;
+    }
+
+    FrameAllocation NullDevice::AllocateFrameMemory(uint64_t size, BufferUsage usage)
+    {
+        uint64_t l_Alignment = 16;
+        if (HasUsage(usage, BufferUsage::Uniform))
+        {
+            l_Alignment = std::max(l_Alignment, k_UniformOffsetAlignment);
+        }
+
+        if (HasUsage(usage, BufferUsage::Storage))
+        {
+            l_Alignment = std::max(l_Alignment, k_StorageOffsetAlignment);
+        }
+
+        FrameAllocation l_Allocation = m_FrameHeap.Allocate(size, l_Alignment);
+        if (!l_Allocation.IsValid() && size != 0 && GrowFrameHeap(size + l_Alignment))
+        {
+            l_Allocation = m_FrameHeap.Allocate(size, l_Alignment);
+        }
+
+        return l_Allocation;
+    }
+
+    bool NullDevice::GrowFrameHeap(uint64_t minimumSize)
+    {
+        uint64_t l_Capacity = std::max(m_FrameHeap.GetCapacity() * 2, k_FrameHeapInitialSize);
+        while (l_Capacity < minimumSize)
+        {
+            l_Capacity *= 2;
+        }
+
+        BufferDescription l_Description;
+        l_Description.Size = l_Capacity;
+        l_Description.Usage = BufferUsage::Uniform | BufferUsage::Storage | BufferUsage::Vertex | BufferUsage::Index;
+        l_Description.Memory = MemoryUsage::CpuToGpu;
+        l_Description.DebugName = "FrameHeap";
+
+        BufferHandle l_Buffer = CreateBuffer(l_Description);
+        NullBufferResource* l_Resource = m_Buffers.Get(l_Buffer);
+        if (l_Resource == nullptr)
+        {
+            return false;
+        }
+
+        if (m_FrameHeap.GetBuffer().IsValid())
+        {
+            m_RetiredFrameHeaps.push_back(m_FrameHeap.GetBuffer());
+        }
+
+        m_FrameHeap.Reset(l_Buffer, l_Resource->Storage->data(), l_Capacity);
+
+        return true;
+    }
+
+    MemoryRequirements NullDevice::GetTextureMemoryRequirements(const TextureDescription& description)
+    {
+        MemoryRequirements l_Requirements;
+
+        const uint64_t l_FormatSize = GetFormatSize(description.Format);
+        if (l_FormatSize == 0 || description.Width == 0 || description.Height == 0)
+        {
+            return l_Requirements;
+        }
+
+        const uint32_t l_Layers = description.Type == TextureType::TextureCube ? std::max(description.ArrayLayers, 6u) : std::max(description.ArrayLayers, 1u);
+        const uint32_t l_Mips = std::max(description.MipLevels, 1u);
+
+        uint64_t l_Size = 0;
+        for (uint32_t l_Mip = 0; l_Mip < l_Mips; ++l_Mip)
+        {
+            const uint64_t l_Width = std::max(description.Width >> l_Mip, 1u);
+            const uint64_t l_Height = std::max(description.Height >> l_Mip, 1u);
+            const uint64_t l_Depth = std::max(description.Depth >> l_Mip, 1u);
+            l_Size += l_Width * l_Height * l_Depth * l_FormatSize;
+        }
+
+        l_Size *= static_cast<uint64_t>(l_Layers) * std::max(description.SampleCount, 1u);
+
+        const bool l_Attachment = HasUsage(description.Usage, TextureUsage::RenderTarget) || HasUsage(description.Usage, TextureUsage::DepthStencil);
+        l_Requirements.Alignment = l_Attachment ? k_RenderTargetAlignment : k_TextureAlignment;
+        l_Requirements.Size = (l_Size + l_Requirements.Alignment - 1) / l_Requirements.Alignment * l_Requirements.Alignment;
+        l_Requirements.TypeBits = 0x1;
+
+        return l_Requirements;
+    }
+
+    MemoryHeapHandle NullDevice::CreateMemoryHeap(const MemoryHeapDescription& description)
+    {
+        if (description.Size == 0)
+        {
+            return {};
+        }
+
+        NullMemoryHeapResource l_Resource;
+        l_Resource.Size = description.Size;
+        l_Resource.DebugName = description.DebugName;
+
+        return m_MemoryHeaps.Allocate(l_Resource);
+    }
+
+    void NullDevice::DestroyMemoryHeap(MemoryHeapHandle handle)
+    {
+        NullMemoryHeapResource l_Resource;
+        m_MemoryHeaps.Free(handle, l_Resource);
+    }
+
+    TextureHandle NullDevice::CreatePlacedTexture(const TextureDescription& description, MemoryHeapHandle heap, uint64_t offset)
+    {
+        NullMemoryHeapResource* l_Heap = m_MemoryHeaps.Get(heap);
+        if (l_Heap == nullptr)
+        {
+            TR_CORE_ERROR("Placed texture '{}' references a missing memory heap", description.DebugName);
+
+            return {};
+        }
+
+        const MemoryRequirements l_Requirements = GetTextureMemoryRequirements(description);
+        if (description.InitialData != nullptr || offset % l_Requirements.Alignment != 0 || offset + l_Requirements.Size > l_Heap->Size)
+        {
+            TR_CORE_ERROR("Placed texture '{}' does not fit its heap at offset {}", description.DebugName, offset);
+
+            return {};
+        }
+
+        return CreateTextureResource(description, true);
+    }
+
+    uint32_t NullDevice::RegisterBindlessTexture(TextureHandle texture, SamplerHandle sampler)
+    {
+        NullTextureResource* l_Texture = m_Textures.Get(texture);
+        if (l_Texture == nullptr || m_Samplers.Get(sampler) == nullptr)
+        {
+            return k_InvalidBindlessIndex;
+        }
+
+        if (l_Texture->BindlessIndex != k_InvalidBindlessIndex)
+        {
+            return l_Texture->BindlessIndex;
+        }
+
+        const bool l_Cube = l_Texture->Type == TextureType::TextureCube;
+        std::vector<uint32_t>& l_FreeSlots = l_Cube ? m_FreeBindlessCube : m_FreeBindless2D;
+        uint32_t& l_Next = l_Cube ? m_NextBindlessCube : m_NextBindless2D;
+
+        uint32_t l_Index;
+        if (!l_FreeSlots.empty())
+        {
+            l_Index = l_FreeSlots.back();
+            l_FreeSlots.pop_back();
+        }
+        else if (l_Next < (l_Cube ? k_BindlessTextureCubeCount : k_BindlessTexture2DCount))
+        {
+            l_Index = l_Next++;
+        }
+        else
+        {
+            return k_InvalidBindlessIndex;
+        }
+
+        l_Texture->BindlessIndex = l_Index;
+
+        return l_Index;
+    }
+
+    std::unique_ptr<Swapchain> NullDevice::CreateSwapchain(const SwapchainDescription& description)
+    {
+        auto l_Swapchain = std::make_unique<NullSwapchain>(*this, description);
+        if (!l_Swapchain->Initialize())
+        {
+            return nullptr;
+        }
+
+        return l_Swapchain;
+    }
+
+    std::unique_ptr<CommandList> NullDevice::CreateCommandList()
+    {
+        return std::make_unique<NullCommandList>(*this);
+    }
+
+    void NullDevice::Submit(CommandList& commandList)
+    {
+        const NullCommandList& l_CommandList = static_cast<const NullCommandList&>(commandList);
+
+        m_Stats.Commands += l_CommandList.GetStats();
+        ++m_Stats.Submissions;
+    }
+
+    void NullDevice::CollectGarbage()
+    {
+        ++m_FrameCounter;
+
+        for (BufferHandle it_Heap : m_RetiredFrameHeaps)
+        {
+            DestroyBuffer(it_Heap);
+        }
+        m_RetiredFrameHeaps.clear();
+
+        const uint64_t l_Retired = m_FrameCounter >= m_DeferredFrameDelay ? m_FrameCounter - m_DeferredFrameDelay : 0;
+        m_FrameHeap.BeginFrame(m_FrameCounter, l_Retired);
+
+        size_t l_Write = 0;
+        for (size_t l_Read = 0; l_Read < m_DeferredStorage.size(); ++l_Read)
+        {
+            if (m_FrameCounter - m_DeferredStorage[l_Read].Frame < m_DeferredFrameDelay)
+            {
+                m_DeferredStorage[l_Write++] = std::move(m_DeferredStorage[l_Read]);
+            }
+        }
+
+        m_DeferredStorage.resize(l_Write);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <Trinity/Renderer/Backends/Null/NullSwapchain.h>
+
+#include <string>
+
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
+
+namespace Trinity
+{
+    NullSwapchain::NullSwapchain(NullDevice& device, const SwapchainDescription& description) : m_Device(device), m_Description(description)
+    {
+
+    }
+
+    NullSwapchain::~NullSwapchain()
+    {
+        Shutdown();
+    }
+
+    bool NullSwapchain::Initialize()
+    {
+        m_Width = m_Description.Width;
+        m_Height = m_Description.Height;
+
+        return CreateImages();
+    }
+
+    void NullSwapchain::Shutdown()
+    {
+        DestroyImages();
+    }
+
+    bool NullSwapchain::CreateImages()
+    {
+        if (m_Width == 0 || m_Height == 0)
+        {
+            return true;
+        }
+
+        const uint32_t l_ImageCount = m_Description.ImageCount > 0 ? m_Description.ImageCount : 1;
+        for (uint32_t l_Index = 0; l_Index < l_ImageCount; ++l_Index)
+        {
+            TextureDescription l_Description;
+            l_Description.Format = m_Description.PreferredFormat;
+            l_Description.Usage = TextureUsage::RenderTarget;
+            l_Description.Width = m_Width;
+            l_Description.Height = m_Height;
+            l_Description.DebugName = "NullBackBuffer" + std::to_string(l_Index);
+
+            TextureHandle l_Image = m_Device.CreateTexture(l_Description);
+            if (!l_Image.IsValid())
+            {
+                DestroyImages();
+
+                return false;
+            }
+
+            m_Images.push_back(l_Image);
+        }
+
+        m_CurrentImageIndex = 0;
+
+        return true;
+    }
+
+    void NullSwapchain::DestroyImages()
+    {
+        for (TextureHandle it_Image : m_Images)
+        {
+            m_Device.DestroyTexture(it_Image);
+        }
+
+        m_Images.clear();
+        m_Acquired = false;
+    }
+
+    bool NullSwapchain::AcquireNextImage(FrameInfo& outFrame)
+    {
+        if (m_Images.empty())
+        {
+            return false;
+        }
+
+        outFrame.BackBuffer = m_Images[m_CurrentImageIndex];
+        outFrame.ImageIndex = m_CurrentImageIndex;
+        m_Acquired = true;
+
+        return true;
+    }
+
+    void NullSwapchain::Present()
+    {
+        if (!m_Acquired)
+        {
+            return;
+        }
+
+        m_CurrentImageIndex = (m_CurrentImageIndex + 1) % static_cast<uint32_t>(m_Images.size());
+        m_Acquired = false;
+        ++m_PresentedFrames;
+    }
+
+    void NullSwapchain::Resize(uint32_t width, uint32_t height)
+    {
+        if (width == m_Width && height == m_Height && !m_Images.empty())
+        {
+            return;
+        }
+
+        DestroyImages();
+
+        m_Width = width;
+        m_Height = height;
+
+        CreateImages();
+    }
+}
\ No newline at end of file
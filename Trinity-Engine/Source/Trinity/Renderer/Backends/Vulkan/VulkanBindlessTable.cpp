@@ -0,0 +1,218 @@
+#include <Trinity/Renderer/Backends/Vulkan/VulkanBindlessTable.h>
+
+#include <array>
+
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    static VkDescriptorSetLayout CreateBindlessLayout(VkDevice device, uint32_t texture2DCount, uint32_t textureCubeCount)
+    {
+        std::array<VkDescriptorSetLayoutBinding, 2> l_Bindings{};
+        l_Bindings[0].binding = VulkanBindlessTable::k_Texture2DBinding;
+        l_Bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        l_Bindings[0].descriptorCount = texture2DCount;
+        l_Bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        l_Bindings[1].binding = VulkanBindlessTable::k_TextureCubeBinding;
+        l_Bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        l_Bindings[1].descriptorCount = textureCubeCount;
+        l_Bindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        // Unregistered slots are never sampled, and registration writes slots while the set is bound for in-flight frames
+        const VkDescriptorBindingFlags l_Flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        std::array<VkDescriptorBindingFlags, 2> l_BindingFlags = { l_Flags, l_Flags };
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo l_FlagsInfo{};
+        l_FlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        l_FlagsInfo.bindingCount = static_cast<uint32_t>(l_BindingFlags.size());
+        l_FlagsInfo.pBindingFlags = l_BindingFlags.data();
+
+        VkDescriptorSetLayoutCreateInfo l_LayoutInfo{};
+        l_LayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        l_LayoutInfo.pNext = &l_FlagsInfo;
+        l_LayoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        l_LayoutInfo.bindingCount = static_cast<uint32_t>(l_Bindings.size());
+        l_LayoutInfo.pBindings = l_Bindings.data();
+
+        VkDescriptorSetLayout l_Layout = VK_NULL_HANDLE;
+        if (vkCreateDescriptorSetLayout(device, &l_LayoutInfo, nullptr, &l_Layout) != VK_SUCCESS)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        return l_Layout;
+    }
+
+    VulkanBindlessTable::~VulkanBindlessTable()
+    {
+        Shutdown();
+    }
+
+    bool VulkanBindlessTable::Initialize(VkDevice device, uint32_t texture2DCount, uint32_t textureCubeCount, uint64_t frameDelay)
+    {
+        m_Device = device;
+        m_FrameDelay = frameDelay;
+        m_Textures2D = SlotArray{};
+        m_Textures2D.Capacity = texture2DCount;
+        m_TexturesCube = SlotArray{};
+        m_TexturesCube.Capacity = textureCubeCount;
+
+        m_Layout = CreateBindlessLayout(m_Device, texture2DCount, textureCubeCount);
+        if (m_Layout == VK_NULL_HANDLE)
+        {
+            TR_CORE_ERROR("Failed to create the bindless descriptor set layout");
+
+            return false;
+        }
+
+        VkDescriptorPoolSize l_PoolSize{};
+        l_PoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        l_PoolSize.descriptorCount = texture2DCount + textureCubeCount;
+
+        VkDescriptorPoolCreateInfo l_PoolInfo{};
+        l_PoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        l_PoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        l_PoolInfo.maxSets = 1;
+        l_PoolInfo.poolSizeCount = 1;
+        l_PoolInfo.pPoolSizes = &l_PoolSize;
+
+        if (vkCreateDescriptorPool(m_Device, &l_PoolInfo, nullptr, &m_Pool) != VK_SUCCESS)
+        {
+            TR_CORE_ERROR("Failed to create the bindless descriptor pool");
+            Shutdown();
+
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo l_AllocateInfo{};
+        l_AllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        l_AllocateInfo.descriptorPool = m_Pool;
+        l_AllocateInfo.descriptorSetCount = 1;
+        l_AllocateInfo.pSetLayouts = &m_Layout;
+
+        if (vkAllocateDescriptorSets(m_Device, &l_AllocateInfo, &m_Set) != VK_SUCCESS)
+        {
+            TR_CORE_ERROR("Failed to allocate the bindless descriptor set");
+            m_Set = VK_NULL_HANDLE;
+            Shutdown();
+
+            return false;
+        }
+
+        TR_CORE_INFO("Bindless texture table: {} 2D, {} cube slots", texture2DCount, textureCubeCount);
+
+        return true;
+    }
+
+    void VulkanBindlessTable::Shutdown()
+    {
+        if (m_Pool != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorPool(m_Device, m_Pool, nullptr);
+            m_Pool = VK_NULL_HANDLE;
+        }
+
+        if (m_Layout != VK_NULL_HANDLE)
+        {
+            vkDestroyDescriptorSetLayout(m_Device, m_Layout, nullptr);
+            m_Layout = VK_NULL_HANDLE;
+        }
+
+        m_Set = VK_NULL_HANDLE;
+    }
+
+    VkDescriptorSetLayout VulkanBindlessTable::CreateCompatibleLayout() const
+    {
+        if (!IsInitialized())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        return CreateBindlessLayout(m_Device, m_Textures2D.Capacity, m_TexturesCube.Capacity);
+    }
+
+    uint32_t VulkanBindlessTable::Register(VkImageView view, VkSampler sampler, bool cube)
+    {
+        if (!IsInitialized())
+        {
+            return UINT32_MAX;
+        }
+
+        uint32_t l_Index = Allocate(cube ? m_TexturesCube : m_Textures2D);
+        if (l_Index == UINT32_MAX)
+        {
+            TR_CORE_WARN("Bindless {} texture table is full", cube ? "cube" : "2D");
+
+            return UINT32_MAX;
+        }
+
+        VkDescriptorImageInfo l_ImageInfo{};
+        l_ImageInfo.sampler = sampler;
+        l_ImageInfo.imageView = view;
+        l_ImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet l_Write{};
+        l_Write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        l_Write.dstSet = m_Set;
+        l_Write.dstBinding = cube ? k_TextureCubeBinding : k_Texture2DBinding;
+        l_Write.dstArrayElement = l_Index;
+        l_Write.descriptorCount = 1;
+        l_Write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        l_Write.pImageInfo = &l_ImageInfo;
+
+        vkUpdateDescriptorSets(m_Device, 1, &l_Write, 0, nullptr);
+
+        return l_Index;
+    }
+
+    void VulkanBindlessTable::Release(uint32_t index, bool cube)
+    {
+        SlotArray& l_Slots = cube ? m_TexturesCube : m_Textures2D;
+        if (index < l_Slots.Capacity)
+        {
+            l_Slots.Pending.emplace_back(index, m_Frame);
+        }
+    }
+
+    void VulkanBindlessTable::Collect(uint64_t frame)
+    {
+        m_Frame = frame;
+
+        for (SlotArray* it_Slots : { &m_Textures2D, &m_TexturesCube })
+        {
+            size_t l_Write = 0;
+            for (size_t l_Read = 0; l_Read < it_Slots->Pending.size(); ++l_Read)
+            {
+                if (it_Slots->Pending[l_Read].second + m_FrameDelay <= m_Frame)
+                {
+                    it_Slots->Free.push_back(it_Slots->Pending[l_Read].first);
+                }
+                else
+                {
+                    it_Slots->Pending[l_Write++] = it_Slots->Pending[l_Read];
+                }
+            }
+
+            it_Slots->Pending.resize(l_Write);
+        }
+    }
+
+    uint32_t VulkanBindlessTable::Allocate(SlotArray& slots)
+    {
+        if (!slots.Free.empty())
+        {
+            uint32_t l_Index = slots.Free.back();
+            slots.Free.pop_back();
+
+            return l_Index;
+        }
+
+        if (slots.Next >= slots.Capacity)
+        {
+            return UINT32_MAX;
+        }
+
+        return slots.Next++;
+    }
+}
\ No newline at end of file
@@ -54,23 +54,6 @@ namespace Trinity
             TR_CORE_CRITICAL("Failed vkAllocateCommandBuffers");
         }
 
-        VkDescriptorPoolSize l_PoolSizes[2]{};
-        l_PoolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        l_PoolSizes[0].descriptorCount = 1024;
-        l_PoolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        l_PoolSizes[1].descriptorCount = 1024;
-
-        VkDescriptorPoolCreateInfo l_PoolInfo{};
-        l_PoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        l_PoolInfo.maxSets = 1024;
-        l_PoolInfo.poolSizeCount = 2;
-        l_PoolInfo.pPoolSizes = l_PoolSizes;
-
-        if (vkCreateDescriptorPool(m_Device.GetHandle(), &l_PoolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
-        {
-            TR_CORE_CRITICAL("Failed vkCreateDescriptorPool");
-        }
-
         TR_CORE_INFO("VULKAN COMMAND LIST INITIALIZED");
     }
 
@@ -78,12 +61,6 @@ namespace Trinity
     {
         TR_CORE_INFO("SHUTTING DOWN VULKAN COMMAND LIST");
 
-        if (m_DescriptorPool != VK_NULL_HANDLE)
-        {
-            vkDestroyDescriptorPool(m_Device.GetHandle(), m_DescriptorPool, nullptr);
-           TR_CORE_TRACE("Descriptor pool destoryed");
-        }
-
         if (m_CommandBuffer != VK_NULL_HANDLE)
         {
             vkFreeCommandBuffers(m_Device.GetHandle(), m_Device.GetCommands().GetPool(), 1, &m_CommandBuffer);
@@ -103,11 +80,6 @@ namespace Trinity
 
         vkBeginCommandBuffer(m_CommandBuffer, &l_CommandBufferBeginInfo);
 
-        if (m_DescriptorPool != VK_NULL_HANDLE)
-        {
-            vkResetDescriptorPool(m_Device.GetHandle(), m_DescriptorPool, 0);
-        }
-
         m_CurrentLayout = VK_NULL_HANDLE;
         m_CurrentSetLayouts.clear();
     }
@@ -119,8 +91,7 @@ namespace Trinity
 
     void VulkanCommandList::BeginRendering(const RenderingInfo& renderingInfo)
     {
-        std::vector<VkRenderingAttachmentInfo> l_ColorAttachments;
-        l_ColorAttachments.reserve(renderingInfo.ColorAttachmentCount);
+        m_ColorAttachments.clear();
 
         for (uint32_t l_Index = 0; l_Index < renderingInfo.ColorAttachmentCount; ++l_Index)
         {
@@ -144,7 +115,7 @@ namespace Trinity
             l_RenderingAttachmentInfo.loadOp = l_Attachment.Clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
             l_RenderingAttachmentInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
             l_RenderingAttachmentInfo.clearValue.color = { { l_Attachment.ClearColor[0], l_Attachment.ClearColor[1], l_Attachment.ClearColor[2], l_Attachment.ClearColor[3] } };
-            l_ColorAttachments.push_back(l_RenderingAttachmentInfo);
+            m_ColorAttachments.push_back(l_RenderingAttachmentInfo);
         }
 
         VkRenderingAttachmentInfo l_RenderingDepthAttachmentInfo{};
@@ -155,7 +126,13 @@ namespace Trinity
             if (l_DepthTexture != nullptr)
             {
                 l_RenderingDepthAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+                // The full view of a layered target spans every layer, so a single layer is rendered through its own view
                 l_RenderingDepthAttachmentInfo.imageView = l_DepthTexture->View;
+                if (renderingInfo.Depth->ArrayLayer != 0 || l_DepthTexture->ArrayLayers > 1)
+                {
+                    l_RenderingDepthAttachmentInfo.imageView = m_Device.GetRenderTargetView(renderingInfo.Depth->Target, 0, renderingInfo.Depth->ArrayLayer);
+                }
+
                 l_RenderingDepthAttachmentInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
                 l_RenderingDepthAttachmentInfo.loadOp = renderingInfo.Depth->Clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
                 l_RenderingDepthAttachmentInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -169,8 +146,8 @@ namespace Trinity
         l_RenderingInfo.renderArea.offset = { 0, 0 };
         l_RenderingInfo.renderArea.extent = { renderingInfo.Width, renderingInfo.Height };
         l_RenderingInfo.layerCount = 1;
-        l_RenderingInfo.colorAttachmentCount = static_cast<uint32_t>(l_ColorAttachments.size());
-        l_RenderingInfo.pColorAttachments = l_ColorAttachments.empty() ? nullptr : l_ColorAttachments.data();
+        l_RenderingInfo.colorAttachmentCount = static_cast<uint32_t>(m_ColorAttachments.size());
+        l_RenderingInfo.pColorAttachments = m_ColorAttachments.empty() ? nullptr : m_ColorAttachments.data();
         l_RenderingInfo.pDepthAttachment = l_HasDepth ? &l_RenderingDepthAttachmentInfo : nullptr;
 
         vkCmdBeginRendering(m_CommandBuffer, &l_RenderingInfo);
@@ -205,18 +182,16 @@ namespace Trinity
 
     void VulkanCommandList::BindPipeline(PipelineHandle pipeline)
     {
-        VulkanPipelineResource* l_Pipeline = m_Device.GetPipeline(pipeline);
-        if (l_Pipeline == nullptr)
+        VkPipeline l_Pipeline = VK_NULL_HANDLE;
+        if (!m_Device.GetPipelineBinding(pipeline, l_Pipeline, m_CurrentLayout, m_CurrentSetLayouts))
         {
             return;
         }
 
-        vkCmdBindPipeline(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, l_Pipeline->Pipeline);
-        m_CurrentLayout = l_Pipeline->Layout;
-        m_CurrentSetLayouts = l_Pipeline->SetLayouts;
+        vkCmdBindPipeline(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, l_Pipeline);
     }
 
-    void VulkanCommandList::BindVertexBuffer(BufferHandle buffer, uint64_t offset)
+    void VulkanCommandList::BindVertexBuffer(BufferHandle buffer, uint64_t offset, uint32_t slot)
     {
         VulkanBufferResource* l_Buffer = m_Device.GetBuffer(buffer);
         if (l_Buffer == nullptr)
@@ -226,10 +201,10 @@ namespace Trinity
 
         VkBuffer l_Handle = l_Buffer->Buffer;
         VkDeviceSize l_Offset = offset;
-        vkCmdBindVertexBuffers(m_CommandBuffer, 0, 1, &l_Handle, &l_Offset);
+        vkCmdBindVertexBuffers(m_CommandBuffer, slot, 1, &l_Handle, &l_Offset);
     }
 
-    void VulkanCommandList::BindIndexBuffer(BufferHandle buffer, uint64_t offset)
+    void VulkanCommandList::BindIndexBuffer(BufferHandle buffer, uint64_t offset, IndexType type)
     {
         VulkanBufferResource* l_Buffer = m_Device.GetBuffer(buffer);
         if (l_Buffer == nullptr)
@@ -237,7 +212,7 @@ namespace Trinity
             return;
         }
 
-        vkCmdBindIndexBuffer(m_CommandBuffer, l_Buffer->Buffer, offset, VK_INDEX_TYPE_UINT32);
+        vkCmdBindIndexBuffer(m_CommandBuffer, l_Buffer->Buffer, offset, VulkanUtilities::ToVkIndexType(type));
     }
 
     void VulkanCommandList::PushConstants(ShaderStage stages, uint32_t offset, uint32_t size, const void* data)
@@ -264,20 +239,6 @@ namespace Trinity
             return;
         }
 
-        VkDescriptorSetAllocateInfo l_AllocateInfo{};
-        l_AllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        l_AllocateInfo.descriptorPool = m_DescriptorPool;
-        l_AllocateInfo.descriptorSetCount = 1;
-        l_AllocateInfo.pSetLayouts = &m_CurrentSetLayouts[set];
-
-        VkDescriptorSet l_DescriptorSet = VK_NULL_HANDLE;
-        if (vkAllocateDescriptorSets(m_Device.GetHandle(), &l_AllocateInfo, &l_DescriptorSet) != VK_SUCCESS)
-        {
-            TR_CORE_CRITICAL("Failed vkAllocateDescriptorSets");
-
-            return;
-        }
-
         VkDescriptorImageInfo l_ImageInfo{};
         l_ImageInfo.sampler = l_Sampler->Sampler;
         l_ImageInfo.imageView = l_Texture->View;
@@ -285,62 +246,110 @@ namespace Trinity
 
         VkWriteDescriptorSet l_Write{};
         l_Write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        l_Write.dstSet = l_DescriptorSet;
         l_Write.dstBinding = binding;
         l_Write.dstArrayElement = 0;
         l_Write.descriptorCount = 1;
         l_Write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         l_Write.pImageInfo = &l_ImageInfo;
 
-        vkUpdateDescriptorSets(m_Device.GetHandle(), 1, &l_Write, 0, nullptr);
+        VulkanDescriptorKey l_Key;
+        l_Key.Layout = m_CurrentSetLayouts[set];
+        l_Key.Type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        l_Key.Binding = binding;
+        l_Key.Resource = texture.Pack();
+        l_Key.Sampler = sampler.Pack();
+
+        VkDescriptorSet l_DescriptorSet = m_Device.GetDescriptorCache().Acquire(l_Key, l_Write);
+        if (l_DescriptorSet == VK_NULL_HANDLE)
+        {
+            return;
+        }
 
         vkCmdBindDescriptorSets(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_CurrentLayout, set, 1, &l_DescriptorSet, 0, nullptr);
     }
 
     void VulkanCommandList::BindUniformBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size)
+    {
+        BindBuffer(set, binding, buffer, offset, size, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    }
+
+    void VulkanCommandList::BindStorageBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size)
+    {
+        BindBuffer(set, binding, buffer, offset, size, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    }
+
+    void VulkanCommandList::BindDynamicUniformBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation)
+    {
+        BindBuffer(set, binding, allocation.Buffer, allocation.Offset, allocation.Size, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+    }
+
+    void VulkanCommandList::BindDynamicStorageBuffer(uint32_t set, uint32_t binding, const FrameAllocation& allocation)
+    {
+        BindBuffer(set, binding, allocation.Buffer, allocation.Offset, allocation.Size, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+    }
+
+    void VulkanCommandList::BindBindlessTextures(uint32_t set)
     {
         if (m_CurrentLayout == VK_NULL_HANDLE || set >= m_CurrentSetLayouts.size())
         {
             return;
         }
 
-        VulkanBufferResource* l_Buffer = m_Device.GetBuffer(buffer);
-        if (l_Buffer == nullptr)
+        VkDescriptorSet l_DescriptorSet = m_Device.GetBindlessTable().GetSet();
+        if (l_DescriptorSet == VK_NULL_HANDLE)
         {
             return;
         }
 
-        VkDescriptorSetAllocateInfo l_AllocateInfo{};
-        l_AllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        l_AllocateInfo.descriptorPool = m_DescriptorPool;
-        l_AllocateInfo.descriptorSetCount = 1;
-        l_AllocateInfo.pSetLayouts = &m_CurrentSetLayouts[set];
+        vkCmdBindDescriptorSets(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_CurrentLayout, set, 1, &l_DescriptorSet, 0, nullptr);
+    }
 
-        VkDescriptorSet l_DescriptorSet = VK_NULL_HANDLE;
-        if (vkAllocateDescriptorSets(m_Device.GetHandle(), &l_AllocateInfo, &l_DescriptorSet) != VK_SUCCESS)
+    void VulkanCommandList::BindBuffer(uint32_t set, uint32_t binding, BufferHandle buffer, uint64_t offset, uint64_t size, VkDescriptorType type)
+    {
+        if (m_CurrentLayout == VK_NULL_HANDLE || set >= m_CurrentSetLayouts.size())
         {
-            TR_CORE_CRITICAL("Failed vkAllocateDescriptorSets");
+            return;
+        }
 
+        VulkanBufferResource* l_Buffer = m_Device.GetBuffer(buffer);
+        if (l_Buffer == nullptr)
+        {
             return;
         }
 
+        // Dynamic descriptors take the offset at bind time, so the set itself only records the range
+        const bool l_Dynamic = type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        const uint64_t l_SetOffset = l_Dynamic ? 0 : offset;
+        const uint32_t l_DynamicOffset = static_cast<uint32_t>(offset);
+
         VkDescriptorBufferInfo l_BufferInfo{};
         l_BufferInfo.buffer = l_Buffer->Buffer;
-        l_BufferInfo.offset = offset;
+        l_BufferInfo.offset = l_SetOffset;
         l_BufferInfo.range = size;
 
         VkWriteDescriptorSet l_Write{};
         l_Write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        l_Write.dstSet = l_DescriptorSet;
         l_Write.dstBinding = binding;
         l_Write.dstArrayElement = 0;
         l_Write.descriptorCount = 1;
-        l_Write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        l_Write.descriptorType = type;
         l_Write.pBufferInfo = &l_BufferInfo;
 
-        vkUpdateDescriptorSets(m_Device.GetHandle(), 1, &l_Write, 0, nullptr);
+        VulkanDescriptorKey l_Key;
+        l_Key.Layout = m_CurrentSetLayouts[set];
+        l_Key.Type = type;
+        l_Key.Binding = binding;
+        l_Key.Resource = buffer.Pack();
+        l_Key.Offset = l_SetOffset;
+        l_Key.Range = size;
 
-        vkCmdBindDescriptorSets(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_CurrentLayout, set, 1, &l_DescriptorSet, 0, nullptr);
+        VkDescriptorSet l_DescriptorSet = m_Device.GetDescriptorCache().Acquire(l_Key, l_Write);
+        if (l_DescriptorSet == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        vkCmdBindDescriptorSets(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_CurrentLayout, set, 1, &l_DescriptorSet, l_Dynamic ? 1u : 0u, l_Dynamic ? &l_DynamicOffset : nullptr);
     }
 
     void VulkanCommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
@@ -353,45 +362,94 @@ namespace Trinity
         vkCmdDrawIndexed(m_CommandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
     }
 
-    void VulkanCommandList::TransitionTexture(TextureHandle texture, ResourceState from, ResourceState to)
+    void VulkanCommandList::CopyTexture(TextureHandle source, TextureHandle destination, uint32_t arrayLayer)
     {
-        VulkanTextureResource* l_Texture = m_Device.GetTexture(texture);
-        if (l_Texture == nullptr)
+        VulkanTextureResource* l_Source = m_Device.GetTexture(source);
+        VulkanTextureResource* l_Destination = m_Device.GetTexture(destination);
+        if (l_Source == nullptr || l_Destination == nullptr)
         {
             return;
         }
 
-        if (from != ResourceState::Undefined && l_Texture->CurrentState != from)
+        VkImageCopy l_Region{};
+        l_Region.srcSubresource.aspectMask = l_Source->Aspect;
+        l_Region.srcSubresource.baseArrayLayer = arrayLayer;
+        l_Region.srcSubresource.layerCount = 1;
+        l_Region.dstSubresource.aspectMask = l_Destination->Aspect;
+        l_Region.dstSubresource.baseArrayLayer = arrayLayer;
+        l_Region.dstSubresource.layerCount = 1;
+        l_Region.extent = l_Source->Extent;
+
+        vkCmdCopyImage(m_CommandBuffer, l_Source->Image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, l_Destination->Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &l_Region);
+    }
+
+    void VulkanCommandList::TransitionTexture(TextureHandle texture, ResourceState from, ResourceState to)
+    {
+        TextureBarrier l_Barrier;
+        l_Barrier.Texture = texture;
+        l_Barrier.From = from;
+        l_Barrier.To = to;
+
+        TransitionTextures(&l_Barrier, 1);
+    }
+
+    void VulkanCommandList::TransitionTextures(const TextureBarrier* barriers, uint32_t count)
+    {
+        m_ImageBarriers.clear();
+
+        for (uint32_t l_Index = 0; l_Index < count; ++l_Index)
         {
-            TR_CORE_WARN("Undefined texture state");
+            const TextureBarrier& l_Request = barriers[l_Index];
+            VulkanTextureResource* l_Texture = m_Device.GetTexture(l_Request.Texture);
+            if (l_Texture == nullptr)
+            {
+                continue;
+            }
+
+            if (l_Request.From != ResourceState::Undefined && l_Texture->CurrentState != l_Request.From)
+            {
+                TR_CORE_WARN("Undefined texture state");
+            }
+
+            l_Texture->CurrentState = l_Request.To;
+
+            StateInfo l_From = ResolveState(l_Request.From);
+            StateInfo l_To = ResolveState(l_Request.To);
+            if (l_Request.Aliased)
+            {
+                l_From.Stage = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                l_From.Access = VK_ACCESS_2_MEMORY_WRITE_BIT;
+            }
+
+            VkImageMemoryBarrier2 l_Barrier{};
+            l_Barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            l_Barrier.srcStageMask = l_From.Stage;
+            l_Barrier.srcAccessMask = l_From.Access;
+            l_Barrier.dstStageMask = l_To.Stage;
+            l_Barrier.dstAccessMask = l_To.Access;
+            l_Barrier.oldLayout = l_From.Layout;
+            l_Barrier.newLayout = l_To.Layout;
+            l_Barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            l_Barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            l_Barrier.image = l_Texture->Image;
+            l_Barrier.subresourceRange.aspectMask = l_Texture->Aspect;
+            l_Barrier.subresourceRange.baseMipLevel = 0;
+            l_Barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            l_Barrier.subresourceRange.baseArrayLayer = 0;
+            l_Barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+
+            m_ImageBarriers.push_back(l_Barrier);
         }
 
-        l_Texture->CurrentState = to;
-
-        StateInfo l_From = ResolveState(from);
-        StateInfo l_To = ResolveState(to);
-
-        VkImageMemoryBarrier2 l_Barrier{};
-        l_Barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-        l_Barrier.srcStageMask = l_From.Stage;
-        l_Barrier.srcAccessMask = l_From.Access;
-        l_Barrier.dstStageMask = l_To.Stage;
-        l_Barrier.dstAccessMask = l_To.Access;
-        l_Barrier.oldLayout = l_From.Layout;
-        l_Barrier.newLayout = l_To.Layout;
-        l_Barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        l_Barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        l_Barrier.image = l_Texture->Image;
-        l_Barrier.subresourceRange.aspectMask = l_Texture->Aspect;
-        l_Barrier.subresourceRange.baseMipLevel = 0;
-        l_Barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
-        l_Barrier.subresourceRange.baseArrayLayer = 0;
-        l_Barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        if (m_ImageBarriers.empty())
+        {
+            return;
+        }
 
         VkDependencyInfo l_DependencyInfo{};
         l_DependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-        l_DependencyInfo.imageMemoryBarrierCount = 1;
-        l_DependencyInfo.pImageMemoryBarriers = &l_Barrier;
+        l_DependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(m_ImageBarriers.size());
+        l_DependencyInfo.pImageMemoryBarriers = m_ImageBarriers.data();
 
         vkCmdPipelineBarrier2(m_CommandBuffer, &l_DependencyInfo);
     }
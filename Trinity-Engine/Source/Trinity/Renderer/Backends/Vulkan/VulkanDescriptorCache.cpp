@@ -0,0 +1,316 @@
+#include <Trinity/Renderer/Backends/Vulkan/VulkanDescriptorCache.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    static void CombineHash(std::size_t& seed, uint64_t value)
+    {
+        seed ^= std::hash<uint64_t>()(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+    }
+
+    std::size_t VulkanDescriptorKeyHash::operator()(const VulkanDescriptorKey& key) const noexcept
+    {
+        std::size_t l_Seed = 0;
+        CombineHash(l_Seed, reinterpret_cast<uint64_t>(key.Layout));
+        CombineHash(l_Seed, (static_cast<uint64_t>(key.Type) << 32) | key.Binding);
+        CombineHash(l_Seed, key.Resource);
+        CombineHash(l_Seed, key.Sampler);
+        CombineHash(l_Seed, key.Offset);
+        CombineHash(l_Seed, key.Range);
+
+        return l_Seed;
+    }
+
+    VulkanDescriptorCache::~VulkanDescriptorCache()
+    {
+        Shutdown();
+    }
+
+    bool VulkanDescriptorCache::Initialize(VkDevice device, uint32_t capacity, uint64_t frameDelay)
+    {
+        m_Device = device;
+        m_Capacity = capacity;
+        m_FrameDelay = frameDelay;
+        m_Frame = 0;
+
+        return CreatePool();
+    }
+
+    void VulkanDescriptorCache::Shutdown()
+    {
+        // Destroying a pool releases every set allocated from it
+        for (Pool& it_Pool : m_Pools)
+        {
+            if (it_Pool.Handle != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorPool(m_Device, it_Pool.Handle, nullptr);
+            }
+        }
+
+        m_Pools.clear();
+        m_CurrentPool = 0;
+        m_Lru.clear();
+        m_Entries.clear();
+        m_Retired.clear();
+        m_DestroyedTextures.clear();
+        m_DestroyedBuffers.clear();
+        m_DestroyedSamplers.clear();
+        m_DestroyedLayouts.clear();
+    }
+
+    VkDescriptorSet VulkanDescriptorCache::Acquire(const VulkanDescriptorKey& key, VkWriteDescriptorSet write)
+    {
+        auto it_Entry = m_Entries.find(key);
+        if (it_Entry != m_Entries.end())
+        {
+            Entry& l_Entry = it_Entry->second;
+            l_Entry.LastUsedFrame = m_Frame;
+            m_Lru.splice(m_Lru.begin(), m_Lru, l_Entry.LruPosition);
+            ++m_Hits;
+
+            return l_Entry.Set;
+        }
+
+        ++m_Misses;
+
+        EvictLeastRecentlyUsed();
+
+        uint32_t l_Pool = 0;
+        VkDescriptorSet l_Set = Allocate(key.Layout, l_Pool);
+        if (l_Set == VK_NULL_HANDLE)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        write.dstSet = l_Set;
+        vkUpdateDescriptorSets(m_Device, 1, &write, 0, nullptr);
+
+        m_Lru.push_front(key);
+
+        Entry l_Entry;
+        l_Entry.Set = l_Set;
+        l_Entry.Pool = l_Pool;
+        l_Entry.LastUsedFrame = m_Frame;
+        l_Entry.LruPosition = m_Lru.begin();
+        m_Entries.emplace(key, l_Entry);
+
+        return l_Set;
+    }
+
+    void VulkanDescriptorCache::Collect(uint64_t frame)
+    {
+        m_Frame = frame;
+
+        DropInvalidated();
+
+        size_t l_Write = 0;
+        for (size_t l_Read = 0; l_Read < m_Retired.size(); ++l_Read)
+        {
+            if (IsReleasable(m_Retired[l_Read].LastUsedFrame))
+            {
+                Free(m_Retired[l_Read].Set, m_Retired[l_Read].Pool);
+            }
+            else
+            {
+                m_Retired[l_Write++] = m_Retired[l_Read];
+            }
+        }
+
+        m_Retired.resize(l_Write);
+    }
+
+    DescriptorCacheStats VulkanDescriptorCache::GetStats() const
+    {
+        DescriptorCacheStats l_Stats;
+        l_Stats.Hits = m_Hits;
+        l_Stats.Misses = m_Misses;
+        l_Stats.Evictions = m_Evictions;
+        l_Stats.LiveSets = static_cast<uint32_t>(m_Entries.size());
+        l_Stats.Pools = static_cast<uint32_t>(m_Pools.size());
+
+        return l_Stats;
+    }
+
+    void VulkanDescriptorCache::ResetStats()
+    {
+        m_Hits = 0;
+        m_Misses = 0;
+        m_Evictions = 0;
+    }
+
+    VkDescriptorSet VulkanDescriptorCache::Allocate(VkDescriptorSetLayout layout, uint32_t& outPool)
+    {
+        VkDescriptorSet l_Set = VK_NULL_HANDLE;
+        if (TryAllocate(m_CurrentPool, layout, l_Set))
+        {
+            outPool = m_CurrentPool;
+
+            return l_Set;
+        }
+
+        // Older pools regain room as sets are evicted; reuse them before growing
+        for (uint32_t l_Index = 0; l_Index < m_Pools.size(); ++l_Index)
+        {
+            if (l_Index != m_CurrentPool && m_Pools[l_Index].Allocated < k_SetsPerPool && TryAllocate(l_Index, layout, l_Set))
+            {
+                m_CurrentPool = l_Index;
+                outPool = l_Index;
+
+                return l_Set;
+            }
+        }
+
+        if (!CreatePool())
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        m_CurrentPool = static_cast<uint32_t>(m_Pools.size() - 1);
+        if (!TryAllocate(m_CurrentPool, layout, l_Set))
+        {
+            TR_CORE_CRITICAL("Failed vkAllocateDescriptorSets from a fresh descriptor pool");
+
+            return VK_NULL_HANDLE;
+        }
+
+        outPool = m_CurrentPool;
+
+        return l_Set;
+    }
+
+    bool VulkanDescriptorCache::TryAllocate(uint32_t poolIndex, VkDescriptorSetLayout layout, VkDescriptorSet& outSet)
+    {
+        if (poolIndex >= m_Pools.size())
+        {
+            return false;
+        }
+
+        Pool& l_Pool = m_Pools[poolIndex];
+
+        VkDescriptorSetAllocateInfo l_AllocateInfo{};
+        l_AllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        l_AllocateInfo.descriptorPool = l_Pool.Handle;
+        l_AllocateInfo.descriptorSetCount = 1;
+        l_AllocateInfo.pSetLayouts = &layout;
+
+        if (vkAllocateDescriptorSets(m_Device, &l_AllocateInfo, &outSet) != VK_SUCCESS)
+        {
+            outSet = VK_NULL_HANDLE;
+
+            return false;
+        }
+
+        ++l_Pool.Allocated;
+
+        return true;
+    }
+
+    bool VulkanDescriptorCache::CreatePool()
+    {
+        VkDescriptorPoolSize l_PoolSizes[5]{};
+        l_PoolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        l_PoolSizes[0].descriptorCount = k_SetsPerPool;
+        l_PoolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        l_PoolSizes[1].descriptorCount = k_SetsPerPool;
+        l_PoolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        l_PoolSizes[2].descriptorCount = k_SetsPerPool / 2;
+
+        // Frame-heap bindings reuse one set per size, so few of these are ever live
+        l_PoolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        l_PoolSizes[3].descriptorCount = k_SetsPerPool / 8;
+        l_PoolSizes[4].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        l_PoolSizes[4].descriptorCount = k_SetsPerPool / 8;
+
+        VkDescriptorPoolCreateInfo l_PoolInfo{};
+        l_PoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        l_PoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        l_PoolInfo.maxSets = k_SetsPerPool;
+        l_PoolInfo.poolSizeCount = 5;
+        l_PoolInfo.pPoolSizes = l_PoolSizes;
+
+        Pool l_Pool;
+        if (vkCreateDescriptorPool(m_Device, &l_PoolInfo, nullptr, &l_Pool.Handle) != VK_SUCCESS)
+        {
+            TR_CORE_CRITICAL("Failed vkCreateDescriptorPool");
+
+            return false;
+        }
+
+        m_Pools.push_back(l_Pool);
+        TR_CORE_TRACE("Descriptor cache grew to {} pools", m_Pools.size());
+
+        return true;
+    }
+
+    void VulkanDescriptorCache::Free(VkDescriptorSet set, uint32_t pool)
+    {
+        if (pool >= m_Pools.size())
+        {
+            return;
+        }
+
+        vkFreeDescriptorSets(m_Device, m_Pools[pool].Handle, 1, &set);
+        --m_Pools[pool].Allocated;
+    }
+
+    void VulkanDescriptorCache::EvictLeastRecentlyUsed()
+    {
+        // Over capacity the cache may grow past its budget rather than free a set the GPU could still be reading; the overshoot drains on later misses
+        while (m_Entries.size() >= m_Capacity && !m_Lru.empty())
+        {
+            auto it_Entry = m_Entries.find(m_Lru.back());
+            if (!IsReleasable(it_Entry->second.LastUsedFrame))
+            {
+                return;
+            }
+
+            Free(it_Entry->second.Set, it_Entry->second.Pool);
+            m_Entries.erase(it_Entry);
+            m_Lru.pop_back();
+            ++m_Evictions;
+        }
+    }
+
+    void VulkanDescriptorCache::DropInvalidated()
+    {
+        if (m_DestroyedTextures.empty() && m_DestroyedBuffers.empty() && m_DestroyedSamplers.empty() && m_DestroyedLayouts.empty())
+        {
+            return;
+        }
+
+        std::unordered_set<uint64_t> l_Textures(m_DestroyedTextures.begin(), m_DestroyedTextures.end());
+        std::unordered_set<uint64_t> l_Buffers(m_DestroyedBuffers.begin(), m_DestroyedBuffers.end());
+        std::unordered_set<uint64_t> l_Samplers(m_DestroyedSamplers.begin(), m_DestroyedSamplers.end());
+        std::unordered_set<VkDescriptorSetLayout> l_Layouts(m_DestroyedLayouts.begin(), m_DestroyedLayouts.end());
+
+        for (auto it_Key = m_Lru.begin(); it_Key != m_Lru.end();)
+        {
+            const VulkanDescriptorKey& l_Key = *it_Key;
+
+            bool l_IsImage = l_Key.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bool l_Stale = l_Layouts.contains(l_Key.Layout) || (l_IsImage ? (l_Textures.contains(l_Key.Resource) || l_Samplers.contains(l_Key.Sampler)) : l_Buffers.contains(l_Key.Resource));
+            if (!l_Stale)
+            {
+                ++it_Key;
+
+                continue;
+            }
+
+            // The set may still be referenced by an in-flight command buffer, so it is retired rather than freed here
+            auto it_Entry = m_Entries.find(l_Key);
+            m_Retired.push_back({ it_Entry->second.Set, it_Entry->second.Pool, it_Entry->second.LastUsedFrame });
+            m_Entries.erase(it_Entry);
+            it_Key = m_Lru.erase(it_Key);
+            ++m_Evictions;
+        }
+
+        m_DestroyedTextures.clear();
+        m_DestroyedBuffers.clear();
+        m_DestroyedSamplers.clear();
+        m_DestroyedLayouts.clear();
+    }
+}
\ No newline at end of file
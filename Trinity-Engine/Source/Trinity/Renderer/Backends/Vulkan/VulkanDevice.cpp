@@ -1,164 +1,36 @@
 #include <Trinity/Renderer/Backends/Vulkan/VulkanDevice.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanImGuiBackend.h>
 
+#include <mutex>
 #include <set>
 #include <vector>
 #include <cstring>
 #include <array>
+#include <algorithm>
 
 #include <Trinity/Renderer/Backends/Vulkan/VulkanSwapchain.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanUtilities.h>
 #include <Trinity/Renderer/Backends/Vulkan/VulkanCommandList.h>
+#include <Trinity/Core/Timer.h>
 #include <Trinity/Core/Log.h>
 
 namespace Trinity
 {
-    static bool UploadViaStaging(VmaAllocator allocator, VulkanCommands& commands, VkBuffer destination, const void* data, uint64_t size, uint64_t destinationOffset)
-    {
-        VkBufferCreateInfo l_StagingInfo{};
-        l_StagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        l_StagingInfo.size = size;
-        l_StagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        l_StagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-        VmaAllocationCreateInfo l_StagingAllocation{};
-        l_StagingAllocation.usage = VMA_MEMORY_USAGE_AUTO;
-        l_StagingAllocation.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
-
-        VkBuffer l_StagingBuffer = VK_NULL_HANDLE;
-        VmaAllocation l_StagingMemory = VK_NULL_HANDLE;
-        VmaAllocationInfo l_StagingResult{};
-
-        if (vmaCreateBuffer(allocator, &l_StagingInfo, &l_StagingAllocation, &l_StagingBuffer, &l_StagingMemory, &l_StagingResult) != VK_SUCCESS)
-        {
-            return false;
-        }
-
-        std::memcpy(l_StagingResult.pMappedData, data, static_cast<size_t>(size));
-
-        commands.ImmediateSubmit([&](VkCommandBuffer commandBuffer)
-        {
-            VkBufferCopy l_Region{};
-            l_Region.srcOffset = 0;
-            l_Region.dstOffset = destinationOffset;
-            l_Region.size = size;
-            vkCmdCopyBuffer(commandBuffer, l_StagingBuffer, destination, 1, &l_Region);
-        });
-
-        vmaDestroyBuffer(allocator, l_StagingBuffer, l_StagingMemory);
-
-        return true;
-    }
-
-    static bool UploadTextureViaStaging(VmaAllocator allocator, VulkanCommands& commands, VkImage image, VkImageAspectFlags aspect, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, uint32_t layerCount, const void* data, uint64_t size)
-    {
-        VkBufferCreateInfo l_StagingInfo{};
-        l_StagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        l_StagingInfo.size = size;
-        l_StagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        l_StagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-        VmaAllocationCreateInfo l_StagingAllocation{};
-        l_StagingAllocation.usage = VMA_MEMORY_USAGE_AUTO;
-        l_StagingAllocation.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
-
-        VkBuffer l_StagingBuffer = VK_NULL_HANDLE;
-        VmaAllocation l_StagingMemory = VK_NULL_HANDLE;
-        VmaAllocationInfo l_StagingResult{};
-
-        if (vmaCreateBuffer(allocator, &l_StagingInfo, &l_StagingAllocation, &l_StagingBuffer, &l_StagingMemory, &l_StagingResult) != VK_SUCCESS)
-        {
-            return false;
-        }
-
-        std::memcpy(l_StagingResult.pMappedData, data, static_cast<size_t>(size));
-
-        commands.ImmediateSubmit([&](VkCommandBuffer commandBuffer)
-        {
-            auto l_Barrier = [&](uint32_t baseLevel, uint32_t levelCount, VkImageLayout oldLayout, VkImageLayout newLayout, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess, VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess)
-            {
-                VkImageMemoryBarrier2 l_ImageBarrier{};
-                l_ImageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-                l_ImageBarrier.srcStageMask = srcStage;
-                l_ImageBarrier.srcAccessMask = srcAccess;
-                l_ImageBarrier.dstStageMask = dstStage;
-                l_ImageBarrier.dstAccessMask = dstAccess;
-                l_ImageBarrier.oldLayout = oldLayout;
-                l_ImageBarrier.newLayout = newLayout;
-                l_ImageBarrier.image = image;
-                l_ImageBarrier.subresourceRange.aspectMask = aspect;
-                l_ImageBarrier.subresourceRange.baseMipLevel = baseLevel;
-                l_ImageBarrier.subresourceRange.levelCount = levelCount;
-                l_ImageBarrier.subresourceRange.baseArrayLayer = 0;
-                l_ImageBarrier.subresourceRange.layerCount = layerCount;
-
-                VkDependencyInfo l_Dependency{};
-                l_Dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-                l_Dependency.imageMemoryBarrierCount = 1;
-                l_Dependency.pImageMemoryBarriers = &l_ImageBarrier;
-                vkCmdPipelineBarrier2(commandBuffer, &l_Dependency);
-            };
-
-            l_Barrier(0, mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, 0, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
-
-            VkBufferImageCopy l_Region{};
-            l_Region.bufferOffset = 0;
-            l_Region.bufferRowLength = 0;
-            l_Region.bufferImageHeight = 0;
-            l_Region.imageSubresource.aspectMask = aspect;
-            l_Region.imageSubresource.mipLevel = 0;
-            l_Region.imageSubresource.baseArrayLayer = 0;
-            l_Region.imageSubresource.layerCount = layerCount;
-            l_Region.imageOffset = { 0, 0, 0 };
-            l_Region.imageExtent = { width, height, depth };
-            vkCmdCopyBufferToImage(commandBuffer, l_StagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &l_Region);
-
-            if (mipLevels > 1)
-            {
-                int32_t l_MipWidth = static_cast<int32_t>(width);
-                int32_t l_MipHeight = static_cast<int32_t>(height);
+    // Live descriptor sets kept before least-recently-used eviction starts; comfortably above one frame's worth of distinct binds
+    static constexpr uint32_t k_DescriptorCacheCapacity = 4096;
 
-                for (uint32_t l_Level = 1; l_Level < mipLevels; ++l_Level)
-                {
-                    l_Barrier(l_Level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
-
-                    const int32_t l_NextWidth = l_MipWidth > 1 ? l_MipWidth / 2 : 1;
-                    const int32_t l_NextHeight = l_MipHeight > 1 ? l_MipHeight / 2 : 1;
-
-                    VkImageBlit l_Blit{};
-                    l_Blit.srcOffsets[0] = { 0, 0, 0 };
-                    l_Blit.srcOffsets[1] = { l_MipWidth, l_MipHeight, 1 };
-                    l_Blit.srcSubresource.aspectMask = aspect;
-                    l_Blit.srcSubresource.mipLevel = l_Level - 1;
-                    l_Blit.srcSubresource.baseArrayLayer = 0;
-                    l_Blit.srcSubresource.layerCount = layerCount;
-                    l_Blit.dstOffsets[0] = { 0, 0, 0 };
-                    l_Blit.dstOffsets[1] = { l_NextWidth, l_NextHeight, 1 };
-                    l_Blit.dstSubresource.aspectMask = aspect;
-                    l_Blit.dstSubresource.mipLevel = l_Level;
-                    l_Blit.dstSubresource.baseArrayLayer = 0;
-                    l_Blit.dstSubresource.layerCount = layerCount;
-
-                    vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &l_Blit, VK_FILTER_LINEAR);
-
-                    l_Barrier(l_Level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT);
-
-                    l_MipWidth = l_NextWidth;
-                    l_MipHeight = l_NextHeight;
-                }
+    // Bindless table sizes; the 2D array covers every material texture of a large scene, cubes are only environment maps
+    static constexpr uint32_t k_BindlessTexture2DCount = 4096;
+    static constexpr uint32_t k_BindlessTextureCubeCount = 64;
 
-                l_Barrier(mipLevels - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT);
-            }
-            else
-            {
-                l_Barrier(0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT);
-            }
-        });
+    // Frames between pipeline cache saves; a save only happens when pipelines were created since the last one, so a crash loses at most this much warm-up
+    static constexpr uint64_t k_PipelineCacheSaveInterval = 600;
 
-        vmaDestroyBuffer(allocator, l_StagingBuffer, l_StagingMemory);
+    // Staging ring shared by every upload; a scene's worth of meshes and textures streams through it a frame's batch at a time
+    static constexpr uint64_t k_UploadRingSize = 64ull << 20;
 
-        return true;
-    }
+    // Starting size of the per-frame heap; doubles whenever a frame outgrows it
+    static constexpr uint64_t k_FrameHeapInitialSize = 4ull << 20;
 
     static VkDescriptorType ToVkDescriptorType(ResourceBindingType type)
     {
@@ -166,6 +38,8 @@ namespace Trinity
         {
             case ResourceBindingType::UniformBuffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
             case ResourceBindingType::StorageBuffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            case ResourceBindingType::DynamicUniformBuffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            case ResourceBindingType::DynamicStorageBuffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
             case ResourceBindingType::StorageImage: return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             case ResourceBindingType::CombinedImageSampler:
             default: return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -218,7 +92,67 @@ namespace Trinity
         return (l_Properties.optimalTilingFeatures & l_Required) == l_Required;
     }
 
-    VulkanDevice::VulkanDevice(const NativeWindowHandle& window, const std::string& applicationName, bool enableValidation) : m_Window(window), m_ApplicationName(applicationName), m_EnableValidation(enableValidation)
+    // Shared by dedicated and placed textures so both create identical images, and by the memory requirement query that sizes placements
+    static bool DescribeImage(VkPhysicalDevice physicalDevice, const TextureDescription& description, VkImageCreateInfo& outInfo)
+    {
+        VkFormat l_Format = VulkanUtilities::ToVkFormat(description.Format);
+        if (l_Format == VK_FORMAT_UNDEFINED)
+        {
+            return false;
+        }
+
+        uint32_t l_ArrayLayers = description.ArrayLayers;
+        VkImageCreateFlags l_ImageCreateFlags = 0;
+        if (description.Type == TextureType::TextureCube)
+        {
+            l_ArrayLayers = description.ArrayLayers * 6;
+            l_ImageCreateFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+        }
+
+        uint32_t l_MipLevels = description.MipLevels > 0 ? description.MipLevels : 1;
+        if (description.GenerateMips && description.InitialData != nullptr)
+        {
+            if (SupportsLinearBlit(physicalDevice, l_Format))
+            {
+                l_MipLevels = ComputeMipLevels(description.Width, description.Height);
+            }
+            else
+            {
+
+                l_MipLevels = 1;
+            }
+        }
+
+        VkImageUsageFlags l_Usage = VulkanUtilities::ToVkImageUsage(description.Usage);
+        if (description.InitialData != nullptr)
+        {
+            l_Usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        }
+
+        if (l_MipLevels > 1)
+        {
+            l_Usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
+
+        outInfo = VkImageCreateInfo{};
+        outInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        outInfo.flags = l_ImageCreateFlags;
+        outInfo.imageType = description.Type == TextureType::Texture3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+        outInfo.format = l_Format;
+        outInfo.extent = { description.Width, description.Height, description.Depth };
+        outInfo.mipLevels = l_MipLevels;
+        outInfo.arrayLayers = l_ArrayLayers;
+        outInfo.samples = static_cast<VkSampleCountFlagBits>(description.SampleCount);
+        outInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        outInfo.usage = l_Usage;
+        outInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        outInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        return true;
+    }
+
+    VulkanDevice::VulkanDevice(const NativeWindowHandle& window, const std::string& applicationName, bool enableValidation, const std::filesystem::path& pipelineCachePath) : m_Window(window),
+        m_ApplicationName(applicationName), m_EnableValidation(enableValidation), m_PipelineCachePath(pipelineCachePath)
     {
 
     }
@@ -268,6 +202,27 @@ namespace Trinity
             return false;
         }
 
+        if (!m_Uploads.Initialize(m_Device, m_Allocator.GetHandle(), m_GraphicsQueueFamily, m_GraphicsQueue, m_TransferQueueFamily, m_TransferQueue, k_UploadRingSize))
+        {
+            return false;
+        }
+
+        if (!m_DescriptorCache.Initialize(m_Device, k_DescriptorCacheCapacity, m_DeferredFrameDelay))
+        {
+            return false;
+        }
+
+        if (!m_PipelineCache.Initialize(m_Device, m_PhysicalDevice.GetProperties(), m_PipelineCachePath))
+        {
+            return false;
+        }
+
+        // Bindless is optional; without it the renderer keeps binding material textures per draw
+        if (m_BindlessSupported && !m_BindlessTable.Initialize(m_Device, k_BindlessTexture2DCount, k_BindlessTextureCubeCount, m_DeferredFrameDelay))
+        {
+            m_BindlessSupported = false;
+        }
+
         if (m_EnableValidation)
         {
             m_SetObjectName = reinterpret_cast<PFN_vkSetDebugUtilsObjectNameEXT>(vkGetDeviceProcAddr(m_Device, "vkSetDebugUtilsObjectNameEXT"));
@@ -292,12 +247,29 @@ namespace Trinity
 
             vkDeviceWaitIdle(m_Device);
 
+            for (BufferHandle it_Heap : m_RetiredFrameHeaps)
+            {
+                DestroyBuffer(it_Heap);
+            }
+            m_RetiredFrameHeaps.clear();
+
+            if (m_FrameHeap.GetBuffer().IsValid())
+            {
+                DestroyBuffer(m_FrameHeap.GetBuffer());
+                m_FrameHeap.Reset(BufferHandle{}, nullptr, 0);
+            }
+
             for (const DeferredRelease& it_Release : m_DeferredReleases)
             {
                 ReleaseNow(it_Release);
             }
             m_DeferredReleases.clear();
 
+            m_Uploads.Shutdown();
+            m_DescriptorCache.Shutdown();
+            m_BindlessTable.Shutdown();
+            m_PipelineCache.Shutdown();
+
             ReportLeaks();
 
             VmaAllocator l_Allocator = m_Allocator.GetHandle();
@@ -345,11 +317,28 @@ namespace Trinity
 
                     if (resource.OwnsImage && resource.Image != VK_NULL_HANDLE)
                     {
-                        vmaDestroyImage(l_Allocator, resource.Image, resource.Allocation);
+                        if (resource.OwnsMemory)
+                        {
+                            vmaDestroyImage(l_Allocator, resource.Image, resource.Allocation);
+                        }
+                        else
+                        {
+                            vkDestroyImage(m_Device, resource.Image, nullptr);
+                        }
                        TR_CORE_TRACE("Vulkan image destroyed");
                     }
                 });
 
+            // Placed images are gone by now, so the memory they aliased can go
+            m_Heaps.ForEachAlive([&](VulkanMemoryHeapResource& resource)
+                {
+                    if (resource.Allocation != VK_NULL_HANDLE)
+                    {
+                        vmaFreeMemory(l_Allocator, resource.Allocation);
+                       TR_CORE_TRACE("Vulkan memory heap freed");
+                    }
+                });
+
             m_Buffers.ForEachAlive([&](VulkanBufferResource& resource)
                 {
                     if (resource.Buffer != VK_NULL_HANDLE)
@@ -484,7 +473,7 @@ namespace Trinity
         {
             if (l_DeviceLocal)
             {
-                if (!UploadViaStaging(m_Allocator.GetHandle(), m_Commands, l_Resource.Buffer, description.InitialData, description.Size, 0))
+                if (!m_Uploads.UploadBuffer(l_Resource.Buffer, description.InitialData, description.Size))
                 {
 
                     vmaDestroyBuffer(m_Allocator.GetHandle(), l_Resource.Buffer, l_Resource.Allocation);
@@ -505,75 +494,80 @@ namespace Trinity
 
     TextureHandle VulkanDevice::CreateTexture(const TextureDescription& description)
     {
-        VkFormat l_Format = VulkanUtilities::ToVkFormat(description.Format);
-        if (l_Format == VK_FORMAT_UNDEFINED)
-        {
-
-            return TextureHandle();
-        }
+        return CreateTextureResource(description, nullptr, 0);
+    }
 
-        uint32_t l_ArrayLayers = description.ArrayLayers;
-        VkImageCreateFlags l_ImageCreateFlags = 0;
-        if (description.Type == TextureType::TextureCube)
+    TextureHandle VulkanDevice::CreatePlacedTexture(const TextureDescription& description, MemoryHeapHandle heap, uint64_t offset)
+    {
+        VulkanMemoryHeapResource* l_Heap = m_Heaps.Get(heap);
+        if (l_Heap == nullptr || description.InitialData != nullptr)
         {
-            l_ArrayLayers = description.ArrayLayers * 6;
-            l_ImageCreateFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+            return TextureHandle();
         }
 
-        uint32_t l_MipLevels = description.MipLevels > 0 ? description.MipLevels : 1;
-        if (description.GenerateMips && description.InitialData != nullptr)
-        {
-            if (SupportsLinearBlit(m_PhysicalDevice.GetHandle(), l_Format))
-            {
-                l_MipLevels = ComputeMipLevels(description.Width, description.Height);
-            }
-            else
-            {
-
-                l_MipLevels = 1;
-            }
-        }
+        return CreateTextureResource(description, l_Heap, offset);
+    }
 
+    TextureHandle VulkanDevice::CreateTextureResource(const TextureDescription& description, const VulkanMemoryHeapResource* heap, uint64_t offset)
+    {
         VkImageCreateInfo l_ImageCreateInfo{};
-        l_ImageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        l_ImageCreateInfo.flags = l_ImageCreateFlags;
-        l_ImageCreateInfo.imageType = description.Type == TextureType::Texture3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
-        l_ImageCreateInfo.format = l_Format;
-        l_ImageCreateInfo.extent = { description.Width, description.Height, description.Depth };
-        l_ImageCreateInfo.mipLevels = l_MipLevels;
-        l_ImageCreateInfo.arrayLayers = l_ArrayLayers;
-        l_ImageCreateInfo.samples = static_cast<VkSampleCountFlagBits>(description.SampleCount);
-        l_ImageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-
-        VkImageUsageFlags l_Usage = VulkanUtilities::ToVkImageUsage(description.Usage);
-        if (description.InitialData != nullptr)
+        if (!DescribeImage(m_PhysicalDevice.GetHandle(), description, l_ImageCreateInfo))
         {
-            l_Usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-        }
 
-        if (l_MipLevels > 1)
-        {
-            l_Usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            return TextureHandle();
         }
 
-        l_ImageCreateInfo.usage = l_Usage;
-        l_ImageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        l_ImageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-        VmaAllocationCreateInfo l_AllocationCreateInfo{};
-        l_AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        const VkFormat l_Format = l_ImageCreateInfo.format;
+        const uint32_t l_ArrayLayers = l_ImageCreateInfo.arrayLayers;
 
         VulkanTextureResource l_Resource{};
         l_Resource.Format = l_Format;
         l_Resource.Extent = l_ImageCreateInfo.extent;
+        l_Resource.ArrayLayers = l_ArrayLayers;
         l_Resource.Aspect = DetermineAspect(description.Format);
         l_Resource.OwnsImage = true;
         l_Resource.OwnsView = true;
+        l_Resource.OwnsMemory = heap == nullptr;
+        l_Resource.Cube = description.Type == TextureType::TextureCube;
+
+        auto a_DestroyImage = [&]()
+            {
+                if (l_Resource.OwnsMemory)
+                {
+                    vmaDestroyImage(m_Allocator.GetHandle(), l_Resource.Image, l_Resource.Allocation);
+                }
+                else
+                {
+                    vkDestroyImage(m_Device, l_Resource.Image, nullptr);
+                }
+            };
 
-        if (vmaCreateImage(m_Allocator.GetHandle(), &l_ImageCreateInfo, &l_AllocationCreateInfo, &l_Resource.Image, &l_Resource.Allocation, nullptr) != VK_SUCCESS)
+        if (heap != nullptr)
         {
+            // Placed images only borrow the heap's memory; several may overlap as long as their lifetimes do not
+            if (vkCreateImage(m_Device, &l_ImageCreateInfo, nullptr, &l_Resource.Image) != VK_SUCCESS)
+            {
+                return TextureHandle();
+            }
 
-            return TextureHandle();
+            if (vmaBindImageMemory2(m_Allocator.GetHandle(), heap->Allocation, offset, l_Resource.Image, nullptr) != VK_SUCCESS)
+            {
+                TR_CORE_ERROR("Failed to bind placed texture '{}' at offset {}", description.DebugName, offset);
+                vkDestroyImage(m_Device, l_Resource.Image, nullptr);
+
+                return TextureHandle();
+            }
+        }
+        else
+        {
+            VmaAllocationCreateInfo l_AllocationCreateInfo{};
+            l_AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+            if (vmaCreateImage(m_Allocator.GetHandle(), &l_ImageCreateInfo, &l_AllocationCreateInfo, &l_Resource.Image, &l_Resource.Allocation, nullptr) != VK_SUCCESS)
+            {
+
+                return TextureHandle();
+            }
         }
 
         VkImageViewCreateInfo l_ImageViewCreateInfo{};
@@ -590,22 +584,23 @@ namespace Trinity
         if (vkCreateImageView(m_Device, &l_ImageViewCreateInfo, nullptr, &l_Resource.View) != VK_SUCCESS)
         {
 
-            vmaDestroyImage(m_Allocator.GetHandle(), l_Resource.Image, l_Resource.Allocation);
+            a_DestroyImage();
 
             return TextureHandle();
         }
 
         if (description.InitialData != nullptr)
         {
-            if (!UploadTextureViaStaging(m_Allocator.GetHandle(), m_Commands, l_Resource.Image, l_Resource.Aspect, description.Width, description.Height, description.Depth, description.MipLevels, l_ArrayLayers, description.InitialData, description.InitialDataSize))
+            if (!m_Uploads.UploadTexture(l_Resource.Image, l_Resource.Aspect, description.Width, description.Height, description.Depth, description.MipLevels, l_ArrayLayers, description.InitialData, description.InitialDataSize))
             {
 
                 vkDestroyImageView(m_Device, l_Resource.View, nullptr);
-                vmaDestroyImage(m_Allocator.GetHandle(), l_Resource.Image, l_Resource.Allocation);
+                a_DestroyImage();
 
                 return TextureHandle();
             }
 
+            // Already true for every submission that can sample it, since those wait on the upload
             l_Resource.CurrentState = ResourceState::ShaderResource;
         }
 
@@ -617,6 +612,57 @@ namespace Trinity
         return m_Textures.Allocate(l_Resource);
     }
 
+    MemoryRequirements VulkanDevice::GetTextureMemoryRequirements(const TextureDescription& description)
+    {
+        MemoryRequirements l_Requirements;
+
+        VkImageCreateInfo l_ImageCreateInfo{};
+        if (!DescribeImage(m_PhysicalDevice.GetHandle(), description, l_ImageCreateInfo))
+        {
+            return l_Requirements;
+        }
+
+        VkDeviceImageMemoryRequirements l_Query{};
+        l_Query.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+        l_Query.pCreateInfo = &l_ImageCreateInfo;
+
+        VkMemoryRequirements2 l_Result{};
+        l_Result.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        vkGetDeviceImageMemoryRequirements(m_Device, &l_Query, &l_Result);
+
+        l_Requirements.Size = l_Result.memoryRequirements.size;
+        l_Requirements.Alignment = l_Result.memoryRequirements.alignment;
+        l_Requirements.TypeBits = l_Result.memoryRequirements.memoryTypeBits;
+
+        return l_Requirements;
+    }
+
+    MemoryHeapHandle VulkanDevice::CreateMemoryHeap(const MemoryHeapDescription& description)
+    {
+        VkMemoryRequirements l_Requirements{};
+        l_Requirements.size = description.Size;
+        l_Requirements.alignment = description.Alignment;
+        l_Requirements.memoryTypeBits = description.TypeBits;
+
+        VmaAllocationCreateInfo l_AllocationCreateInfo{};
+        l_AllocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        VulkanMemoryHeapResource l_Resource{};
+        l_Resource.Size = description.Size;
+        l_Resource.DebugName = description.DebugName;
+
+        if (vmaAllocateMemory(m_Allocator.GetHandle(), &l_Requirements, &l_AllocationCreateInfo, &l_Resource.Allocation, nullptr) != VK_SUCCESS)
+        {
+            TR_CORE_ERROR("Failed to allocate memory heap '{}' ({} bytes)", description.DebugName, description.Size);
+
+            return MemoryHeapHandle();
+        }
+
+        vmaSetAllocationName(m_Allocator.GetHandle(), l_Resource.Allocation, l_Resource.DebugName.c_str());
+
+        return m_Heaps.Allocate(l_Resource);
+    }
+
     SamplerHandle VulkanDevice::CreateSampler(const SamplerDescription& description)
     {
         VkSamplerCreateInfo l_SamplerCreateInfo{};
@@ -686,33 +732,55 @@ namespace Trinity
 
         SetObjectName(reinterpret_cast<uint64_t>(l_Resource.Module), VK_OBJECT_TYPE_SHADER_MODULE, l_Resource.DebugName);
 
+        std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+
         return m_Shaders.Allocate(l_Resource);
     }
 
     PipelineHandle VulkanDevice::CreatePipeline(const PipelineDescription& description)
     {
-        VulkanShaderResource* l_Vertex = m_Shaders.Get(description.VertexShader);
-        VulkanShaderResource* l_Fragment = m_Shaders.Get(description.FragmentShader);
-        if (l_Vertex == nullptr || l_Fragment == nullptr)
+        // Copied out under the lock: another thread creating a shader may grow the pool while this pipeline compiles
+        VulkanShaderResource l_Vertex;
+        VulkanShaderResource l_Fragment;
         {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
 
-            return PipelineHandle();
+            VulkanShaderResource* l_VertexResource = m_Shaders.Get(description.VertexShader);
+            VulkanShaderResource* l_FragmentResource = m_Shaders.Get(description.FragmentShader);
+            if (l_VertexResource == nullptr || l_FragmentResource == nullptr)
+            {
+                return PipelineHandle();
+            }
+
+            l_Vertex = *l_VertexResource;
+            l_Fragment = *l_FragmentResource;
         }
 
         std::array<VkPipelineShaderStageCreateInfo, 2> l_Stages{};
         l_Stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         l_Stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-        l_Stages[0].module = l_Vertex->Module;
-        l_Stages[0].pName = l_Vertex->EntryPoint.c_str();
+        l_Stages[0].module = l_Vertex.Module;
+        l_Stages[0].pName = l_Vertex.EntryPoint.c_str();
         l_Stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         l_Stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-        l_Stages[1].module = l_Fragment->Module;
-        l_Stages[1].pName = l_Fragment->EntryPoint.c_str();
+        l_Stages[1].module = l_Fragment.Module;
+        l_Stages[1].pName = l_Fragment.EntryPoint.c_str();
+
+        std::vector<VkVertexInputBindingDescription> l_VertexInputBindingDescriptions;
+        l_VertexInputBindingDescriptions.reserve(description.Vertex.StreamStrides.size() + 1);
 
         VkVertexInputBindingDescription l_Binding{};
         l_Binding.binding = 0;
         l_Binding.stride = description.Vertex.Stride;
         l_Binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        l_VertexInputBindingDescriptions.push_back(l_Binding);
+
+        for (size_t l_Stream = 0; l_Stream < description.Vertex.StreamStrides.size(); ++l_Stream)
+        {
+            l_Binding.binding = static_cast<uint32_t>(l_Stream + 1);
+            l_Binding.stride = description.Vertex.StreamStrides[l_Stream];
+            l_VertexInputBindingDescriptions.push_back(l_Binding);
+        }
 
         std::vector<VkVertexInputAttributeDescription> l_VertexInputAttributeDescriptions;
         l_VertexInputAttributeDescriptions.reserve(description.Vertex.Attributes.size());
@@ -720,7 +788,7 @@ namespace Trinity
         {
             VkVertexInputAttributeDescription l_VertexInputAttributeDescription{};
             l_VertexInputAttributeDescription.location = l_Attribute.Location;
-            l_VertexInputAttributeDescription.binding = 0;
+            l_VertexInputAttributeDescription.binding = l_Attribute.Binding;
             l_VertexInputAttributeDescription.format = VulkanUtilities::ToVkFormat(l_Attribute.Format);
             l_VertexInputAttributeDescription.offset = l_Attribute.Offset;
             l_VertexInputAttributeDescriptions.push_back(l_VertexInputAttributeDescription);
@@ -730,8 +798,8 @@ namespace Trinity
 
         VkPipelineVertexInputStateCreateInfo l_PipelineVertexInputStateCreateInfo{};
         l_PipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        l_PipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount = l_HasVertexInput ? 1 : 0;
-        l_PipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = l_HasVertexInput ? &l_Binding : nullptr;
+        l_PipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount = l_HasVertexInput ? static_cast<uint32_t>(l_VertexInputBindingDescriptions.size()) : 0;
+        l_PipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = l_HasVertexInput ? l_VertexInputBindingDescriptions.data() : nullptr;
         l_PipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(l_VertexInputAttributeDescriptions.size());
         l_PipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions = l_VertexInputAttributeDescriptions.empty() ? nullptr : l_VertexInputAttributeDescriptions.data();
 
@@ -764,11 +832,11 @@ namespace Trinity
         VkPipelineColorBlendAttachmentState l_PipelineColorBlendAttachmentState{};
         l_PipelineColorBlendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
         l_PipelineColorBlendAttachmentState.blendEnable = description.Blend.Enabled ? VK_TRUE : VK_FALSE;
-        l_PipelineColorBlendAttachmentState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-        l_PipelineColorBlendAttachmentState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        l_PipelineColorBlendAttachmentState.srcColorBlendFactor = description.Blend.Additive ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_SRC_ALPHA;
+        l_PipelineColorBlendAttachmentState.dstColorBlendFactor = description.Blend.Additive ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
         l_PipelineColorBlendAttachmentState.colorBlendOp = VK_BLEND_OP_ADD;
         l_PipelineColorBlendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-        l_PipelineColorBlendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        l_PipelineColorBlendAttachmentState.dstAlphaBlendFactor = description.Blend.Additive ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ZERO;
         l_PipelineColorBlendAttachmentState.alphaBlendOp = VK_BLEND_OP_ADD;
 
         std::vector<VkPipelineColorBlendAttachmentState> l_BlendAttachments(description.ColorFormats.size(), l_PipelineColorBlendAttachmentState);
@@ -799,6 +867,7 @@ namespace Trinity
             const uint32_t l_SetCount = l_MaxSet + 1;
             for (uint32_t l_Set = 0; l_Set < l_SetCount; ++l_Set)
             {
+                bool l_IsBindlessSet = false;
                 std::vector<VkDescriptorSetLayoutBinding> l_LayoutBindings;
                 for (const ResourceBinding& it_Binding : description.Bindings)
                 {
@@ -807,6 +876,13 @@ namespace Trinity
                         continue;
                     }
 
+                    if (it_Binding.Type == ResourceBindingType::BindlessTextures)
+                    {
+                        l_IsBindlessSet = true;
+
+                        break;
+                    }
+
                     VkDescriptorSetLayoutBinding l_LayoutBinding{};
                     l_LayoutBinding.binding = it_Binding.Binding;
                     l_LayoutBinding.descriptorType = ToVkDescriptorType(it_Binding.Type);
@@ -821,7 +897,17 @@ namespace Trinity
                 l_LayoutInfo.pBindings = l_LayoutBindings.empty() ? nullptr : l_LayoutBindings.data();
 
                 VkDescriptorSetLayout l_SetLayout = VK_NULL_HANDLE;
-                if (vkCreateDescriptorSetLayout(m_Device, &l_LayoutInfo, nullptr, &l_SetLayout) != VK_SUCCESS)
+                if (l_IsBindlessSet)
+                {
+                    // A private copy of the table's layout keeps pipeline teardown uniform; identical layouts are compatible with the global set
+                    l_SetLayout = m_BindlessTable.CreateCompatibleLayout();
+                }
+                else if (vkCreateDescriptorSetLayout(m_Device, &l_LayoutInfo, nullptr, &l_SetLayout) != VK_SUCCESS)
+                {
+                    l_SetLayout = VK_NULL_HANDLE;
+                }
+
+                if (l_SetLayout == VK_NULL_HANDLE)
                 {
 
                     for (VkDescriptorSetLayout it_Layout : l_SetLayouts)
@@ -889,7 +975,8 @@ namespace Trinity
         l_GraphicsPipelineCreateInfo.pDynamicState = &l_PipelineDynamicStateCreateInfo;
         l_GraphicsPipelineCreateInfo.layout = l_Resource.Layout;
 
-        if (vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &l_GraphicsPipelineCreateInfo, nullptr, &l_Resource.Pipeline) != VK_SUCCESS)
+        Timer l_Timer;
+        if (vkCreateGraphicsPipelines(m_Device, m_PipelineCache.GetHandle(), 1, &l_GraphicsPipelineCreateInfo, nullptr, &l_Resource.Pipeline) != VK_SUCCESS)
         {
 
             vkDestroyPipelineLayout(m_Device, l_Resource.Layout, nullptr);
@@ -901,11 +988,15 @@ namespace Trinity
             return PipelineHandle();
         }
 
+        const float l_Milliseconds = l_Timer.ElapsedMilliseconds();
         l_Resource.DebugName = description.DebugName;
 
         SetObjectName(reinterpret_cast<uint64_t>(l_Resource.Pipeline), VK_OBJECT_TYPE_PIPELINE, l_Resource.DebugName);
         SetObjectName(reinterpret_cast<uint64_t>(l_Resource.Layout), VK_OBJECT_TYPE_PIPELINE_LAYOUT, l_Resource.DebugName);
 
+        std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+        m_PipelineCache.RecordCreation(l_Milliseconds);
+
         return m_Pipelines.Allocate(l_Resource);
     }
 
@@ -914,8 +1005,11 @@ namespace Trinity
         VulkanBufferResource l_Resource{};
         if (m_Buffers.Free(handle, l_Resource) && l_Resource.Buffer != VK_NULL_HANDLE)
         {
+            m_DescriptorCache.InvalidateBuffer(handle);
+
             DeferredRelease l_Release{};
             l_Release.Frame = m_FrameCounter;
+            l_Release.UploadValue = m_Uploads.GetRecordedValue();
             l_Release.Type = DeferredRelease::Kind::Buffer;
             l_Release.Buffer = l_Resource.Buffer;
             l_Release.Allocation = l_Resource.Allocation;
@@ -932,6 +1026,13 @@ namespace Trinity
             return;
         }
 
+        m_DescriptorCache.InvalidateTexture(handle);
+
+        if (l_Resource.BindlessIndex != k_InvalidBindlessIndex)
+        {
+            m_BindlessTable.Release(l_Resource.BindlessIndex, l_Resource.Cube);
+        }
+
         const bool l_HasNative = (l_Resource.OwnsView && l_Resource.View != VK_NULL_HANDLE) || (l_Resource.OwnsImage && l_Resource.Image != VK_NULL_HANDLE);
         if (!l_HasNative)
         {
@@ -940,12 +1041,14 @@ namespace Trinity
 
         DeferredRelease l_Release{};
         l_Release.Frame = m_FrameCounter;
+        l_Release.UploadValue = m_Uploads.GetRecordedValue();
         l_Release.Type = DeferredRelease::Kind::Texture;
         l_Release.Image = l_Resource.Image;
         l_Release.View = l_Resource.View;
         l_Release.Allocation = l_Resource.Allocation;
         l_Release.OwnsImage = l_Resource.OwnsImage;
         l_Release.OwnsView = l_Resource.OwnsView;
+        l_Release.OwnsMemory = l_Resource.OwnsMemory;
 
         for (const VulkanSubresourceView& it_View : l_Resource.SubViews)
         {
@@ -1003,6 +1106,8 @@ namespace Trinity
         VulkanSamplerResource l_Resource{};
         if (m_Samplers.Free(handle, l_Resource) && l_Resource.Sampler != VK_NULL_HANDLE)
         {
+            m_DescriptorCache.InvalidateSampler(handle);
+
             DeferredRelease l_Release{};
             l_Release.Frame = m_FrameCounter;
             l_Release.Type = DeferredRelease::Kind::Sampler;
@@ -1012,10 +1117,31 @@ namespace Trinity
         }
     }
 
+    void VulkanDevice::DestroyMemoryHeap(MemoryHeapHandle handle)
+    {
+        VulkanMemoryHeapResource l_Resource{};
+        if (m_Heaps.Free(handle, l_Resource) && l_Resource.Allocation != VK_NULL_HANDLE)
+        {
+            // Queued after any placed textures destroyed earlier this frame, so the memory outlives every image bound to it
+            DeferredRelease l_Release{};
+            l_Release.Frame = m_FrameCounter;
+            l_Release.Type = DeferredRelease::Kind::MemoryHeap;
+            l_Release.Allocation = l_Resource.Allocation;
+
+            m_DeferredReleases.push_back(l_Release);
+        }
+    }
+
     void VulkanDevice::DestroyShader(ShaderHandle handle)
     {
         VulkanShaderResource l_Resource{};
-        if (m_Shaders.Free(handle, l_Resource) && l_Resource.Module != VK_NULL_HANDLE)
+        bool l_Freed = false;
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+            l_Freed = m_Shaders.Free(handle, l_Resource);
+        }
+
+        if (l_Freed && l_Resource.Module != VK_NULL_HANDLE)
         {
             DeferredRelease l_Release{};
             l_Release.Frame = m_FrameCounter;
@@ -1029,8 +1155,16 @@ namespace Trinity
     void VulkanDevice::DestroyPipeline(PipelineHandle handle)
     {
         VulkanPipelineResource l_Resource{};
-        if (m_Pipelines.Free(handle, l_Resource))
+        bool l_Freed = false;
+        {
+            std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+            l_Freed = m_Pipelines.Free(handle, l_Resource);
+        }
+
+        if (l_Freed)
         {
+            m_DescriptorCache.InvalidateLayouts(l_Resource.SetLayouts);
+
             DeferredRelease l_Release{};
             l_Release.Frame = m_FrameCounter;
             l_Release.Type = DeferredRelease::Kind::Pipeline;
@@ -1069,7 +1203,21 @@ namespace Trinity
 
                 if (release.OwnsImage && release.Image != VK_NULL_HANDLE)
                 {
-                    vmaDestroyImage(m_Allocator.GetHandle(), release.Image, release.Allocation);
+                    if (release.OwnsMemory)
+                    {
+                        vmaDestroyImage(m_Allocator.GetHandle(), release.Image, release.Allocation);
+                    }
+                    else
+                    {
+                        vkDestroyImage(m_Device, release.Image, nullptr);
+                    }
+                }
+                break;
+
+            case DeferredRelease::Kind::MemoryHeap:
+                if (release.Allocation != VK_NULL_HANDLE)
+                {
+                    vmaFreeMemory(m_Allocator.GetHandle(), release.Allocation);
                 }
                 break;
 
@@ -1106,19 +1254,90 @@ namespace Trinity
         }
     }
 
+    uint32_t VulkanDevice::RegisterBindlessTexture(TextureHandle texture, SamplerHandle sampler)
+    {
+        if (!m_BindlessTable.IsInitialized())
+        {
+            return k_InvalidBindlessIndex;
+        }
+
+        VulkanTextureResource* l_Texture = m_Textures.Get(texture);
+        VulkanSamplerResource* l_Sampler = m_Samplers.Get(sampler);
+        if (l_Texture == nullptr || l_Sampler == nullptr)
+        {
+            return k_InvalidBindlessIndex;
+        }
+
+        if (l_Texture->BindlessIndex != k_InvalidBindlessIndex)
+        {
+            return l_Texture->BindlessIndex;
+        }
+
+        uint32_t l_Index = m_BindlessTable.Register(l_Texture->View, l_Sampler->Sampler, l_Texture->Cube);
+        if (l_Index == UINT32_MAX)
+        {
+            return k_InvalidBindlessIndex;
+        }
+
+        l_Texture->BindlessIndex = l_Index;
+
+        return l_Index;
+    }
+
     void VulkanDevice::CollectGarbage()
     {
         ++m_FrameCounter;
 
+        // The frame that outgrew these heaps is closed, so nothing will name them again; the deferred release keeps the memory until the GPU is done with it
+        for (BufferHandle it_Heap : m_RetiredFrameHeaps)
+        {
+            DestroyBuffer(it_Heap);
+        }
+        m_RetiredFrameHeaps.clear();
+
+        // Runs before the deferred releases so cached sets are dropped while the layouts and resources they reference still exist
+        m_DescriptorCache.Collect(m_FrameCounter);
+        m_BindlessTable.Collect(m_FrameCounter);
+        m_Uploads.Retire();
+
+        // Frames that far back have finished on the GPU, the same guarantee the deferred releases below rely on
+        m_FrameHeap.BeginFrame(m_FrameCounter, m_FrameCounter >= m_DeferredFrameDelay ? m_FrameCounter - m_DeferredFrameDelay : 0);
+
+        if (m_FrameCounter % k_PipelineCacheSaveInterval == 0)
+        {
+            std::vector<uint8_t> l_PipelineCacheFile;
+            {
+                std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+                m_PipelineCache.Snapshot(l_PipelineCacheFile);
+            }
+
+            // Pipeline creation on other threads only waits for the copy above, never for the disk
+            if (!l_PipelineCacheFile.empty() && m_PipelineCache.WriteFile(l_PipelineCacheFile))
+            {
+                std::lock_guard<std::mutex> l_Lock(m_PipelineMutex);
+                m_PipelineCache.RecordSave(l_PipelineCacheFile);
+            }
+        }
+
+        const uint64_t l_UploadsCompleted = m_Uploads.GetCompletedValue();
+
         size_t l_Write = 0;
         for (size_t l_Read = 0; l_Read < m_DeferredReleases.size(); ++l_Read)
         {
-            if (m_DeferredReleases[l_Read].Frame + m_DeferredFrameDelay <= m_FrameCounter)
+            const DeferredRelease& l_Release = m_DeferredReleases[l_Read];
+            const bool l_FramesRetired = l_Release.Frame + m_DeferredFrameDelay <= m_FrameCounter;
+            if (l_FramesRetired && l_Release.UploadValue <= l_UploadsCompleted)
             {
-                ReleaseNow(m_DeferredReleases[l_Read]);
+                ReleaseNow(l_Release);
             }
             else
             {
+                // Destroyed while a copy into it still sat in a batch no frame has submitted since; send it so the release can complete
+                if (l_FramesRetired && l_Release.UploadValue > m_Uploads.GetSubmittedValue())
+                {
+                    m_Uploads.Submit();
+                }
+
                 if (l_Write != l_Read)
                 {
                     m_DeferredReleases[l_Write] = m_DeferredReleases[l_Read];
@@ -1144,10 +1363,75 @@ namespace Trinity
         }
         else
         {
-            UploadViaStaging(m_Allocator.GetHandle(), m_Commands, l_Resource->Buffer, data, size, offset);
+            m_Uploads.UpdateBuffer(l_Resource->Buffer, offset, data, size);
         }
     }
 
+    FrameAllocation VulkanDevice::AllocateFrameMemory(uint64_t size, BufferUsage usage)
+    {
+        const VkPhysicalDeviceLimits& l_Limits = m_PhysicalDevice.GetProperties().limits;
+
+        // Dynamic offsets must honour the descriptor alignment; vertex and index data only need their element size, which 16 covers
+        uint64_t l_Alignment = 16;
+        if ((static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Uniform)) != 0)
+        {
+            l_Alignment = std::max<uint64_t>(l_Alignment, l_Limits.minUniformBufferOffsetAlignment);
+        }
+
+        if ((static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Storage)) != 0)
+        {
+            l_Alignment = std::max<uint64_t>(l_Alignment, l_Limits.minStorageBufferOffsetAlignment);
+        }
+
+        FrameAllocation l_Allocation = m_FrameHeap.Allocate(size, l_Alignment);
+        if (!l_Allocation.IsValid() && size != 0 && GrowFrameHeap(size + l_Alignment))
+        {
+            l_Allocation = m_FrameHeap.Allocate(size, l_Alignment);
+        }
+
+        return l_Allocation;
+    }
+
+    bool VulkanDevice::GrowFrameHeap(uint64_t minimumSize)
+    {
+        uint64_t l_Capacity = std::max(m_FrameHeap.GetCapacity() * 2, k_FrameHeapInitialSize);
+        while (l_Capacity < minimumSize)
+        {
+            l_Capacity *= 2;
+        }
+
+        BufferDescription l_Description;
+        l_Description.Size = l_Capacity;
+        l_Description.Usage = BufferUsage::Uniform | BufferUsage::Storage | BufferUsage::Vertex | BufferUsage::Index;
+        l_Description.Memory = MemoryUsage::CpuToGpu;
+        l_Description.DebugName = "FrameHeap";
+
+        BufferHandle l_Buffer = CreateBuffer(l_Description);
+        VulkanBufferResource* l_Resource = m_Buffers.Get(l_Buffer);
+        if (l_Resource == nullptr || l_Resource->Mapped == nullptr)
+        {
+            TR_CORE_ERROR("Frame heap allocation of {} MB failed", l_Capacity >> 20);
+
+            if (l_Resource != nullptr)
+            {
+                DestroyBuffer(l_Buffer);
+            }
+
+            return false;
+        }
+
+        // Earlier frames, including the one being recorded, may still read the old heap, and the frame's earlier allocations still name it
+        if (m_FrameHeap.GetBuffer().IsValid())
+        {
+            m_RetiredFrameHeaps.push_back(m_FrameHeap.GetBuffer());
+            TR_CORE_INFO("Frame heap grown to {} MB", l_Capacity >> 20);
+        }
+
+        m_FrameHeap.Reset(l_Buffer, l_Resource->Mapped, l_Capacity);
+
+        return true;
+    }
+
     std::unique_ptr<Swapchain> VulkanDevice::CreateSwapchain(const SwapchainDescription& description)
     {
         auto l_Swapchain = std::make_unique<VulkanSwapchain>(*this, description);
@@ -1172,7 +1456,8 @@ namespace Trinity
         l_CommandBufferSubmitInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
         l_CommandBufferSubmitInfo.commandBuffer = l_CommandList.GetHandle();
 
-        VkSemaphoreSubmitInfo l_WaitInfo{};
+        std::array<VkSemaphoreSubmitInfo, 2> l_WaitInfos{};
+        uint32_t l_WaitCount = 0;
         VkSemaphoreSubmitInfo l_SignalInfo{};
         VkFence l_Fence = VK_NULL_HANDLE;
 
@@ -1186,6 +1471,7 @@ namespace Trinity
             VulkanFrameSync l_Sync = m_ActiveSwapchain->GetCurrentSync();
             l_Fence = l_Sync.Fence;
 
+            VkSemaphoreSubmitInfo& l_WaitInfo = l_WaitInfos[l_WaitCount++];
             l_WaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
             l_WaitInfo.semaphore = l_Sync.Wait;
             l_WaitInfo.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
@@ -1194,12 +1480,24 @@ namespace Trinity
             l_SignalInfo.semaphore = l_Sync.Signal;
             l_SignalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT;
 
-            l_SubmitInfo.waitSemaphoreInfoCount = 1;
-            l_SubmitInfo.pWaitSemaphoreInfos = &l_WaitInfo;
             l_SubmitInfo.signalSemaphoreInfoCount = 1;
             l_SubmitInfo.pSignalSemaphoreInfos = &l_SignalInfo;
         }
 
+        // Everything uploaded while this frame was recorded goes out as one batch the frame waits on, on the GPU only
+        const uint64_t l_UploadValue = m_Uploads.Flush();
+        if (l_UploadValue != 0)
+        {
+            VkSemaphoreSubmitInfo& l_WaitInfo = l_WaitInfos[l_WaitCount++];
+            l_WaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            l_WaitInfo.semaphore = m_Uploads.GetTimeline();
+            l_WaitInfo.value = l_UploadValue;
+            l_WaitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        }
+
+        l_SubmitInfo.waitSemaphoreInfoCount = l_WaitCount;
+        l_SubmitInfo.pWaitSemaphoreInfos = l_WaitInfos.data();
+
         vkQueueSubmit2(m_GraphicsQueue, 1, &l_SubmitInfo, l_Fence);
     }
 
@@ -1238,6 +1536,7 @@ namespace Trinity
         vkGetPhysicalDeviceFeatures(m_PhysicalDevice.GetHandle(), &l_Features);
         m_Capabilities.SupportsAnisotropy = l_Features.samplerAnisotropy == VK_TRUE;
         m_Capabilities.SupportsRayTracing = false;
+        m_Capabilities.SupportsBindless = m_BindlessSupported && m_BindlessTable.IsInitialized();
 
         VkPhysicalDeviceMemoryProperties l_Memory{};
         vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice.GetHandle(), &l_Memory);
@@ -1259,8 +1558,9 @@ namespace Trinity
         const QueueFamilyIndices& l_Families = m_PhysicalDevice.GetQueueFamilies();
         m_GraphicsQueueFamily = l_Families.Graphics.value();
         m_PresentQueueFamily = l_Families.Present.value();
+        m_TransferQueueFamily = l_Families.Transfer.value_or(m_GraphicsQueueFamily);
 
-        std::set<uint32_t> l_UniqueFamilies = { m_GraphicsQueueFamily, m_PresentQueueFamily };
+        std::set<uint32_t> l_UniqueFamilies = { m_GraphicsQueueFamily, m_PresentQueueFamily, m_TransferQueueFamily };
 
         float l_Priority = 1.0f;
         std::vector<VkDeviceQueueCreateInfo> l_QueueInfos;
@@ -1291,6 +1591,39 @@ namespace Trinity
         l_Vulkan12Features.timelineSemaphore = VK_TRUE;
         l_Vulkan12Features.pNext = &l_Vulkan11Features;
 
+        // Descriptor indexing is enabled only when every feature the bindless table relies on is present
+        VkPhysicalDeviceVulkan12Features l_Supported12{};
+        l_Supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 l_SupportedFeatures{};
+        l_SupportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        l_SupportedFeatures.pNext = &l_Supported12;
+        vkGetPhysicalDeviceFeatures2(m_PhysicalDevice.GetHandle(), &l_SupportedFeatures);
+
+        VkPhysicalDeviceVulkan12Properties l_Properties12{};
+        l_Properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 l_Properties{};
+        l_Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        l_Properties.pNext = &l_Properties12;
+        vkGetPhysicalDeviceProperties2(m_PhysicalDevice.GetHandle(), &l_Properties);
+
+        m_BindlessSupported = l_Supported12.descriptorIndexing == VK_TRUE && l_Supported12.runtimeDescriptorArray == VK_TRUE
+            && l_Supported12.descriptorBindingPartiallyBound == VK_TRUE && l_Supported12.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE
+            && l_Supported12.descriptorBindingUpdateUnusedWhilePending == VK_TRUE && l_Supported12.shaderSampledImageArrayNonUniformIndexing == VK_TRUE
+            && l_Properties12.maxDescriptorSetUpdateAfterBindSampledImages >= k_BindlessTexture2DCount + k_BindlessTextureCubeCount
+            && l_Properties12.maxPerStageDescriptorUpdateAfterBindSampledImages >= k_BindlessTexture2DCount + k_BindlessTextureCubeCount;
+
+        if (m_BindlessSupported)
+        {
+            l_Vulkan12Features.descriptorIndexing = VK_TRUE;
+            l_Vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+            l_Vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+            l_Vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            l_Vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            l_Vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        }
+
         VkPhysicalDeviceFeatures2 l_Features{};
         l_Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
         l_Features.pNext = &l_Vulkan12Features;
@@ -1314,6 +1647,7 @@ namespace Trinity
 
         vkGetDeviceQueue(m_Device, m_GraphicsQueueFamily, 0, &m_GraphicsQueue);
         vkGetDeviceQueue(m_Device, m_PresentQueueFamily, 0, &m_PresentQueue);
+        vkGetDeviceQueue(m_Device, m_TransferQueueFamily, 0, &m_TransferQueue);
 
         return true;
     }
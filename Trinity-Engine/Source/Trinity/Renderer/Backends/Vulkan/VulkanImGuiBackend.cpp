@@ -127,6 +127,7 @@ namespace Trinity
         }
 
         vkDeviceWaitIdle(m_Device.GetHandle());
+        CollectTextures(true);
         ImGui_ImplVulkan_Shutdown();
 
         if (m_Sampler != VK_NULL_HANDLE)
@@ -148,6 +149,7 @@ namespace Trinity
 
     void VulkanImGuiBackend::NewFrame()
     {
+        CollectTextures(false);
         ImGui_ImplVulkan_NewFrame();
     }
 
@@ -188,6 +190,24 @@ namespace Trinity
             return;
         }
 
-        ImGui_ImplVulkan_RemoveTexture(reinterpret_cast<VkDescriptorSet>(a_TextureId));
+        m_PendingRemovals.emplace_back(reinterpret_cast<VkDescriptorSet>(a_TextureId), m_Device.GetFrameCounter());
+    }
+
+    void VulkanImGuiBackend::CollectTextures(bool all)
+    {
+        size_t l_Write = 0;
+        for (size_t l_Read = 0; l_Read < m_PendingRemovals.size(); ++l_Read)
+        {
+            if (all || m_PendingRemovals[l_Read].second + m_Device.GetDeferredFrameDelay() <= m_Device.GetFrameCounter())
+            {
+                ImGui_ImplVulkan_RemoveTexture(m_PendingRemovals[l_Read].first);
+            }
+            else
+            {
+                m_PendingRemovals[l_Write++] = m_PendingRemovals[l_Read];
+            }
+        }
+
+        m_PendingRemovals.resize(l_Write);
     }
 }
\ No newline at end of file
@@ -140,6 +140,17 @@ namespace Trinity
             }
         }
 
+        for (uint32_t l_Index = 0; l_Index < l_FamilyCount; l_Index++)
+        {
+            const VkQueueFlags l_Flags = l_Families[l_Index].queueFlags;
+            if ((l_Flags & VK_QUEUE_TRANSFER_BIT) != 0 && (l_Flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0)
+            {
+                l_Indices.Transfer = l_Index;
+
+                break;
+            }
+        }
+
         return l_Indices;
     }
 
@@ -0,0 +1,267 @@
+#include <Trinity/Renderer/Backends/Vulkan/VulkanPipelineCache.h>
+
+#include <cstring>
+#include <optional>
+#include <system_error>
+
+#include <Trinity/Core/FileManagement.h>
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    static constexpr uint32_t k_PipelineCacheMagic = 0x43505254;  // "TRPC"
+    static constexpr uint32_t k_PipelineCacheVersion = 1;
+
+    // Prefixed to the driver's blob. The driver validates its own header too, but not the driver version or the data's integrity
+    struct PipelineCacheFileHeader
+    {
+        uint32_t Magic = k_PipelineCacheMagic;
+        uint32_t Version = k_PipelineCacheVersion;
+        uint32_t VendorID = 0;
+        uint32_t DeviceID = 0;
+        uint32_t DriverVersion = 0;
+        uint8_t CacheUUID[VK_UUID_SIZE]{};
+        uint32_t Reserved = 0;
+        uint64_t DataSize = 0;
+        uint64_t DataHash = 0;
+    };
+
+    static uint64_t HashFnv1a(const uint8_t* data, size_t size)
+    {
+        uint64_t l_Hash = 1469598103934665603ull;
+        for (size_t l_Index = 0; l_Index < size; ++l_Index)
+        {
+            l_Hash ^= data[l_Index];
+            l_Hash *= 1099511628211ull;
+        }
+
+        return l_Hash;
+    }
+
+    VulkanPipelineCache::~VulkanPipelineCache()
+    {
+        Shutdown();
+    }
+
+    bool VulkanPipelineCache::Initialize(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::filesystem::path& path)
+    {
+        m_Device = device;
+        m_Properties = properties;
+        m_Path = path;
+        m_Dirty = false;
+        m_Stats = PipelineCacheStats{};
+
+        std::vector<uint8_t> l_Data;
+        if (!m_Path.empty() && !Load(l_Data))
+        {
+            l_Data.clear();
+        }
+
+        VkPipelineCacheCreateInfo l_CreateInfo{};
+        l_CreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        l_CreateInfo.initialDataSize = l_Data.size();
+        l_CreateInfo.pInitialData = l_Data.empty() ? nullptr : l_Data.data();
+
+        if (vkCreatePipelineCache(m_Device, &l_CreateInfo, nullptr, &m_Cache) != VK_SUCCESS)
+        {
+            // The blob passed validation yet the driver still refused it; an empty cache is always accepted
+            l_Data.clear();
+            l_CreateInfo.initialDataSize = 0;
+            l_CreateInfo.pInitialData = nullptr;
+
+            if (vkCreatePipelineCache(m_Device, &l_CreateInfo, nullptr, &m_Cache) != VK_SUCCESS)
+            {
+                TR_CORE_ERROR("Failed to create the Vulkan pipeline cache");
+                m_Cache = VK_NULL_HANDLE;
+
+                return false;
+            }
+        }
+
+        m_Stats.LoadedBytes = l_Data.size();
+        if (l_Data.empty())
+        {
+            TR_CORE_INFO("Pipeline cache: cold start");
+        }
+        else
+        {
+            TR_CORE_INFO("Pipeline cache: loaded {} KB from {}", l_Data.size() / 1024, m_Path.string());
+        }
+
+        return true;
+    }
+
+    void VulkanPipelineCache::Shutdown()
+    {
+        if (m_Cache == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        Save();
+
+        vkDestroyPipelineCache(m_Device, m_Cache, nullptr);
+        m_Cache = VK_NULL_HANDLE;
+    }
+
+    void VulkanPipelineCache::RecordCreation(double milliseconds)
+    {
+        ++m_Stats.PipelinesCreated;
+        m_Stats.CreationMilliseconds += milliseconds;
+        m_Dirty = true;
+    }
+
+    bool VulkanPipelineCache::Save()
+    {
+        std::vector<uint8_t> l_File;
+        if (!Snapshot(l_File))
+        {
+            return false;
+        }
+
+        if (l_File.empty())
+        {
+            return true;
+        }
+
+        if (!WriteFile(l_File))
+        {
+            return false;
+        }
+
+        RecordSave(l_File);
+
+        return true;
+    }
+
+    bool VulkanPipelineCache::Snapshot(std::vector<uint8_t>& outFile)
+    {
+        outFile.clear();
+
+        if (m_Cache == VK_NULL_HANDLE || m_Path.empty() || !m_Dirty)
+        {
+            return true;
+        }
+
+        m_Dirty = false;
+
+        size_t l_Size = 0;
+        if (vkGetPipelineCacheData(m_Device, m_Cache, &l_Size, nullptr) != VK_SUCCESS || l_Size == 0)
+        {
+            return false;
+        }
+
+        outFile.resize(sizeof(PipelineCacheFileHeader) + l_Size);
+        if (vkGetPipelineCacheData(m_Device, m_Cache, &l_Size, outFile.data() + sizeof(PipelineCacheFileHeader)) != VK_SUCCESS)
+        {
+            outFile.clear();
+
+            return false;
+        }
+
+        outFile.resize(sizeof(PipelineCacheFileHeader) + l_Size);
+
+        PipelineCacheFileHeader l_Header;
+        l_Header.VendorID = m_Properties.vendorID;
+        l_Header.DeviceID = m_Properties.deviceID;
+        l_Header.DriverVersion = m_Properties.driverVersion;
+        std::memcpy(l_Header.CacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE);
+        l_Header.DataSize = l_Size;
+        l_Header.DataHash = HashFnv1a(outFile.data() + sizeof(PipelineCacheFileHeader), l_Size);
+        std::memcpy(outFile.data(), &l_Header, sizeof(l_Header));
+
+        return true;
+    }
+
+    bool VulkanPipelineCache::WriteFile(const std::vector<uint8_t>& file) const
+    {
+        // Written beside the target and renamed over it, so a crash mid-write never leaves a torn cache behind
+        FileManagement::EnsureDirectory(m_Path.parent_path());
+
+        std::filesystem::path l_Temporary = m_Path;
+        l_Temporary += ".tmp";
+        if (!FileManagement::WriteBinary(l_Temporary, file))
+        {
+            TR_CORE_WARN("Pipeline cache: could not write {}", l_Temporary.string());
+
+            return false;
+        }
+
+        std::error_code l_Error;
+        std::filesystem::rename(l_Temporary, m_Path, l_Error);
+        if (l_Error)
+        {
+            TR_CORE_WARN("Pipeline cache: could not replace {}: {}", m_Path.string(), l_Error.message());
+            std::filesystem::remove(l_Temporary, l_Error);
+
+            return false;
+        }
+
+        return true;
+    }
+
+    void VulkanPipelineCache::RecordSave(const std::vector<uint8_t>& file)
+    {
+        m_Stats.SavedBytes = file.size() - sizeof(PipelineCacheFileHeader);
+    }
+
+    bool VulkanPipelineCache::Load(std::vector<uint8_t>& outData) const
+    {
+        if (!FileManagement::Exists(m_Path))
+        {
+            return false;
+        }
+
+        std::optional<std::vector<uint8_t>> l_File = FileManagement::ReadBinary(m_Path);
+        if (!l_File || l_File->size() < sizeof(PipelineCacheFileHeader))
+        {
+            return false;
+        }
+
+        PipelineCacheFileHeader l_Header;
+        std::memcpy(&l_Header, l_File->data(), sizeof(l_Header));
+
+        const uint8_t* l_Data = l_File->data() + sizeof(PipelineCacheFileHeader);
+        const size_t l_Size = l_File->size() - sizeof(PipelineCacheFileHeader);
+
+        if (l_Header.Magic != k_PipelineCacheMagic || l_Header.Version != k_PipelineCacheVersion || l_Header.DataSize != l_Size)
+        {
+            TR_CORE_WARN("Pipeline cache: {} is not a valid cache file, discarding", m_Path.string());
+
+            return false;
+        }
+
+        if (l_Header.VendorID != m_Properties.vendorID || l_Header.DeviceID != m_Properties.deviceID || l_Header.DriverVersion != m_Properties.driverVersion
+            || std::memcmp(l_Header.CacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            TR_CORE_INFO("Pipeline cache: written by another device or driver, discarding");
+
+            return false;
+        }
+
+        if (HashFnv1a(l_Data, l_Size) != l_Header.DataHash)
+        {
+            TR_CORE_WARN("Pipeline cache: {} is corrupt, discarding", m_Path.string());
+
+            return false;
+        }
+
+        // The driver's own header must agree as well before the blob is handed over
+        VkPipelineCacheHeaderVersionOne l_DriverHeader{};
+        if (l_Size < sizeof(l_DriverHeader))
+        {
+            return false;
+        }
+
+        std::memcpy(&l_DriverHeader, l_Data, sizeof(l_DriverHeader));
+        if (l_DriverHeader.headerSize < sizeof(l_DriverHeader) || l_DriverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || l_DriverHeader.vendorID != m_Properties.vendorID
+            || l_DriverHeader.deviceID != m_Properties.deviceID || std::memcmp(l_DriverHeader.pipelineCacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            return false;
+        }
+
+        outData.assign(l_Data, l_Data + l_Size);
+
+        return true;
+    }
+}
\ No newline at end of file
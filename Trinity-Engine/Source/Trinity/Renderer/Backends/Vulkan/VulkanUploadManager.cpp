@@ -0,0 +1,622 @@
+#include <Trinity/Renderer/Backends/Vulkan/VulkanUploadManager.h>
+
+#include <cstring>
+
+#include <Trinity/Core/Log.h>
+
+namespace Trinity
+{
+    // Satisfies the buffer offset rules of every format the engine uploads, including block-compressed ones
+    static constexpr uint64_t k_StagingAlignment = 16;
+
+    static void ImageBarrier(VkCommandBuffer commandBuffer, VkImage image, VkImageAspectFlags aspect, uint32_t layerCount, uint32_t baseLevel, uint32_t levelCount, VkImageLayout oldLayout,
+        VkImageLayout newLayout, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess, VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess,
+        uint32_t srcFamily = VK_QUEUE_FAMILY_IGNORED, uint32_t dstFamily = VK_QUEUE_FAMILY_IGNORED)
+    {
+        VkImageMemoryBarrier2 l_ImageBarrier{};
+        l_ImageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        l_ImageBarrier.srcStageMask = srcStage;
+        l_ImageBarrier.srcAccessMask = srcAccess;
+        l_ImageBarrier.dstStageMask = dstStage;
+        l_ImageBarrier.dstAccessMask = dstAccess;
+        l_ImageBarrier.oldLayout = oldLayout;
+        l_ImageBarrier.newLayout = newLayout;
+        l_ImageBarrier.srcQueueFamilyIndex = srcFamily;
+        l_ImageBarrier.dstQueueFamilyIndex = dstFamily;
+        l_ImageBarrier.image = image;
+        l_ImageBarrier.subresourceRange.aspectMask = aspect;
+        l_ImageBarrier.subresourceRange.baseMipLevel = baseLevel;
+        l_ImageBarrier.subresourceRange.levelCount = levelCount;
+        l_ImageBarrier.subresourceRange.baseArrayLayer = 0;
+        l_ImageBarrier.subresourceRange.layerCount = layerCount;
+
+        VkDependencyInfo l_Dependency{};
+        l_Dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        l_Dependency.imageMemoryBarrierCount = 1;
+        l_Dependency.pImageMemoryBarriers = &l_ImageBarrier;
+        vkCmdPipelineBarrier2(commandBuffer, &l_Dependency);
+    }
+
+    static void BufferBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer, uint64_t size, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess, VkPipelineStageFlags2 dstStage,
+        VkAccessFlags2 dstAccess, uint32_t srcFamily, uint32_t dstFamily)
+    {
+        VkBufferMemoryBarrier2 l_BufferBarrier{};
+        l_BufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        l_BufferBarrier.srcStageMask = srcStage;
+        l_BufferBarrier.srcAccessMask = srcAccess;
+        l_BufferBarrier.dstStageMask = dstStage;
+        l_BufferBarrier.dstAccessMask = dstAccess;
+        l_BufferBarrier.srcQueueFamilyIndex = srcFamily;
+        l_BufferBarrier.dstQueueFamilyIndex = dstFamily;
+        l_BufferBarrier.buffer = buffer;
+        l_BufferBarrier.offset = 0;
+        l_BufferBarrier.size = size;
+
+        VkDependencyInfo l_Dependency{};
+        l_Dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        l_Dependency.bufferMemoryBarrierCount = 1;
+        l_Dependency.pBufferMemoryBarriers = &l_BufferBarrier;
+        vkCmdPipelineBarrier2(commandBuffer, &l_Dependency);
+    }
+
+    VulkanUploadManager::~VulkanUploadManager()
+    {
+        Shutdown();
+    }
+
+    bool VulkanUploadManager::Initialize(VkDevice device, VmaAllocator allocator, uint32_t graphicsFamily, VkQueue graphicsQueue, uint32_t transferFamily, VkQueue transferQueue, uint64_t ringSize)
+    {
+        m_Device = device;
+        m_Allocator = allocator;
+        m_GraphicsFamily = graphicsFamily;
+        m_GraphicsQueue = graphicsQueue;
+        m_TransferFamily = transferFamily;
+        m_TransferQueue = transferQueue;
+        m_RingSize = ringSize;
+        m_Stats = VulkanUploadStats{};
+
+        VkCommandPoolCreateInfo l_PoolInfo{};
+        l_PoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        l_PoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        l_PoolInfo.queueFamilyIndex = m_GraphicsFamily;
+        if (vkCreateCommandPool(m_Device, &l_PoolInfo, nullptr, &m_GraphicsPool) != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        if (HasTransferQueue())
+        {
+            l_PoolInfo.queueFamilyIndex = m_TransferFamily;
+            if (vkCreateCommandPool(m_Device, &l_PoolInfo, nullptr, &m_TransferPool) != VK_SUCCESS)
+            {
+                return false;
+            }
+        }
+
+        VkSemaphoreTypeCreateInfo l_TimelineInfo{};
+        l_TimelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        l_TimelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        l_TimelineInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo l_SemaphoreInfo{};
+        l_SemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        l_SemaphoreInfo.pNext = &l_TimelineInfo;
+        if (vkCreateSemaphore(m_Device, &l_SemaphoreInfo, nullptr, &m_Timeline) != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        VkBufferCreateInfo l_RingInfo{};
+        l_RingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        l_RingInfo.size = m_RingSize;
+        l_RingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        l_RingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo l_RingAllocation{};
+        l_RingAllocation.usage = VMA_MEMORY_USAGE_AUTO;
+        l_RingAllocation.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo l_RingResult{};
+        if (vmaCreateBuffer(m_Allocator, &l_RingInfo, &l_RingAllocation, &m_Ring.Buffer, &m_Ring.Allocation, &l_RingResult) != VK_SUCCESS)
+        {
+            TR_CORE_ERROR("Failed to create the {} MB upload ring", m_RingSize >> 20);
+
+            return false;
+        }
+
+        m_RingData = static_cast<uint8_t*>(l_RingResult.pMappedData);
+        m_RingHead = 0;
+        m_RingUsed = 0;
+
+        TR_CORE_INFO("Upload ring: {} MB, {}", m_RingSize >> 20, HasTransferQueue() ? "dedicated transfer queue" : "graphics queue");
+
+        return true;
+    }
+
+    void VulkanUploadManager::Shutdown()
+    {
+        if (m_Device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        if (m_Recording)
+        {
+            // Never submitted; whatever it was filling is being destroyed too
+            vkEndCommandBuffer(m_Open.Graphics);
+            if (m_Open.Transfer != VK_NULL_HANDLE)
+            {
+                vkEndCommandBuffer(m_Open.Transfer);
+            }
+
+            m_Open.Value = 0;
+            m_InFlight.push_back(std::move(m_Open));
+            m_Open = Batch{};
+            m_Recording = false;
+        }
+
+        if (m_LastValue != 0)
+        {
+            WaitForValue(m_LastValue);
+        }
+
+        Retire();
+
+        // Command buffers go with their pools
+        m_Recycled.clear();
+
+        if (m_Ring.Buffer != VK_NULL_HANDLE)
+        {
+            vmaDestroyBuffer(m_Allocator, m_Ring.Buffer, m_Ring.Allocation);
+            m_Ring = StagingBuffer{};
+            m_RingData = nullptr;
+        }
+
+        if (m_Timeline != VK_NULL_HANDLE)
+        {
+            vkDestroySemaphore(m_Device, m_Timeline, nullptr);
+            m_Timeline = VK_NULL_HANDLE;
+        }
+
+        if (m_TransferPool != VK_NULL_HANDLE)
+        {
+            vkDestroyCommandPool(m_Device, m_TransferPool, nullptr);
+            m_TransferPool = VK_NULL_HANDLE;
+        }
+
+        if (m_GraphicsPool != VK_NULL_HANDLE)
+        {
+            vkDestroyCommandPool(m_Device, m_GraphicsPool, nullptr);
+            m_GraphicsPool = VK_NULL_HANDLE;
+        }
+
+        m_LastValue = 0;
+        m_PendingWait = 0;
+        m_Device = VK_NULL_HANDLE;
+    }
+
+    bool VulkanUploadManager::UploadBuffer(VkBuffer destination, const void* data, uint64_t size)
+    {
+        VkBuffer l_Source = VK_NULL_HANDLE;
+        uint64_t l_Offset = 0;
+        if (!BeginBatch() || !Stage(data, size, l_Source, l_Offset))
+        {
+            return false;
+        }
+
+        VkBufferCopy l_Region{};
+        l_Region.srcOffset = l_Offset;
+        l_Region.dstOffset = 0;
+        l_Region.size = size;
+
+        if (HasTransferQueue())
+        {
+            vkCmdCopyBuffer(m_Open.Transfer, l_Source, destination, 1, &l_Region);
+
+            // Release on the transfer queue, acquire on the graphics queue; the semaphore between the two submissions orders them
+            BufferBarrier(m_Open.Transfer, destination, VK_WHOLE_SIZE, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_NONE, 0, m_TransferFamily, m_GraphicsFamily);
+            BufferBarrier(m_Open.Graphics, destination, VK_WHOLE_SIZE, VK_PIPELINE_STAGE_2_NONE, 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT, m_TransferFamily,
+                m_GraphicsFamily);
+        }
+        else
+        {
+            // The semaphore signal at the end of the batch makes the copy visible to the frame that waits on it
+            vkCmdCopyBuffer(m_Open.Graphics, l_Source, destination, 1, &l_Region);
+        }
+
+        m_Stats.Bytes += size;
+
+        return true;
+    }
+
+    bool VulkanUploadManager::UpdateBuffer(VkBuffer destination, uint64_t offset, const void* data, uint64_t size)
+    {
+        VkBuffer l_Source = VK_NULL_HANDLE;
+        uint64_t l_Offset = 0;
+        if (!BeginBatch() || !Stage(data, size, l_Source, l_Offset))
+        {
+            return false;
+        }
+
+        // The first update of a batch waits for every command submitted before it on the graphics queue, so frames still in flight finish reading (or writing) the
+        // old contents before the copy lands; later updates of the batch only have to land in order behind the copies ahead of them
+        VkMemoryBarrier2 l_MemoryBarrier{};
+        l_MemoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        l_MemoryBarrier.srcStageMask = m_Open.GraphicsCopies == 0 ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_2_COPY_BIT;
+        l_MemoryBarrier.srcAccessMask = m_Open.GraphicsCopies == 0 ? VK_ACCESS_2_MEMORY_WRITE_BIT : VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        l_MemoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        l_MemoryBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+        VkDependencyInfo l_Dependency{};
+        l_Dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        l_Dependency.memoryBarrierCount = 1;
+        l_Dependency.pMemoryBarriers = &l_MemoryBarrier;
+        vkCmdPipelineBarrier2(m_Open.Graphics, &l_Dependency);
+
+        VkBufferCopy l_Region{};
+        l_Region.srcOffset = l_Offset;
+        l_Region.dstOffset = offset;
+        l_Region.size = size;
+        vkCmdCopyBuffer(m_Open.Graphics, l_Source, destination, 1, &l_Region);
+
+        ++m_Open.GraphicsCopies;
+        m_Stats.Bytes += size;
+
+        return true;
+    }
+
+    bool VulkanUploadManager::UploadTexture(VkImage image, VkImageAspectFlags aspect, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, uint32_t layerCount, const void* data,
+        uint64_t size)
+    {
+        VkBuffer l_Source = VK_NULL_HANDLE;
+        uint64_t l_Offset = 0;
+        if (!BeginBatch() || !Stage(data, size, l_Source, l_Offset))
+        {
+            return false;
+        }
+
+        VkCommandBuffer l_CopyCommands = HasTransferQueue() ? m_Open.Transfer : m_Open.Graphics;
+        VkCommandBuffer l_Commands = m_Open.Graphics;
+
+        ImageBarrier(l_CopyCommands, image, aspect, layerCount, 0, mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_NONE, 0,
+            VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+        VkBufferImageCopy l_Region{};
+        l_Region.bufferOffset = l_Offset;
+        l_Region.bufferRowLength = 0;
+        l_Region.bufferImageHeight = 0;
+        l_Region.imageSubresource.aspectMask = aspect;
+        l_Region.imageSubresource.mipLevel = 0;
+        l_Region.imageSubresource.baseArrayLayer = 0;
+        l_Region.imageSubresource.layerCount = layerCount;
+        l_Region.imageOffset = { 0, 0, 0 };
+        l_Region.imageExtent = { width, height, depth };
+        vkCmdCopyBufferToImage(l_CopyCommands, l_Source, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &l_Region);
+
+        if (HasTransferQueue())
+        {
+            // The layout stays TRANSFER_DST across the ownership transfer; blits need the graphics queue anyway
+            ImageBarrier(m_Open.Transfer, image, aspect, layerCount, 0, mipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+                VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_NONE, 0, m_TransferFamily, m_GraphicsFamily);
+            ImageBarrier(m_Open.Graphics, image, aspect, layerCount, 0, mipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_2_NONE, 0,
+                VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT, m_TransferFamily, m_GraphicsFamily);
+        }
+
+        if (mipLevels > 1)
+        {
+            int32_t l_MipWidth = static_cast<int32_t>(width);
+            int32_t l_MipHeight = static_cast<int32_t>(height);
+
+            for (uint32_t l_Level = 1; l_Level < mipLevels; ++l_Level)
+            {
+                ImageBarrier(l_Commands, image, aspect, layerCount, l_Level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT,
+                    VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+
+                const int32_t l_NextWidth = l_MipWidth > 1 ? l_MipWidth / 2 : 1;
+                const int32_t l_NextHeight = l_MipHeight > 1 ? l_MipHeight / 2 : 1;
+
+                VkImageBlit l_Blit{};
+                l_Blit.srcOffsets[0] = { 0, 0, 0 };
+                l_Blit.srcOffsets[1] = { l_MipWidth, l_MipHeight, 1 };
+                l_Blit.srcSubresource.aspectMask = aspect;
+                l_Blit.srcSubresource.mipLevel = l_Level - 1;
+                l_Blit.srcSubresource.baseArrayLayer = 0;
+                l_Blit.srcSubresource.layerCount = layerCount;
+                l_Blit.dstOffsets[0] = { 0, 0, 0 };
+                l_Blit.dstOffsets[1] = { l_NextWidth, l_NextHeight, 1 };
+                l_Blit.dstSubresource.aspectMask = aspect;
+                l_Blit.dstSubresource.mipLevel = l_Level;
+                l_Blit.dstSubresource.baseArrayLayer = 0;
+                l_Blit.dstSubresource.layerCount = layerCount;
+
+                vkCmdBlitImage(l_Commands, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &l_Blit, VK_FILTER_LINEAR);
+
+                ImageBarrier(l_Commands, image, aspect, layerCount, l_Level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_BLIT_BIT,
+                    VK_ACCESS_2_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT);
+
+                l_MipWidth = l_NextWidth;
+                l_MipHeight = l_NextHeight;
+            }
+
+            ImageBarrier(l_Commands, image, aspect, layerCount, mipLevels - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT);
+        }
+        else
+        {
+            ImageBarrier(l_Commands, image, aspect, layerCount, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_COPY_BIT,
+                VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT);
+        }
+
+        m_Stats.Bytes += size;
+
+        return true;
+    }
+
+    uint64_t VulkanUploadManager::Flush()
+    {
+        Submit();
+
+        const uint64_t l_Wait = m_PendingWait;
+        m_PendingWait = 0;
+
+        return l_Wait;
+    }
+
+    uint64_t VulkanUploadManager::GetCompletedValue() const
+    {
+        uint64_t l_Completed = 0;
+        if (m_Timeline != VK_NULL_HANDLE)
+        {
+            vkGetSemaphoreCounterValue(m_Device, m_Timeline, &l_Completed);
+        }
+
+        return l_Completed;
+    }
+
+    void VulkanUploadManager::Retire()
+    {
+        if (m_InFlight.empty())
+        {
+            return;
+        }
+
+        const uint64_t l_Completed = GetCompletedValue();
+
+        while (!m_InFlight.empty() && m_InFlight.front().Value <= l_Completed)
+        {
+            Batch& l_Batch = m_InFlight.front();
+            for (const StagingBuffer& it_Staging : l_Batch.Dedicated)
+            {
+                vmaDestroyBuffer(m_Allocator, it_Staging.Buffer, it_Staging.Allocation);
+            }
+
+            m_RingUsed -= l_Batch.RingBytes;
+
+            l_Batch.Dedicated.clear();
+            l_Batch.RingBytes = 0;
+            l_Batch.GraphicsCopies = 0;
+            l_Batch.Value = 0;
+            m_Recycled.push_back(std::move(l_Batch));
+            m_InFlight.pop_front();
+        }
+    }
+
+    bool VulkanUploadManager::Stage(const void* data, uint64_t size, VkBuffer& outBuffer, uint64_t& outOffset)
+    {
+        // Anything that would hog a large share of the ring gets its own buffer instead of draining the ring for everything queued behind it
+        if (size <= m_RingSize / 4)
+        {
+            for (;;)
+            {
+                // Nothing staged anywhere: restart at the front so the upload does not straddle the wrap
+                if (m_RingUsed == 0)
+                {
+                    m_RingHead = 0;
+                }
+
+                uint64_t l_Offset = (m_RingHead + k_StagingAlignment - 1) & ~(k_StagingAlignment - 1);
+                uint64_t l_Consumed = l_Offset - m_RingHead + size;
+                if (l_Offset + size > m_RingSize)
+                {
+                    // The tail end is too short; skip it and count it against this batch so it is reclaimed with the rest
+                    l_Offset = 0;
+                    l_Consumed = m_RingSize - m_RingHead + size;
+                }
+
+                if (m_RingUsed + l_Consumed <= m_RingSize)
+                {
+                    std::memcpy(m_RingData + l_Offset, data, static_cast<size_t>(size));
+
+                    m_RingHead = l_Offset + size;
+                    m_RingUsed += l_Consumed;
+                    m_Open.RingBytes += l_Consumed;
+
+                    outBuffer = m_Ring.Buffer;
+                    outOffset = l_Offset;
+
+                    return true;
+                }
+
+                // Full: the open batch may hold most of the ring itself, so it goes out first, then the oldest batch is waited on
+                if (m_Open.RingBytes > 0)
+                {
+                    Submit();
+                    if (!BeginBatch())
+                    {
+                        return false;
+                    }
+                }
+
+                if (m_InFlight.empty())
+                {
+                    break;
+                }
+
+                ++m_Stats.Stalls;
+                WaitForValue(m_InFlight.front().Value);
+                Retire();
+            }
+        }
+
+        VkBufferCreateInfo l_StagingInfo{};
+        l_StagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        l_StagingInfo.size = size;
+        l_StagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        l_StagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo l_StagingAllocation{};
+        l_StagingAllocation.usage = VMA_MEMORY_USAGE_AUTO;
+        l_StagingAllocation.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        StagingBuffer l_Staging;
+        VmaAllocationInfo l_StagingResult{};
+        if (vmaCreateBuffer(m_Allocator, &l_StagingInfo, &l_StagingAllocation, &l_Staging.Buffer, &l_Staging.Allocation, &l_StagingResult) != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        std::memcpy(l_StagingResult.pMappedData, data, static_cast<size_t>(size));
+        m_Open.Dedicated.push_back(l_Staging);
+        ++m_Stats.DedicatedStaging;
+
+        outBuffer = l_Staging.Buffer;
+        outOffset = 0;
+
+        return true;
+    }
+
+    bool VulkanUploadManager::BeginBatch()
+    {
+        if (m_Recording)
+        {
+            return true;
+        }
+
+        if (m_Device == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        if (!m_Recycled.empty())
+        {
+            m_Open = std::move(m_Recycled.back());
+            m_Recycled.pop_back();
+        }
+
+        VkCommandBufferAllocateInfo l_AllocateInfo{};
+        l_AllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        l_AllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        l_AllocateInfo.commandBufferCount = 1;
+
+        if (m_Open.Graphics == VK_NULL_HANDLE)
+        {
+            l_AllocateInfo.commandPool = m_GraphicsPool;
+            if (vkAllocateCommandBuffers(m_Device, &l_AllocateInfo, &m_Open.Graphics) != VK_SUCCESS)
+            {
+                return false;
+            }
+        }
+
+        if (HasTransferQueue() && m_Open.Transfer == VK_NULL_HANDLE)
+        {
+            l_AllocateInfo.commandPool = m_TransferPool;
+            if (vkAllocateCommandBuffers(m_Device, &l_AllocateInfo, &m_Open.Transfer) != VK_SUCCESS)
+            {
+                return false;
+            }
+        }
+
+        // Recycled buffers are reset implicitly by beginning them again
+        VkCommandBufferBeginInfo l_BeginInfo{};
+        l_BeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        l_BeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkBeginCommandBuffer(m_Open.Graphics, &l_BeginInfo);
+        if (m_Open.Transfer != VK_NULL_HANDLE)
+        {
+            vkBeginCommandBuffer(m_Open.Transfer, &l_BeginInfo);
+        }
+
+        m_Recording = true;
+
+        return true;
+    }
+
+    void VulkanUploadManager::Submit()
+    {
+        if (!m_Recording)
+        {
+            return;
+        }
+
+        vkEndCommandBuffer(m_Open.Graphics);
+
+        // Two values per batch: the odd one marks the copies on the transfer queue, the even one the batch as visible to the graphics queue
+        m_Open.Value = m_LastValue + 2;
+
+        VkCommandBufferSubmitInfo l_CommandBufferInfo{};
+        l_CommandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+
+        VkSemaphoreSubmitInfo l_WaitInfo{};
+        l_WaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        l_WaitInfo.semaphore = m_Timeline;
+        l_WaitInfo.value = m_Open.Value - 1;
+        l_WaitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkSemaphoreSubmitInfo l_SignalInfo{};
+        l_SignalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        l_SignalInfo.semaphore = m_Timeline;
+        l_SignalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkSubmitInfo2 l_SubmitInfo{};
+        l_SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        l_SubmitInfo.commandBufferInfoCount = 1;
+        l_SubmitInfo.pCommandBufferInfos = &l_CommandBufferInfo;
+        l_SubmitInfo.signalSemaphoreInfoCount = 1;
+        l_SubmitInfo.pSignalSemaphoreInfos = &l_SignalInfo;
+
+        if (HasTransferQueue())
+        {
+            vkEndCommandBuffer(m_Open.Transfer);
+
+            // Both queues signal the same timeline, so the copies wait for the previous batch's graphics half; otherwise the odd value could be signalled before the
+            // even one below it, and Retire would reclaim ring space that batch's graphics copies are still reading
+            VkSemaphoreSubmitInfo l_PreviousInfo = l_WaitInfo;
+            l_PreviousInfo.value = m_LastValue;
+            if (m_LastValue != 0)
+            {
+                l_SubmitInfo.waitSemaphoreInfoCount = 1;
+                l_SubmitInfo.pWaitSemaphoreInfos = &l_PreviousInfo;
+            }
+
+            l_CommandBufferInfo.commandBuffer = m_Open.Transfer;
+            l_SignalInfo.value = m_Open.Value - 1;
+            vkQueueSubmit2(m_TransferQueue, 1, &l_SubmitInfo, VK_NULL_HANDLE);
+
+            l_SubmitInfo.waitSemaphoreInfoCount = 1;
+            l_SubmitInfo.pWaitSemaphoreInfos = &l_WaitInfo;
+        }
+
+        l_CommandBufferInfo.commandBuffer = m_Open.Graphics;
+        l_SignalInfo.value = m_Open.Value;
+        vkQueueSubmit2(m_GraphicsQueue, 1, &l_SubmitInfo, VK_NULL_HANDLE);
+
+        m_LastValue = m_Open.Value;
+        m_PendingWait = m_LastValue;
+        ++m_Stats.Batches;
+
+        m_InFlight.push_back(std::move(m_Open));
+        m_Open = Batch{};
+        m_Recording = false;
+    }
+
+    void VulkanUploadManager::WaitForValue(uint64_t value)
+    {
+        VkSemaphoreWaitInfo l_WaitInfo{};
+        l_WaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        l_WaitInfo.semaphoreCount = 1;
+        l_WaitInfo.pSemaphores = &m_Timeline;
+        l_WaitInfo.pValues = &value;
+        vkWaitSemaphores(m_Device, &l_WaitInfo, UINT64_MAX);
+    }
+}
\ No newline at end of file
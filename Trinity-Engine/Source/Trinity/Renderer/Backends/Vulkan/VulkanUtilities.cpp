@@ -17,6 +17,8 @@ namespace Trinity
             case Format::R16_SFLOAT: return VK_FORMAT_R16_SFLOAT;
             case Format::RG16_SFLOAT: return VK_FORMAT_R16G16_SFLOAT;
             case Format::RGBA16_SFLOAT: return VK_FORMAT_R16G16B16A16_SFLOAT;
+            case Format::RG16_SNORM: return VK_FORMAT_R16G16_SNORM;
+            case Format::RGBA16_UNORM: return VK_FORMAT_R16G16B16A16_UNORM;
             case Format::R32_SFLOAT: return VK_FORMAT_R32_SFLOAT;
             case Format::RG32_SFLOAT: return VK_FORMAT_R32G32_SFLOAT;
             case Format::RGB32_SFLOAT: return VK_FORMAT_R32G32B32_SFLOAT;
@@ -173,6 +175,11 @@ namespace Trinity
             }
         }
 
+        VkIndexType ToVkIndexType(IndexType type)
+        {
+            return type == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        }
+
         VkShaderStageFlags ToVkShaderStages(ShaderStage stages)
         {
             VkShaderStageFlags l_Flags = 0;
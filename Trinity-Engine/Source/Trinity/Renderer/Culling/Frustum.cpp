@@ -0,0 +1,210 @@
+#include <Trinity/Renderer/Culling/Frustum.h>
+
+#include <bit>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRINITY_CULL_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRINITY_CULL_SSE 1
+#endif
+
+namespace Trinity
+{
+    namespace
+    {
+        uint32_t CullRange(const Frustum& frustum, const SphereBatch& spheres, uint8_t* visibility, size_t begin, size_t end)
+        {
+            uint32_t l_Visible = 0;
+            for (size_t l_Index = begin; l_Index < end; ++l_Index)
+            {
+                bool l_Inside = true;
+                for (const glm::vec4& it_Plane : frustum.Planes)
+                {
+                    float l_Distance = it_Plane.x * spheres.CenterX[l_Index] + it_Plane.y * spheres.CenterY[l_Index] + it_Plane.z * spheres.CenterZ[l_Index] + it_Plane.w;
+                    if (l_Distance < -spheres.Radius[l_Index])
+                    {
+                        l_Inside = false;
+
+                        break;
+                    }
+                }
+
+                visibility[l_Index] = l_Inside ? 1 : 0;
+                l_Visible += l_Inside ? 1 : 0;
+            }
+
+            return l_Visible;
+        }
+    }
+
+    Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+    {
+        // Gribb-Hartmann on the rows of the matrix; with zero-to-one depth the near plane is the third row alone
+        glm::vec4 l_Row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+        glm::vec4 l_Row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+        glm::vec4 l_Row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+        glm::vec4 l_Row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+        Frustum l_Frustum;
+        l_Frustum.Planes[0] = l_Row3 + l_Row0;
+        l_Frustum.Planes[1] = l_Row3 - l_Row0;
+        l_Frustum.Planes[2] = l_Row3 + l_Row1;
+        l_Frustum.Planes[3] = l_Row3 - l_Row1;
+        l_Frustum.Planes[4] = l_Row2;
+        l_Frustum.Planes[5] = l_Row3 - l_Row2;
+
+        for (glm::vec4& it_Plane : l_Frustum.Planes)
+        {
+            float l_Length = glm::length(glm::vec3(it_Plane));
+            if (l_Length > 0.0f)
+            {
+                it_Plane /= l_Length;
+            }
+        }
+
+        return l_Frustum;
+    }
+
+    bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+    {
+        for (const glm::vec4& it_Plane : Planes)
+        {
+            if (glm::dot(glm::vec3(it_Plane), center) + it_Plane.w < -radius)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void SphereBatch::Clear()
+    {
+        CenterX.clear();
+        CenterY.clear();
+        CenterZ.clear();
+        Radius.clear();
+    }
+
+    void SphereBatch::Reserve(size_t count)
+    {
+        CenterX.reserve(count);
+        CenterY.reserve(count);
+        CenterZ.reserve(count);
+        Radius.reserve(count);
+    }
+
+    void SphereBatch::Push(const glm::vec4& sphere)
+    {
+        CenterX.push_back(sphere.x);
+        CenterY.push_back(sphere.y);
+        CenterZ.push_back(sphere.z);
+        Radius.push_back(sphere.w);
+    }
+
+    uint32_t FrustumCuller::CullScalar(const Frustum& frustum, const SphereBatch& spheres, std::vector<uint8_t>& visibility)
+    {
+        visibility.resize(spheres.Size());
+
+        return CullRange(frustum, spheres, visibility.data(), 0, spheres.Size());
+    }
+
+    uint32_t FrustumCuller::Cull(const Frustum& frustum, const SphereBatch& spheres, std::vector<uint8_t>& visibility)
+    {
+        const size_t l_Count = spheres.Size();
+        visibility.resize(l_Count);
+
+        uint8_t* l_Visibility = visibility.data();
+        uint32_t l_Visible = 0;
+        size_t l_Index = 0;
+
+#if defined(TRINITY_CULL_AVX)
+        __m256 l_PlaneX[6];
+        __m256 l_PlaneY[6];
+        __m256 l_PlaneZ[6];
+        __m256 l_PlaneW[6];
+        for (int l_Plane = 0; l_Plane < 6; ++l_Plane)
+        {
+            l_PlaneX[l_Plane] = _mm256_set1_ps(frustum.Planes[l_Plane].x);
+            l_PlaneY[l_Plane] = _mm256_set1_ps(frustum.Planes[l_Plane].y);
+            l_PlaneZ[l_Plane] = _mm256_set1_ps(frustum.Planes[l_Plane].z);
+            l_PlaneW[l_Plane] = _mm256_set1_ps(frustum.Planes[l_Plane].w);
+        }
+
+        const __m256 l_Zero = _mm256_setzero_ps();
+        for (; l_Index + 8 <= l_Count; l_Index += 8)
+        {
+            __m256 l_X = _mm256_loadu_ps(spheres.CenterX.data() + l_Index);
+            __m256 l_Y = _mm256_loadu_ps(spheres.CenterY.data() + l_Index);
+            __m256 l_Z = _mm256_loadu_ps(spheres.CenterZ.data() + l_Index);
+            __m256 l_NegativeRadius = _mm256_sub_ps(l_Zero, _mm256_loadu_ps(spheres.Radius.data() + l_Index));
+
+            __m256 l_Inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int l_Plane = 0; l_Plane < 6; ++l_Plane)
+            {
+                __m256 l_Distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(l_PlaneX[l_Plane], l_X), _mm256_mul_ps(l_PlaneY[l_Plane], l_Y)), _mm256_add_ps(_mm256_mul_ps(l_PlaneZ[l_Plane], l_Z), l_PlaneW[l_Plane]));
+                l_Inside = _mm256_and_ps(l_Inside, _mm256_cmp_ps(l_Distance, l_NegativeRadius, _CMP_GE_OQ));
+            }
+
+            int l_Mask = _mm256_movemask_ps(l_Inside);
+            for (int l_Lane = 0; l_Lane < 8; ++l_Lane)
+            {
+                l_Visibility[l_Index + l_Lane] = static_cast<uint8_t>((l_Mask >> l_Lane) & 1);
+            }
+
+            l_Visible += static_cast<uint32_t>(std::popcount(static_cast<unsigned int>(l_Mask)));
+        }
+#elif defined(TRINITY_CULL_SSE)
+        __m128 l_PlaneX[6];
+        __m128 l_PlaneY[6];
+        __m128 l_PlaneZ[6];
+        __m128 l_PlaneW[6];
+        for (int l_Plane = 0; l_Plane < 6; ++l_Plane)
+        {
+            l_PlaneX[l_Plane] = _mm_set1_ps(frustum.Planes[l_Plane].x);
+            l_PlaneY[l_Plane] = _mm_set1_ps(frustum.Planes[l_Plane].y);
+            l_PlaneZ[l_Plane] = _mm_set1_ps(frustum.Planes[l_Plane].z);
+            l_PlaneW[l_Plane] = _mm_set1_ps(frustum.Planes[l_Plane].w);
+        }
+
+        const __m128 l_Zero = _mm_setzero_ps();
+        for (; l_Index + 4 <= l_Count; l_Index += 4)
+        {
+            __m128 l_X = _mm_loadu_ps(spheres.CenterX.data() + l_Index);
+            __m128 l_Y = _mm_loadu_ps(spheres.CenterY.data() + l_Index);
+            __m128 l_Z = _mm_loadu_ps(spheres.CenterZ.data() + l_Index);
+            __m128 l_NegativeRadius = _mm_sub_ps(l_Zero, _mm_loadu_ps(spheres.Radius.data() + l_Index));
+
+            __m128 l_Inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int l_Plane = 0; l_Plane < 6; ++l_Plane)
+            {
+                __m128 l_Distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l_PlaneX[l_Plane], l_X), _mm_mul_ps(l_PlaneY[l_Plane], l_Y)), _mm_add_ps(_mm_mul_ps(l_PlaneZ[l_Plane], l_Z), l_PlaneW[l_Plane]));
+                l_Inside = _mm_and_ps(l_Inside, _mm_cmpge_ps(l_Distance, l_NegativeRadius));
+            }
+
+            int l_Mask = _mm_movemask_ps(l_Inside);
+            l_Visibility[l_Index + 0] = static_cast<uint8_t>(l_Mask & 1);
+            l_Visibility[l_Index + 1] = static_cast<uint8_t>((l_Mask >> 1) & 1);
+            l_Visibility[l_Index + 2] = static_cast<uint8_t>((l_Mask >> 2) & 1);
+            l_Visibility[l_Index + 3] = static_cast<uint8_t>((l_Mask >> 3) & 1);
+
+            l_Visible += static_cast<uint32_t>(std::popcount(static_cast<unsigned int>(l_Mask)));
+        }
+#endif
+
+        return l_Visible + CullRange(frustum, spheres, l_Visibility, l_Index, l_Count);
+    }
+
+    const char* FrustumCuller::GetInstructionSet()
+    {
+#if defined(TRINITY_CULL_AVX)
+        return "AVX";
+#elif defined(TRINITY_CULL_SSE)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+}
\ No newline at end of file
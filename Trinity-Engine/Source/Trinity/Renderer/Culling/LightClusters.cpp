@@ -0,0 +1,323 @@
+#include <Trinity/Renderer/Culling/LightClusters.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <Trinity/Core/JobSystem.h>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint32_t k_BoundsGrain = 64;
+
+        // View-space point on the line through the given NDC xy at view depth `depth`. The line runs between the near and far plane unprojections, which makes
+        // it the camera ray for perspective projections and a depth-parallel line for orthographic ones
+        glm::vec3 UnprojectAtDepth(const glm::mat4& inverseProjection, float ndcX, float ndcY, float depth)
+        {
+            glm::vec4 l_Near = inverseProjection * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+            glm::vec4 l_Far = inverseProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+            glm::vec3 l_NearPoint = glm::vec3(l_Near) / l_Near.w;
+            glm::vec3 l_FarPoint = glm::vec3(l_Far) / l_Far.w;
+
+            float l_Span = l_NearPoint.z - l_FarPoint.z;
+            float l_T = std::abs(l_Span) > 1e-6f ? (depth + l_NearPoint.z) / l_Span : 0.0f;
+
+            return glm::vec3(glm::mix(glm::vec2(l_NearPoint), glm::vec2(l_FarPoint), l_T), -depth);
+        }
+
+        uint32_t NdcToTile(float ndc, uint32_t tiles)
+        {
+            float l_Tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+
+            return static_cast<uint32_t>(std::clamp(l_Tile, 0.0f, static_cast<float>(tiles - 1)));
+        }
+
+        // Tile rows count down from the top of the target, as SV_Position does through the flipped viewport, while NDC y points up. Every row lookup goes
+        // through here so the grid and the shader agree on which way is up
+        float RowToNdcY(uint32_t row, uint32_t rows)
+        {
+            return 1.0f - 2.0f * static_cast<float>(row) / static_cast<float>(rows);
+        }
+
+        uint32_t NdcYToRow(float ndcY, uint32_t rows)
+        {
+            return NdcToTile(-ndcY, rows);
+        }
+    }
+
+    void LightClusterBinner::Configure(uint32_t tilesX, uint32_t tilesY, uint32_t slices)
+    {
+        m_TilesX = std::max(tilesX, 1u);
+        m_TilesY = std::max(tilesY, 1u);
+        m_Slices = std::max(slices, 1u);
+
+        // Forces the grid to rebuild on the next Build
+        m_GridNear = 0.0f;
+        m_GridFar = 0.0f;
+    }
+
+    void LightClusterBinner::Build(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane, const std::vector<GpuLight>& lights, JobSystem* jobSystem)
+    {
+        nearPlane = std::max(nearPlane, 1e-4f);
+        farPlane = std::max(farPlane, nearPlane * 1.001f);
+
+        if (projection != m_GridProjection || nearPlane != m_GridNear || farPlane != m_GridFar)
+        {
+            RebuildGrid(projection, nearPlane, farPlane);
+        }
+
+        const uint32_t l_LightCount = static_cast<uint32_t>(lights.size());
+        m_Bounds.resize(l_LightCount);
+
+        const bool l_Parallel = jobSystem != nullptr && jobSystem->IsInitialized();
+
+        auto a_Bound = [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t l_Index = begin; l_Index < end; ++l_Index)
+                {
+                    BoundLight(view, projection, lights[l_Index], m_Bounds[l_Index]);
+                }
+            };
+
+        auto a_Bin = [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t l_Slice = begin; l_Slice < end; ++l_Slice)
+                {
+                    BinSlice(l_Slice);
+                }
+            };
+
+        if (l_Parallel)
+        {
+            jobSystem->ParallelFor(l_LightCount, k_BoundsGrain, a_Bound);
+            jobSystem->ParallelFor(m_Slices, 1, a_Bin);
+        }
+        else
+        {
+            a_Bound(0, l_LightCount);
+            a_Bin(0, m_Slices);
+        }
+
+        // Slices were binned into private lists with slice-relative offsets; stitch them into one list in cluster order
+        m_Stats = LightClusterStats{};
+        m_Stats.Lights = l_LightCount;
+        m_Indices.clear();
+
+        const uint32_t l_ClustersPerSlice = m_TilesX * m_TilesY;
+        for (uint32_t l_Slice = 0; l_Slice < m_Slices; ++l_Slice)
+        {
+            const uint32_t l_Base = static_cast<uint32_t>(m_Indices.size());
+            const std::vector<uint32_t>& l_SliceIndices = m_SliceIndices[l_Slice];
+            m_Indices.insert(m_Indices.end(), l_SliceIndices.begin(), l_SliceIndices.end());
+
+            for (uint32_t l_Cluster = l_Slice * l_ClustersPerSlice; l_Cluster < (l_Slice + 1) * l_ClustersPerSlice; ++l_Cluster)
+            {
+                LightClusterRange& l_Range = m_Ranges[l_Cluster];
+                l_Range.Offset += l_Base;
+                m_Stats.MaxPerCluster = std::max(m_Stats.MaxPerCluster, l_Range.Count);
+                m_Stats.OccupiedClusters += l_Range.Count > 0 ? 1 : 0;
+            }
+        }
+
+        m_Stats.Indices = static_cast<uint32_t>(m_Indices.size());
+    }
+
+    void LightClusterBinner::RebuildGrid(const glm::mat4& projection, float nearPlane, float farPlane)
+    {
+        m_GridProjection = projection;
+        m_GridNear = nearPlane;
+        m_GridFar = farPlane;
+
+        const float l_LogRatio = std::log(farPlane / nearPlane);
+        m_SliceScaleBias.x = static_cast<float>(m_Slices) / l_LogRatio;
+        m_SliceScaleBias.y = -static_cast<float>(m_Slices) * std::log(nearPlane) / l_LogRatio;
+
+        const glm::mat4 l_InverseProjection = glm::inverse(projection);
+        const uint32_t l_ClustersPerSlice = m_TilesX * m_TilesY;
+
+        m_Boxes.resize(static_cast<size_t>(l_ClustersPerSlice) * m_Slices);
+        m_Ranges.assign(m_Boxes.size(), LightClusterRange{});
+        m_SliceIndices.resize(m_Slices);
+        m_SliceLights.resize(m_Slices);
+        m_RowLights.resize(m_Slices);
+
+        for (uint32_t l_Slice = 0; l_Slice < m_Slices; ++l_Slice)
+        {
+            const float l_NearDepth = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(l_Slice) / static_cast<float>(m_Slices));
+            const float l_FarDepth = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(l_Slice + 1) / static_cast<float>(m_Slices));
+
+            for (uint32_t l_Y = 0; l_Y < m_TilesY; ++l_Y)
+            {
+                for (uint32_t l_X = 0; l_X < m_TilesX; ++l_X)
+                {
+                    const float l_MinX = -1.0f + 2.0f * static_cast<float>(l_X) / static_cast<float>(m_TilesX);
+                    const float l_MaxX = -1.0f + 2.0f * static_cast<float>(l_X + 1) / static_cast<float>(m_TilesX);
+                    const float l_MinY = RowToNdcY(l_Y + 1, m_TilesY);
+                    const float l_MaxY = RowToNdcY(l_Y, m_TilesY);
+
+                    ClusterBox& l_Box = m_Boxes[l_Slice * l_ClustersPerSlice + l_Y * m_TilesX + l_X];
+                    l_Box.Min = glm::vec3(std::numeric_limits<float>::max());
+                    l_Box.Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+                    const std::array<glm::vec2, 4> l_Corners = { glm::vec2(l_MinX, l_MinY), glm::vec2(l_MaxX, l_MinY), glm::vec2(l_MinX, l_MaxY), glm::vec2(l_MaxX, l_MaxY) };
+                    for (const glm::vec2& it_Corner : l_Corners)
+                    {
+                        for (float it_Depth : { l_NearDepth, l_FarDepth })
+                        {
+                            glm::vec3 l_Point = UnprojectAtDepth(l_InverseProjection, it_Corner.x, it_Corner.y, it_Depth);
+                            l_Box.Min = glm::min(l_Box.Min, l_Point);
+                            l_Box.Max = glm::max(l_Box.Max, l_Point);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LightClusterBinner::BoundLight(const glm::mat4& view, const glm::mat4& projection, const GpuLight& light, LightBounds& outBounds) const
+    {
+        outBounds.MinSlice = 1;
+        outBounds.MaxSlice = 0;
+
+        if (static_cast<uint32_t>(light.PositionType.w) == 0 || light.DirectionRange.w <= 0.0f)
+        {
+            return;
+        }
+
+        outBounds.Center = glm::vec3(view * glm::vec4(glm::vec3(light.PositionType), 1.0f));
+        outBounds.Radius = light.DirectionRange.w;
+
+        const float l_MinDepth = -outBounds.Center.z - outBounds.Radius;
+        const float l_MaxDepth = -outBounds.Center.z + outBounds.Radius;
+        if (l_MaxDepth < m_GridNear || l_MinDepth > m_GridFar)
+        {
+            return;
+        }
+
+        outBounds.MinSlice = SliceForDepth(l_MinDepth);
+        outBounds.MaxSlice = SliceForDepth(l_MaxDepth);
+
+        outBounds.MinTileX = 0;
+        outBounds.MaxTileX = m_TilesX - 1;
+        outBounds.MinTileY = 0;
+        outBounds.MaxTileY = m_TilesY - 1;
+
+        // The screen rectangle of the sphere's view-space box is the hull of its projected corners, as long as every corner lies in front of the camera
+        glm::vec2 l_NdcMin(std::numeric_limits<float>::max());
+        glm::vec2 l_NdcMax(std::numeric_limits<float>::lowest());
+        for (uint32_t l_Corner = 0; l_Corner < 8; ++l_Corner)
+        {
+            glm::vec3 l_Offset((l_Corner & 1) ? outBounds.Radius : -outBounds.Radius, (l_Corner & 2) ? outBounds.Radius : -outBounds.Radius, (l_Corner & 4) ? outBounds.Radius : -outBounds.Radius);
+            glm::vec4 l_Clip = projection * glm::vec4(outBounds.Center + l_Offset, 1.0f);
+            if (l_Clip.w <= 1e-5f)
+            {
+                return;
+            }
+
+            glm::vec2 l_Ndc = glm::vec2(l_Clip) / l_Clip.w;
+            l_NdcMin = glm::min(l_NdcMin, l_Ndc);
+            l_NdcMax = glm::max(l_NdcMax, l_Ndc);
+        }
+
+        if (l_NdcMax.x < -1.0f || l_NdcMin.x > 1.0f || l_NdcMax.y < -1.0f || l_NdcMin.y > 1.0f)
+        {
+            outBounds.MinSlice = 1;
+            outBounds.MaxSlice = 0;
+
+            return;
+        }
+
+        outBounds.MinTileX = NdcToTile(l_NdcMin.x, m_TilesX);
+        outBounds.MaxTileX = NdcToTile(l_NdcMax.x, m_TilesX);
+        outBounds.MinTileY = NdcYToRow(l_NdcMax.y, m_TilesY);
+        outBounds.MaxTileY = NdcYToRow(l_NdcMin.y, m_TilesY);
+    }
+
+    void LightClusterBinner::BinSlice(uint32_t slice)
+    {
+        std::vector<uint32_t>& l_SliceIndices = m_SliceIndices[slice];
+        l_SliceIndices.clear();
+
+        const uint32_t l_ClustersPerSlice = m_TilesX * m_TilesY;
+        const uint32_t l_SliceBase = slice * l_ClustersPerSlice;
+
+        for (uint32_t l_Cluster = l_SliceBase; l_Cluster < l_SliceBase + l_ClustersPerSlice; ++l_Cluster)
+        {
+            m_Ranges[l_Cluster] = LightClusterRange{};
+        }
+
+        // Lights are visited once per slice and scattered into that slice's tiles; a second pass over the tiles then lays each cluster's lights out contiguously
+        std::vector<uint32_t>& l_SliceLights = m_SliceLights[slice];
+        l_SliceLights.clear();
+        for (uint32_t l_Light = 0; l_Light < static_cast<uint32_t>(m_Bounds.size()); ++l_Light)
+        {
+            const LightBounds& l_Bounds = m_Bounds[l_Light];
+            if (slice >= l_Bounds.MinSlice && slice <= l_Bounds.MaxSlice)
+            {
+                l_SliceLights.push_back(l_Light);
+            }
+        }
+
+        if (l_SliceLights.empty())
+        {
+            return;
+        }
+
+        // Narrowing to the lights that cover the tile row first keeps the per-tile loop proportional to the lights actually nearby
+        std::vector<uint32_t>& l_RowLights = m_RowLights[slice];
+        for (uint32_t l_Y = 0; l_Y < m_TilesY; ++l_Y)
+        {
+            l_RowLights.clear();
+            for (uint32_t it_Light : l_SliceLights)
+            {
+                const LightBounds& l_Bounds = m_Bounds[it_Light];
+                if (l_Y >= l_Bounds.MinTileY && l_Y <= l_Bounds.MaxTileY)
+                {
+                    l_RowLights.push_back(it_Light);
+                }
+            }
+
+            for (uint32_t l_X = 0; l_X < m_TilesX; ++l_X)
+            {
+                const uint32_t l_Cluster = l_SliceBase + l_Y * m_TilesX + l_X;
+                const ClusterBox& l_Box = m_Boxes[l_Cluster];
+
+                LightClusterRange& l_Range = m_Ranges[l_Cluster];
+                l_Range.Offset = static_cast<uint32_t>(l_SliceIndices.size());
+
+                for (uint32_t it_Light : l_RowLights)
+                {
+                    const LightBounds& l_Bounds = m_Bounds[it_Light];
+                    if (l_X < l_Bounds.MinTileX || l_X > l_Bounds.MaxTileX)
+                    {
+                        continue;
+                    }
+
+                    glm::vec3 l_Closest = glm::clamp(l_Bounds.Center, l_Box.Min, l_Box.Max);
+                    glm::vec3 l_Delta = l_Closest - l_Bounds.Center;
+                    if (glm::dot(l_Delta, l_Delta) <= l_Bounds.Radius * l_Bounds.Radius)
+                    {
+                        l_SliceIndices.push_back(it_Light);
+                    }
+                }
+
+                l_Range.Count = static_cast<uint32_t>(l_SliceIndices.size()) - l_Range.Offset;
+            }
+        }
+    }
+
+    uint32_t LightClusterBinner::SliceForDepth(float depth) const
+    {
+        if (depth <= m_GridNear)
+        {
+            return 0;
+        }
+
+        float l_Slice = std::floor(std::log(depth) * m_SliceScaleBias.x + m_SliceScaleBias.y);
+
+        return static_cast<uint32_t>(std::clamp(l_Slice, 0.0f, static_cast<float>(m_Slices - 1)));
+    }
+}
\ No newline at end of file
@@ -2,70 +2,159 @@
 #include <Trinity/ImGui/ImGuiLayer.h>
 #include <Trinity/ImGui/IImGuiRenderBackend.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <utility>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <Trinity/Platform/FileSystem.h>
 #include <Trinity/Core/Log.h>
+#include <Trinity/Core/JobSystem.h>
 
 #include <Trinity/Renderer/Meshes/Mesh.h>
-#include <Trinity/Renderer/Materials/Material.h>
+#include <Trinity/Renderer/Materials/ResolvedMaterial.h>
 #include <Trinity/Renderer/Textures/Image.h>
-#include <Trinity/Renderer/Materials/MaterialParameter.h>
 #include <Trinity/Scene/Scene.h>
-#include <Trinity/Scene/Components/TransformComponent.h>
+#include <Trinity/Scene/Components/WorldTransformComponent.h>
 #include <Trinity/Scene/Components/MeshRendererComponent.h>
 #include <Trinity/Scene/Components/LightComponent.h>
 #include <Trinity/Assets/AssetDatabase.h>
 
 namespace Trinity
 {
-    static constexpr uint32_t k_MaxLights = 16;
+    // Directional lights reach every cluster, so they are shaded from the frame uniform; point and spot lights go through the clustered storage buffers
+    static constexpr uint32_t k_MaxDirectionalLights = 4;
 
+    // Pipeline field of the packet sort key. Quantized meshes sort after the float ones, so each pass switches to their pipeline at most once
+    static constexpr uint32_t k_MeshPipelineKey = 0;
+    static constexpr uint32_t k_QuantizedMeshPipelineKey = 1;
+
+    // Smallest instance range allocated per frame; larger frames double from here
+    static constexpr uint32_t k_MinInstanceCapacity = 1024;
+    static constexpr uint32_t k_MinLightCapacity = 256;
+    static constexpr uint32_t k_MinLightIndexCapacity = 4096;
+
+    // Frames a LOD view or one of its entries may go undrawn before its hysteresis state is dropped
+    static constexpr uint64_t k_LodRetireFrames = 300;
+
+    // Per-draw data lives in the instance buffer; SV_InstanceID restarts at zero for every draw, so the batch's base record travels here
     struct MeshPushConstants
     {
-        glm::mat4 Model;
-        glm::vec4 BaseColorFactor;
-        glm::vec4 PbrFactors;      // x = metallic, y = roughness, z = occlusionStrength, w = normalScale
-        glm::vec4 EmissiveFactor;  // rgb = emissive color, a = emissive strength
+        uint32_t InstanceOffset;
+        uint32_t Padding[3];
+
+        // Dequantization range of the batch's mesh; only the TR_QUANTIZED variants read it
+        glm::vec4 PositionScale;
+        glm::vec4 PositionOffset;
     };
 
-    // Matches the std140 layout of FrameData / GpuLight in Mesh.slang.
-    struct GpuLight
+    // Depth-only passes: the light's matrix for the shadow cascades, the camera's for the pre-pass and the overdraw view
+    struct DepthPushConstants
     {
-        glm::vec4 PositionType;
-        glm::vec4 DirectionRange;
-        glm::vec4 ColorIntensity;
-        glm::vec4 SpotAngles;
+        glm::mat4 ViewProjection;
+        uint32_t InstanceOffset;
+        uint32_t Padding[3];
+        glm::vec4 PositionScale;
+        glm::vec4 PositionOffset;
     };
 
+    // Matches the std140 layout of FrameData in Mesh.slang.
     struct FrameData
     {
         glm::mat4 ViewProjection;
+        glm::mat4 View;
         glm::vec4 CameraPosition;
-        glm::vec4 AmbientAndCount;
+        glm::vec4 AmbientAndCount;      // a = directional light count
         glm::vec4 IblParams;            // x = IBL enabled, y = max prefilter LOD
-        glm::mat4 LightViewProjection;  // directional shadow caster
-        glm::vec4 ShadowParams;         // x = enabled, y = bias, w = 1 / shadow map size
-        GpuLight Lights[k_MaxLights];
+        glm::mat4 CascadeViewProjections[Renderer::k_ShadowCascadeCount];
+        glm::vec4 CascadeSplits;        // view depth each cascade ends at; negative for a cascade with nothing to sample
+        glm::vec4 CascadeBias;
+        glm::vec4 ShadowParams;         // x = enabled, z = cascade count, w = 1 / shadow map size
+        glm::uvec4 ClusterGrid;         // x = tiles x, y = tiles y, z = depth slices, w = clustered light count
+        glm::vec4 ClusterParams;        // x = slice scale, y = slice bias, zw = tiles per pixel
+        GpuLight DirectionalLights[k_MaxDirectionalLights];
     };
 
-    static void LogShaderDiagnostics(const char* stage, const ShaderCompileResult& result)
+    // Copies a per-frame array into frame memory. The bound range is the element minimum doubled until the array fits, so the cached descriptor set only changes
+    // when the count crosses a power of two; empty arrays still get the minimum so the descriptor sets stay complete
+    static FrameAllocation AllocateStorage(GraphicsDevice& device, const void* data, uint32_t count, uint32_t minimum, uint64_t stride)
+    {
+        uint64_t l_Capacity = std::max(minimum, 1u);
+        while (l_Capacity < count)
+        {
+            l_Capacity *= 2;
+        }
+
+        FrameAllocation l_Allocation = device.AllocateFrameMemory(stride * l_Capacity, BufferUsage::Storage);
+        if (l_Allocation.IsValid() && count != 0)
+        {
+            std::memcpy(l_Allocation.Data, data, static_cast<size_t>(stride * count));
+        }
+
+        return l_Allocation;
+    }
+
+    static constexpr uint64_t k_HashOffset = 14695981039346656037ull;
+    static constexpr uint64_t k_HashPrime = 1099511628211ull;
+
+    // FNV-1a over 32-bit words rather than bytes; the shadow cache hashes every caster's matrix each frame
+    static void HashWords(uint64_t& hash, const void* data, size_t size)
+    {
+        const unsigned char* l_Bytes = static_cast<const unsigned char*>(data);
+        for (size_t l_Offset = 0; l_Offset + sizeof(uint32_t) <= size; l_Offset += sizeof(uint32_t))
+        {
+            uint32_t l_Word = 0;
+            std::memcpy(&l_Word, l_Bytes + l_Offset, sizeof(uint32_t));
+            hash ^= l_Word;
+            hash *= k_HashPrime;
+        }
+    }
+
+    // Everything about a caster that shows in its shadow: the geometry it draws and where
+    static void HashShadowCaster(uint64_t& hash, const RenderPacket& packet)
+    {
+        const uint64_t l_VertexBuffer = packet.MeshSource->GetVertexBuffer().Pack();
+        const uint32_t l_Range[3] = { packet.ShadowFirstIndex, packet.ShadowIndexCount, static_cast<uint32_t>(packet.BaseVertex) };
+
+        HashWords(hash, &l_VertexBuffer, sizeof(l_VertexBuffer));
+        HashWords(hash, l_Range, sizeof(l_Range));
+        HashWords(hash, &packet.World, sizeof(packet.World));
+    }
+
+    // Coarsest level whose error, projected at pixelsPerUnit, stays within the threshold. The search starts from last frame's level and only leaves it once the
+    // error is past the threshold by the hysteresis margin, coarsening below it or refining above it
+    static uint32_t SelectSubmeshLod(const Submesh& submesh, float pixelsPerUnit, float threshold, float hysteresis, uint32_t previous)
     {
-        for (const ShaderDiagnostic& l_Message : result.Messages)
+        const uint32_t l_LevelCount = static_cast<uint32_t>(submesh.Lods.size());
+        if (threshold <= 0.0f || l_LevelCount == 0)
         {
-            const char* l_Severity = l_Message.Severity == ShaderDiagnosticSeverity::Error ? "error" : (l_Message.Severity == ShaderDiagnosticSeverity::Warning ? "warning" : "info");
+            return 0;
         }
 
-        if (result.Messages.empty() && !result.Diagnostics.empty())
+        auto a_Pixels = [&submesh, pixelsPerUnit](uint32_t level)
+            {
+                return level == 0 ? 0.0f : submesh.Lods[level - 1].Error * pixelsPerUnit;
+            };
+
+        uint32_t l_Level = std::min(previous, l_LevelCount);
+        while (l_Level > 0 && a_Pixels(l_Level) > threshold * (1.0f + hysteresis))
         {
+            --l_Level;
+        }
 
+        while (l_Level < l_LevelCount && a_Pixels(l_Level + 1) <= threshold * (1.0f - hysteresis))
+        {
+            ++l_Level;
         }
+
+        return l_Level;
     }
 
-    Renderer::Renderer(GraphicsDevice& device, Swapchain& swapchain, FileSystem& fileSystem) : m_Device(device), m_Swapchain(swapchain), m_FileSystem(fileSystem), m_TextureManager(device, fileSystem), m_MeshLibrary(device, fileSystem)
+    Renderer::Renderer(GraphicsDevice& device, Swapchain& swapchain, FileSystem& fileSystem, JobSystem* jobSystem) : m_Device(device), m_Swapchain(swapchain), m_FileSystem(fileSystem), m_JobSystem(jobSystem), m_PipelineCompiler(device, m_ShaderCompiler, jobSystem), m_TextureManager(device, fileSystem), m_MeshLibrary(device, fileSystem)
     {
 
     }
@@ -92,30 +181,7 @@ namespace Trinity
             m_CommandLists.push_back(m_Device.CreateCommandList());
         }
 
-        m_FrameUniforms.reserve(l_FramesInFlight);
-        for (uint32_t l_Index = 0; l_Index < l_FramesInFlight; ++l_Index)
-        {
-            BufferDescription l_FrameDescription;
-            l_FrameDescription.Size = sizeof(FrameData);
-            l_FrameDescription.Usage = BufferUsage::Uniform;
-            l_FrameDescription.Memory = MemoryUsage::CpuToGpu;
-            l_FrameDescription.DebugName = "FrameUniform";
-
-            BufferHandle l_Frame = m_Device.CreateBuffer(l_FrameDescription);
-            if (!l_Frame.IsValid())
-            {
-                ("Renderer: frame uniform buffer creation failed");
-
-                return false;
-            }
-
-            m_FrameUniforms.push_back(l_Frame);
-        }
-
-        if (!CreatePipeline())
-        {
-            return false;
-        }
+        CreatePipeline();
 
         if (!m_MeshLibrary.Initialize())
         {
@@ -127,10 +193,9 @@ namespace Trinity
             return false;
         }
 
-        if (!CreateSceneTargets(m_Swapchain.GetWidth(), m_Swapchain.GetHeight()))
-        {
-            return false;
-        }
+        m_RenderGraph.Initialize(m_Device);
+        m_RenderWidth = m_Swapchain.GetWidth();
+        m_RenderHeight = m_Swapchain.GetHeight();
 
         std::filesystem::path l_ShaderDirectory = m_FileSystem.Resolve(BaseDirectory::Executable, "Shaders");
         if (!m_PostProcess.Initialize(m_Device, m_ShaderCompiler, l_ShaderDirectory, m_Swapchain.GetFormat()))
@@ -148,7 +213,7 @@ namespace Trinity
             return false;
         }
 
-        if (!m_DebugLineStage.Initialize(m_Device, m_ShaderCompiler, l_ShaderDirectory, Format::RGBA16_SFLOAT, Format::D32_SFLOAT, l_FramesInFlight))
+        if (!m_DebugLineStage.Initialize(m_Device, m_ShaderCompiler, l_ShaderDirectory, Format::RGBA16_SFLOAT, Format::D32_SFLOAT))
         {
             return false;
         }
@@ -181,16 +246,20 @@ namespace Trinity
 
     void Renderer::Shutdown()
     {
-        m_CommandLists.clear();
-
-        for (BufferHandle& it_Frame : m_FrameUniforms)
+        // Compiles still in flight would otherwise create pipelines on a device that is being torn down
+        m_PipelineCompiler.Discard(m_PendingPipeline);
+        m_PipelineCompiler.Discard(m_PendingShadowPipeline);
+        m_PipelineCompiler.Discard(m_PendingPrepassPipeline);
+        m_PipelineCompiler.Discard(m_PendingEqualPipeline);
+        m_PipelineCompiler.Discard(m_PendingOverdrawPipeline);
+        for (QuantizedTwin& it_Twin : m_QuantizedPipelines)
         {
-            if (it_Frame.IsValid())
-            {
-                m_Device.DestroyBuffer(it_Frame);
-            }
+            m_PipelineCompiler.Discard(it_Twin.Pending);
         }
-        m_FrameUniforms.clear();
+
+        m_PipelineCompiler.Shutdown();
+
+        m_CommandLists.clear();
 
         m_PostProcess.Shutdown();
         m_DepthVisualizeStage.Shutdown();
@@ -237,6 +306,48 @@ namespace Trinity
             m_ShadowVertex = ShaderHandle{};
         }
 
+        for (PipelineHandle* it_Pipeline : { &m_PrepassPipeline, &m_EqualPipeline, &m_OverdrawPipeline })
+        {
+            if (it_Pipeline->IsValid())
+            {
+                m_Device.DestroyPipeline(*it_Pipeline);
+                *it_Pipeline = PipelineHandle{};
+            }
+        }
+
+        for (ShaderHandle* it_Shader : { &m_PrepassVertex, &m_PrepassFragment, &m_EqualVertexShader, &m_EqualFragmentShader, &m_OverdrawVertex, &m_OverdrawFragment })
+        {
+            if (it_Shader->IsValid())
+            {
+                m_Device.DestroyShader(*it_Shader);
+                *it_Shader = ShaderHandle{};
+            }
+        }
+
+        for (QuantizedTwin& it_Twin : m_QuantizedPipelines)
+        {
+            if (it_Twin.Pipeline.IsValid())
+            {
+                m_Device.DestroyPipeline(it_Twin.Pipeline);
+            }
+
+            for (ShaderHandle it_Shader : { it_Twin.VertexShader, it_Twin.FragmentShader })
+            {
+                if (it_Shader.IsValid())
+                {
+                    m_Device.DestroyShader(it_Shader);
+                }
+            }
+
+            it_Twin = QuantizedTwin{};
+        }
+
+        m_PrepassRequested = false;
+        m_OverdrawRequested = false;
+        m_OverdrawPrepass = false;
+        m_PendingOverdrawPrepass = false;
+        m_QuantizedMeshes = false;
+
         if (m_ShadowFragment.IsValid())
         {
             m_Device.DestroyShader(m_ShadowFragment);
@@ -255,6 +366,16 @@ namespace Trinity
             m_ShadowMap = TextureHandle{};
         }
 
+        if (m_ShadowStaticMap.IsValid())
+        {
+            m_Device.DestroyTexture(m_ShadowStaticMap);
+            m_ShadowStaticMap = TextureHandle{};
+        }
+
+        m_ShadowCascades = {};
+        m_ShadowMapReady = false;
+        m_ShadowStaticMapReady = false;
+
         if (m_Pipeline.IsValid())
         {
             m_Device.DestroyPipeline(m_Pipeline);
@@ -275,96 +396,62 @@ namespace Trinity
 
         m_MeshLibrary.Shutdown();
 
-        DestroySceneTargets();
-        DestroyViewportOutput();
+        if (m_ViewportTextureID != 0)
+        {
+            m_Device.GetImGuiBackend().UnregisterTexture(m_ViewportTextureID);
+            m_ViewportTextureID = 0;
+        }
+
+        m_RenderGraph.Shutdown();
+        m_SceneColor = TextureHandle{};
+        m_SceneDepth = TextureHandle{};
+        m_DepthVis = TextureHandle{};
+        m_Overdraw = TextureHandle{};
+        m_ViewportColor = TextureHandle{};
+        m_ViewportTextureSource = TextureHandle{};
 
         m_TextureManager.Shutdown();
 
         m_ShaderCompiler.Shutdown();
     }
 
-    bool Renderer::CreatePipeline()
+    void Renderer::CreatePipeline()
     {
-        return BuildPipeline(m_VertexShader, m_FragmentShader, m_Pipeline);
+        m_PendingBindless = m_BindlessRequested && m_Device.GetCapabilities().SupportsBindless;
+        m_PendingPipeline = m_PipelineCompiler.Compile(DescribeMeshPipeline(m_PendingBindless, false));
+        m_PendingShadowPipeline = m_PipelineCompiler.Compile(DescribeShadowPipeline());
     }
 
-    bool Renderer::BuildPipeline(ShaderHandle& vertexShader, ShaderHandle& fragmentShader, PipelineHandle& pipeline)
+    PipelineCompileRequest Renderer::DescribeMeshPipeline(bool bindless, bool depthEqual) const
     {
-        vertexShader = ShaderHandle{};
-        fragmentShader = ShaderHandle{};
-        pipeline = PipelineHandle{};
-
-        std::filesystem::path l_ShaderDirectory = m_FileSystem.Resolve(BaseDirectory::Executable, "Shaders");
-
-        ShaderCompileResult l_VertexResult = m_ShaderCompiler.Compile(l_ShaderDirectory, "Mesh", "vertexMain");
-        if (!l_VertexResult.Success)
-        {
-            LogShaderDiagnostics("vertexMain", l_VertexResult);
-
-            return false;
-        }
-
-        ShaderCompileResult l_FragmentResult = m_ShaderCompiler.Compile(l_ShaderDirectory, "Mesh", "fragmentMain");
-        if (!l_FragmentResult.Success)
-        {
-            LogShaderDiagnostics("fragmentMain", l_FragmentResult);
-
-            return false;
-        }
-
-
-        for (const ShaderVertexInput& it_Input : l_VertexResult.Reflection.VertexInputs)
-        {
-
-        }
-
-        ShaderDescription l_VertexDescription;
-        l_VertexDescription.Stage = ShaderStage::Vertex;
-        l_VertexDescription.Bytecode = l_VertexResult.SPIRV;
-        l_VertexDescription.EntryPoint = "vertexMain";
-        l_VertexDescription.DebugName = "Mesh.vertexMain";
-        vertexShader = m_Device.CreateShader(l_VertexDescription);
-
-        ShaderDescription l_FragmentDescription;
-        l_FragmentDescription.Stage = ShaderStage::Fragment;
-        l_FragmentDescription.Bytecode = l_FragmentResult.SPIRV;
-        l_FragmentDescription.EntryPoint = "fragmentMain";
-        l_FragmentDescription.DebugName = "Mesh.fragmentMain";
-        fragmentShader = m_Device.CreateShader(l_FragmentDescription);
-
-        if (!vertexShader.IsValid() || !fragmentShader.IsValid())
+        PipelineCompileRequest l_Request;
+        l_Request.SearchDirectory = m_FileSystem.Resolve(BaseDirectory::Executable, "Shaders");
+        l_Request.Vertex = { "Mesh", "vertexMain", {} };
+        l_Request.Fragment = { "Mesh", "fragmentMain", {} };
+        if (bindless)
         {
-            ("Renderer: shader module creation failed");
-            if (vertexShader.IsValid())
-            {
-                m_Device.DestroyShader(vertexShader); vertexShader = ShaderHandle{};
-            }
-
-            if (fragmentShader.IsValid())
-            {
-                m_Device.DestroyShader(fragmentShader); fragmentShader = ShaderHandle{};
-            }
-
-            return false;
+            l_Request.Vertex.Defines.push_back({ "TR_BINDLESS", "1" });
+            l_Request.Fragment.Defines.push_back({ "TR_BINDLESS", "1" });
         }
 
-        PipelineDescription l_PipelineDescription;
-        l_PipelineDescription.VertexShader = vertexShader;
-        l_PipelineDescription.FragmentShader = fragmentShader;
+        PipelineDescription& l_PipelineDescription = l_Request.Description;
         l_PipelineDescription.Vertex = MeshVertex::GetLayout();
         l_PipelineDescription.Topology = PrimitiveTopology::TriangleList;
         l_PipelineDescription.Rasterizer.Cull = CullMode::None;
         l_PipelineDescription.DepthStencil.DepthTest = true;
-        l_PipelineDescription.DepthStencil.DepthWrite = true;
+        l_PipelineDescription.DepthStencil.DepthWrite = !depthEqual;
+
+        // Less-equal rather than less, so the main pipeline still shades the pre-pass's surfaces while the equal variant is compiling
+        l_PipelineDescription.DepthStencil.DepthCompare = depthEqual ? CompareOp::Equal : CompareOp::LessEqual;
         l_PipelineDescription.DepthFormat = Format::D32_SFLOAT;
         l_PipelineDescription.ColorFormats = { Format::RGBA16_SFLOAT };
         l_PipelineDescription.PushConstantSize = static_cast<uint32_t>(sizeof(MeshPushConstants));
 
-        // The Vulkan backend allocates one descriptor set per bind call, so each resource lives in its own set.
+        // Each bind call resolves to a single-binding descriptor set from the device's cache, keyed by the one resource it holds, so every resource lives in its own set
         ResourceBinding l_FrameBinding;
         l_FrameBinding.Set = 0;
         l_FrameBinding.Binding = 0;
-        l_FrameBinding.Type = ResourceBindingType::UniformBuffer;
+        l_FrameBinding.Type = ResourceBindingType::DynamicUniformBuffer;
         l_FrameBinding.Stages = ShaderStage::Vertex | ShaderStage::Fragment;
 
         ResourceBinding l_BaseColorBinding;
@@ -415,58 +502,183 @@ namespace Trinity
         l_ShadowBinding.Type = ResourceBindingType::CombinedImageSampler;
         l_ShadowBinding.Stages = ShaderStage::Fragment;
 
-        l_PipelineDescription.Bindings = { l_FrameBinding, l_BaseColorBinding, l_NormalBinding, l_MetallicRoughnessBinding, l_EmissiveBinding, l_IrradianceBinding, l_PrefilteredBinding, l_BrdfBinding, l_ShadowBinding };
-        l_PipelineDescription.DebugName = "Mesh";
+        ResourceBinding l_InstanceBinding;
+        l_InstanceBinding.Set = 9;
+        l_InstanceBinding.Binding = 0;
+        l_InstanceBinding.Type = ResourceBindingType::DynamicStorageBuffer;
+        l_InstanceBinding.Stages = ShaderStage::Vertex;
 
-        pipeline = m_Device.CreatePipeline(l_PipelineDescription);
-        if (!pipeline.IsValid())
-        {
+        ResourceBinding l_LightBinding;
+        l_LightBinding.Set = 11;
+        l_LightBinding.Binding = 0;
+        l_LightBinding.Type = ResourceBindingType::DynamicStorageBuffer;
+        l_LightBinding.Stages = ShaderStage::Fragment;
 
-            m_Device.DestroyShader(vertexShader); vertexShader = ShaderHandle{};
-            m_Device.DestroyShader(fragmentShader); fragmentShader = ShaderHandle{};
+        ResourceBinding l_ClusterRangeBinding = l_LightBinding;
+        l_ClusterRangeBinding.Set = 12;
 
-            return false;
+        ResourceBinding l_LightIndexBinding = l_LightBinding;
+        l_LightIndexBinding.Set = 13;
+
+        if (bindless)
+        {
+            // Sets 1-4 stay as empty layouts; material textures come from the global table in set 10
+            ResourceBinding l_BindlessBinding;
+            l_BindlessBinding.Set = 10;
+            l_BindlessBinding.Binding = 0;
+            l_BindlessBinding.Type = ResourceBindingType::BindlessTextures;
+            l_BindlessBinding.Stages = ShaderStage::Vertex | ShaderStage::Fragment;
+
+            l_PipelineDescription.Bindings = { l_FrameBinding, l_IrradianceBinding, l_PrefilteredBinding, l_BrdfBinding, l_ShadowBinding, l_InstanceBinding, l_BindlessBinding, l_LightBinding, l_ClusterRangeBinding, l_LightIndexBinding };
+        }
+        else
+        {
+            l_PipelineDescription.Bindings = { l_FrameBinding, l_BaseColorBinding, l_NormalBinding, l_MetallicRoughnessBinding, l_EmissiveBinding, l_IrradianceBinding, l_PrefilteredBinding, l_BrdfBinding, l_ShadowBinding, l_InstanceBinding, l_LightBinding, l_ClusterRangeBinding, l_LightIndexBinding };
         }
 
-        return true;
+        l_PipelineDescription.DebugName = bindless ? (depthEqual ? "Mesh.Bindless.DepthEqual" : "Mesh.Bindless") : (depthEqual ? "Mesh.DepthEqual" : "Mesh");
+
+        return l_Request;
     }
 
     void Renderer::ReloadShaders()
     {
+        // A newer edit supersedes whatever is still compiling; the stale result is destroyed once it lands
+        m_PipelineCompiler.Discard(m_PendingPipeline);
 
+        m_PendingBindless = m_BindlessRequested && m_Device.GetCapabilities().SupportsBindless;
+        m_PendingPipeline = m_PipelineCompiler.Compile(DescribeMeshPipeline(m_PendingBindless, false));
 
-        ShaderHandle l_NewVertex;
-        ShaderHandle l_NewFragment;
-        PipelineHandle l_NewPipeline;
+        if (m_PrepassRequested)
+        {
+            m_PipelineCompiler.Discard(m_PendingEqualPipeline);
+            m_PendingEqualBindless = m_PendingBindless;
+            m_PendingEqualPipeline = m_PipelineCompiler.Compile(DescribeMeshPipeline(m_PendingEqualBindless, true));
+        }
 
-        if (!BuildPipeline(l_NewVertex, l_NewFragment, l_NewPipeline))
+        for (QuantizedPipeline it_Pipeline : { QuantizedPipeline::Mesh, QuantizedPipeline::Equal })
         {
+            if (m_QuantizedPipelines[static_cast<size_t>(it_Pipeline)].Requested)
+            {
+                CompileQuantizedPipeline(it_Pipeline, m_PendingBindless);
+            }
+        }
+    }
 
-            return;
+    // Swaps in compiles that have finished. A failed compile keeps the previous pipeline, so a broken shader edit never takes the scene down
+    void Renderer::UpdatePipelines()
+    {
+        m_PipelineCompiler.Collect();
+
+        const auto a_Adopt = [this](PipelineFuture& future, PipelineHandle& pipeline, ShaderHandle& vertexShader, ShaderHandle& fragmentShader)
+            {
+                if (!future.IsReady())
+                {
+                    return false;
+                }
+
+                if (!future.Succeeded())
+                {
+                    m_PipelineCompiler.Discard(future);
+
+                    return false;
+                }
+
+                // Destruction is deferred by the device until frames still using the old pipeline have retired
+                if (pipeline.IsValid())
+                {
+                    m_Device.DestroyPipeline(pipeline);
+                }
+
+                if (vertexShader.IsValid())
+                {
+                    m_Device.DestroyShader(vertexShader);
+                }
+
+                if (fragmentShader.IsValid())
+                {
+                    m_Device.DestroyShader(fragmentShader);
+                }
+
+                const CompiledPipeline& l_Result = future.GetResult();
+                pipeline = l_Result.Pipeline;
+                vertexShader = l_Result.VertexShader;
+                fragmentShader = l_Result.FragmentShader;
+                future = PipelineFuture{};
+
+                return true;
+            };
+
+        const bool l_Pending = m_PendingPipeline.IsValid();
+        if (a_Adopt(m_PendingPipeline, m_Pipeline, m_VertexShader, m_FragmentShader))
+        {
+            m_BindlessActive = m_PendingBindless;
+        }
+        else if (l_Pending && !m_PendingPipeline.IsValid())
+        {
+            // Failed: a bindless request the shaders cannot satisfy would otherwise be retried every frame
+            m_BindlessRequested = m_BindlessActive;
         }
 
-        m_Device.WaitIdle();
+        a_Adopt(m_PendingShadowPipeline, m_ShadowPipeline, m_ShadowVertex, m_ShadowFragment);
 
-        if (m_Pipeline.IsValid())
+        if (a_Adopt(m_PendingEqualPipeline, m_EqualPipeline, m_EqualVertexShader, m_EqualFragmentShader))
         {
-            m_Device.DestroyPipeline(m_Pipeline);
+            m_EqualBindless = m_PendingEqualBindless;
         }
 
-        if (m_VertexShader.IsValid())
+        a_Adopt(m_PendingPrepassPipeline, m_PrepassPipeline, m_PrepassVertex, m_PrepassFragment);
+        if (a_Adopt(m_PendingOverdrawPipeline, m_OverdrawPipeline, m_OverdrawVertex, m_OverdrawFragment))
         {
-            m_Device.DestroyShader(m_VertexShader);
+            m_OverdrawPrepass = m_PendingOverdrawPrepass;
         }
 
-        if (m_FragmentShader.IsValid())
+        for (QuantizedTwin& it_Twin : m_QuantizedPipelines)
         {
-            m_Device.DestroyShader(m_FragmentShader);
+            if (a_Adopt(it_Twin.Pending, it_Twin.Pipeline, it_Twin.VertexShader, it_Twin.FragmentShader))
+            {
+                it_Twin.Variant = it_Twin.PendingVariant;
+            }
         }
 
-        m_VertexShader = l_NewVertex;
-        m_FragmentShader = l_NewFragment;
-        m_Pipeline = l_NewPipeline;
+        // Pipelines of the opt-in views are built the first time they are asked for, so sessions that never use them do not pay for the compiles
+        if (m_DepthPrepass && !m_PrepassRequested)
+        {
+            m_PrepassRequested = true;
+            m_PendingEqualBindless = m_PendingPipeline.IsValid() ? m_PendingBindless : m_BindlessActive;
+            m_PendingEqualPipeline = m_PipelineCompiler.Compile(DescribeMeshPipeline(m_PendingEqualBindless, true));
+            m_PendingPrepassPipeline = m_PipelineCompiler.Compile(DescribePrepassPipeline());
+        }
+
+        // The overdraw view repeats the lit pass's depth test, which changes with the pre-pass, so toggling the pre-pass rebuilds it
+        if (m_OverdrawVisualize && (!m_OverdrawRequested || m_PendingOverdrawPrepass != m_DepthPrepass))
+        {
+            m_OverdrawRequested = true;
+            m_PipelineCompiler.Discard(m_PendingOverdrawPipeline);
+            m_PendingOverdrawPrepass = m_DepthPrepass;
+            m_PendingOverdrawPipeline = m_PipelineCompiler.Compile(DescribeOverdrawPipeline(m_PendingOverdrawPrepass));
+            if (m_QuantizedPipelines[static_cast<size_t>(QuantizedPipeline::Overdraw)].Requested)
+            {
+                CompileQuantizedPipeline(QuantizedPipeline::Overdraw, m_PendingOverdrawPrepass);
+            }
+        }
 
+        // Twins follow once a quantized mesh has been drawn, for the pipelines that have been asked for so far
+        if (m_QuantizedMeshes)
+        {
+            const bool l_Bindless = m_PendingPipeline.IsValid() ? m_PendingBindless : m_BindlessActive;
+            const std::array<bool, static_cast<size_t>(QuantizedPipeline::Count)> l_Wanted = { true, m_PrepassRequested, true, m_PrepassRequested, m_OverdrawRequested };
+            for (size_t l_Index = 0; l_Index < l_Wanted.size(); ++l_Index)
+            {
+                if (l_Wanted[l_Index] && !m_QuantizedPipelines[l_Index].Requested)
+                {
+                    const QuantizedPipeline l_Pipeline = static_cast<QuantizedPipeline>(l_Index);
+                    CompileQuantizedPipeline(l_Pipeline, l_Pipeline == QuantizedPipeline::Overdraw ? m_PendingOverdrawPrepass : l_Bindless);
+                }
+            }
+        }
 
+        m_Stats.PendingPipelines = m_PipelineCompiler.GetPendingCount();
     }
 
     void Renderer::CheckHotReload()
@@ -490,101 +702,26 @@ namespace Trinity
         }
     }
 
-    bool Renderer::CreateTextureResources()
-    {
-        return m_TextureManager.Initialize();
-    }
-
-    bool Renderer::CreateSceneTargets(uint32_t width, uint32_t height)
+    static TextureDescription DescribeRenderTarget(const char* debugName, Format format, TextureUsage usage, uint32_t width, uint32_t height)
     {
-        TextureDescription l_ColorDescription;
-        l_ColorDescription.Type = TextureType::Texture2D;
-        l_ColorDescription.Format = Format::RGBA16_SFLOAT;
-        l_ColorDescription.Usage = TextureUsage::Sampled | TextureUsage::RenderTarget;
-        l_ColorDescription.Width = width;
-        l_ColorDescription.Height = height;
-        l_ColorDescription.Depth = 1;
-        l_ColorDescription.MipLevels = 1;
-        l_ColorDescription.ArrayLayers = 1;
-        l_ColorDescription.SampleCount = 1;
-        l_ColorDescription.DebugName = "SceneColor";
-
-        m_SceneColor = m_Device.CreateTexture(l_ColorDescription);
-        if (!m_SceneColor.IsValid())
-        {
-
-
-            return false;
-        }
-
-        TextureDescription l_DepthDescription;
-        l_DepthDescription.Type = TextureType::Texture2D;
-        l_DepthDescription.Format = Format::D32_SFLOAT;
-        l_DepthDescription.Usage = TextureUsage::DepthStencil | TextureUsage::Sampled;
-        l_DepthDescription.Width = width;
-        l_DepthDescription.Height = height;
-        l_DepthDescription.Depth = 1;
-        l_DepthDescription.MipLevels = 1;
-        l_DepthDescription.ArrayLayers = 1;
-        l_DepthDescription.SampleCount = 1;
-        l_DepthDescription.DebugName = "SceneDepth";
-
-        m_SceneDepth = m_Device.CreateTexture(l_DepthDescription);
-        if (!m_SceneDepth.IsValid())
-        {
-
-
-            return false;
-        }
-
-        TextureDescription l_DepthVisDescription;
-        l_DepthVisDescription.Type = TextureType::Texture2D;
-        l_DepthVisDescription.Format = Format::RGBA8_UNORM;
-        l_DepthVisDescription.Usage = TextureUsage::Sampled | TextureUsage::RenderTarget;
-        l_DepthVisDescription.Width = width;
-        l_DepthVisDescription.Height = height;
-        l_DepthVisDescription.Depth = 1;
-        l_DepthVisDescription.MipLevels = 1;
-        l_DepthVisDescription.ArrayLayers = 1;
-        l_DepthVisDescription.SampleCount = 1;
-        l_DepthVisDescription.DebugName = "DepthVis";
-
-        m_DepthVis = m_Device.CreateTexture(l_DepthVisDescription);
-        if (!m_DepthVis.IsValid())
-        {
-
-
-            return false;
-        }
-
-        m_RenderWidth = width;
-        m_RenderHeight = height;
+        TextureDescription l_Description;
+        l_Description.Type = TextureType::Texture2D;
+        l_Description.Format = format;
+        l_Description.Usage = usage;
+        l_Description.Width = width;
+        l_Description.Height = height;
+        l_Description.Depth = 1;
+        l_Description.MipLevels = 1;
+        l_Description.ArrayLayers = 1;
+        l_Description.SampleCount = 1;
+        l_Description.DebugName = debugName;
 
-        return true;
+        return l_Description;
     }
 
-    void Renderer::DestroySceneTargets()
+    bool Renderer::CreateTextureResources()
     {
-        if (m_SceneColor.IsValid())
-        {
-            m_Device.DestroyTexture(m_SceneColor);
-            m_SceneColor = TextureHandle{};
-        }
-
-        if (m_SceneDepth.IsValid())
-        {
-            m_Device.DestroyTexture(m_SceneDepth);
-            m_SceneDepth = TextureHandle{};
-        }
-
-        if (m_DepthVis.IsValid())
-        {
-            m_Device.DestroyTexture(m_DepthVis);
-            m_DepthVis = TextureHandle{};
-        }
-
-        m_RenderWidth = 0;
-        m_RenderHeight = 0;
+        return m_TextureManager.Initialize();
     }
 
     void Renderer::SetViewportSize(uint32_t width, uint32_t height)
@@ -611,54 +748,28 @@ namespace Trinity
             return;
         }
 
-        m_Device.WaitIdle();
-        DestroyViewportOutput();
-        DestroySceneTargets();
-        CreateSceneTargets(m_PendingWidth, m_PendingHeight);
-        CreateViewportOutput(m_PendingWidth, m_PendingHeight);
+        // The targets are graph transients sized from the render extent; the next compile places textures of the new size, nothing needs to wait
+        m_RenderWidth = m_PendingWidth;
+        m_RenderHeight = m_PendingHeight;
         m_ViewportDirty = false;
     }
 
-    bool Renderer::CreateViewportOutput(uint32_t width, uint32_t height)
+    void Renderer::RefreshViewportTexture()
     {
-        TextureDescription l_Description;
-        l_Description.Type = TextureType::Texture2D;
-        l_Description.Format = m_Swapchain.GetFormat();
-        l_Description.Usage = TextureUsage::Sampled | TextureUsage::RenderTarget;
-        l_Description.Width = width;
-        l_Description.Height = height;
-        l_Description.Depth = 1;
-        l_Description.MipLevels = 1;
-        l_Description.ArrayLayers = 1;
-        l_Description.SampleCount = 1;
-        l_Description.DebugName = "ViewportColor";
-
-        m_ViewportColor = m_Device.CreateTexture(l_Description);
-        if (!m_ViewportColor.IsValid())
+        if (m_ViewportColor == m_ViewportTextureSource)
         {
-
-
-            return false;
+            return;
         }
 
-        m_ViewportTextureID = m_Device.GetImGuiBackend().RegisterTexture(m_ViewportColor);
-
-        return true;
-    }
-
-    void Renderer::DestroyViewportOutput()
-    {
+        // The editor draws with the new binding from the next frame on; the old one is released once the frame still using it retires
+        IImGuiRenderBackend& l_Backend = m_Device.GetImGuiBackend();
         if (m_ViewportTextureID != 0)
         {
-            m_Device.GetImGuiBackend().UnregisterTexture(m_ViewportTextureID);
-            m_ViewportTextureID = 0;
+            l_Backend.UnregisterTexture(m_ViewportTextureID);
         }
 
-        if (m_ViewportColor.IsValid())
-        {
-            m_Device.DestroyTexture(m_ViewportColor);
-            m_ViewportColor = TextureHandle{};
-        }
+        m_ViewportTextureID = m_ViewportColor.IsValid() ? l_Backend.RegisterTexture(m_ViewportColor) : 0;
+        m_ViewportTextureSource = m_ViewportColor;
     }
 
     void Renderer::LoadEnvironmentMap()
@@ -782,23 +893,20 @@ namespace Trinity
             l_Targets.push_back({ "DepthVis", m_DepthVis, m_RenderWidth, m_RenderHeight });
         }
 
+        if (m_OverdrawVisualize && m_Overdraw.IsValid())
+        {
+            l_Targets.push_back({ "Overdraw", m_Overdraw, m_RenderWidth, m_RenderHeight });
+        }
+
         return l_Targets;
     }
 
     bool Renderer::CreateShadowResources()
     {
-        TextureDescription l_Description;
-        l_Description.Type = TextureType::Texture2D;
-        l_Description.Format = Format::D32_SFLOAT;
-        l_Description.Usage = TextureUsage::DepthStencil | TextureUsage::Sampled;
-        l_Description.Width = k_ShadowMapSize;
-        l_Description.Height = k_ShadowMapSize;
-        l_Description.Depth = 1;
-        l_Description.MipLevels = 1;
-        l_Description.ArrayLayers = 1;
-        l_Description.SampleCount = 1;
-        l_Description.DebugName = "ShadowMap";
-
+        // One layer per cascade; copy destination for the static caster layer
+        TextureDescription l_Description = DescribeRenderTarget("ShadowMap", Format::D32_SFLOAT, TextureUsage::DepthStencil | TextureUsage::Sampled | TextureUsage::TransferDestination, k_ShadowMapSize, k_ShadowMapSize);
+        l_Description.Type = TextureType::Texture2DArray;
+        l_Description.ArrayLayers = k_ShadowCascadeCount;
         m_ShadowMap = m_Device.CreateTexture(l_Description);
         if (!m_ShadowMap.IsValid())
         {
@@ -816,90 +924,224 @@ namespace Trinity
         l_SamplerDescription.DebugName = "ShadowSampler";
         m_ShadowSampler = m_Device.CreateSampler(l_SamplerDescription);
 
-        std::filesystem::path l_ShaderDirectory = m_FileSystem.Resolve(BaseDirectory::Executable, "Shaders");
+        return m_ShadowSampler.IsValid();
+    }
 
-        ShaderCompileResult l_VertexResult = m_ShaderCompiler.Compile(l_ShaderDirectory, "Shadow", "vertexMain");
-        ShaderCompileResult l_FragmentResult = m_ShaderCompiler.Compile(l_ShaderDirectory, "Shadow", "fragmentMain");
-        if (!l_VertexResult.Success || !l_FragmentResult.Success)
+    bool Renderer::CreateShadowStaticMap()
+    {
+        if (m_ShadowStaticMap.IsValid())
         {
-
-
-            return false;
+            return true;
         }
 
-        ShaderDescription l_VertexDescription;
-        l_VertexDescription.Stage = ShaderStage::Vertex;
-        l_VertexDescription.Bytecode = l_VertexResult.SPIRV;
-        l_VertexDescription.EntryPoint = "vertexMain";
-        l_VertexDescription.DebugName = "Shadow.vertexMain";
-        m_ShadowVertex = m_Device.CreateShader(l_VertexDescription);
-
-        ShaderDescription l_FragmentDescription;
-        l_FragmentDescription.Stage = ShaderStage::Fragment;
-        l_FragmentDescription.Bytecode = l_FragmentResult.SPIRV;
-        l_FragmentDescription.EntryPoint = "fragmentMain";
-        l_FragmentDescription.DebugName = "Shadow.fragmentMain";
-        m_ShadowFragment = m_Device.CreateShader(l_FragmentDescription);
-
-        if (!m_ShadowVertex.IsValid() || !m_ShadowFragment.IsValid())
+        TextureDescription l_Description = DescribeRenderTarget("ShadowStaticMap", Format::D32_SFLOAT, TextureUsage::DepthStencil | TextureUsage::Sampled | TextureUsage::TransferSource, k_ShadowMapSize, k_ShadowMapSize);
+        l_Description.Type = TextureType::Texture2DArray;
+        l_Description.ArrayLayers = k_ShadowCascadeCount;
+        m_ShadowStaticMap = m_Device.CreateTexture(l_Description);
+        m_ShadowStaticMapReady = false;
+        for (ShadowCascade& it_Cascade : m_ShadowCascades)
         {
-            ("Renderer: shadow shader creation failed");
-
-            return false;
+            it_Cascade.StaticCache = ShadowCacheState{};
         }
 
-        // The shadow vertex shader only consumes Position, but the bound buffer is a full MeshVertex, so keep the stride and expose just location 0
-        VertexLayout l_ShadowLayout;
-        l_ShadowLayout.Stride = sizeof(MeshVertex);
-        l_ShadowLayout.Attributes = { { 0, offsetof(MeshVertex, Position), Format::RGB32_SFLOAT } };
+        return m_ShadowStaticMap.IsValid();
+    }
 
-        PipelineDescription l_PipelineDescription;
-        l_PipelineDescription.VertexShader = m_ShadowVertex;
-        l_PipelineDescription.FragmentShader = m_ShadowFragment;
-        l_PipelineDescription.Vertex = l_ShadowLayout;
+    PipelineCompileRequest Renderer::DescribeShadowPipeline() const
+    {
+        PipelineCompileRequest l_Request;
+        l_Request.SearchDirectory = m_FileSystem.Resolve(BaseDirectory::Executable, "Shaders");
+        l_Request.Vertex = { "Shadow", "vertexMain", {} };
+        l_Request.Fragment = { "Shadow", "fragmentMain", {} };
+
+        // The shadow vertex shader only consumes Position, so it reads the packed position stream and never touches the attributes
+        PipelineDescription& l_PipelineDescription = l_Request.Description;
+        l_PipelineDescription.Vertex = MeshVertex::GetPositionLayout();
         l_PipelineDescription.Topology = PrimitiveTopology::TriangleList;
         l_PipelineDescription.Rasterizer.Cull = CullMode::None;
         l_PipelineDescription.DepthStencil.DepthTest = true;
         l_PipelineDescription.DepthStencil.DepthWrite = true;
         l_PipelineDescription.DepthFormat = Format::D32_SFLOAT;
-        l_PipelineDescription.PushConstantSize = static_cast<uint32_t>(sizeof(glm::mat4));
+        l_PipelineDescription.PushConstantSize = static_cast<uint32_t>(sizeof(DepthPushConstants));
+
+        ResourceBinding l_InstanceBinding;
+        l_InstanceBinding.Set = 0;
+        l_InstanceBinding.Binding = 0;
+        l_InstanceBinding.Type = ResourceBindingType::DynamicStorageBuffer;
+        l_InstanceBinding.Stages = ShaderStage::Vertex;
+
+        l_PipelineDescription.Bindings = { l_InstanceBinding };
         l_PipelineDescription.DebugName = "Shadow";
 
-        m_ShadowPipeline = m_Device.CreatePipeline(l_PipelineDescription);
-        if (!m_ShadowPipeline.IsValid())
+        return l_Request;
+    }
+
+    PipelineCompileRequest Renderer::DescribePrepassPipeline() const
+    {
+        // Same shaders and position-only layout as the shadow pass, with the camera's matrix in the push constants; the vertex math matches Mesh.slang's and is marked
+        // precise in both, so the lit pass's equal test finds the exact depth written here
+        PipelineCompileRequest l_Request = DescribeShadowPipeline();
+        l_Request.Description.DebugName = "DepthPrepass";
+
+        return l_Request;
+    }
+
+    PipelineCompileRequest Renderer::DescribeOverdrawPipeline(bool afterPrepass) const
+    {
+        PipelineCompileRequest l_Request = DescribeShadowPipeline();
+        l_Request.Vertex = { "Overdraw", "vertexMain", {} };
+        l_Request.Fragment = { "Overdraw", "fragmentMain", {} };
+
+        // Replays the lit pass's depth test, so every fragment it would shade adds one step to the count. After a pre-pass that is the equal test against the
+        // scene depth, which is left untouched; without one the view builds depth of its own the way the lit pass does
+        PipelineDescription& l_PipelineDescription = l_Request.Description;
+        l_PipelineDescription.DepthStencil.DepthWrite = !afterPrepass;
+        l_PipelineDescription.DepthStencil.DepthCompare = afterPrepass ? CompareOp::Equal : CompareOp::LessEqual;
+        l_PipelineDescription.ColorFormats = { Format::RGBA8_UNORM };
+        l_PipelineDescription.Blend.Enabled = true;
+        l_PipelineDescription.Blend.Additive = true;
+        l_PipelineDescription.DebugName = afterPrepass ? "Overdraw.DepthEqual" : "Overdraw";
+
+        return l_Request;
+    }
+
+    PipelineCompileRequest Renderer::DescribeQuantizedPipeline(QuantizedPipeline pipeline, bool variant) const
+    {
+        PipelineCompileRequest l_Request;
+        switch (pipeline)
         {
+            case QuantizedPipeline::Mesh: l_Request = DescribeMeshPipeline(variant, false); break;
+            case QuantizedPipeline::Equal: l_Request = DescribeMeshPipeline(variant, true); break;
+            case QuantizedPipeline::Shadow: l_Request = DescribeShadowPipeline(); break;
+            case QuantizedPipeline::Prepass: l_Request = DescribePrepassPipeline(); break;
+            case QuantizedPipeline::Overdraw: l_Request = DescribeOverdrawPipeline(variant); break;
+            default: break;
+        }
 
+        // Same shaders and state; only the vertex formats and the decode in the vertex stage differ
+        const bool l_Lit = pipeline == QuantizedPipeline::Mesh || pipeline == QuantizedPipeline::Equal;
+        PipelineDescription& l_PipelineDescription = l_Request.Description;
+        l_PipelineDescription.Vertex = l_Lit ? MeshVertex::GetLayout(MeshVertexFormat::Quantized) : MeshVertex::GetPositionLayout(MeshVertexFormat::Quantized);
+        l_PipelineDescription.DebugName += ".Quantized";
+        l_Request.Vertex.Defines.push_back({ "TR_QUANTIZED", "1" });
 
-            return false;
+        return l_Request;
+    }
+
+    void Renderer::CompileQuantizedPipeline(QuantizedPipeline pipeline, bool variant)
+    {
+        QuantizedTwin& l_Twin = m_QuantizedPipelines[static_cast<size_t>(pipeline)];
+        m_PipelineCompiler.Discard(l_Twin.Pending);
+
+        l_Twin.Requested = true;
+        l_Twin.PendingVariant = variant;
+        l_Twin.Pending = m_PipelineCompiler.Compile(DescribeQuantizedPipeline(pipeline, variant));
+    }
+
+    PipelineHandle Renderer::GetQuantizedPipeline(QuantizedPipeline pipeline) const
+    {
+        const QuantizedTwin& l_Twin = m_QuantizedPipelines[static_cast<size_t>(pipeline)];
+        const bool l_Lit = pipeline == QuantizedPipeline::Mesh || pipeline == QuantizedPipeline::Equal;
+        if (l_Lit && l_Twin.Variant != m_BindlessActive)
+        {
+            return PipelineHandle{};
         }
 
-        return m_ShadowSampler.IsValid();
+        if (pipeline == QuantizedPipeline::Overdraw && l_Twin.Variant != m_OverdrawPrepass)
+        {
+            return PipelineHandle{};
+        }
+
+        return l_Twin.Pipeline;
     }
 
-    glm::mat4 Renderer::ComputeLightMatrix(const glm::vec3& direction) const
+    void Renderer::FitShadowCascades(const Camera& camera, const glm::vec3& direction)
     {
         glm::vec3 l_Direction = glm::normalize(direction);
 
         // Up vector guarded against a near-vertical light.
         glm::vec3 l_Up = glm::abs(l_Direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::mat3 l_LightRotation = glm::mat3(glm::lookAt(glm::vec3(0.0f), l_Direction, l_Up));
+
+        const float l_CameraNear = camera.GetNear();
+        const float l_CameraFar = camera.GetFar();
+        const float l_Far = std::max(std::min(l_CameraFar, m_ShadowDistance), l_CameraNear * 2.0f);
+
+        // Corners of the camera's near and far planes; a slice's corners lie on the edges between them, at its split depths
+        glm::mat4 l_InverseViewProjection = glm::inverse(camera.GetViewProjection());
+        std::array<glm::vec3, 8> l_Corners{};
+        for (uint32_t l_Index = 0; l_Index < 8; ++l_Index)
+        {
+            glm::vec4 l_Corner = l_InverseViewProjection * glm::vec4((l_Index & 1) ? 1.0f : -1.0f, (l_Index & 2) ? 1.0f : -1.0f, (l_Index & 4) ? 1.0f : 0.0f, 1.0f);
+            l_Corners[l_Index] = glm::vec3(l_Corner) / l_Corner.w;
+        }
+
+        float l_SplitNear = l_CameraNear;
+        for (uint32_t l_Index = 0; l_Index < k_ShadowCascadeCount; ++l_Index)
+        {
+            ShadowCascade& l_Cascade = m_ShadowCascades[l_Index];
+
+            // Practical split scheme: logarithmic splits match the perspective texel density, the uniform share keeps the first cascades from getting too thin
+            const float l_Fraction = static_cast<float>(l_Index + 1) / static_cast<float>(k_ShadowCascadeCount);
+            const float l_Logarithmic = l_CameraNear * std::pow(l_Far / l_CameraNear, l_Fraction);
+            const float l_Uniform = l_CameraNear + (l_Far - l_CameraNear) * l_Fraction;
+            const float l_SplitFar = glm::mix(l_Uniform, l_Logarithmic, k_ShadowSplitBlend);
+
+            const float l_NearBlend = (l_SplitNear - l_CameraNear) / (l_CameraFar - l_CameraNear);
+            const float l_FarBlend = (l_SplitFar - l_CameraNear) / (l_CameraFar - l_CameraNear);
+
+            std::array<glm::vec3, 8> l_Slice{};
+            glm::vec3 l_Center(0.0f);
+            for (uint32_t l_Corner = 0; l_Corner < 4; ++l_Corner)
+            {
+                l_Slice[l_Corner] = glm::mix(l_Corners[l_Corner], l_Corners[l_Corner + 4], l_NearBlend);
+                l_Slice[l_Corner + 4] = glm::mix(l_Corners[l_Corner], l_Corners[l_Corner + 4], l_FarBlend);
+                l_Center += l_Slice[l_Corner] + l_Slice[l_Corner + 4];
+            }
+
+            l_Center /= 8.0f;
+
+            // A bounding sphere keeps the cascade's size, and so its texel size, fixed while the camera turns
+            float l_Radius = 0.0f;
+            for (const glm::vec3& it_Corner : l_Slice)
+            {
+                l_Radius = std::max(l_Radius, glm::length(it_Corner - l_Center));
+            }
+
+            l_Radius = std::ceil(l_Radius * 16.0f) / 16.0f;
+            const float l_TexelSize = 2.0f * l_Radius / static_cast<float>(k_ShadowMapSize);
+
+            // Snap the center to whole texels across the light and to depth steps along it, so static casters rasterize the same way from frame to frame and
+            // the matrix, and with it the cached layer, only changes once the camera has moved far enough to matter
+            glm::vec3 l_LightCenter = l_LightRotation * l_Center;
+            l_LightCenter.x = std::floor(l_LightCenter.x / l_TexelSize) * l_TexelSize;
+            l_LightCenter.y = std::floor(l_LightCenter.y / l_TexelSize) * l_TexelSize;
+            l_LightCenter.z = std::floor(l_LightCenter.z / k_ShadowDepthStep) * k_ShadowDepthStep;
+            l_Center = glm::transpose(l_LightRotation) * l_LightCenter;
 
-        const float l_Radius = 25.0f;
-        glm::vec3 l_Center(0.0f);
-        glm::vec3 l_Eye = l_Center - l_Direction * 50.0f;
+            // Padded by the snapping error on every side; casters up to the reach behind the slice still land in the map
+            const float l_Extent = l_Radius + l_TexelSize;
+            const float l_Depth = 2.0f * l_Extent + k_ShadowCasterReach + k_ShadowDepthStep;
+            glm::vec3 l_Eye = l_Center - l_Direction * (l_Extent + k_ShadowCasterReach);
 
-        glm::mat4 l_View = glm::lookAt(l_Eye, l_Center, l_Up);
-        glm::mat4 l_Projection = glm::ortho(-l_Radius, l_Radius, -l_Radius, l_Radius, 0.1f, 100.0f);
+            glm::mat4 l_View = glm::lookAt(l_Eye, l_Center, l_Up);
+            glm::mat4 l_Projection = glm::ortho(-l_Extent, l_Extent, -l_Extent, l_Extent, 0.0f, l_Depth);
 
-        return l_Projection * l_View;
+            l_Cascade.LightViewProjection = l_Projection * l_View;
+            l_Cascade.SplitDistance = l_SplitFar;
+            l_Cascade.Bias = k_ShadowBiasTexels * l_TexelSize / l_Depth;
+
+            l_SplitNear = l_SplitFar;
+        }
     }
 
-    bool Renderer::ComputeShadowLight(Scene& scene, glm::mat4& outMatrix)
+    bool Renderer::ComputeShadowLight(Scene& scene, glm::vec3& outDirection)
     {
         glm::vec3 l_Direction(0.0f);
         bool l_Found = false;
         uint32_t l_LightCount = 0;
 
-        auto l_View = scene.GetRegistry().view<TransformComponent, LightComponent>();
+        auto l_View = scene.GetRegistry().view<WorldTransformComponent, LightComponent>();
         for (entt::entity l_Entity : l_View)
         {
             ++l_LightCount;
@@ -907,7 +1149,7 @@ namespace Trinity
             const LightComponent& l_Light = l_View.get<LightComponent>(l_Entity);
             if (!l_Found && l_Light.Type == LightType::Directional)
             {
-                glm::mat4 l_World = scene.GetWorldMatrix(l_Entity);
+                const glm::mat4& l_World = l_View.get<WorldTransformComponent>(l_Entity).World;
                 l_Direction = glm::normalize(glm::mat3(l_World) * glm::vec3(0.0f, 0.0f, -1.0f));
                 l_Found = true;
             }
@@ -924,36 +1166,531 @@ namespace Trinity
             l_Direction = glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f));
         }
 
-        outMatrix = ComputeLightMatrix(l_Direction);
+        outDirection = l_Direction;
 
         return true;
     }
 
-    void Renderer::DrawSceneDepth(CommandList& commandList, Scene& scene, const glm::mat4& lightViewProjection)
+    void Renderer::ReleaseScene(const Scene& scene)
+    {
+        std::erase_if(m_LodViews, [&scene](const LodView& view) { return view.SceneId == scene.GetInstanceId(); });
+    }
+
+    Renderer::LodView& Renderer::AcquireLodView(const Scene& scene, const Camera& camera)
     {
-        commandList.BindPipeline(m_ShadowPipeline);
+        ++m_LodFrame;
+
+        // A view that has gone quiet, such as a stopped play session's scene, takes its state with it; so do its entities that stopped drawing, swept now and then
+        std::erase_if(m_LodViews, [this](const LodView& view) { return view.Frame + k_LodRetireFrames < m_LodFrame; });
 
-        auto l_View = scene.GetRegistry().view<TransformComponent, MeshRendererComponent>();
+        const uint64_t l_SceneId = scene.GetInstanceId();
+        const uint32_t l_ViewId = camera.GetViewId();
+        auto l_Found = std::find_if(m_LodViews.begin(), m_LodViews.end(), [l_SceneId, l_ViewId](const LodView& view) { return view.SceneId == l_SceneId && view.ViewId == l_ViewId; });
+        if (l_Found == m_LodViews.end())
+        {
+            LodView& l_View = m_LodViews.emplace_back();
+            l_View.SceneId = l_SceneId;
+            l_View.ViewId = l_ViewId;
+            l_Found = std::prev(m_LodViews.end());
+        }
+
+        l_Found->Frame = m_LodFrame;
+        if (m_LodFrame % k_LodRetireFrames == 0)
+        {
+            std::erase_if(l_Found->Levels, [this](const auto& entry) { return entry.second.Frame + k_LodRetireFrames < m_LodFrame; });
+        }
+
+        return *l_Found;
+    }
+
+    void Renderer::ExtractRenderPackets(Scene& scene, AssetDatabase& assetDatabase, const Camera& camera)
+    {
+        Timer l_Timer;
+        m_Packets.clear();
+
+        // Pixels one unit spans at unit distance; a perspective projection divides it by the distance, an orthographic one spans it everywhere
+        const glm::mat4& l_Projection = camera.GetProjection();
+        const bool l_Perspective = l_Projection[2][3] != 0.0f;
+        const float l_PixelsPerUnit = 0.5f * l_Projection[1][1] * static_cast<float>(m_RenderHeight);
+        const glm::vec3 l_CameraPosition = camera.GetPosition();
+        LodView& l_LodView = AcquireLodView(scene, camera);
+
+        auto l_View = scene.GetRegistry().view<WorldTransformComponent, MeshRendererComponent>();
         for (entt::entity l_Entity : l_View)
         {
-            const MeshRendererComponent& l_MeshRenderer = l_View.get<MeshRendererComponent>(l_Entity);
+            MeshRendererComponent& l_MeshRenderer = l_View.get<MeshRendererComponent>(l_Entity);
             if (!l_MeshRenderer.MeshReference || !l_MeshRenderer.MeshReference->IsValid())
             {
                 continue;
             }
 
-            Mesh& l_Mesh = *l_MeshRenderer.MeshReference;
-            glm::mat4 l_MVP = lightViewProjection * scene.GetWorldMatrix(l_Entity);
+            const Mesh& l_Mesh = *l_MeshRenderer.MeshReference;
+            const std::vector<MaterialSlot>& l_Slots = l_Mesh.GetMaterialSlots();
+            const WorldTransformComponent& l_WorldTransform = l_View.get<WorldTransformComponent>(l_Entity);
+            const glm::mat4& l_World = l_WorldTransform.World;
+            const bool l_Dynamic = l_WorldTransform.StableUpdates < k_ShadowSettleFrames;
+            ++m_Stats.Meshes;
+
+            const bool l_Quantized = l_Mesh.GetVertexFormat() == MeshVertexFormat::Quantized;
+            m_QuantizedMeshes = m_QuantizedMeshes || l_Quantized;
+
+            const std::vector<Submesh>& l_Submeshes = l_Mesh.GetSubmeshes();
+
+            for (size_t l_SubmeshIndex = 0; l_SubmeshIndex < l_Submeshes.size(); ++l_SubmeshIndex)
+            {
+                const Submesh& it_Submesh = l_Submeshes[l_SubmeshIndex];
+                UUID l_MaterialAsset = it_Submesh.MaterialIndex < l_MeshRenderer.Materials.size() ? l_MeshRenderer.Materials[it_Submesh.MaterialIndex] : UUID(0);
+
+                uint32_t l_Material = 0;
+                if (static_cast<uint64_t>(l_MaterialAsset) == 0 && it_Submesh.MaterialIndex < l_Slots.size())
+                {
+                    l_Material = assetDatabase.CompileFallbackMaterial(l_Slots[it_Submesh.MaterialIndex].BaseColorFactor);
+                }
+                else
+                {
+                    l_Material = assetDatabase.CompileMaterial(l_MaterialAsset);
+                }
+
+                RenderPacket& l_Packet = m_Packets.emplace_back();
+                l_Packet.MeshSource = &l_Mesh;
+                l_Packet.FirstIndex = it_Submesh.FirstIndex;
+                l_Packet.IndexCount = it_Submesh.IndexCount;
+                l_Packet.BaseVertex = static_cast<int32_t>(it_Submesh.BaseVertex);
+                l_Packet.Material = l_Material;
+                l_Packet.World = l_World;
+                l_Packet.WorldSphere = it_Submesh.Bounds.TransformSphere(l_World);
+
+                // Errors are in mesh units; the world sphere's radius carries the instance's largest scale
+                uint32_t l_Lod = 0;
+                if (!it_Submesh.Lods.empty())
+                {
+                    const float l_Scale = it_Submesh.Bounds.Radius > 0.0f ? l_Packet.WorldSphere.w / it_Submesh.Bounds.Radius : 1.0f;
+                    const float l_Distance = std::max(glm::length(glm::vec3(l_Packet.WorldSphere) - l_CameraPosition) - l_Packet.WorldSphere.w, camera.GetNear());
+                    const float l_Pixels = l_PixelsPerUnit * l_Scale / (l_Perspective ? l_Distance : 1.0f);
+                    LodEntry& l_Entry = l_LodView.Levels[(static_cast<uint64_t>(entt::to_integral(l_Entity)) << 32) | l_SubmeshIndex];
+                    l_Lod = SelectSubmeshLod(it_Submesh, l_Pixels, m_LodThreshold, k_LodHysteresis, l_Entry.Level);
+                    l_Entry.Level = static_cast<uint8_t>(l_Lod);
+                    l_Entry.Frame = m_LodFrame;
+                }
+
+                if (l_Lod > 0)
+                {
+                    l_Packet.FirstIndex = it_Submesh.Lods[l_Lod - 1].FirstIndex;
+                    l_Packet.IndexCount = it_Submesh.Lods[l_Lod - 1].IndexCount;
+                    ++m_Stats.LodPackets;
+                }
+
+                const uint32_t l_ShadowLod = std::min(l_Lod + m_ShadowLodBias, static_cast<uint32_t>(it_Submesh.Lods.size()));
+                l_Packet.ShadowFirstIndex = l_ShadowLod > 0 ? it_Submesh.Lods[l_ShadowLod - 1].FirstIndex : it_Submesh.FirstIndex;
+                l_Packet.ShadowIndexCount = l_ShadowLod > 0 ? it_Submesh.Lods[l_ShadowLod - 1].IndexCount : it_Submesh.IndexCount;
+                m_Stats.ShadowLodPackets += l_ShadowLod > l_Lod ? 1u : 0u;
+                l_Packet.SortKey = MakeRenderSortKey(l_Quantized ? k_QuantizedMeshPipelineKey : k_MeshPipelineKey, l_Packet.Material, l_Mesh.GetSortID());
+                l_Packet.Dynamic = l_Dynamic;
+            }
+        }
+
+        m_Stats.ExtractMilliseconds = l_Timer.ElapsedMilliseconds();
+        l_Timer.Reset();
+
+        // Submeshes of one mesh share a key; ordering them by index range keeps identical draws adjacent so they batch into one instanced call. Extraction order
+        // breaks the remaining ties, so the frame's order does not depend on the sort implementation
+        m_PacketOrder.resize(m_Packets.size());
+        for (size_t l_Index = 0; l_Index < m_Packets.size(); ++l_Index)
+        {
+            m_PacketOrder[l_Index] = { m_Packets[l_Index].SortKey, m_Packets[l_Index].FirstIndex, static_cast<uint32_t>(l_Index) };
+        }
+
+        std::sort(m_PacketOrder.begin(), m_PacketOrder.end(), [](const PacketSortEntry& a, const PacketSortEntry& b)
+            {
+                if (a.Key != b.Key)
+                {
+                    return a.Key < b.Key;
+                }
+
+                if (a.FirstIndex != b.FirstIndex)
+                {
+                    return a.FirstIndex < b.FirstIndex;
+                }
+
+                return a.Packet < b.Packet;
+            });
+
+        m_PacketScratch.clear();
+        for (const PacketSortEntry& it_Entry : m_PacketOrder)
+        {
+            m_PacketScratch.push_back(m_Packets[it_Entry.Packet]);
+        }
+
+        std::swap(m_Packets, m_PacketScratch);
+
+        m_PacketSpheres.Clear();
+        m_PacketSpheres.Reserve(m_Packets.size());
+        for (const RenderPacket& it_Packet : m_Packets)
+        {
+            m_PacketSpheres.Push(it_Packet.WorldSphere);
+        }
+
+        m_Stats.Packets = static_cast<uint32_t>(m_Packets.size());
+        m_Stats.SortMilliseconds = l_Timer.ElapsedMilliseconds();
+    }
+
+    void Renderer::PlanShadowUpdate()
+    {
+        m_ShadowLayered = m_ShadowCasterLayers && CreateShadowStaticMap();
+
+        const PipelineHandle l_QuantizedShadowPipeline = GetQuantizedPipeline(QuantizedPipeline::Shadow);
+        auto a_IsCurrent = [this, l_QuantizedShadowPipeline](const ShadowCacheState& cache, uint64_t hash)
+            {
+                return m_ShadowCaching && cache.Valid && cache.Pipeline == m_ShadowPipeline && cache.QuantizedShadowPipeline == l_QuantizedShadowPipeline && cache.Hash == hash;
+            };
+
+        auto a_Store = [this, l_QuantizedShadowPipeline](ShadowCacheState& cache, uint64_t hash, const ShadowCascade& cascade)
+            {
+                // A redraw only fills the cache once the shadow pipeline exists; until then the pass just clears. Quantized casters missed while their twin
+                // compiles are caught by the redraw its arrival triggers
+                cache.Hash = hash;
+                cache.Pipeline = m_ShadowPipeline;
+                cache.QuantizedShadowPipeline = l_QuantizedShadowPipeline;
+                cache.LightViewProjection = cascade.LightViewProjection;
+                cache.Bias = cascade.Bias;
+                cache.Valid = m_ShadowPipeline.IsValid();
+            };
+
+        for (uint32_t l_CascadeIndex = 0; l_CascadeIndex < k_ShadowCascadeCount; ++l_CascadeIndex)
+        {
+            ShadowCascade& l_Cascade = m_ShadowCascades[l_CascadeIndex];
+            l_Cascade.Draw = false;
+            l_Cascade.DrawStatic = false;
+            if (!m_ShadowActive)
+            {
+                continue;
+            }
+
+            if (m_ShadowLayered)
+            {
+                l_Cascade.StaticVisibility.assign(l_Cascade.Visibility.size(), 0);
+            }
+
+            // The static layer depends on the cascade's light matrix and its settled casters. The layer sampled is that plus the moving casters, so its hash
+            // covers both; without caster layers every caster counts as static and only the sampled layer is kept
+            uint64_t l_StaticHash = k_HashOffset;
+            uint64_t l_DynamicHash = k_HashOffset;
+            HashWords(l_StaticHash, &l_Cascade.LightViewProjection, sizeof(l_Cascade.LightViewProjection));
+
+            for (size_t l_Index = 0; l_Index < m_Packets.size(); ++l_Index)
+            {
+                if (l_Cascade.Visibility[l_Index] == 0)
+                {
+                    continue;
+                }
+
+                const RenderPacket& l_Packet = m_Packets[l_Index];
+                if (m_ShadowLayered && !l_Packet.Dynamic)
+                {
+                    HashShadowCaster(l_StaticHash, l_Packet);
+                    l_Cascade.StaticVisibility[l_Index] = 1;
+                    l_Cascade.Visibility[l_Index] = 0;
+                }
+                else
+                {
+                    HashShadowCaster(l_DynamicHash, l_Packet);
+                }
+            }
+
+            uint64_t l_Hash = l_StaticHash;
+            HashWords(l_Hash, &l_DynamicHash, sizeof(l_DynamicHash));
+
+            // A stale layer waits for its cascade's turn unless it holds nothing usable. Turns are staggered so the slower cascades do not land on one frame.
+            // The static layer only changes along with the sampled one, since the latter's hash covers it, so both are redrawn together and stay in step
+            const ShadowCacheState& l_Cache = l_Cascade.Cache;
+            const bool l_Due = !m_ShadowCaching || (m_ShadowFrame + l_CascadeIndex) % k_ShadowCascadeIntervals[l_CascadeIndex] == 0;
+            const bool l_Unusable = !l_Cache.Valid || l_Cache.Pipeline != m_ShadowPipeline;
+            l_Cascade.Draw = !a_IsCurrent(l_Cache, l_Hash) && (l_Due || l_Unusable);
+            l_Cascade.DrawStatic = l_Cascade.Draw && m_ShadowLayered && !a_IsCurrent(l_Cascade.StaticCache, l_StaticHash);
+
+            if (l_Cascade.DrawStatic)
+            {
+                a_Store(l_Cascade.StaticCache, l_StaticHash, l_Cascade);
+            }
+
+            if (l_Cascade.Draw)
+            {
+                a_Store(l_Cascade.Cache, l_Hash, l_Cascade);
+                ++m_Stats.ShadowUpdates;
+                m_Stats.ShadowStaticCacheHits += m_ShadowLayered && !l_Cascade.DrawStatic ? 1u : 0u;
+            }
+            else
+            {
+                ++m_Stats.ShadowCacheHits;
+            }
+        }
+
+        ++m_ShadowFrame;
+    }
+
+    void Renderer::BuildInstanceBatches(const AssetDatabase& assetDatabase, const Camera& camera)
+    {
+        m_Instances.clear();
+        m_SceneBatches.clear();
+        m_PrepassBatches.clear();
+        m_InstanceMemory = FrameAllocation{};
+
+        // Cached shadow layers are not redrawn, so their casters need no instance data
+        AppendInstanceBatches(m_CameraVisibility, true, false, m_SceneBatches, assetDatabase);
+        if (m_PrepassActive)
+        {
+            SortPrepassPackets(camera);
+            for (uint32_t it_Packet : m_PrepassOrder)
+            {
+                AppendInstance(it_Packet, false, false, m_PrepassBatches, assetDatabase);
+            }
+        }
+
+        for (ShadowCascade& it_Cascade : m_ShadowCascades)
+        {
+            it_Cascade.Batches.clear();
+            it_Cascade.StaticBatches.clear();
+            if (it_Cascade.Draw)
+            {
+                AppendInstanceBatches(it_Cascade.Visibility, false, true, it_Cascade.Batches, assetDatabase);
+            }
+
+            if (it_Cascade.DrawStatic)
+            {
+                AppendInstanceBatches(it_Cascade.StaticVisibility, false, true, it_Cascade.StaticBatches, assetDatabase);
+            }
+        }
+
+        if (m_Instances.empty())
+        {
+            return;
+        }
+
+        m_InstanceMemory = AllocateStorage(m_Device, m_Instances.data(), static_cast<uint32_t>(m_Instances.size()), k_MinInstanceCapacity, sizeof(GpuInstance));
+        if (!m_InstanceMemory.IsValid())
+        {
+            m_SceneBatches.clear();
+            m_PrepassBatches.clear();
+            for (ShadowCascade& it_Cascade : m_ShadowCascades)
+            {
+                it_Cascade.Batches.clear();
+                it_Cascade.StaticBatches.clear();
+            }
+        }
+    }
+
+    void Renderer::AppendInstanceBatches(const std::vector<uint8_t>& visibility, bool matchMaterial, bool shadowDetail, std::vector<InstanceBatch>& outBatches, const AssetDatabase& assetDatabase)
+    {
+        for (size_t l_Index = 0; l_Index < m_Packets.size(); ++l_Index)
+        {
+            if (visibility[l_Index] != 0)
+            {
+                AppendInstance(static_cast<uint32_t>(l_Index), matchMaterial, shadowDetail, outBatches, assetDatabase);
+            }
+        }
+    }
+
+    void Renderer::AppendInstance(uint32_t packet, bool matchMaterial, bool shadowDetail, std::vector<InstanceBatch>& outBatches, const AssetDatabase& assetDatabase)
+    {
+        const RenderPacket& l_Packet = m_Packets[packet];
+        const uint32_t l_FirstIndex = shadowDetail ? l_Packet.ShadowFirstIndex : l_Packet.FirstIndex;
+        const uint32_t l_IndexCount = shadowDetail ? l_Packet.ShadowIndexCount : l_Packet.IndexCount;
+
+        // Culled packets in between do not break a run; only a change of geometry (or material, for the lit pass) does
+        bool l_Extends = false;
+        if (!outBatches.empty())
+        {
+            const InstanceBatch& l_Run = outBatches.back();
+            const RenderPacket& l_First = m_Packets[l_Run.Packet];
+            l_Extends = l_First.MeshSource == l_Packet.MeshSource && l_Run.FirstIndex == l_FirstIndex && l_Run.IndexCount == l_IndexCount
+                && l_First.BaseVertex == l_Packet.BaseVertex && (!matchMaterial || l_First.Material == l_Packet.Material);
+        }
+
+        if (!l_Extends)
+        {
+            InstanceBatch& l_Batch = outBatches.emplace_back();
+            l_Batch.Packet = packet;
+            l_Batch.FirstInstance = static_cast<uint32_t>(m_Instances.size());
+            l_Batch.FirstIndex = l_FirstIndex;
+            l_Batch.IndexCount = l_IndexCount;
+        }
+
+        ++outBatches.back().InstanceCount;
+
+        GpuInstance& l_Instance = m_Instances.emplace_back();
+        l_Instance.Model = l_Packet.World;
+        if (matchMaterial)
+        {
+            l_Instance.Material = assetDatabase.GetResolvedMaterial(l_Packet.Material).Factors;
+        }
+    }
+
+    void Renderer::SortPrepassPackets(const Camera& camera)
+    {
+        const glm::mat4& l_View = camera.GetView();
+        const glm::vec3 l_Forward(-l_View[0][2], -l_View[1][2], -l_View[2][2]);
+        const glm::vec3 l_Position = camera.GetPosition();
+
+        m_PrepassOrder.clear();
+        m_PrepassKeys.resize(m_Packets.size());
+        for (size_t l_Index = 0; l_Index < m_Packets.size(); ++l_Index)
+        {
+            if (m_CameraVisibility[l_Index] == 0)
+            {
+                continue;
+            }
+
+            // Quarter-octave buckets of the nearest point's view depth: strict enough that near occluders go first, coarse enough that copies of a mesh at
+            // similar depths land in one bucket and keep batching. The low half is the packet's mesh ID, and the top bit sends quantized meshes into a second
+            // front-to-back sweep rather than switching pipelines between buckets
+            const RenderPacket& l_Packet = m_Packets[l_Index];
+            const float l_Depth = glm::dot(glm::vec3(l_Packet.WorldSphere) - l_Position, l_Forward) - l_Packet.WorldSphere.w;
+            const uint64_t l_Bucket = l_Depth > 1.0f ? std::min<uint64_t>(static_cast<uint64_t>(std::log2(l_Depth) * 4.0f) + 1, 0x7FFFFFFF) : 0;
+            const uint64_t l_Quantized = l_Packet.MeshSource->GetVertexFormat() == MeshVertexFormat::Quantized ? 1ull << 63 : 0;
+            m_PrepassKeys[l_Index] = l_Quantized | (l_Bucket << 32) | (l_Packet.SortKey & 0xFFFFFFFFull);
+            m_PrepassOrder.push_back(static_cast<uint32_t>(l_Index));
+        }
+
+        std::sort(m_PrepassOrder.begin(), m_PrepassOrder.end(), [this](uint32_t a, uint32_t b)
+            {
+                if (m_PrepassKeys[a] != m_PrepassKeys[b])
+                {
+                    return m_PrepassKeys[a] < m_PrepassKeys[b];
+                }
+
+                if (m_Packets[a].FirstIndex != m_Packets[b].FirstIndex)
+                {
+                    return m_Packets[a].FirstIndex < m_Packets[b].FirstIndex;
+                }
+
+                return a < b;
+            });
+    }
+
+    bool Renderer::UploadLightClusters(const Camera& camera)
+    {
+        m_LightClusters.Build(camera.GetView(), camera.GetProjection(), camera.GetNear(), camera.GetFar(), m_ClusteredLights, m_JobSystem);
+
+        const std::vector<LightClusterRange>& l_Ranges = m_LightClusters.GetRanges();
+        const std::vector<uint32_t>& l_Indices = m_LightClusters.GetIndices();
+        m_ClusterMemory.Lights = AllocateStorage(m_Device, m_ClusteredLights.data(), static_cast<uint32_t>(m_ClusteredLights.size()), k_MinLightCapacity, sizeof(GpuLight));
+        m_ClusterMemory.Ranges = AllocateStorage(m_Device, l_Ranges.data(), static_cast<uint32_t>(l_Ranges.size()), m_LightClusters.GetClusterCount(), sizeof(LightClusterRange));
+        m_ClusterMemory.Indices = AllocateStorage(m_Device, l_Indices.data(), static_cast<uint32_t>(l_Indices.size()), k_MinLightIndexCapacity, sizeof(uint32_t));
+        if (!m_ClusterMemory.Lights.IsValid() || !m_ClusterMemory.Ranges.IsValid() || !m_ClusterMemory.Indices.IsValid())
+        {
+            return false;
+        }
+
+        const LightClusterStats& l_ClusterStats = m_LightClusters.GetStats();
+        m_Stats.Lights = l_ClusterStats.Lights;
+        m_Stats.LightIndices = l_ClusterStats.Indices;
+        m_Stats.MaxLightsPerCluster = l_ClusterStats.MaxPerCluster;
+
+        return true;
+    }
+
+    void Renderer::DrawShadowCascades(CommandList& commandList, TextureHandle target, bool staticLayer, bool clear)
+    {
+        for (uint32_t l_Index = 0; l_Index < k_ShadowCascadeCount; ++l_Index)
+        {
+            const ShadowCascade& l_Cascade = m_ShadowCascades[l_Index];
+            if (!(staticLayer ? l_Cascade.DrawStatic : l_Cascade.Draw))
+            {
+                continue;
+            }
+
+            DepthAttachment l_Depth;
+            l_Depth.Target = target;
+            l_Depth.Clear = clear;
+            l_Depth.ClearDepth = 1.0f;
+            l_Depth.ArrayLayer = l_Index;
+
+            RenderingInfo l_RenderingInfo;
+            l_RenderingInfo.Depth = &l_Depth;
+            l_RenderingInfo.Width = k_ShadowMapSize;
+            l_RenderingInfo.Height = k_ShadowMapSize;
+            commandList.BeginRendering(l_RenderingInfo);
+
+            Viewport l_Viewport;
+            l_Viewport.Width = static_cast<float>(k_ShadowMapSize);
+            l_Viewport.Height = static_cast<float>(k_ShadowMapSize);
+            commandList.SetViewport(l_Viewport);
+
+            Scissor l_Scissor;
+            l_Scissor.Width = k_ShadowMapSize;
+            l_Scissor.Height = k_ShadowMapSize;
+            commandList.SetScissor(l_Scissor);
 
-            commandList.BindVertexBuffer(l_Mesh.GetVertexBuffer(), 0);
-            commandList.BindIndexBuffer(l_Mesh.GetIndexBuffer(), 0);
+            DrawSceneDepth(commandList, m_ShadowPipeline, GetQuantizedPipeline(QuantizedPipeline::Shadow), l_Cascade.LightViewProjection, staticLayer ? l_Cascade.StaticBatches : l_Cascade.Batches, m_Stats.ShadowDrawCalls, m_Stats.ShadowInstances);
+
+            commandList.EndRendering();
+        }
+    }
 
-            for (const Submesh& l_Submesh : l_Mesh.GetSubmeshes())
+    void Renderer::DrawSceneDepth(CommandList& commandList, PipelineHandle pipeline, PipelineHandle quantizedPipeline, const glm::mat4& viewProjection,
+        const std::vector<InstanceBatch>& batches, uint32_t& drawCalls, uint32_t& instances)
+    {
+        if (batches.empty() || (!pipeline.IsValid() && !quantizedPipeline.IsValid()))
+        {
+            return;
+        }
+
+        commandList.BindDynamicStorageBuffer(0, 0, m_InstanceMemory);
+
+        // Both variants share the layout, so the matrix pushed once stays resident across a switch between them
+        DepthPushConstants l_PushConstants{};
+        l_PushConstants.ViewProjection = viewProjection;
+        commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, 0, static_cast<uint32_t>(sizeof(l_PushConstants)), &l_PushConstants);
+
+        PipelineHandle l_BoundPipeline{};
+        const Mesh* l_BoundMesh = nullptr;
+        for (const InstanceBatch& it_Batch : batches)
+        {
+            const RenderPacket& l_Packet = m_Packets[it_Batch.Packet];
+            const Mesh& l_Mesh = *l_Packet.MeshSource;
+            const bool l_Quantized = l_Mesh.GetVertexFormat() == MeshVertexFormat::Quantized;
+
+            // A quantized mesh waits for its twin rather than going through a pipeline that would misread its stream
+            const PipelineHandle l_Pipeline = l_Quantized ? quantizedPipeline : pipeline;
+            if (!l_Pipeline.IsValid())
             {
-                commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, 0, static_cast<uint32_t>(sizeof(glm::mat4)), &l_MVP);
-                commandList.DrawIndexed(l_Submesh.IndexCount, 1, l_Submesh.FirstIndex, static_cast<int32_t>(l_Submesh.BaseVertex), 0);
-                ++m_Stats.ShadowDrawCalls;
+                continue;
             }
+
+            if (l_Pipeline != l_BoundPipeline)
+            {
+                commandList.BindPipeline(l_Pipeline);
+                l_BoundPipeline = l_Pipeline;
+            }
+
+            if (&l_Mesh != l_BoundMesh)
+            {
+                commandList.BindVertexBuffer(l_Mesh.GetVertexBuffer(), 0, 0);
+                commandList.BindIndexBuffer(l_Mesh.GetIndexBuffer(), 0, l_Mesh.GetIndexType());
+                l_BoundMesh = &l_Mesh;
+                m_Stats.Binds += 2;
+
+                if (l_Quantized)
+                {
+                    const MeshQuantizationBox& l_Box = l_Mesh.GetQuantizationBox();
+                    const glm::vec4 l_Range[2] = { glm::vec4(l_Box.Scale, 0.0f), glm::vec4(l_Box.Offset, 0.0f) };
+                    commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, static_cast<uint32_t>(offsetof(DepthPushConstants, PositionScale)), static_cast<uint32_t>(sizeof(l_Range)), l_Range);
+                }
+            }
+            else
+            {
+                m_Stats.BindsSkipped += 2;
+            }
+
+            // The matrix stays resident; only the batch offset changes between draws
+            commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, static_cast<uint32_t>(offsetof(DepthPushConstants, InstanceOffset)), static_cast<uint32_t>(sizeof(uint32_t)), &it_Batch.FirstInstance);
+            commandList.DrawIndexed(it_Batch.IndexCount, it_Batch.InstanceCount, it_Batch.FirstIndex, l_Packet.BaseVertex, 0);
+            ++drawCalls;
+            instances += it_Batch.InstanceCount;
+
+            const uint64_t l_Fetches = static_cast<uint64_t>(it_Batch.IndexCount) * it_Batch.InstanceCount;
+            m_Stats.VertexFetchBytes += l_Fetches * l_Mesh.GetPositionStride();
+            m_Stats.VertexFetchBytesSaved += l_Fetches * l_Mesh.GetAttributeStride();
         }
     }
 
@@ -961,170 +1698,207 @@ namespace Trinity
     {
         FrameData l_FrameData{};
         l_FrameData.ViewProjection = camera.GetViewProjection();
+        l_FrameData.View = camera.GetView();
         l_FrameData.CameraPosition = glm::vec4(camera.GetPosition(), 1.0f);
         l_FrameData.AmbientAndCount = glm::vec4(0.03f, 0.03f, 0.03f, 0.0f);
 
-        uint32_t l_LightCount = 0;
-        auto l_LightView = scene.GetRegistry().view<TransformComponent, LightComponent>();
+        uint32_t l_DirectionalCount = 0;
+        m_ClusteredLights.clear();
+
+        auto l_LightView = scene.GetRegistry().view<WorldTransformComponent, LightComponent>();
         for (entt::entity l_Entity : l_LightView)
         {
-            if (l_LightCount >= k_MaxLights)
+            const LightComponent& l_Light = l_LightView.get<LightComponent>(l_Entity);
+            if (l_Light.Type == LightType::Directional && l_DirectionalCount >= k_MaxDirectionalLights)
             {
-                break;
+                continue;
             }
 
-            const LightComponent& l_Light = l_LightView.get<LightComponent>(l_Entity);
-
-            glm::mat4 l_World = scene.GetWorldMatrix(l_Entity);
+            const glm::mat4& l_World = l_LightView.get<WorldTransformComponent>(l_Entity).World;
             glm::vec3 l_Position = glm::vec3(l_World[3]);
             glm::vec3 l_Direction = glm::normalize(glm::mat3(l_World) * glm::vec3(0.0f, 0.0f, -1.0f));
 
-            GpuLight& l_GpuLight = l_FrameData.Lights[l_LightCount];
+            GpuLight& l_GpuLight = l_Light.Type == LightType::Directional ? l_FrameData.DirectionalLights[l_DirectionalCount++] : m_ClusteredLights.emplace_back();
             l_GpuLight.PositionType = glm::vec4(l_Position, static_cast<float>(l_Light.Type));
             l_GpuLight.DirectionRange = glm::vec4(l_Direction, l_Light.Range);
             l_GpuLight.ColorIntensity = glm::vec4(l_Light.Color, l_Light.Intensity);
             l_GpuLight.SpotAngles = glm::vec4(std::cos(l_Light.InnerConeAngle), std::cos(l_Light.OuterConeAngle), 0.0f, 0.0f);
-
-            ++l_LightCount;
         }
 
         // Fall back to a default directional light so scenes authored before lights existed remain visible.
-        if (l_LightCount == 0)
+        if (l_DirectionalCount == 0 && m_ClusteredLights.empty())
         {
-            GpuLight& l_GpuLight = l_FrameData.Lights[0];
+            GpuLight& l_GpuLight = l_FrameData.DirectionalLights[0];
             l_GpuLight.PositionType = glm::vec4(0.0f, 0.0f, 0.0f, static_cast<float>(LightType::Directional));
             l_GpuLight.DirectionRange = glm::vec4(glm::normalize(glm::vec3(-0.5f, -1.0f, -0.3f)), 0.0f);
             l_GpuLight.ColorIntensity = glm::vec4(1.0f, 1.0f, 1.0f, 3.0f);
             l_GpuLight.SpotAngles = glm::vec4(0.0f);
 
-            l_LightCount = 1;
+            l_DirectionalCount = 1;
         }
 
-        l_FrameData.AmbientAndCount.a = static_cast<float>(l_LightCount);
+        bool l_Clustered = UploadLightClusters(camera);
+
+        l_FrameData.AmbientAndCount.a = static_cast<float>(l_DirectionalCount);
         l_FrameData.IblParams = glm::vec4(m_EnvironmentMap.IsValid() ? 1.0f : 0.0f, static_cast<float>(k_PrefilterMips - 1), 0.0f, 0.0f);
-        l_FrameData.LightViewProjection = m_ShadowLightViewProjection;
-        l_FrameData.ShadowParams = glm::vec4(m_ShadowActive ? 1.0f : 0.0f, k_ShadowBias, 0.0f, 1.0f / static_cast<float>(k_ShadowMapSize));
 
-        BufferHandle l_FrameUniform = m_FrameUniforms[m_FrameIndex];
-        m_Device.UpdateBuffer(l_FrameUniform, &l_FrameData, sizeof(FrameData), 0);
+        // Layers are sampled with the matrix they were drawn with, which lags the fitted one while a cascade waits for its update
+        for (uint32_t l_Index = 0; l_Index < k_ShadowCascadeCount; ++l_Index)
+        {
+            const ShadowCascade& l_Cascade = m_ShadowCascades[l_Index];
+            l_FrameData.CascadeViewProjections[l_Index] = l_Cascade.Cache.LightViewProjection;
+            l_FrameData.CascadeSplits[l_Index] = l_Cascade.Cache.Valid ? l_Cascade.SplitDistance : -1.0f;
+            l_FrameData.CascadeBias[l_Index] = l_Cascade.Cache.Bias;
+        }
 
-        commandList.BindPipeline(m_Pipeline);
-        commandList.BindUniformBuffer(0, 0, l_FrameUniform, 0, sizeof(FrameData));
-        commandList.BindTexture(5, 0, m_IrradianceMap, m_IblCubeSampler);
-        commandList.BindTexture(6, 0, m_PrefilteredMap, m_IblCubeSampler);
-        commandList.BindTexture(7, 0, m_BrdfLut, m_BrdfSampler);
-        commandList.BindTexture(8, 0, m_ShadowMap, m_ShadowSampler);
+        l_FrameData.ShadowParams = glm::vec4(m_ShadowActive ? 1.0f : 0.0f, 0.0f, static_cast<float>(k_ShadowCascadeCount), 1.0f / static_cast<float>(k_ShadowMapSize));
 
-        SamplerHandle l_Sampler = m_TextureManager.DefaultSampler();
+        glm::vec2 l_SliceScaleBias = m_LightClusters.GetSliceScaleBias();
+        l_FrameData.ClusterGrid = glm::uvec4(m_LightClusters.GetTilesX(), m_LightClusters.GetTilesY(), m_LightClusters.GetSlices(), l_Clustered ? static_cast<uint32_t>(m_ClusteredLights.size()) : 0u);
+        l_FrameData.ClusterParams = glm::vec4(l_SliceScaleBias.x, l_SliceScaleBias.y, static_cast<float>(m_LightClusters.GetTilesX()) / static_cast<float>(std::max(m_RenderWidth, 1u)), static_cast<float>(m_LightClusters.GetTilesY()) / static_cast<float>(std::max(m_RenderHeight, 1u)));
 
-        auto l_View = scene.GetRegistry().view<TransformComponent, MeshRendererComponent>();
-        for (entt::entity l_Entity : l_View)
+        // The first compile has not landed yet; the skybox and debug lines still draw
+        FrameAllocation l_FrameUniform = m_Device.AllocateFrameMemory(sizeof(FrameData), BufferUsage::Uniform);
+        if (!m_Pipeline.IsValid() || !l_FrameUniform.IsValid())
         {
-            const MeshRendererComponent& l_MeshRenderer = l_View.get<MeshRendererComponent>(l_Entity);
-            if (!l_MeshRenderer.MeshReference || !l_MeshRenderer.MeshReference->IsValid())
-            {
-                continue;
-            }
-
-            Mesh& l_Mesh = *l_MeshRenderer.MeshReference;
-            const std::vector<MaterialSlot>& l_Slots = l_Mesh.GetMaterialSlots();
-            ++m_Stats.Meshes;
+            return;
+        }
 
-            glm::mat4 l_Model = scene.GetWorldMatrix(l_Entity);
+        std::memcpy(l_FrameUniform.Data, &l_FrameData, sizeof(FrameData));
 
-            commandList.BindVertexBuffer(l_Mesh.GetVertexBuffer(), 0);
-            commandList.BindIndexBuffer(l_Mesh.GetIndexBuffer(), 0);
+        // After the pre-pass the depth buffer already holds each pixel's nearest surface, so only that one is shaded and depth is left as it is
+        PipelineHandle l_Pipeline = m_Pipeline;
+        PipelineHandle l_QuantizedPipeline = GetQuantizedPipeline(QuantizedPipeline::Mesh);
+        if (m_PrepassActive && m_EqualPipeline.IsValid() && m_EqualBindless == m_BindlessActive)
+        {
+            l_Pipeline = m_EqualPipeline;
 
-            for (const Submesh& l_Submesh : l_Mesh.GetSubmeshes())
+            // The quantized pre-pass decodes positions with the same math, so its depth matches the equal test bit for bit. Until both twins exist the
+            // quantized meshes are depth-tested as usual, since the pre-pass may not have written them
+            if (GetQuantizedPipeline(QuantizedPipeline::Prepass).IsValid() && GetQuantizedPipeline(QuantizedPipeline::Equal).IsValid())
             {
-                MeshPushConstants l_PushConstants;
-                l_PushConstants.Model = l_Model;
-                l_PushConstants.BaseColorFactor = glm::vec4(1.0f);
-                l_PushConstants.PbrFactors = glm::vec4(0.0f, 0.5f, 1.0f, 1.0f);
-                l_PushConstants.EmissiveFactor = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-
-                TextureHandle l_BaseColor = m_TextureManager.White();
-                TextureHandle l_Normal = m_TextureManager.Normal();
-                TextureHandle l_MetallicRoughness = m_TextureManager.White();
-                TextureHandle l_Emissive = m_TextureManager.White();
-
-                UUID l_MaterialAsset = l_Submesh.MaterialIndex < l_MeshRenderer.Materials.size() ? l_MeshRenderer.Materials[l_Submesh.MaterialIndex] : UUID(0);
-                if (static_cast<uint64_t>(l_MaterialAsset) != 0)
-                {
-                    std::shared_ptr<Material> l_Material = assetDatabase.ResolveMaterial(l_MaterialAsset);
-                    if (l_Material)
-                    {
-                        if (const MaterialParameter* l_Factor = l_Material->FindParameter(Material::BaseColorFactor))
-                        {
-                            l_PushConstants.BaseColorFactor = l_Factor->AsVec4();
-                        }
+                l_QuantizedPipeline = GetQuantizedPipeline(QuantizedPipeline::Equal);
+            }
+        }
 
-                        if (const MaterialParameter* l_Metallic = l_Material->FindParameter(Material::MetallicFactor))
-                        {
-                            l_PushConstants.PbrFactors.x = l_Metallic->AsFloat();
-                        }
+        commandList.BindPipeline(l_Pipeline);
+        commandList.BindDynamicUniformBuffer(0, 0, l_FrameUniform);
+        commandList.BindTexture(5, 0, m_IrradianceMap, m_IblCubeSampler);
+        commandList.BindTexture(6, 0, m_PrefilteredMap, m_IblCubeSampler);
+        commandList.BindTexture(7, 0, m_BrdfLut, m_BrdfSampler);
+        commandList.BindTexture(8, 0, m_ShadowMap, m_ShadowSampler);
 
-                        if (const MaterialParameter* l_Roughness = l_Material->FindParameter(Material::RoughnessFactor))
-                        {
-                            l_PushConstants.PbrFactors.y = l_Roughness->AsFloat();
-                        }
+        if (m_SceneBatches.empty())
+        {
+            return;
+        }
 
-                        if (const MaterialParameter* l_Occlusion = l_Material->FindParameter(Material::OcclusionStrength))
-                        {
-                            l_PushConstants.PbrFactors.z = l_Occlusion->AsFloat();
-                        }
+        // Bound at full capacity rather than the live count so the descriptor stays cacheable while the visible set changes
+        commandList.BindDynamicStorageBuffer(9, 0, m_InstanceMemory);
 
-                        if (const MaterialParameter* l_NormalScale = l_Material->FindParameter(Material::NormalScale))
-                        {
-                            l_PushConstants.PbrFactors.w = l_NormalScale->AsFloat();
-                        }
+        if (l_Clustered)
+        {
+            commandList.BindDynamicStorageBuffer(11, 0, m_ClusterMemory.Lights);
+            commandList.BindDynamicStorageBuffer(12, 0, m_ClusterMemory.Ranges);
+            commandList.BindDynamicStorageBuffer(13, 0, m_ClusterMemory.Indices);
+        }
 
-                        if (const MaterialParameter* l_Emissive = l_Material->FindParameter(Material::EmissiveFactor))
-                        {
-                            l_PushConstants.EmissiveFactor = glm::vec4(l_Emissive->AsVec3(), l_PushConstants.EmissiveFactor.a);
-                        }
+        if (m_BindlessActive)
+        {
+            commandList.BindBindlessTextures(10);
+            ++m_Stats.Binds;
+        }
 
-                        if (const MaterialParameter* l_EmissiveStrength = l_Material->FindParameter(Material::EmissiveStrength))
-                        {
-                            l_PushConstants.EmissiveFactor.a = l_EmissiveStrength->AsFloat();
-                        }
+        SamplerHandle l_Sampler = m_TextureManager.DefaultSampler();
 
-                        if (const MaterialParameter* l_Texture = l_Material->FindParameter(Material::BaseColorTexture); l_Texture != nullptr && static_cast<uint64_t>(l_Texture->AsTexture()) != 0)
-                        {
-                            l_BaseColor = assetDatabase.ResolveTexture(l_Texture->AsTexture());
-                        }
+        // Packets arrive sorted by vertex format, material then mesh, so state is only rebound where it actually changes. The two pipeline variants share
+        // their layout, which keeps the descriptors above bound across the switch
+        PipelineHandle l_BoundPipeline = l_Pipeline;
+        const Mesh* l_BoundMesh = nullptr;
+        uint32_t l_BoundMaterial = UINT32_MAX;
+        std::array<TextureHandle, ResolvedMaterial::TextureCount> l_BoundTextures{};
 
-                        if (const MaterialParameter* l_Texture = l_Material->FindParameter(Material::NormalTexture); l_Texture != nullptr && static_cast<uint64_t>(l_Texture->AsTexture()) != 0)
-                        {
-                            l_Normal = assetDatabase.ResolveTexture(l_Texture->AsTexture());
-                        }
+        for (const InstanceBatch& it_Batch : m_SceneBatches)
+        {
+            const RenderPacket& l_Packet = m_Packets[it_Batch.Packet];
+            const Mesh& l_Mesh = *l_Packet.MeshSource;
+            const bool l_Quantized = l_Mesh.GetVertexFormat() == MeshVertexFormat::Quantized;
+            bool l_StateChanged = false;
 
-                        if (const MaterialParameter* l_Texture = l_Material->FindParameter(Material::MetallicRoughnessTexture); l_Texture != nullptr && static_cast<uint64_t>(l_Texture->AsTexture()) != 0)
-                        {
-                            l_MetallicRoughness = assetDatabase.ResolveTexture(l_Texture->AsTexture());
-                        }
+            const PipelineHandle l_BatchPipeline = l_Quantized ? l_QuantizedPipeline : l_Pipeline;
+            if (!l_BatchPipeline.IsValid())
+            {
+                continue;
+            }
 
-                        if (const MaterialParameter* l_Texture = l_Material->FindParameter(Material::EmissiveTexture); l_Texture != nullptr && static_cast<uint64_t>(l_Texture->AsTexture()) != 0)
-                        {
-                            l_Emissive = assetDatabase.ResolveTexture(l_Texture->AsTexture());
-                        }
-                    }
-                }
-                else if (l_Submesh.MaterialIndex < l_Slots.size())
+            if (l_BatchPipeline != l_BoundPipeline)
+            {
+                commandList.BindPipeline(l_BatchPipeline);
+                l_BoundPipeline = l_BatchPipeline;
+                l_StateChanged = true;
+            }
+
+            if (&l_Mesh != l_BoundMesh)
+            {
+                commandList.BindVertexBuffer(l_Mesh.GetVertexBuffer(), 0, 0);
+                commandList.BindVertexBuffer(l_Mesh.GetVertexBuffer(), l_Mesh.GetAttributeOffset(), 1);
+                commandList.BindIndexBuffer(l_Mesh.GetIndexBuffer(), 0, l_Mesh.GetIndexType());
+                l_BoundMesh = &l_Mesh;
+                m_Stats.Binds += 3;
+                l_StateChanged = true;
+            }
+            else
+            {
+                m_Stats.BindsSkipped += 3;
+            }
+
+            const ResolvedMaterial& l_Material = assetDatabase.GetResolvedMaterial(l_Packet.Material);
+            if (m_BindlessActive)
+            {
+                // Texture indices travel with each instance record, so a material change costs no binds
+                m_Stats.BindsSkipped += ResolvedMaterial::TextureCount;
+            }
+            else if (l_Packet.Material != l_BoundMaterial)
+            {
+                // Distinct materials frequently share textures (the white/normal defaults especially), so compare per slot
+                for (uint32_t l_Slot = 0; l_Slot < ResolvedMaterial::TextureCount; ++l_Slot)
                 {
-                    l_PushConstants.BaseColorFactor = l_Slots[l_Submesh.MaterialIndex].BaseColorFactor;
+                    if (l_Material.Textures[l_Slot] != l_BoundTextures[l_Slot])
+                    {
+                        commandList.BindTexture(l_Slot + 1, 0, l_Material.Textures[l_Slot], l_Sampler);
+                        l_BoundTextures[l_Slot] = l_Material.Textures[l_Slot];
+                        ++m_Stats.Binds;
+                    }
+                    else
+                    {
+                        ++m_Stats.BindsSkipped;
+                    }
                 }
 
-                commandList.BindTexture(1, 0, l_BaseColor, l_Sampler);
-                commandList.BindTexture(2, 0, l_Normal, l_Sampler);
-                commandList.BindTexture(3, 0, l_MetallicRoughness, l_Sampler);
-                commandList.BindTexture(4, 0, l_Emissive, l_Sampler);
-                commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, 0, static_cast<uint32_t>(sizeof(l_PushConstants)), &l_PushConstants);
+                l_BoundMaterial = l_Packet.Material;
+                l_StateChanged = true;
+            }
+            else
+            {
+                m_Stats.BindsSkipped += ResolvedMaterial::TextureCount;
+            }
 
-                commandList.DrawIndexed(l_Submesh.IndexCount, 1, l_Submesh.FirstIndex, static_cast<int32_t>(l_Submesh.BaseVertex), 0);
-                ++m_Stats.DrawCalls;
-                m_Stats.Triangles += l_Submesh.IndexCount / 3;
+            if (l_StateChanged)
+            {
+                ++m_Stats.StateChanges;
             }
+
+            MeshPushConstants l_PushConstants{};
+            l_PushConstants.InstanceOffset = it_Batch.FirstInstance;
+            l_PushConstants.PositionScale = glm::vec4(l_Mesh.GetQuantizationBox().Scale, 0.0f);
+            l_PushConstants.PositionOffset = glm::vec4(l_Mesh.GetQuantizationBox().Offset, 0.0f);
+            commandList.PushConstants(ShaderStage::Vertex | ShaderStage::Fragment, 0, static_cast<uint32_t>(sizeof(l_PushConstants)), &l_PushConstants);
+
+            commandList.DrawIndexed(it_Batch.IndexCount, it_Batch.InstanceCount, it_Batch.FirstIndex, l_Packet.BaseVertex, 0);
+            ++m_Stats.DrawCalls;
+            m_Stats.Instances += it_Batch.InstanceCount;
+            m_Stats.Triangles += (it_Batch.IndexCount / 3) * it_Batch.InstanceCount;
+            m_Stats.VertexFetchBytes += static_cast<uint64_t>(it_Batch.IndexCount) * it_Batch.InstanceCount * (l_Mesh.GetPositionStride() + l_Mesh.GetAttributeStride());
         }
     }
 
@@ -1143,6 +1917,7 @@ namespace Trinity
         }
 
         m_Stats = RenderStats{};
+        UpdatePipelines();
 
         float l_Elapsed = m_Timer.Elapsed();
         if (l_Elapsed - m_LastReloadCheck >= 0.5f)
@@ -1151,12 +1926,18 @@ namespace Trinity
             CheckHotReload();
         }
 
-        if (!m_SceneColor.IsValid() || !m_SceneDepth.IsValid())
+        // Requested once; the switch happens when the rebuilt pipeline lands
+        if (m_BindlessRequested != m_BindlessActive && !m_PendingPipeline.IsValid() && (m_BindlessActive || m_Device.GetCapabilities().SupportsBindless))
+        {
+            ReloadShaders();
+        }
+
+        if (m_RenderWidth == 0 || m_RenderHeight == 0)
         {
             return;
         }
 
-        bool l_UseViewport = m_ViewportActive && m_ViewportColor.IsValid();
+        bool l_UseViewport = m_ViewportActive;
 
         FrameInfo l_Frame;
         if (!m_Swapchain.AcquireNextImage(l_Frame))
@@ -1166,42 +1947,157 @@ namespace Trinity
 
         CommandList& l_CommandList = *m_CommandLists[m_FrameIndex];
 
-        m_DebugLineStage.Upload(m_FrameIndex, m_PendingDebugLines);
+        m_DebugLineStage.Upload(m_PendingDebugLines);
         m_PendingDebugLines.clear();
 
         uint32_t l_SwapWidth = m_Swapchain.GetWidth();
         uint32_t l_SwapHeight = m_Swapchain.GetHeight();
 
-        // Fresh per-frame targets start in Undefined (contents discarded).
+        // Render-extent targets are graph transients: placed in shared memory at compile time, aliased where their lifetimes allow, and reused while the sizes hold.
+        // Pass callbacks read the m_ handles, which are resolved to the placed textures after Compile.
         m_RenderGraph.Reset();
-        m_RenderGraph.Import(m_SceneColor, ResourceState::Undefined, "SceneColor");
-        m_RenderGraph.Import(m_SceneDepth, ResourceState::Undefined, "SceneDepth");
-        m_RenderGraph.Import(l_Frame.BackBuffer, ResourceState::Undefined, "BackBuffer");
+        TextureHandle l_SceneColor = m_RenderGraph.CreateTransient(DescribeRenderTarget("SceneColor", Format::RGBA16_SFLOAT, TextureUsage::Sampled | TextureUsage::RenderTarget, m_RenderWidth, m_RenderHeight));
+        TextureHandle l_SceneDepth = m_RenderGraph.CreateTransient(DescribeRenderTarget("SceneDepth", Format::D32_SFLOAT, TextureUsage::DepthStencil | TextureUsage::Sampled, m_RenderWidth, m_RenderHeight));
+        TextureHandle l_DepthVis = m_RenderGraph.CreateTransient(DescribeRenderTarget("DepthVis", Format::RGBA8_UNORM, TextureUsage::Sampled | TextureUsage::RenderTarget, m_RenderWidth, m_RenderHeight));
+        TextureHandle l_Overdraw = m_RenderGraph.CreateTransient(DescribeRenderTarget("Overdraw", Format::RGBA8_UNORM, TextureUsage::Sampled | TextureUsage::RenderTarget, m_RenderWidth, m_RenderHeight));
+        TextureHandle l_ViewportColor;
         if (l_UseViewport)
         {
-            m_RenderGraph.Import(m_ViewportColor, ResourceState::Undefined, "ViewportColor");
+            l_ViewportColor = m_RenderGraph.CreateTransient(DescribeRenderTarget("ViewportColor", m_Swapchain.GetFormat(), TextureUsage::Sampled | TextureUsage::RenderTarget, m_RenderWidth, m_RenderHeight));
         }
 
-        // Directional shadow map (depth-only). Always recorded so the map stays valid to sample.
-        m_ShadowActive = ComputeShadowLight(scene, m_ShadowLightViewProjection);
-        m_RenderGraph.Import(m_ShadowMap, ResourceState::Undefined, "ShadowMap");
+        m_RenderGraph.Import(l_Frame.BackBuffer, ResourceState::Undefined, "BackBuffer");
+
+        // Shadow and scene passes both consume the same sorted packet list
+        ExtractRenderPackets(scene, assetDatabase, camera);
+
+        // Directional shadow cascades (depth-only), fitted to the camera. Each layer is redrawn when its cache is stale and its turn has come
+        glm::vec3 l_ShadowDirection(0.0f);
+        m_ShadowActive = ComputeShadowLight(scene, l_ShadowDirection);
+        if (m_ShadowActive)
+        {
+            FitShadowCascades(camera, l_ShadowDirection);
+        }
+
+        // Cull once per view up front; the passes only consult the visibility masks
+        Timer l_CullTimer;
+        uint32_t l_CameraVisible = FrustumCuller::Cull(Frustum::FromViewProjection(camera.GetViewProjection()), m_PacketSpheres, m_CameraVisibility);
+        m_Stats.Culled = m_Stats.Packets - l_CameraVisible;
+
+        // Each cascade only draws the casters inside its own light frustum; a packet counts as shadow-culled when no cascade kept it
+        m_Stats.ShadowCulled = 0;
+        if (m_ShadowActive)
+        {
+            for (ShadowCascade& it_Cascade : m_ShadowCascades)
+            {
+                FrustumCuller::Cull(Frustum::FromViewProjection(it_Cascade.LightViewProjection), m_PacketSpheres, it_Cascade.Visibility);
+            }
+
+            for (size_t l_Index = 0; l_Index < m_Packets.size(); ++l_Index)
+            {
+                bool l_Kept = false;
+                for (const ShadowCascade& it_Cascade : m_ShadowCascades)
+                {
+                    l_Kept = l_Kept || it_Cascade.Visibility[l_Index] != 0;
+                }
+
+                m_Stats.ShadowCulled += l_Kept ? 0u : 1u;
+            }
+        }
+
+        // Decide which shadow layers are stale, then collapse the visible packets of all views into instanced batches and upload their per-instance data in one write
+        PlanShadowUpdate();
+        m_PrepassActive = m_DepthPrepass && m_PrepassPipeline.IsValid();
+        BuildInstanceBatches(assetDatabase, camera);
+        m_Stats.CullMilliseconds = l_CullTimer.ElapsedMilliseconds();
+
+        bool l_DrawShadow = false;
+        bool l_DrawShadowStatic = false;
+        for (const ShadowCascade& it_Cascade : m_ShadowCascades)
+        {
+            l_DrawShadow = l_DrawShadow || it_Cascade.Draw;
+            l_DrawShadowStatic = l_DrawShadowStatic || it_Cascade.DrawStatic;
+        }
+
+        // Every frame hands the maps back in the ShaderResource state the scene pass leaves them in, so the graph preserves the layers that are kept; the import
+        // state only differs on a map's first frame, which keeps the compiled plan reusable while cascades take turns
+        m_RenderGraph.Import(m_ShadowMap, m_ShadowMapReady ? ResourceState::ShaderResource : ResourceState::Undefined, "ShadowMap");
+        m_ShadowMapReady = true;
+        if (m_ShadowLayered)
+        {
+            m_RenderGraph.Import(m_ShadowStaticMap, m_ShadowStaticMapReady ? ResourceState::ShaderResource : ResourceState::Undefined, "ShadowStaticMap");
+            m_ShadowStaticMapReady = true;
+        }
+
+        // Cascades render into their own layers, so the passes begin rendering themselves, once per layer being drawn
+        if (l_DrawShadowStatic)
+        {
+            RenderGraphPass& l_Pass = m_RenderGraph.AddPass("ShadowStatic");
+            l_Pass.Depth = m_ShadowStaticMap;
+            l_Pass.ManageRendering = false;
+            l_Pass.Execute = [this](CommandList& commandList)
+                {
+                    DrawShadowCascades(commandList, m_ShadowStaticMap, true, true);
+                };
+        }
+
+        // The graph only knows sampling and attachment states, so the copy moves both maps into transfer states and back itself
+        if (l_DrawShadow && m_ShadowLayered)
+        {
+            RenderGraphPass& l_Pass = m_RenderGraph.AddPass("ShadowCopy");
+            l_Pass.Reads.push_back(m_ShadowStaticMap);
+            l_Pass.Depth = m_ShadowMap;
+            l_Pass.ManageRendering = false;
+            l_Pass.Execute = [this](CommandList& commandList)
+                {
+                    TextureBarrier l_Barriers[2];
+                    l_Barriers[0].Texture = m_ShadowStaticMap;
+                    l_Barriers[0].From = ResourceState::ShaderResource;
+                    l_Barriers[0].To = ResourceState::CopySource;
+                    l_Barriers[1].Texture = m_ShadowMap;
+                    l_Barriers[1].From = ResourceState::DepthStencil;
+                    l_Barriers[1].To = ResourceState::CopyDestination;
+                    commandList.TransitionTextures(l_Barriers, 2);
+
+                    for (uint32_t l_Index = 0; l_Index < k_ShadowCascadeCount; ++l_Index)
+                    {
+                        if (m_ShadowCascades[l_Index].Draw)
+                        {
+                            commandList.CopyTexture(m_ShadowStaticMap, m_ShadowMap, l_Index);
+                        }
+                    }
+
+                    std::swap(l_Barriers[0].From, l_Barriers[0].To);
+                    std::swap(l_Barriers[1].From, l_Barriers[1].To);
+                    commandList.TransitionTextures(l_Barriers, 2);
+                };
+        }
+
+        if (l_DrawShadow)
         {
             RenderGraphPass& l_Pass = m_RenderGraph.AddPass("Shadow");
             l_Pass.Depth = m_ShadowMap;
+            l_Pass.ManageRendering = false;
+            l_Pass.Execute = [this](CommandList& commandList)
+                {
+                    DrawShadowCascades(commandList, m_ShadowMap, false, !m_ShadowLayered);
+                };
+        }
+
+        // Depth pre-pass: lays down the nearest opaque surface, front to back, so the scene pass shades each pixel once
+        const glm::mat4 l_ViewProjection = camera.GetViewProjection();
+        if (m_PrepassActive)
+        {
+            RenderGraphPass& l_Pass = m_RenderGraph.AddPass("DepthPrepass");
+            l_Pass.Depth = l_SceneDepth;
             l_Pass.ClearDepth = true;
             l_Pass.DepthClearValue = 1.0f;
-            l_Pass.Width = k_ShadowMapSize;
-            l_Pass.Height = k_ShadowMapSize;
+            l_Pass.Width = m_RenderWidth;
+            l_Pass.Height = m_RenderHeight;
             l_Pass.ManageRendering = true;
-
-            glm::mat4 l_LightViewProjection = m_ShadowLightViewProjection;
-            bool l_Active = m_ShadowActive;
-            l_Pass.Execute = [this, &scene, l_LightViewProjection, l_Active](CommandList& commandList)
+            l_Pass.Execute = [this, l_ViewProjection](CommandList& commandList)
                 {
-                    if (l_Active)
-                    {
-                        DrawSceneDepth(commandList, scene, l_LightViewProjection);
-                    }
+                    DrawSceneDepth(commandList, m_PrepassPipeline, GetQuantizedPipeline(QuantizedPipeline::Prepass), l_ViewProjection, m_PrepassBatches, m_Stats.PrepassDrawCalls, m_Stats.PrepassInstances);
                 };
         }
 
@@ -1211,7 +2107,7 @@ namespace Trinity
             l_Pass.Reads.push_back(m_ShadowMap);
 
             RenderGraphColorTarget l_Color;
-            l_Color.Target = m_SceneColor;
+            l_Color.Target = l_SceneColor;
             l_Color.Clear = true;
             l_Color.ClearColor[0] = 0.0f;
             l_Color.ClearColor[1] = 0.0f;
@@ -1219,8 +2115,8 @@ namespace Trinity
             l_Color.ClearColor[3] = 1.0f;
             l_Pass.Colors.push_back(l_Color);
 
-            l_Pass.Depth = m_SceneDepth;
-            l_Pass.ClearDepth = true;
+            l_Pass.Depth = l_SceneDepth;
+            l_Pass.ClearDepth = !m_PrepassActive;
             l_Pass.DepthClearValue = 1.0f;
             l_Pass.Width = m_RenderWidth;
             l_Pass.Height = m_RenderHeight;
@@ -1235,20 +2131,17 @@ namespace Trinity
 
                     DrawScene(commandList, scene, assetDatabase, camera);
 
-                    m_DebugLineStage.Record(commandList, m_FrameIndex, camera.GetViewProjection());
+                    m_DebugLineStage.Record(commandList, camera.GetViewProjection());
                 };
         }
 
-        // Optional depth linearization pass for the editor's render-target viewer.
-        if (m_DepthVisualize && m_DepthVis.IsValid())
+        // Depth linearization for the editor's render-target viewer. Always declared; the graph culls it, and never allocates DepthVis, unless a later pass reads it.
         {
-            m_RenderGraph.Import(m_DepthVis, ResourceState::Undefined, "DepthVis");
-
             RenderGraphPass& l_Pass = m_RenderGraph.AddPass("DepthVisualize");
-            l_Pass.Reads.push_back(m_SceneDepth);
+            l_Pass.Reads.push_back(l_SceneDepth);
 
             RenderGraphColorTarget l_Color;
-            l_Color.Target = m_DepthVis;
+            l_Color.Target = l_DepthVis;
             l_Color.Clear = false;
             l_Pass.Colors.push_back(l_Color);
 
@@ -1264,15 +2157,55 @@ namespace Trinity
                 };
         }
 
+        // Overdraw view: replays the lit pass's draws and depth test with additive blending. After a pre-pass the final depth is tested for equality as the lit
+        // pass tests it; without one the draws build their own depth in the lit pass's order. Only declared while the view is on, since it redraws the scene, and
+        // while its pipeline was built for the current pre-pass mode
+        const bool l_ShowOverdraw = m_OverdrawVisualize && m_OverdrawPipeline.IsValid() && m_OverdrawPrepass == m_PrepassActive;
+        if (l_ShowOverdraw)
+        {
+            RenderGraphPass& l_Pass = m_RenderGraph.AddPass("OverdrawVisualize");
+
+            RenderGraphColorTarget l_Color;
+            l_Color.Target = l_Overdraw;
+            l_Color.Clear = true;
+            l_Color.ClearColor[0] = 0.0f;
+            l_Color.ClearColor[1] = 0.0f;
+            l_Color.ClearColor[2] = 0.0f;
+            l_Color.ClearColor[3] = 1.0f;
+            l_Pass.Colors.push_back(l_Color);
+
+            if (m_PrepassActive)
+            {
+                l_Pass.Depth = l_SceneDepth;
+                l_Pass.ClearDepth = false;
+            }
+            else
+            {
+                l_Pass.Depth = m_RenderGraph.CreateTransient(DescribeRenderTarget("OverdrawDepth", Format::D32_SFLOAT, TextureUsage::DepthStencil, m_RenderWidth, m_RenderHeight));
+                l_Pass.ClearDepth = true;
+            }
+
+            l_Pass.DepthClearValue = 1.0f;
+            l_Pass.Width = m_RenderWidth;
+            l_Pass.Height = m_RenderHeight;
+            l_Pass.ManageRendering = true;
+            l_Pass.Execute = [this, l_ViewProjection](CommandList& commandList)
+                {
+                    uint32_t l_DrawCalls = 0;
+                    uint32_t l_Instances = 0;
+                    DrawSceneDepth(commandList, m_OverdrawPipeline, GetQuantizedPipeline(QuantizedPipeline::Overdraw), l_ViewProjection, m_SceneBatches, l_DrawCalls, l_Instances);
+                };
+        }
+
         if (l_UseViewport)
         {
             // Post-process the HDR scene into the viewport color target.
             {
                 RenderGraphPass& l_Pass = m_RenderGraph.AddPass("PostProcess");
-                l_Pass.Reads.push_back(m_SceneColor);
+                l_Pass.Reads.push_back(l_SceneColor);
 
                 RenderGraphColorTarget l_Color;
-                l_Color.Target = m_ViewportColor;
+                l_Color.Target = l_ViewportColor;
                 l_Color.Clear = false;
                 l_Pass.Colors.push_back(l_Color);
 
@@ -1288,10 +2221,18 @@ namespace Trinity
             // Composite: clear the swapchain and draw the editor UI, which samples the viewport target.
             {
                 RenderGraphPass& l_Pass = m_RenderGraph.AddPass("Composite");
-                l_Pass.Reads.push_back(m_ViewportColor);
-                if (m_DepthVisualize && m_DepthVis.IsValid())
+                l_Pass.Reads.push_back(l_ViewportColor);
+
+                // The render-target viewer samples these from the UI, so their memory must not be handed to another transient before this pass
+                if (m_DepthVisualize)
                 {
-                    l_Pass.Reads.push_back(m_DepthVis);
+                    l_Pass.Reads.push_back(l_DepthVis);
+                    l_Pass.Reads.push_back(l_SceneColor);
+                }
+
+                if (l_ShowOverdraw)
+                {
+                    l_Pass.Reads.push_back(l_Overdraw);
                 }
 
                 RenderGraphColorTarget l_Color;
@@ -1320,7 +2261,7 @@ namespace Trinity
             // Post-process the HDR scene straight to the swapchain.
             {
                 RenderGraphPass& l_Pass = m_RenderGraph.AddPass("PostProcess");
-                l_Pass.Reads.push_back(m_SceneColor);
+                l_Pass.Reads.push_back(l_SceneColor);
 
                 RenderGraphColorTarget l_Color;
                 l_Color.Target = l_Frame.BackBuffer;
@@ -1342,9 +2283,15 @@ namespace Trinity
             if (imgui != nullptr && imgui->IsInitialized())
             {
                 RenderGraphPass& l_Pass = m_RenderGraph.AddPass("ImGui");
-                if (m_DepthVisualize && m_DepthVis.IsValid())
+                if (m_DepthVisualize)
                 {
-                    l_Pass.Reads.push_back(m_DepthVis);
+                    l_Pass.Reads.push_back(l_DepthVis);
+                    l_Pass.Reads.push_back(l_SceneColor);
+                }
+
+                if (l_ShowOverdraw)
+                {
+                    l_Pass.Reads.push_back(l_Overdraw);
                 }
 
                 RenderGraphColorTarget l_Color;
@@ -1363,7 +2310,16 @@ namespace Trinity
         }
 
         m_RenderGraph.SetPresent(l_Frame.BackBuffer);
+        m_RenderGraph.Compile();
+
+        m_SceneColor = m_RenderGraph.GetTexture(l_SceneColor);
+        m_SceneDepth = m_RenderGraph.GetTexture(l_SceneDepth);
+        m_DepthVis = m_RenderGraph.GetTexture(l_DepthVis);
+        m_Overdraw = m_RenderGraph.GetTexture(l_Overdraw);
+        m_ViewportColor = m_RenderGraph.GetTexture(l_ViewportColor);
+        RefreshViewportTexture();
 
+        Timer l_RecordTimer;
         l_CommandList.Begin();
 
         if (!m_IblGenerated)
@@ -1386,6 +2342,7 @@ namespace Trinity
 
         m_RenderGraph.Execute(l_CommandList);
         l_CommandList.End();
+        m_Stats.RecordMilliseconds = l_RecordTimer.ElapsedMilliseconds();
 
         m_Device.Submit(l_CommandList);
         m_Swapchain.Present();
@@ -1408,8 +2365,8 @@ namespace Trinity
 
         if (!m_ViewportActive)
         {
-            DestroySceneTargets();
-            CreateSceneTargets(m_Swapchain.GetWidth(), m_Swapchain.GetHeight());
+            m_RenderWidth = m_Swapchain.GetWidth();
+            m_RenderHeight = m_Swapchain.GetHeight();
         }
     }
 }
\ No newline at end of file
@@ -1,204 +1,943 @@
 #include <Trinity/Renderer/Graph/RenderGraph.h>
 
+#include <algorithm>
 #include <utility>
 
 #include <Trinity/Renderer/RHI/CommandList.h>
+#include <Trinity/Core/Log.h>
 
 namespace Trinity
 {
+    // Frames a retired heap waits before reuse: every frame in flight plus the one whose editor UI still shows the old targets
+    static constexpr uint64_t k_HeapReuseDelay = 4;
+    // Retired heaps nobody reused are freed after this many frames
+    static constexpr uint64_t k_HeapRetireFrames = 120;
+
+    // Slots of the handle-to-resource table to start with; it only grows, so steady frames never allocate
+    static constexpr size_t k_InitialResourceSlots = 64;
+
+    static constexpr uint64_t k_HashOffset = 14695981039346656037ull;
+    static constexpr uint64_t k_HashPrime = 1099511628211ull;
+
+    static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+    }
+
+    // Everything that decides the image a description creates; names and initial data do not
+    static bool SameLayout(const TextureDescription& left, const TextureDescription& right)
+    {
+        return left.Type == right.Type && left.Format == right.Format && left.Usage == right.Usage && left.Width == right.Width && left.Height == right.Height
+            && left.Depth == right.Depth && left.MipLevels == right.MipLevels && left.ArrayLayers == right.ArrayLayers && left.SampleCount == right.SampleCount;
+    }
+
+    // FNV-1a; values are hashed one field at a time so struct padding never leaks in
+    static void HashBytes(uint64_t& hash, const void* data, size_t size)
+    {
+        const unsigned char* l_Bytes = static_cast<const unsigned char*>(data);
+        for (size_t l_Index = 0; l_Index < size; ++l_Index)
+        {
+            hash ^= l_Bytes[l_Index];
+            hash *= k_HashPrime;
+        }
+    }
+
+    template<typename T>
+    static void HashValue(uint64_t& hash, const T& value)
+    {
+        HashBytes(hash, &value, sizeof(T));
+    }
+
+    static void HashString(uint64_t& hash, const std::string& value)
+    {
+        HashValue(hash, value.size());
+        HashBytes(hash, value.data(), value.size());
+    }
+
+    void RenderGraph::Initialize(GraphicsDevice& device)
+    {
+        m_Device = &device;
+    }
+
+    void RenderGraph::Shutdown()
+    {
+        if (m_Device == nullptr)
+        {
+            return;
+        }
+
+        ReleasePool();
+
+        for (const TransientHeap& it_Heap : m_RetiredHeaps)
+        {
+            m_Device->DestroyMemoryHeap(it_Heap.Handle);
+        }
+
+        m_RetiredHeaps.clear();
+        m_Transients.clear();
+        m_TransientCount = 0;
+        m_HasPlan = false;
+        m_IsCompiled = false;
+        m_Device = nullptr;
+    }
+
     void RenderGraph::Reset()
     {
-        m_Passes.clear();
-        m_States.clear();
-        m_Names.clear();
-        m_PassInfo.clear();
-        m_Present = TextureHandle{};
-        m_HasPresent = false;
+        ++m_Frame;
+
+        // Callbacks hold references into the caller's frame; drop them now rather than when the slot is next reused
+        for (uint32_t l_Pass = 0; l_Pass < m_PassCount; ++l_Pass)
+        {
+            m_Passes[l_Pass].Execute = nullptr;
+        }
+
+        m_PassCount = 0;
+        m_ResourceCount = 0;
+        std::fill(m_ResourceSlots.begin(), m_ResourceSlots.end(), 0u);
+        m_TransientCount = 0;
+        m_Present = UINT32_MAX;
+        m_IsCompiled = false;
     }
 
-    void RenderGraph::Import(TextureHandle handle, ResourceState initialState, const std::string& name)
+    void RenderGraph::Import(TextureHandle handle, ResourceState initialState, std::string_view name)
     {
         if (!handle.IsValid())
         {
             return;
         }
 
-        SetState(handle, initialState);
+        uint32_t l_Index = ResourceIndex(handle);
+        m_InitialStates[l_Index] = initialState;
 
         if (!name.empty())
         {
-            m_Names.push_back({ handle, name });
+            m_Names[l_Index].assign(name);
         }
+
+        m_IsCompiled = false;
     }
 
-    RenderGraphPass& RenderGraph::AddPass(const std::string& name)
+    TextureHandle RenderGraph::CreateTransient(const TextureDescription& description)
     {
-        m_Passes.emplace_back();
-        m_Passes.back().Name = name;
+        if (m_TransientCount == m_Transients.size())
+        {
+            m_Transients.emplace_back();
+        }
 
-        return m_Passes.back();
+        TextureHandle l_Handle(m_TransientCount, 0);
+
+        // Only the description is replaced; the placement from the last compile stays until the next one decides otherwise
+        TransientTexture& l_Transient = m_Transients[m_TransientCount++];
+        l_Transient.Description = description;
+        l_Transient.Description.InitialData = nullptr;
+        l_Transient.Description.InitialDataSize = 0;
+
+        m_Names[ResourceIndex(l_Handle)].assign(description.DebugName);
+        m_IsCompiled = false;
+
+        return l_Handle;
+    }
+
+    TextureHandle RenderGraph::GetTexture(TextureHandle handle) const
+    {
+        if (handle.IsValid() && handle.GetGeneration() == 0)
+        {
+            return handle.GetIndex() < m_TransientCount ? m_Transients[handle.GetIndex()].Physical : TextureHandle{};
+        }
+
+        return handle;
+    }
+
+    RenderGraphPass& RenderGraph::AddPass(std::string_view name)
+    {
+        if (m_PassCount == m_Passes.size())
+        {
+            m_Passes.emplace_back();
+        }
+
+        // Back to defaults, keeping the name's and the vectors' storage
+        RenderGraphPass& l_Pass = m_Passes[m_PassCount++];
+        l_Pass.Name.assign(name);
+        l_Pass.Reads.clear();
+        l_Pass.Colors.clear();
+        l_Pass.Depth = TextureHandle{};
+        l_Pass.ClearDepth = true;
+        l_Pass.DepthClearValue = 1.0f;
+        l_Pass.ManageRendering = true;
+        l_Pass.NeverCull = false;
+        l_Pass.Width = 0;
+        l_Pass.Height = 0;
+        l_Pass.Execute = nullptr;
+
+        m_IsCompiled = false;
+
+        return l_Pass;
     }
 
     void RenderGraph::SetPresent(TextureHandle handle)
     {
-        m_Present = handle;
-        m_HasPresent = handle.IsValid();
+        m_Present = handle.IsValid() ? ResourceIndex(handle) : UINT32_MAX;
+        m_IsCompiled = false;
     }
 
-    ResourceState RenderGraph::GetState(TextureHandle handle) const
+    void RenderGraph::Export(TextureHandle handle)
     {
-        for (const ResourceEntry& it_Entry : m_States)
+        if (!handle.IsValid())
         {
-            if (it_Entry.Handle == handle)
+            return;
+        }
+
+        m_Exported[ResourceIndex(handle)] = 1;
+        m_IsCompiled = false;
+    }
+
+    // Linear probe for the handle's slot: either the one holding it or the empty one it belongs in
+    uint32_t& RenderGraph::ResourceSlot(TextureHandle handle)
+    {
+        const size_t l_Mask = m_ResourceSlots.size() - 1;
+        size_t l_Slot = static_cast<size_t>((std::hash<TextureHandle>()(handle) * 0x9E3779B97F4A7C15ull) >> 32) & l_Mask;
+        while (m_ResourceSlots[l_Slot] != 0 && m_Resources[m_ResourceSlots[l_Slot] - 1] != handle)
+        {
+            l_Slot = (l_Slot + 1) & l_Mask;
+        }
+
+        return m_ResourceSlots[l_Slot];
+    }
+
+    uint32_t RenderGraph::ResourceIndex(TextureHandle handle)
+    {
+        // Open-addressed table of resource index + 1, kept at most half full; zero marks an empty slot
+        if (m_ResourceSlots.empty())
+        {
+            m_ResourceSlots.assign(k_InitialResourceSlots, 0u);
+        }
+
+        uint32_t* l_Slot = &ResourceSlot(handle);
+        if (*l_Slot != 0)
+        {
+            return *l_Slot - 1;
+        }
+
+        if ((m_ResourceCount + 1) * 2 > m_ResourceSlots.size())
+        {
+            m_ResourceSlots.assign(m_ResourceSlots.size() * 2, 0u);
+            for (uint32_t l_Index = 0; l_Index < m_ResourceCount; ++l_Index)
             {
-                return it_Entry.State;
+                ResourceSlot(m_Resources[l_Index]) = l_Index + 1;
             }
+
+            l_Slot = &ResourceSlot(handle);
+        }
+
+        if (m_ResourceCount == m_Resources.size())
+        {
+            m_Resources.emplace_back();
+            m_InitialStates.emplace_back();
+            m_Names.emplace_back();
+            m_Exported.emplace_back();
+        }
+
+        uint32_t l_Index = m_ResourceCount++;
+        m_Resources[l_Index] = handle;
+        *l_Slot = l_Index + 1;
+        m_InitialStates[l_Index] = ResourceState::Undefined;
+        m_Names[l_Index].clear();
+        m_Exported[l_Index] = 0;
+
+        return l_Index;
+    }
+
+    std::string RenderGraph::NameOf(uint32_t resource) const
+    {
+        if (!m_Names[resource].empty())
+        {
+            return m_Names[resource];
         }
 
-        return ResourceState::Undefined;
+        return "Texture#" + std::to_string(m_Resources[resource].GetIndex());
     }
 
-    void RenderGraph::SetState(TextureHandle handle, ResourceState state)
+    uint64_t RenderGraph::GatherTopology()
     {
-        for (ResourceEntry& it_Entry : m_States)
+        m_PassRanges.clear();
+        m_PassResources.clear();
+
+        uint64_t l_Hash = k_HashOffset;
+        HashValue(l_Hash, m_PassCount);
+
+        for (uint32_t l_Pass = 0; l_Pass < m_PassCount; ++l_Pass)
         {
-            if (it_Entry.Handle == handle)
+            const RenderGraphPass& l_Source = m_Passes[l_Pass];
+            PassResources& l_Range = m_PassRanges.emplace_back();
+            const uint32_t l_First = static_cast<uint32_t>(m_PassResources.size());
+
+            l_Range.FirstRead = l_First;
+            for (TextureHandle it_Read : l_Source.Reads)
+            {
+                if (it_Read.IsValid())
+                {
+                    m_PassResources.push_back(ResourceIndex(it_Read));
+                }
+            }
+
+            l_Range.ReadCount = static_cast<uint32_t>(m_PassResources.size()) - l_Range.FirstRead;
+            l_Range.FirstWrite = static_cast<uint32_t>(m_PassResources.size());
+            for (const RenderGraphColorTarget& it_Color : l_Source.Colors)
+            {
+                if (it_Color.Target.IsValid())
+                {
+                    m_PassResources.push_back(ResourceIndex(it_Color.Target));
+                }
+            }
+
+            if (l_Source.Depth.IsValid())
+            {
+                l_Range.Depth = ResourceIndex(l_Source.Depth);
+                m_PassResources.push_back(l_Range.Depth);
+            }
+
+            // Attachments that are not cleared keep their previous contents, which makes them inputs as well; raw passes decide for themselves, so assume they load
+            l_Range.WriteCount = static_cast<uint32_t>(m_PassResources.size()) - l_Range.FirstWrite;
+            l_Range.FirstLoad = static_cast<uint32_t>(m_PassResources.size());
+            for (const RenderGraphColorTarget& it_Color : l_Source.Colors)
             {
-                it_Entry.State = state;
+                if (it_Color.Target.IsValid() && (!it_Color.Clear || !l_Source.ManageRendering))
+                {
+                    m_PassResources.push_back(ResourceIndex(it_Color.Target));
+                }
+            }
 
-                return;
+            if (l_Source.Depth.IsValid() && (!l_Source.ClearDepth || !l_Source.ManageRendering))
+            {
+                m_PassResources.push_back(l_Range.Depth);
             }
+
+            l_Range.LoadCount = static_cast<uint32_t>(m_PassResources.size()) - l_Range.FirstLoad;
+
+            HashString(l_Hash, l_Source.Name);
+            HashValue(l_Hash, l_Source.ManageRendering);
+            HashValue(l_Hash, l_Source.NeverCull);
+            HashValue(l_Hash, l_Range.ReadCount);
+            HashValue(l_Hash, l_Range.WriteCount);
+            HashValue(l_Hash, l_Range.LoadCount);
+            HashValue(l_Hash, l_Range.Depth);
+            HashBytes(l_Hash, m_PassResources.data() + l_First, (m_PassResources.size() - l_First) * sizeof(uint32_t));
         }
 
-        m_States.push_back({ handle, state });
+        // Resources are identified by declaration order, not handle, so a back buffer that changes every frame still matches
+        HashValue(l_Hash, m_ResourceCount);
+        for (uint32_t l_Resource = 0; l_Resource < m_ResourceCount; ++l_Resource)
+        {
+            HashValue(l_Hash, m_InitialStates[l_Resource]);
+            HashValue(l_Hash, m_Exported[l_Resource]);
+            HashValue(l_Hash, IsTransient(m_Resources[l_Resource]));
+            HashString(l_Hash, m_Names[l_Resource]);
+        }
+
+        HashValue(l_Hash, m_TransientCount);
+        for (uint32_t l_Index = 0; l_Index < m_TransientCount; ++l_Index)
+        {
+            const TextureDescription& l_Description = m_Transients[l_Index].Description;
+            HashValue(l_Hash, l_Description.Type);
+            HashValue(l_Hash, l_Description.Format);
+            HashValue(l_Hash, l_Description.Usage);
+            HashValue(l_Hash, l_Description.Width);
+            HashValue(l_Hash, l_Description.Height);
+            HashValue(l_Hash, l_Description.Depth);
+            HashValue(l_Hash, l_Description.MipLevels);
+            HashValue(l_Hash, l_Description.ArrayLayers);
+            HashValue(l_Hash, l_Description.SampleCount);
+        }
+
+        HashValue(l_Hash, m_Present);
+
+        return l_Hash;
     }
 
-    void RenderGraph::Transition(CommandList& commandList, TextureHandle handle, ResourceState target)
+    void RenderGraph::Compile()
     {
-        if (!handle.IsValid())
+        CollectRetiredHeaps();
+
+        const uint64_t l_Hash = GatherTopology();
+        const uint64_t l_Compilations = m_Stats.Compilations;
+
+        if (m_CachingEnabled && m_HasPlan && l_Hash == m_PlanHash)
         {
-            return;
+            m_Stats.Reused = true;
         }
-
-        ResourceState l_Current = GetState(handle);
-        if (l_Current == target)
+        else
         {
-            return;
+            BuildPlan();
+
+            m_PlanHash = l_Hash;
+            m_HasPlan = true;
+            m_Stats.Reused = false;
+            m_Stats.Compilations = l_Compilations + 1;
         }
 
-        commandList.TransitionTexture(handle, l_Current, target);
-        SetState(handle, target);
+        m_IsCompiled = true;
     }
 
-    std::string RenderGraph::NameOf(TextureHandle handle) const
+    void RenderGraph::BuildPlan()
     {
-        for (const ResourceName& it_Name : m_Names)
+        const uint32_t l_PassCount = m_PassCount;
+        const uint32_t l_ResourceCount = m_ResourceCount;
+
+        // Dependency DAG: every read or load depends on the most recent earlier writer of that resource
+        std::vector<uint32_t> l_LastWriter(l_ResourceCount, UINT32_MAX);
+        std::vector<std::vector<uint32_t>> l_Dependencies(l_PassCount);
+        for (uint32_t l_Pass = 0; l_Pass < l_PassCount; ++l_Pass)
         {
-            if (it_Name.Handle == handle)
+            const PassResources& l_Range = m_PassRanges[l_Pass];
+            std::vector<uint32_t>& l_PassDependencies = l_Dependencies[l_Pass];
+            auto a_Depend = [&](uint32_t first, uint32_t count)
+                {
+                    for (uint32_t l_Index = first; l_Index < first + count; ++l_Index)
+                    {
+                        uint32_t l_Producer = l_LastWriter[m_PassResources[l_Index]];
+                        if (l_Producer != UINT32_MAX && std::find(l_PassDependencies.begin(), l_PassDependencies.end(), l_Producer) == l_PassDependencies.end())
+                        {
+                            l_PassDependencies.push_back(l_Producer);
+                        }
+                    }
+                };
+
+            a_Depend(l_Range.FirstRead, l_Range.ReadCount);
+            a_Depend(l_Range.FirstLoad, l_Range.LoadCount);
+
+            for (uint32_t l_Index = l_Range.FirstWrite; l_Index < l_Range.FirstWrite + l_Range.WriteCount; ++l_Index)
             {
-                return it_Name.Name;
+                l_LastWriter[m_PassResources[l_Index]] = l_Pass;
             }
         }
 
-        return "Texture#" + std::to_string(handle.GetIndex());
-    }
+        // Culling: the final writers of presented and exported resources are the roots; dependencies always point backwards, so one reverse sweep marks every pass they reach
+        std::vector<uint8_t> l_Live(l_PassCount, 0);
+        for (uint32_t l_Resource = 0; l_Resource < l_ResourceCount; ++l_Resource)
+        {
+            bool l_Root = m_Exported[l_Resource] != 0 || l_Resource == m_Present;
+            if (l_Root && l_LastWriter[l_Resource] != UINT32_MAX)
+            {
+                l_Live[l_LastWriter[l_Resource]] = 1;
+            }
+        }
 
-    void RenderGraph::Execute(CommandList& commandList)
-    {
-        m_PassInfo.clear();
+        for (uint32_t l_Pass = l_PassCount; l_Pass-- > 0;)
+        {
+            if (m_Passes[l_Pass].NeverCull)
+            {
+                l_Live[l_Pass] = 1;
+            }
+
+            if (l_Live[l_Pass] == 0)
+            {
+                continue;
+            }
+
+            for (uint32_t it_Dependency : l_Dependencies[l_Pass])
+            {
+                l_Live[it_Dependency] = 1;
+            }
+        }
+
+        m_Stats = RenderGraphStats{};
+        m_Stats.Passes = l_PassCount;
+
+        // Transient lifetimes span their first to last surviving use; presented and exported ones must last to the end of the frame
+        for (uint32_t l_Index = 0; l_Index < m_TransientCount; ++l_Index)
+        {
+            TransientTexture& l_Transient = m_Transients[l_Index];
+            l_Transient.FirstPass = UINT32_MAX;
+            l_Transient.LastPass = 0;
+            l_Transient.Heap = UINT32_MAX;
+            l_Transient.Physical = TextureHandle{};
+        }
+
+        for (uint32_t l_Pass = 0; l_Pass < l_PassCount; ++l_Pass)
+        {
+            if (l_Live[l_Pass] == 0)
+            {
+                continue;
+            }
+
+            const PassResources& l_Range = m_PassRanges[l_Pass];
+            for (uint32_t l_Index = l_Range.FirstRead; l_Index < l_Range.FirstWrite + l_Range.WriteCount; ++l_Index)
+            {
+                TextureHandle l_Handle = m_Resources[m_PassResources[l_Index]];
+                if (IsTransient(l_Handle))
+                {
+                    TransientTexture& l_Transient = m_Transients[l_Handle.GetIndex()];
+                    l_Transient.FirstPass = std::min(l_Transient.FirstPass, l_Pass);
+                    l_Transient.LastPass = std::max(l_Transient.LastPass, l_Pass);
+                }
+            }
+        }
+
+        for (uint32_t l_Resource = 0; l_Resource < l_ResourceCount; ++l_Resource)
+        {
+            bool l_Root = m_Exported[l_Resource] != 0 || l_Resource == m_Present;
+            if (l_Root && IsTransient(m_Resources[l_Resource]))
+            {
+                m_Transients[m_Resources[l_Resource].GetIndex()].LastPass = l_PassCount;
+            }
+        }
+
+        PlaceTransients();
+        RealizeTransients();
+
+        // Barriers: walk the surviving passes in order, collecting each pass's transitions into one contiguous batch
+        m_Compiled.assign(l_PassCount, CompiledPass{});
+        m_Barriers.clear();
+
+        std::vector<ResourceState> l_States(m_InitialStates.begin(), m_InitialStates.begin() + l_ResourceCount);
+        auto a_Require = [&](uint32_t resource, ResourceState target, uint32_t firstBarrier)
+            {
+                if (l_States[resource] == target)
+                {
+                    return;
+                }
+
+                // A texture used twice by the same pass keeps a single transition, straight to its last requested state
+                for (uint32_t l_Index = firstBarrier; l_Index < m_Barriers.size(); ++l_Index)
+                {
+                    if (m_Barriers[l_Index].Resource == resource)
+                    {
+                        m_Barriers[l_Index].To = target;
+                        l_States[resource] = target;
+
+                        return;
+                    }
+                }
+
+                // Transients start every frame Undefined, so this is always their first use and the point where they take over shared memory
+                CompiledBarrier l_Barrier;
+                l_Barrier.Resource = resource;
+                l_Barrier.From = l_States[resource];
+                l_Barrier.To = target;
+                l_Barrier.Aliased = IsTransient(m_Resources[resource]) && l_States[resource] == ResourceState::Undefined;
+
+                m_Barriers.push_back(l_Barrier);
+                l_States[resource] = target;
+            };
+
+        for (uint32_t l_Pass = 0; l_Pass < l_PassCount; ++l_Pass)
+        {
+            CompiledPass& l_Compiled = m_Compiled[l_Pass];
+            l_Compiled.Culled = l_Live[l_Pass] == 0;
+            if (l_Compiled.Culled)
+            {
+                ++m_Stats.CulledPasses;
+
+                continue;
+            }
+
+            const PassResources& l_Range = m_PassRanges[l_Pass];
+            l_Compiled.FirstBarrier = static_cast<uint32_t>(m_Barriers.size());
+
+            for (uint32_t l_Index = l_Range.FirstRead; l_Index < l_Range.FirstRead + l_Range.ReadCount; ++l_Index)
+            {
+                a_Require(m_PassResources[l_Index], ResourceState::ShaderResource, l_Compiled.FirstBarrier);
+            }
+
+            for (uint32_t l_Index = l_Range.FirstWrite; l_Index < l_Range.FirstWrite + l_Range.WriteCount; ++l_Index)
+            {
+                uint32_t l_Resource = m_PassResources[l_Index];
+                a_Require(l_Resource, l_Resource == l_Range.Depth ? ResourceState::DepthStencil : ResourceState::RenderTarget, l_Compiled.FirstBarrier);
+            }
 
-        for (RenderGraphPass& it_Pass : m_Passes)
+            l_Compiled.BarrierCount = static_cast<uint32_t>(m_Barriers.size()) - l_Compiled.FirstBarrier;
+            m_Stats.BarrierBatches += l_Compiled.BarrierCount > 0 ? 1 : 0;
+        }
+
+        m_FinalBarrierOffset = static_cast<uint32_t>(m_Barriers.size());
+        if (m_Present != UINT32_MAX)
         {
+            a_Require(m_Present, ResourceState::Present, m_FinalBarrierOffset);
+            m_Stats.BarrierBatches += m_Barriers.size() > m_FinalBarrierOffset ? 1 : 0;
+        }
+
+        m_Stats.Barriers = static_cast<uint32_t>(m_Barriers.size());
+        m_FrameBarriers.reserve(m_Barriers.size());
+
+        m_PassInfo.clear();
+        m_PassInfo.reserve(l_PassCount);
+        for (uint32_t l_Pass = 0; l_Pass < l_PassCount; ++l_Pass)
+        {
+            const RenderGraphPass& l_Source = m_Passes[l_Pass];
+            const PassResources& l_Range = m_PassRanges[l_Pass];
+
             PassInfo l_Info;
-            l_Info.Name = it_Pass.Name;
-            l_Info.Managed = it_Pass.ManageRendering;
+            l_Info.Name = l_Source.Name;
+            l_Info.Managed = l_Source.ManageRendering;
+            l_Info.Culled = m_Compiled[l_Pass].Culled;
+            l_Info.Barriers = m_Compiled[l_Pass].BarrierCount;
+
+            for (uint32_t l_Index = l_Range.FirstRead; l_Index < l_Range.FirstRead + l_Range.ReadCount; ++l_Index)
+            {
+                l_Info.Reads.push_back(NameOf(m_PassResources[l_Index]));
+            }
 
-            for (TextureHandle it_Read : it_Pass.Reads)
+            for (uint32_t l_Index = l_Range.FirstWrite; l_Index < l_Range.FirstWrite + l_Range.WriteCount; ++l_Index)
             {
-                Transition(commandList, it_Read, ResourceState::ShaderResource);
-                l_Info.Reads.push_back(NameOf(it_Read));
+                l_Info.Writes.push_back(NameOf(m_PassResources[l_Index]));
             }
 
-            for (const RenderGraphColorTarget& it_Color : it_Pass.Colors)
+            for (uint32_t it_Dependency : l_Dependencies[l_Pass])
             {
-                Transition(commandList, it_Color.Target, ResourceState::RenderTarget);
-                l_Info.Writes.push_back(NameOf(it_Color.Target));
+                l_Info.DependsOn.push_back(m_Passes[it_Dependency].Name);
             }
 
-            if (it_Pass.Depth.IsValid())
+            m_PassInfo.push_back(std::move(l_Info));
+        }
+    }
+
+    void RenderGraph::PlaceTransients()
+    {
+        m_PlannedHeaps.clear();
+        if (m_Device == nullptr)
+        {
+            return;
+        }
+
+        // Largest first, so the big targets claim offsets early and the small ones fill the gaps they leave
+        std::vector<uint32_t> l_Order;
+        for (uint32_t l_Index = 0; l_Index < m_TransientCount; ++l_Index)
+        {
+            TransientTexture& l_Transient = m_Transients[l_Index];
+            if (l_Transient.FirstPass == UINT32_MAX)
             {
-                Transition(commandList, it_Pass.Depth, ResourceState::DepthStencil);
-                l_Info.Writes.push_back(NameOf(it_Pass.Depth));
+                continue;
             }
 
-            if (it_Pass.ManageRendering)
+            l_Transient.Requirements = m_Device->GetTextureMemoryRequirements(l_Transient.Description);
+            if (l_Transient.Requirements.Size == 0)
             {
-                std::vector<RenderingAttachment> l_ColorAttachments;
-                l_ColorAttachments.reserve(it_Pass.Colors.size());
-                for (const RenderGraphColorTarget& it_Color : it_Pass.Colors)
+                continue;
+            }
+
+            m_Stats.TransientMemoryUnaliased += l_Transient.Requirements.Size;
+            l_Order.push_back(l_Index);
+        }
+
+        std::stable_sort(l_Order.begin(), l_Order.end(), [this](uint32_t left, uint32_t right)
+            {
+                return m_Transients[left].Requirements.Size > m_Transients[right].Requirements.Size;
+            });
+
+        std::vector<std::pair<uint64_t, uint64_t>> l_Occupied;
+        for (uint32_t it_Index : l_Order)
+        {
+            TransientTexture& l_Transient = m_Transients[it_Index];
+            const MemoryRequirements& l_Requirements = l_Transient.Requirements;
+
+            for (uint32_t l_Heap = 0; l_Transient.Heap == UINT32_MAX; ++l_Heap)
+            {
+                if (l_Heap == m_PlannedHeaps.size())
                 {
-                    RenderingAttachment l_Attachment;
-                    l_Attachment.Target = it_Color.Target;
-                    l_Attachment.Clear = it_Color.Clear;
-                    l_Attachment.ClearColor[0] = it_Color.ClearColor[0];
-                    l_Attachment.ClearColor[1] = it_Color.ClearColor[1];
-                    l_Attachment.ClearColor[2] = it_Color.ClearColor[2];
-                    l_Attachment.ClearColor[3] = it_Color.ClearColor[3];
-                    l_ColorAttachments.push_back(l_Attachment);
+                    m_PlannedHeaps.emplace_back();
+                    m_PlannedHeaps.back().TypeBits = l_Requirements.TypeBits;
                 }
 
-                DepthAttachment l_DepthAttachment;
-                bool l_HasDepth = it_Pass.Depth.IsValid();
-                if (l_HasDepth)
+                TransientHeap& l_Planned = m_PlannedHeaps[l_Heap];
+                if ((l_Planned.TypeBits & l_Requirements.TypeBits) == 0)
                 {
-                    l_DepthAttachment.Target = it_Pass.Depth;
-                    l_DepthAttachment.Clear = it_Pass.ClearDepth;
-                    l_DepthAttachment.ClearDepth = it_Pass.DepthClearValue;
+                    continue;
                 }
 
-                RenderingInfo l_RenderingInfo;
-                l_RenderingInfo.ColorAttachments = l_ColorAttachments.empty() ? nullptr : l_ColorAttachments.data();
-                l_RenderingInfo.ColorAttachmentCount = static_cast<uint32_t>(l_ColorAttachments.size());
-                l_RenderingInfo.Depth = l_HasDepth ? &l_DepthAttachment : nullptr;
-                l_RenderingInfo.Width = it_Pass.Width;
-                l_RenderingInfo.Height = it_Pass.Height;
-
-                commandList.BeginRendering(l_RenderingInfo);
-
-                Viewport l_Viewport;
-                l_Viewport.X = 0.0f;
-                l_Viewport.Y = 0.0f;
-                l_Viewport.Width = static_cast<float>(it_Pass.Width);
-                l_Viewport.Height = static_cast<float>(it_Pass.Height);
-                l_Viewport.MinDepth = 0.0f;
-                l_Viewport.MaxDepth = 1.0f;
-                commandList.SetViewport(l_Viewport);
-
-                Scissor l_Scissor;
-                l_Scissor.X = 0;
-                l_Scissor.Y = 0;
-                l_Scissor.Width = it_Pass.Width;
-                l_Scissor.Height = it_Pass.Height;
-                commandList.SetScissor(l_Scissor);
-
-                if (it_Pass.Execute)
+                // Ranges already claimed in this heap by textures alive during any pass this one is
+                l_Occupied.clear();
+                for (uint32_t it_Other : l_Order)
                 {
-                    it_Pass.Execute(commandList);
+                    const TransientTexture& l_Other = m_Transients[it_Other];
+                    if (l_Other.Heap == l_Heap && l_Other.FirstPass <= l_Transient.LastPass && l_Transient.FirstPass <= l_Other.LastPass)
+                    {
+                        l_Occupied.emplace_back(l_Other.Offset, l_Other.Offset + l_Other.Requirements.Size);
+                    }
                 }
 
-                commandList.EndRendering();
+                std::sort(l_Occupied.begin(), l_Occupied.end());
+
+                // First fit: the lowest aligned gap between claimed ranges that holds the texture, or the end of the heap
+                uint64_t l_Offset = 0;
+                for (const std::pair<uint64_t, uint64_t>& it_Range : l_Occupied)
+                {
+                    if (AlignUp(l_Offset, l_Requirements.Alignment) + l_Requirements.Size <= it_Range.first)
+                    {
+                        break;
+                    }
+
+                    l_Offset = std::max(l_Offset, it_Range.second);
+                }
+
+                l_Transient.Heap = l_Heap;
+                l_Transient.Offset = AlignUp(l_Offset, l_Requirements.Alignment);
+
+                l_Planned.TypeBits &= l_Requirements.TypeBits;
+                l_Planned.Size = std::max(l_Planned.Size, l_Transient.Offset + l_Requirements.Size);
+                l_Planned.Alignment = std::max(l_Planned.Alignment, l_Requirements.Alignment);
             }
-            else if (it_Pass.Execute)
+        }
+
+        m_Stats.TransientTextures = static_cast<uint32_t>(l_Order.size());
+        m_Stats.TransientHeaps = static_cast<uint32_t>(m_PlannedHeaps.size());
+        for (const TransientHeap& it_Heap : m_PlannedHeaps)
+        {
+            m_Stats.TransientMemory += it_Heap.Size;
+        }
+    }
+
+    void RenderGraph::RealizeTransients()
+    {
+        if (m_Device == nullptr)
+        {
+            return;
+        }
+
+        auto a_FindPooled = [this](const TransientTexture& transient) -> TextureHandle
+            {
+                for (const PooledTexture& it_Pooled : m_Pool)
+                {
+                    if (it_Pooled.Heap == transient.Heap && it_Pooled.Offset == transient.Offset && SameLayout(it_Pooled.Description, transient.Description))
+                    {
+                        return it_Pooled.Handle;
+                    }
+                }
+
+                return TextureHandle{};
+            };
+
+        // Steady state: the plan fits the current heaps and every placement already has its texture
+        bool l_Reuse = m_PlannedHeaps.size() == m_Heaps.size();
+        for (size_t l_Heap = 0; l_Reuse && l_Heap < m_PlannedHeaps.size(); ++l_Heap)
+        {
+            const TransientHeap& l_Planned = m_PlannedHeaps[l_Heap];
+            l_Reuse = m_Heaps[l_Heap].TypeBits == l_Planned.TypeBits && m_Heaps[l_Heap].Size >= l_Planned.Size && m_Heaps[l_Heap].Alignment >= l_Planned.Alignment;
+        }
+
+        for (uint32_t l_Index = 0; l_Reuse && l_Index < m_TransientCount; ++l_Index)
+        {
+            TransientTexture& l_Transient = m_Transients[l_Index];
+            if (l_Transient.Heap != UINT32_MAX)
             {
-                it_Pass.Execute(commandList);
+                l_Transient.Physical = a_FindPooled(l_Transient);
+                l_Reuse = l_Transient.Physical.IsValid();
             }
+        }
 
-            m_PassInfo.push_back(std::move(l_Info));
+        if (l_Reuse)
+        {
+            return;
+        }
+
+        // The plan changed. New textures never go over the old ones' memory: the editor UI recorded this frame may still sample them, so the old heaps are
+        // retired and only reused once that frame is done
+        ReleasePool();
+
+        for (const TransientHeap& it_Planned : m_PlannedHeaps)
+        {
+            auto it_Retired = std::find_if(m_RetiredHeaps.begin(), m_RetiredHeaps.end(), [&](const TransientHeap& retired)
+                {
+                    return retired.RetiredFrame + k_HeapReuseDelay <= m_Frame && retired.TypeBits == it_Planned.TypeBits && retired.Size >= it_Planned.Size
+                        && retired.Alignment >= it_Planned.Alignment;
+                });
+
+            if (it_Retired != m_RetiredHeaps.end())
+            {
+                m_Heaps.push_back(*it_Retired);
+                m_RetiredHeaps.erase(it_Retired);
+
+                continue;
+            }
+
+            MemoryHeapDescription l_Description;
+            l_Description.Size = it_Planned.Size;
+            l_Description.Alignment = it_Planned.Alignment;
+            l_Description.TypeBits = it_Planned.TypeBits;
+            l_Description.DebugName = "RenderGraphHeap" + std::to_string(m_Heaps.size());
+
+            TransientHeap l_Heap = it_Planned;
+            l_Heap.Handle = m_Device->CreateMemoryHeap(l_Description);
+            m_Heaps.push_back(l_Heap);
+        }
+
+        for (uint32_t l_Index = 0; l_Index < m_TransientCount; ++l_Index)
+        {
+            TransientTexture& l_Transient = m_Transients[l_Index];
+            l_Transient.Physical = TextureHandle{};
+            if (l_Transient.Heap == UINT32_MAX || !m_Heaps[l_Transient.Heap].Handle.IsValid())
+            {
+                continue;
+            }
+
+            // Identical textures with disjoint lifetimes placed at the same offset share one image
+            l_Transient.Physical = a_FindPooled(l_Transient);
+            if (l_Transient.Physical.IsValid())
+            {
+                continue;
+            }
+
+            l_Transient.Physical = m_Device->CreatePlacedTexture(l_Transient.Description, m_Heaps[l_Transient.Heap].Handle, l_Transient.Offset);
+            if (!l_Transient.Physical.IsValid())
+            {
+                TR_CORE_ERROR("Failed to place transient texture '{}'", l_Transient.Description.DebugName);
+
+                continue;
+            }
+
+            m_Pool.push_back({ l_Transient.Description, l_Transient.Heap, l_Transient.Offset, l_Transient.Physical });
+        }
+    }
+
+    void RenderGraph::ReleasePool()
+    {
+        for (const PooledTexture& it_Pooled : m_Pool)
+        {
+            m_Device->DestroyTexture(it_Pooled.Handle);
         }
 
-        if (m_HasPresent)
+        m_Pool.clear();
+
+        // Heaps are freed only after the reuse delay, well after the device has released the images placed in them
+        for (TransientHeap& it_Heap : m_Heaps)
+        {
+            if (it_Heap.Handle.IsValid())
+            {
+                it_Heap.RetiredFrame = m_Frame;
+                m_RetiredHeaps.push_back(it_Heap);
+            }
+        }
+
+        m_Heaps.clear();
+    }
+
+    void RenderGraph::CollectRetiredHeaps()
+    {
+        if (m_Device == nullptr)
+        {
+            return;
+        }
+
+        size_t l_Kept = 0;
+        for (size_t l_Index = 0; l_Index < m_RetiredHeaps.size(); ++l_Index)
+        {
+            if (m_RetiredHeaps[l_Index].RetiredFrame + k_HeapRetireFrames <= m_Frame)
+            {
+                m_Device->DestroyMemoryHeap(m_RetiredHeaps[l_Index].Handle);
+            }
+            else
+            {
+                m_RetiredHeaps[l_Kept++] = m_RetiredHeaps[l_Index];
+            }
+        }
+
+        m_RetiredHeaps.resize(l_Kept);
+    }
+
+    void RenderGraph::Execute(CommandList& commandList)
+    {
+        if (!m_IsCompiled)
+        {
+            Compile();
+        }
+
+        // Handles are resolved here rather than at compile time, so a cached plan still transitions this frame's back buffer
+        auto a_Transition = [&](uint32_t first, uint32_t count)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+
+                m_FrameBarriers.clear();
+                for (uint32_t l_Index = first; l_Index < first + count; ++l_Index)
+                {
+                    const CompiledBarrier& l_Compiled = m_Barriers[l_Index];
+
+                    TextureBarrier l_Barrier{ Resolve(l_Compiled.Resource), l_Compiled.From, l_Compiled.To };
+                    l_Barrier.Aliased = l_Compiled.Aliased;
+                    m_FrameBarriers.push_back(l_Barrier);
+                }
+
+                commandList.TransitionTextures(m_FrameBarriers.data(), count);
+            };
+
+        for (uint32_t l_Pass = 0; l_Pass < m_PassCount; ++l_Pass)
+        {
+            const CompiledPass& l_Compiled = m_Compiled[l_Pass];
+            if (l_Compiled.Culled)
+            {
+                continue;
+            }
+
+            a_Transition(l_Compiled.FirstBarrier, l_Compiled.BarrierCount);
+            RecordPass(commandList, m_Passes[l_Pass]);
+        }
+
+        a_Transition(m_FinalBarrierOffset, static_cast<uint32_t>(m_Barriers.size()) - m_FinalBarrierOffset);
+    }
+
+    void RenderGraph::RecordPass(CommandList& commandList, RenderGraphPass& pass)
+    {
+        if (pass.ManageRendering)
+        {
+            std::vector<RenderingAttachment>& l_ColorAttachments = m_FrameAttachments;
+            l_ColorAttachments.clear();
+            for (const RenderGraphColorTarget& it_Color : pass.Colors)
+            {
+                RenderingAttachment l_Attachment;
+                l_Attachment.Target = GetTexture(it_Color.Target);
+                l_Attachment.Clear = it_Color.Clear;
+                l_Attachment.ClearColor[0] = it_Color.ClearColor[0];
+                l_Attachment.ClearColor[1] = it_Color.ClearColor[1];
+                l_Attachment.ClearColor[2] = it_Color.ClearColor[2];
+                l_Attachment.ClearColor[3] = it_Color.ClearColor[3];
+                l_ColorAttachments.push_back(l_Attachment);
+            }
+
+            DepthAttachment l_DepthAttachment;
+            bool l_HasDepth = pass.Depth.IsValid();
+            if (l_HasDepth)
+            {
+                l_DepthAttachment.Target = GetTexture(pass.Depth);
+                l_DepthAttachment.Clear = pass.ClearDepth;
+                l_DepthAttachment.ClearDepth = pass.DepthClearValue;
+            }
+
+            RenderingInfo l_RenderingInfo;
+            l_RenderingInfo.ColorAttachments = l_ColorAttachments.empty() ? nullptr : l_ColorAttachments.data();
+            l_RenderingInfo.ColorAttachmentCount = static_cast<uint32_t>(l_ColorAttachments.size());
+            l_RenderingInfo.Depth = l_HasDepth ? &l_DepthAttachment : nullptr;
+            l_RenderingInfo.Width = pass.Width;
+            l_RenderingInfo.Height = pass.Height;
+
+            commandList.BeginRendering(l_RenderingInfo);
+
+            Viewport l_Viewport;
+            l_Viewport.X = 0.0f;
+            l_Viewport.Y = 0.0f;
+            l_Viewport.Width = static_cast<float>(pass.Width);
+            l_Viewport.Height = static_cast<float>(pass.Height);
+            l_Viewport.MinDepth = 0.0f;
+            l_Viewport.MaxDepth = 1.0f;
+            commandList.SetViewport(l_Viewport);
+
+            Scissor l_Scissor;
+            l_Scissor.X = 0;
+            l_Scissor.Y = 0;
+            l_Scissor.Width = pass.Width;
+            l_Scissor.Height = pass.Height;
+            commandList.SetScissor(l_Scissor);
+
+            if (pass.Execute)
+            {
+                pass.Execute(commandList);
+            }
+
+            commandList.EndRendering();
+        }
+        else if (pass.Execute)
         {
-            Transition(commandList, m_Present, ResourceState::Present);
+            pass.Execute(commandList);
         }
     }
 }
\ No newline at end of file
@@ -1,11 +1,19 @@
 #include <Trinity/Renderer/Meshes/Mesh.h>
 
+#include <algorithm>
+#include <atomic>
+
 #include <Trinity/Renderer/RHI/GraphicsDevice.h>
 #include <Trinity/Core/Log.h>
 
 namespace Trinity
 {
-    Mesh::Mesh(GraphicsDevice& device) : m_Device(device)
+    namespace
+    {
+        std::atomic<uint32_t> s_NextSortID{ 0 };
+    }
+
+    Mesh::Mesh(GraphicsDevice& device) : m_Device(device), m_SortID(s_NextSortID.fetch_add(1, std::memory_order_relaxed))
     {
 
     }
@@ -25,19 +33,62 @@ namespace Trinity
             return false;
         }
 
+        const bool l_Quantized = data.VertexFormat == MeshVertexFormat::Quantized;
+        const uint32_t l_PositionStride = l_Quantized ? sizeof(QuantizedMeshPosition) : sizeof(glm::vec3);
+        const uint32_t l_AttributeStride = l_Quantized ? sizeof(QuantizedMeshVertexAttributes) : sizeof(MeshVertexAttributes);
+
+        // Split the interleaved vertices into a packed position stream and an attribute stream, so depth-only passes fetch only the positions
+        const uint64_t l_PositionBytes = static_cast<uint64_t>(data.Vertices.size()) * l_PositionStride;
+        const uint64_t l_AttributeOffset = (l_PositionBytes + 15) & ~uint64_t{ 15 };
+        const uint64_t l_VertexBytes = l_AttributeOffset + static_cast<uint64_t>(data.Vertices.size()) * l_AttributeStride;
+
+        std::vector<uint8_t> l_Streams(l_VertexBytes, 0);
+        if (l_Quantized)
+        {
+            m_QuantizationBox = ComputeQuantizationBox(data.Vertices);
+
+            QuantizedMeshPosition* l_Positions = reinterpret_cast<QuantizedMeshPosition*>(l_Streams.data());
+            QuantizedMeshVertexAttributes* l_Attributes = reinterpret_cast<QuantizedMeshVertexAttributes*>(l_Streams.data() + l_AttributeOffset);
+            for (size_t l_Index = 0; l_Index < data.Vertices.size(); ++l_Index)
+            {
+                l_Positions[l_Index] = QuantizePosition(data.Vertices[l_Index], m_QuantizationBox);
+                l_Attributes[l_Index] = QuantizeAttributes(data.Vertices[l_Index]);
+            }
+        }
+        else
+        {
+            glm::vec3* l_Positions = reinterpret_cast<glm::vec3*>(l_Streams.data());
+            MeshVertexAttributes* l_Attributes = reinterpret_cast<MeshVertexAttributes*>(l_Streams.data() + l_AttributeOffset);
+            for (size_t l_Index = 0; l_Index < data.Vertices.size(); ++l_Index)
+            {
+                const MeshVertex& l_Vertex = data.Vertices[l_Index];
+                l_Positions[l_Index] = l_Vertex.Position;
+                l_Attributes[l_Index] = { l_Vertex.Normal, glm::vec4(l_Vertex.Tangent, l_Vertex.TangentSign), l_Vertex.UV };
+            }
+        }
+
         BufferDescription l_VertexDescription;
-        l_VertexDescription.Size = static_cast<uint64_t>(data.Vertices.size()) * sizeof(MeshVertex);
+        l_VertexDescription.Size = l_VertexBytes;
         l_VertexDescription.Usage = BufferUsage::Vertex;
         l_VertexDescription.Memory = MemoryUsage::GpuOnly;
-        l_VertexDescription.InitialData = data.Vertices.data();
+        l_VertexDescription.InitialData = l_Streams.data();
         l_VertexDescription.DebugName = "Mesh.Vertices";
         m_VertexBuffer = m_Device.CreateBuffer(l_VertexDescription);
 
+        // Indices are relative to each submesh's base vertex, so 16 bits are enough whenever no submesh addresses 65536 vertices or more
+        const bool l_ShortIndices = *std::max_element(data.Indices.begin(), data.Indices.end()) <= UINT16_MAX;
+
+        std::vector<uint16_t> l_ShortIndexData;
+        if (l_ShortIndices)
+        {
+            l_ShortIndexData.assign(data.Indices.begin(), data.Indices.end());
+        }
+
         BufferDescription l_IndexDescription;
-        l_IndexDescription.Size = static_cast<uint64_t>(data.Indices.size()) * sizeof(uint32_t);
+        l_IndexDescription.Size = static_cast<uint64_t>(data.Indices.size()) * (l_ShortIndices ? sizeof(uint16_t) : sizeof(uint32_t));
         l_IndexDescription.Usage = BufferUsage::Index;
         l_IndexDescription.Memory = MemoryUsage::GpuOnly;
-        l_IndexDescription.InitialData = data.Indices.data();
+        l_IndexDescription.InitialData = l_ShortIndices ? static_cast<const void*>(l_ShortIndexData.data()) : static_cast<const void*>(data.Indices.data());
         l_IndexDescription.DebugName = "Mesh.Indices";
         m_IndexBuffer = m_Device.CreateBuffer(l_IndexDescription);
 
@@ -49,10 +100,16 @@ namespace Trinity
             return false;
         }
 
+        m_VertexFormat = data.VertexFormat;
+        m_IndexType = l_ShortIndices ? IndexType::UInt16 : IndexType::UInt32;
+        m_AttributeOffset = l_AttributeOffset;
+        m_PositionStride = l_PositionStride;
+        m_AttributeStride = l_AttributeStride;
         m_VertexCount = static_cast<uint32_t>(data.Vertices.size());
         m_IndexCount = static_cast<uint32_t>(data.Indices.size());
         m_Submeshes = data.Submeshes;
         m_MaterialSlots = data.MaterialSlots;
+        m_Bounds = data.Bounds;
 
 
 
@@ -75,6 +132,13 @@ namespace Trinity
 
         m_Submeshes.clear();
         m_MaterialSlots.clear();
+        m_Bounds = MeshBounds{};
+        m_VertexFormat = MeshVertexFormat::Float;
+        m_IndexType = IndexType::UInt32;
+        m_QuantizationBox = MeshQuantizationBox{};
+        m_AttributeOffset = 0;
+        m_PositionStride = 0;
+        m_AttributeStride = 0;
         m_VertexCount = 0;
         m_IndexCount = 0;
     }
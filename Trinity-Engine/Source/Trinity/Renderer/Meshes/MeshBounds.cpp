@@ -0,0 +1,116 @@
+#include <Trinity/Renderer/Meshes/MeshBounds.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Trinity/Renderer/Meshes/MeshData.h>
+
+namespace Trinity
+{
+    glm::vec4 MeshBounds::TransformSphere(const glm::mat4& transform) const
+    {
+        glm::vec3 l_Center = glm::vec3(transform * glm::vec4(Center, 1.0f));
+
+        float l_ScaleX = glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0]));
+        float l_ScaleY = glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1]));
+        float l_ScaleZ = glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]));
+        float l_Scale = std::sqrt(std::max(l_ScaleX, std::max(l_ScaleY, l_ScaleZ)));
+
+        return glm::vec4(l_Center, Radius * l_Scale);
+    }
+
+    MeshBounds ComputeMeshBounds(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices, uint32_t firstIndex, uint32_t indexCount, uint32_t baseVertex)
+    {
+        MeshBounds l_Bounds;
+
+        const uint32_t l_End = std::min<uint32_t>(firstIndex + indexCount, static_cast<uint32_t>(indices.size()));
+        if (firstIndex >= l_End)
+        {
+            return l_Bounds;
+        }
+
+        glm::vec3 l_Min(std::numeric_limits<float>::max());
+        glm::vec3 l_Max(std::numeric_limits<float>::lowest());
+        for (uint32_t l_Index = firstIndex; l_Index < l_End; ++l_Index)
+        {
+            uint32_t l_Vertex = indices[l_Index] + baseVertex;
+            if (l_Vertex >= vertices.size())
+            {
+                continue;
+            }
+
+            l_Min = glm::min(l_Min, vertices[l_Vertex].Position);
+            l_Max = glm::max(l_Max, vertices[l_Vertex].Position);
+        }
+
+        if (l_Min.x > l_Max.x)
+        {
+            return l_Bounds;
+        }
+
+        l_Bounds.Min = l_Min;
+        l_Bounds.Max = l_Max;
+        l_Bounds.Center = (l_Min + l_Max) * 0.5f;
+
+        // Second pass against the box center gives a tighter sphere than the half diagonal for most shapes
+        float l_RadiusSquared = 0.0f;
+        for (uint32_t l_Index = firstIndex; l_Index < l_End; ++l_Index)
+        {
+            uint32_t l_Vertex = indices[l_Index] + baseVertex;
+            if (l_Vertex >= vertices.size())
+            {
+                continue;
+            }
+
+            glm::vec3 l_Offset = vertices[l_Vertex].Position - l_Bounds.Center;
+            l_RadiusSquared = std::max(l_RadiusSquared, glm::dot(l_Offset, l_Offset));
+        }
+
+        l_Bounds.Radius = std::sqrt(l_RadiusSquared);
+
+        return l_Bounds;
+    }
+
+    void ComputeMeshBounds(MeshData& data)
+    {
+        bool l_HasBounds = false;
+        glm::vec3 l_Min(0.0f);
+        glm::vec3 l_Max(0.0f);
+
+        for (Submesh& it_Submesh : data.Submeshes)
+        {
+            it_Submesh.Bounds = ComputeMeshBounds(data.Vertices, data.Indices, it_Submesh.FirstIndex, it_Submesh.IndexCount, it_Submesh.BaseVertex);
+            if (it_Submesh.IndexCount == 0)
+            {
+                continue;
+            }
+
+            l_Min = l_HasBounds ? glm::min(l_Min, it_Submesh.Bounds.Min) : it_Submesh.Bounds.Min;
+            l_Max = l_HasBounds ? glm::max(l_Max, it_Submesh.Bounds.Max) : it_Submesh.Bounds.Max;
+            l_HasBounds = true;
+        }
+
+        data.Bounds = MeshBounds{};
+        if (!l_HasBounds)
+        {
+            return;
+        }
+
+        data.Bounds.Min = l_Min;
+        data.Bounds.Max = l_Max;
+        data.Bounds.Center = (l_Min + l_Max) * 0.5f;
+
+        // Enclose every submesh sphere rather than revisiting the vertices
+        for (const Submesh& it_Submesh : data.Submeshes)
+        {
+            if (it_Submesh.IndexCount == 0)
+            {
+                continue;
+            }
+
+            float l_Reach = glm::length(it_Submesh.Bounds.Center - data.Bounds.Center) + it_Submesh.Bounds.Radius;
+            data.Bounds.Radius = std::max(data.Bounds.Radius, l_Reach);
+        }
+    }
+}
\ No newline at end of file
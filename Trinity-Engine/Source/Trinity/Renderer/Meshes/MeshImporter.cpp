@@ -4,6 +4,7 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
 #include <format>
 
 #include <Trinity/Core/Log.h>
@@ -22,11 +23,11 @@ namespace Trinity
 
     MeshImporter::~MeshImporter() = default;
 
-    std::optional<MeshData> MeshImporter::Import(const std::filesystem::path& path)
+    std::optional<MeshData> MeshImporter::Import(const std::filesystem::path& path, const MeshImportSettings& settings)
     {
         const std::string l_PathString = path.string();
 
-        const unsigned int l_Flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality | aiProcess_PreTransformVertices | aiProcess_FlipUVs;
+        const unsigned int l_Flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices | aiProcess_PreTransformVertices | aiProcess_FlipUVs;
 
         const aiScene* l_Scene = m_Implementation->Importer.ReadFile(l_PathString, l_Flags);
         if (l_Scene == nullptr || (l_Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0 || l_Scene->mRootNode == nullptr)
@@ -98,6 +99,10 @@ namespace Trinity
                 if (l_HasTangents)
                 {
                     l_Vertex.Tangent = { l_Mesh->mTangents[l_Vi].x, l_Mesh->mTangents[l_Vi].y, l_Mesh->mTangents[l_Vi].z };
+
+                    // Mirrored UVs flip the bitangent against cross(normal, tangent)
+                    const glm::vec3 l_Bitangent = { l_Mesh->mBitangents[l_Vi].x, l_Mesh->mBitangents[l_Vi].y, l_Mesh->mBitangents[l_Vi].z };
+                    l_Vertex.TangentSign = glm::dot(glm::cross(l_Vertex.Normal, l_Vertex.Tangent), l_Bitangent) < 0.0f ? -1.0f : 1.0f;
                 }
                 
                 if (l_HasUV)
@@ -134,6 +139,32 @@ namespace Trinity
             return std::nullopt;
         }
 
+        ComputeMeshBounds(l_Data);
+
+        // The levels reuse the full-detail vertices and only append indices, so quantization and the index width below are unaffected by them
+        const size_t l_FullIndexCount = l_Data.Indices.size();
+        GenerateMeshLods(l_Data, settings.Lods);
+        for (const Submesh& it_Submesh : l_Data.Submeshes)
+        {
+            l_Data.Diagnostics.LodLevels += static_cast<uint32_t>(it_Submesh.Lods.size());
+        }
+
+        l_Data.Diagnostics.LodIndices = static_cast<uint32_t>(l_Data.Indices.size() - l_FullIndexCount);
+
+        // Runs after the levels so their ranges get the same treatment, and replaces assimp's cache locality step with one that also handles overdraw
+        OptimizeMesh(l_Data, settings.Optimization);
+
+        l_Data.Diagnostics.QuantizationError = MeasureQuantizationError(l_Data.Vertices);
+        if (MeshQuantizationTolerance{}.Accepts(l_Data.Diagnostics.QuantizationError))
+        {
+            l_Data.VertexFormat = MeshVertexFormat::Quantized;
+        }
+        else
+        {
+            const MeshQuantizationError& l_Error = l_Data.Diagnostics.QuantizationError;
+            l_Data.Diagnostics.Warnings.push_back(std::format("kept full-precision vertices; quantizing would cost {:.5f} units, {:.5f} rad and {:.5f} UV", l_Error.Position, std::max(l_Error.Normal, l_Error.Tangent), l_Error.UV));
+        }
+
         ("MeshImporter: loaded '{}' ({} submeshes, {} vertices, {} indices)", l_PathString, l_Data.Submeshes.size(), l_Data.Vertices.size(), l_Data.Indices.size());
         for (const std::string& l_Warning : l_Data.Diagnostics.Warnings)
         {
@@ -142,4 +173,9 @@ namespace Trinity
 
         return l_Data;
     }
+
+    bool MeshImporter::IsExtensionSupported(const std::filesystem::path& path) const
+    {
+        return m_Implementation->Importer.IsExtensionSupported(path.extension().string());
+    }
 }
\ No newline at end of file
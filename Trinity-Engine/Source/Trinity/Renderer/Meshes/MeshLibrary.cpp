@@ -60,6 +60,8 @@ namespace Trinity
         l_Data.Diagnostics.SourcePath = "<procedural cube>";
         l_Data.Diagnostics.SourceFormat = "procedural";
 
+        ComputeMeshBounds(l_Data);
+
         return l_Data;
     }
 
@@ -96,6 +98,8 @@ namespace Trinity
         l_Data.Diagnostics.SourcePath = "<procedural plane>";
         l_Data.Diagnostics.SourceFormat = "procedural";
 
+        ComputeMeshBounds(l_Data);
+
         return l_Data;
     }
 
@@ -137,6 +141,8 @@ namespace Trinity
         l_Data.Diagnostics.SourcePath = "<procedural quad>";
         l_Data.Diagnostics.SourceFormat = "procedural";
 
+        ComputeMeshBounds(l_Data);
+
         return l_Data;
     }
 
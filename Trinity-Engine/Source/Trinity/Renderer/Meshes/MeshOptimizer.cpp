@@ -0,0 +1,638 @@
+#include <Trinity/Renderer/Meshes/MeshOptimizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Trinity/Renderer/Meshes/MeshData.h>
+
+namespace Trinity
+{
+    namespace
+    {
+        // Forsyth's tuning; the scoring cache is an LRU independent of the FIFO the metrics simulate
+        constexpr uint32_t k_ScoringCacheSize = 32;
+        constexpr float k_CacheDecayPower = 1.5f;
+        constexpr float k_LastTriangleScore = 0.75f;
+        constexpr float k_ValenceBoostScale = 2.0f;
+        constexpr float k_ValenceBoostPower = 0.5f;
+
+        constexpr uint32_t k_OverdrawGridSize = 256;
+        constexpr uint32_t k_InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        float ScoreVertex(int32_t cachePosition, uint32_t remainingTriangles)
+        {
+            if (remainingTriangles == 0)
+            {
+                return -1.0f;
+            }
+
+            float l_Score = 0.0f;
+            if (cachePosition >= 0)
+            {
+                // The last triangle's vertices get a fixed score, so the next one does not just reuse the same edge
+                if (cachePosition < 3)
+                {
+                    l_Score = k_LastTriangleScore;
+                }
+                else
+                {
+                    const float l_Age = static_cast<float>(cachePosition - 3) / static_cast<float>(k_ScoringCacheSize - 3);
+                    l_Score = std::pow(1.0f - l_Age, k_CacheDecayPower);
+                }
+            }
+
+            // Finishing off vertices with few triangles left stops lone triangles being stranded for a costly revisit later
+            l_Score += k_ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -k_ValenceBoostPower);
+
+            return l_Score;
+        }
+
+        uint32_t CountReferencedRange(std::span<const uint32_t> indices)
+        {
+            uint32_t l_Count = 0;
+            for (uint32_t it_Index : indices)
+            {
+                l_Count = std::max(l_Count, it_Index + 1);
+            }
+
+            return l_Count;
+        }
+
+        // FIFO cache as insertion timestamps: a vertex is resident while fewer than cacheSize others went in after it, and hits do not refresh it
+        struct FifoCache
+        {
+            std::vector<uint32_t> Timestamps;
+            uint32_t Time = 0;
+            uint32_t Size = 0;
+
+            FifoCache(uint32_t vertexCount, uint32_t size) : Timestamps(vertexCount, 0), Time(size + 1), Size(size)
+            {
+
+            }
+
+            void Reset()
+            {
+                Time += Size + 1;
+            }
+
+            uint32_t Access(uint32_t vertex)
+            {
+                if (Time - Timestamps[vertex] > Size)
+                {
+                    Timestamps[vertex] = Time++;
+
+                    return 1;
+                }
+
+                return 0;
+            }
+
+            uint32_t AccessTriangle(const uint32_t* triangle)
+            {
+                return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]);
+            }
+        };
+    }
+
+    VertexCacheStatistics AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStatistics l_Statistics;
+        l_Statistics.Triangles = static_cast<uint32_t>(indices.size() / 3);
+        if (l_Statistics.Triangles == 0 || cacheSize == 0)
+        {
+            return l_Statistics;
+        }
+
+        FifoCache l_Cache(vertexCount, cacheSize);
+        std::vector<uint8_t> l_Referenced(vertexCount, 0);
+        for (size_t l_Index = 0; l_Index < static_cast<size_t>(l_Statistics.Triangles) * 3; ++l_Index)
+        {
+            const uint32_t l_Vertex = indices[l_Index];
+            if (l_Vertex >= vertexCount)
+            {
+                continue;
+            }
+
+            l_Statistics.VerticesTransformed += l_Cache.Access(l_Vertex);
+            l_Statistics.Vertices += l_Referenced[l_Vertex] == 0 ? 1 : 0;
+            l_Referenced[l_Vertex] = 1;
+        }
+
+        l_Statistics.Acmr = static_cast<float>(l_Statistics.VerticesTransformed) / static_cast<float>(l_Statistics.Triangles);
+        l_Statistics.Atvr = l_Statistics.Vertices > 0 ? static_cast<float>(l_Statistics.VerticesTransformed) / static_cast<float>(l_Statistics.Vertices) : 0.0f;
+
+        return l_Statistics;
+    }
+
+    OverdrawStatistics AnalyzeOverdraw(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices)
+    {
+        OverdrawStatistics l_Statistics;
+        const size_t l_TriangleCount = indices.size() / 3;
+
+        glm::vec3 l_Min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 l_Max = glm::vec3(std::numeric_limits<float>::lowest());
+        for (size_t l_Index = 0; l_Index < l_TriangleCount * 3; ++l_Index)
+        {
+            if (indices[l_Index] < vertices.size())
+            {
+                l_Min = glm::min(l_Min, vertices[indices[l_Index]].Position);
+                l_Max = glm::max(l_Max, vertices[indices[l_Index]].Position);
+            }
+        }
+
+        const float l_Extent = std::max(std::max(l_Max.x - l_Min.x, l_Max.y - l_Min.y), l_Max.z - l_Min.z);
+        if (l_TriangleCount == 0 || !(l_Extent > 0.0f))
+        {
+            return l_Statistics;
+        }
+
+        // Uniform scale on every axis, so each view keeps the mesh's proportions
+        const float l_Scale = static_cast<float>(k_OverdrawGridSize - 1) / l_Extent;
+        std::vector<float> l_Depth(k_OverdrawGridSize * k_OverdrawGridSize);
+
+        for (int32_t it_Axis = 0; it_Axis < 3; ++it_Axis)
+        {
+            const int32_t l_U = (it_Axis + 1) % 3;
+            const int32_t l_V = (it_Axis + 2) % 3;
+
+            for (float it_Sign : { 1.0f, -1.0f })
+            {
+                std::fill(l_Depth.begin(), l_Depth.end(), std::numeric_limits<float>::max());
+
+                for (size_t l_Triangle = 0; l_Triangle < l_TriangleCount; ++l_Triangle)
+                {
+                    const uint32_t* l_Indices = indices.data() + l_Triangle * 3;
+                    if (l_Indices[0] >= vertices.size() || l_Indices[1] >= vertices.size() || l_Indices[2] >= vertices.size())
+                    {
+                        continue;
+                    }
+
+                    // Screen x and y run along the two other axes and depth grows along the view direction, it_Sign times the axis
+                    float l_X[3], l_Y[3], l_Z[3];
+                    for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+                    {
+                        const glm::vec3 l_Position = vertices[l_Indices[l_Corner]].Position - l_Min;
+                        l_X[l_Corner] = l_Position[l_U] * l_Scale;
+                        l_Y[l_Corner] = l_Position[l_V] * l_Scale;
+                        l_Z[l_Corner] = l_Position[it_Axis] * it_Sign;
+                    }
+
+                    // The signed area is the normal's component along the axis; counter-clockwise front faces point back at the viewer
+                    const float l_Area = (l_X[1] - l_X[0]) * (l_Y[2] - l_Y[0]) - (l_X[2] - l_X[0]) * (l_Y[1] - l_Y[0]);
+                    if (l_Area * it_Sign >= 0.0f)
+                    {
+                        continue;
+                    }
+
+                    const uint32_t l_MinX = static_cast<uint32_t>(std::max(std::floor(std::min({ l_X[0], l_X[1], l_X[2] })), 0.0f));
+                    const uint32_t l_MinY = static_cast<uint32_t>(std::max(std::floor(std::min({ l_Y[0], l_Y[1], l_Y[2] })), 0.0f));
+                    const uint32_t l_MaxX = std::min(static_cast<uint32_t>(std::max({ l_X[0], l_X[1], l_X[2] })), k_OverdrawGridSize - 1);
+                    const uint32_t l_MaxY = std::min(static_cast<uint32_t>(std::max({ l_Y[0], l_Y[1], l_Y[2] })), k_OverdrawGridSize - 1);
+                    const float l_InverseArea = 1.0f / l_Area;
+
+                    for (uint32_t l_PixelY = l_MinY; l_PixelY <= l_MaxY; ++l_PixelY)
+                    {
+                        for (uint32_t l_PixelX = l_MinX; l_PixelX <= l_MaxX; ++l_PixelX)
+                        {
+                            const float l_SampleX = static_cast<float>(l_PixelX) + 0.5f;
+                            const float l_SampleY = static_cast<float>(l_PixelY) + 0.5f;
+
+                            // Barycentrics from the edge functions, already divided by the area so their sign no longer depends on the winding
+                            const float l_W0 = ((l_X[1] - l_SampleX) * (l_Y[2] - l_SampleY) - (l_X[2] - l_SampleX) * (l_Y[1] - l_SampleY)) * l_InverseArea;
+                            const float l_W1 = ((l_X[2] - l_SampleX) * (l_Y[0] - l_SampleY) - (l_X[0] - l_SampleX) * (l_Y[2] - l_SampleY)) * l_InverseArea;
+                            const float l_W2 = 1.0f - l_W0 - l_W1;
+                            if (l_W0 < 0.0f || l_W1 < 0.0f || l_W2 < 0.0f)
+                            {
+                                continue;
+                            }
+
+                            float& l_Stored = l_Depth[l_PixelY * k_OverdrawGridSize + l_PixelX];
+                            const float l_FragmentDepth = l_W0 * l_Z[0] + l_W1 * l_Z[1] + l_W2 * l_Z[2];
+                            if (l_Stored == std::numeric_limits<float>::max())
+                            {
+                                ++l_Statistics.PixelsCovered;
+                            }
+
+                            if (l_FragmentDepth < l_Stored)
+                            {
+                                l_Stored = l_FragmentDepth;
+                                ++l_Statistics.PixelsShaded;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        l_Statistics.Overdraw = l_Statistics.PixelsCovered > 0 ? static_cast<float>(l_Statistics.PixelsShaded) / static_cast<float>(l_Statistics.PixelsCovered) : 0.0f;
+
+        return l_Statistics;
+    }
+
+    void OptimizeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, std::vector<uint32_t>& outIndices)
+    {
+        const uint32_t l_TriangleCount = static_cast<uint32_t>(indices.size() / 3);
+        outIndices.clear();
+        outIndices.reserve(static_cast<size_t>(l_TriangleCount) * 3);
+
+        // Triangles of each vertex, packed; the first Remaining entries of a vertex's run are the ones not emitted yet
+        std::vector<uint32_t> l_Remaining(vertexCount, 0);
+        for (size_t l_Index = 0; l_Index < static_cast<size_t>(l_TriangleCount) * 3; ++l_Index)
+        {
+            ++l_Remaining[indices[l_Index]];
+        }
+
+        std::vector<uint32_t> l_Offsets(vertexCount + 1, 0);
+        for (uint32_t l_Vertex = 0; l_Vertex < vertexCount; ++l_Vertex)
+        {
+            l_Offsets[l_Vertex + 1] = l_Offsets[l_Vertex] + l_Remaining[l_Vertex];
+        }
+
+        std::vector<uint32_t> l_Adjacency(static_cast<size_t>(l_TriangleCount) * 3);
+        std::vector<uint32_t> l_Fill(l_Offsets.begin(), l_Offsets.end() - 1);
+        for (uint32_t l_Triangle = 0; l_Triangle < l_TriangleCount; ++l_Triangle)
+        {
+            for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+            {
+                l_Adjacency[l_Fill[indices[l_Triangle * 3 + l_Corner]]++] = l_Triangle;
+            }
+        }
+
+        std::vector<int32_t> l_CachePosition(vertexCount, -1);
+        std::vector<float> l_VertexScore(vertexCount);
+        for (uint32_t l_Vertex = 0; l_Vertex < vertexCount; ++l_Vertex)
+        {
+            l_VertexScore[l_Vertex] = ScoreVertex(-1, l_Remaining[l_Vertex]);
+        }
+
+        std::vector<uint8_t> l_Emitted(l_TriangleCount, 0);
+        uint32_t l_Cache[k_ScoringCacheSize + 3];
+        uint32_t l_CacheCount = 0;
+        uint32_t l_Best = k_InvalidIndex;
+        uint32_t l_Cursor = 0;
+
+        for (uint32_t l_EmittedCount = 0; l_EmittedCount < l_TriangleCount; ++l_EmittedCount)
+        {
+            // Nothing left next to the cache; restart from the first triangle not emitted, which keeps the source's locality
+            if (l_Best == k_InvalidIndex)
+            {
+                while (l_Emitted[l_Cursor] != 0)
+                {
+                    ++l_Cursor;
+                }
+
+                l_Best = l_Cursor;
+            }
+
+            const uint32_t* l_Triangle = indices.data() + static_cast<size_t>(l_Best) * 3;
+            outIndices.insert(outIndices.end(), l_Triangle, l_Triangle + 3);
+            l_Emitted[l_Best] = 1;
+
+            // The triangle's vertices move to the front of the LRU, the rest keep their order behind them
+            uint32_t l_NewCache[k_ScoringCacheSize + 3];
+            uint32_t l_NewCount = 0;
+            for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+            {
+                const uint32_t l_Vertex = l_Triangle[l_Corner];
+                if (std::find(l_NewCache, l_NewCache + l_NewCount, l_Vertex) == l_NewCache + l_NewCount)
+                {
+                    l_NewCache[l_NewCount++] = l_Vertex;
+                }
+
+                uint32_t* l_Begin = l_Adjacency.data() + l_Offsets[l_Vertex];
+                uint32_t* l_End = l_Begin + l_Remaining[l_Vertex];
+                uint32_t* l_Found = std::find(l_Begin, l_End, l_Best);
+                if (l_Found != l_End)
+                {
+                    std::swap(*l_Found, *(l_End - 1));
+                    --l_Remaining[l_Vertex];
+                }
+            }
+
+            for (uint32_t l_Entry = 0; l_Entry < l_CacheCount; ++l_Entry)
+            {
+                const uint32_t l_Vertex = l_Cache[l_Entry];
+                if (l_Vertex != l_Triangle[0] && l_Vertex != l_Triangle[1] && l_Vertex != l_Triangle[2])
+                {
+                    l_NewCache[l_NewCount++] = l_Vertex;
+                }
+            }
+
+            // Rescores everything the cache touched, evicted vertices included, and looks for the next triangle only around the resident ones
+            l_Best = k_InvalidIndex;
+            float l_BestScore = -std::numeric_limits<float>::max();
+            for (uint32_t l_Entry = 0; l_Entry < l_NewCount; ++l_Entry)
+            {
+                const uint32_t l_Vertex = l_NewCache[l_Entry];
+                l_CachePosition[l_Vertex] = l_Entry < k_ScoringCacheSize ? static_cast<int32_t>(l_Entry) : -1;
+                l_VertexScore[l_Vertex] = ScoreVertex(l_CachePosition[l_Vertex], l_Remaining[l_Vertex]);
+            }
+
+            for (uint32_t l_Entry = 0; l_Entry < std::min(l_NewCount, k_ScoringCacheSize); ++l_Entry)
+            {
+                const uint32_t l_Vertex = l_NewCache[l_Entry];
+                for (uint32_t l_Slot = l_Offsets[l_Vertex]; l_Slot < l_Offsets[l_Vertex] + l_Remaining[l_Vertex]; ++l_Slot)
+                {
+                    const uint32_t* l_Candidate = indices.data() + static_cast<size_t>(l_Adjacency[l_Slot]) * 3;
+                    const float l_Score = l_VertexScore[l_Candidate[0]] + l_VertexScore[l_Candidate[1]] + l_VertexScore[l_Candidate[2]];
+                    if (l_Score > l_BestScore)
+                    {
+                        l_BestScore = l_Score;
+                        l_Best = l_Adjacency[l_Slot];
+                    }
+                }
+            }
+
+            l_CacheCount = std::min(l_NewCount, k_ScoringCacheSize);
+            std::copy(l_NewCache, l_NewCache + l_CacheCount, l_Cache);
+        }
+    }
+
+    bool OptimizeOverdraw(std::span<const MeshVertex> vertices, std::span<uint32_t> indices, uint32_t cacheSize, float threshold)
+    {
+        const uint32_t l_TriangleCount = static_cast<uint32_t>(indices.size() / 3);
+        const uint32_t l_VertexCount = CountReferencedRange(indices);
+        if (l_TriangleCount < 2 || cacheSize == 0 || threshold < 1.0f || l_VertexCount > vertices.size())
+        {
+            return false;
+        }
+
+        // Hard boundaries: triangles that miss on all three vertices, where the cache optimizer ran out of neighbours and started somewhere new
+        FifoCache l_Cache(l_VertexCount, cacheSize);
+        std::vector<uint32_t> l_HardBoundaries;
+        for (uint32_t l_Triangle = 0; l_Triangle < l_TriangleCount; ++l_Triangle)
+        {
+            if (l_Cache.AccessTriangle(indices.data() + l_Triangle * 3) == 3)
+            {
+                l_HardBoundaries.push_back(l_Triangle);
+            }
+        }
+
+        l_HardBoundaries.push_back(l_TriangleCount);
+
+        // Soft boundaries: each cluster starts on a cold cache and closes as soon as its own ACMR is within threshold of the whole hard cluster's
+        std::vector<uint32_t> l_Clusters;
+        for (size_t l_Hard = 0; l_Hard + 1 < l_HardBoundaries.size(); ++l_Hard)
+        {
+            const uint32_t l_Begin = l_HardBoundaries[l_Hard];
+            const uint32_t l_End = l_HardBoundaries[l_Hard + 1];
+
+            l_Cache.Reset();
+            uint32_t l_Misses = 0;
+            for (uint32_t l_Triangle = l_Begin; l_Triangle < l_End; ++l_Triangle)
+            {
+                l_Misses += l_Cache.AccessTriangle(indices.data() + l_Triangle * 3);
+            }
+
+            const float l_ClusterThreshold = threshold * static_cast<float>(l_Misses) / static_cast<float>(l_End - l_Begin);
+
+            l_Cache.Reset();
+            l_Clusters.push_back(l_Begin);
+            uint32_t l_ClusterBegin = l_Begin;
+            uint32_t l_ClusterMisses = 0;
+            for (uint32_t l_Triangle = l_Begin; l_Triangle + 1 < l_End; ++l_Triangle)
+            {
+                l_ClusterMisses += l_Cache.AccessTriangle(indices.data() + l_Triangle * 3);
+                if (static_cast<float>(l_ClusterMisses) <= l_ClusterThreshold * static_cast<float>(l_Triangle + 1 - l_ClusterBegin))
+                {
+                    l_Clusters.push_back(l_Triangle + 1);
+                    l_ClusterBegin = l_Triangle + 1;
+                    l_ClusterMisses = 0;
+                    l_Cache.Reset();
+                }
+            }
+        }
+
+        const uint32_t l_ClusterCount = static_cast<uint32_t>(l_Clusters.size());
+        l_Clusters.push_back(l_TriangleCount);
+        if (l_ClusterCount < 2)
+        {
+            return false;
+        }
+
+        // Area-weighted centroid and normal of every cluster; the normal sum is twice the projected area, so it needs no separate weight
+        std::vector<glm::vec3> l_Centroids(l_ClusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> l_Normals(l_ClusterCount, glm::vec3(0.0f));
+        std::vector<float> l_Areas(l_ClusterCount, 0.0f);
+        glm::vec3 l_MeshCentroid = glm::vec3(0.0f);
+        float l_MeshArea = 0.0f;
+
+        for (uint32_t l_Cluster = 0; l_Cluster < l_ClusterCount; ++l_Cluster)
+        {
+            for (uint32_t l_Triangle = l_Clusters[l_Cluster]; l_Triangle < l_Clusters[l_Cluster + 1]; ++l_Triangle)
+            {
+                const glm::vec3& l_A = vertices[indices[l_Triangle * 3 + 0]].Position;
+                const glm::vec3& l_B = vertices[indices[l_Triangle * 3 + 1]].Position;
+                const glm::vec3& l_C = vertices[indices[l_Triangle * 3 + 2]].Position;
+
+                const glm::vec3 l_Normal = glm::cross(l_B - l_A, l_C - l_A);
+                const float l_Area = glm::length(l_Normal);
+
+                l_Centroids[l_Cluster] += (l_A + l_B + l_C) * (l_Area / 3.0f);
+                l_Normals[l_Cluster] += l_Normal;
+                l_Areas[l_Cluster] += l_Area;
+            }
+
+            l_MeshCentroid += l_Centroids[l_Cluster];
+            l_MeshArea += l_Areas[l_Cluster];
+        }
+
+        if (!(l_MeshArea > 0.0f))
+        {
+            return false;
+        }
+
+        l_MeshCentroid /= l_MeshArea;
+
+        // Clusters far out along their own normal tend to sit in front of the rest from most directions they can be seen
+        std::vector<float> l_SortKeys(l_ClusterCount, 0.0f);
+        for (uint32_t l_Cluster = 0; l_Cluster < l_ClusterCount; ++l_Cluster)
+        {
+            const float l_NormalLength = glm::length(l_Normals[l_Cluster]);
+            if (l_Areas[l_Cluster] > 0.0f && l_NormalLength > 0.0f)
+            {
+                l_SortKeys[l_Cluster] = glm::dot(l_Centroids[l_Cluster] / l_Areas[l_Cluster] - l_MeshCentroid, l_Normals[l_Cluster] / l_NormalLength);
+            }
+        }
+
+        std::vector<uint32_t> l_Order(l_ClusterCount);
+        for (uint32_t l_Cluster = 0; l_Cluster < l_ClusterCount; ++l_Cluster)
+        {
+            l_Order[l_Cluster] = l_Cluster;
+        }
+
+        std::stable_sort(l_Order.begin(), l_Order.end(), [&](uint32_t left, uint32_t right)
+        {
+            return l_SortKeys[left] > l_SortKeys[right];
+        });
+
+        std::vector<uint32_t> l_Sorted;
+        l_Sorted.reserve(indices.size());
+        for (uint32_t it_Cluster : l_Order)
+        {
+            l_Sorted.insert(l_Sorted.end(), indices.begin() + l_Clusters[it_Cluster] * 3, indices.begin() + l_Clusters[it_Cluster + 1] * 3);
+        }
+
+        const float l_InputAcmr = AnalyzeVertexCache(indices, l_VertexCount, cacheSize).Acmr;
+        const float l_SortedAcmr = AnalyzeVertexCache(l_Sorted, l_VertexCount, cacheSize).Acmr;
+        if (l_SortedAcmr > l_InputAcmr * threshold)
+        {
+            return false;
+        }
+
+        std::copy(l_Sorted.begin(), l_Sorted.end(), indices.begin());
+
+        return true;
+    }
+
+    void OptimizeVertexFetch(MeshData& data)
+    {
+        std::vector<uint32_t> l_Remap;
+        std::vector<MeshVertex> l_Reordered;
+
+        for (Submesh& it_Submesh : data.Submeshes)
+        {
+            if (it_Submesh.BaseVertex >= data.Vertices.size())
+            {
+                continue;
+            }
+
+            // Full detail first, so its order decides the layout; the levels only reference a subset of the same vertices
+            std::vector<std::span<uint32_t>> l_Ranges;
+            l_Ranges.push_back(std::span<uint32_t>(data.Indices).subspan(it_Submesh.FirstIndex, it_Submesh.IndexCount));
+            for (const SubmeshLod& it_Lod : it_Submesh.Lods)
+            {
+                l_Ranges.push_back(std::span<uint32_t>(data.Indices).subspan(it_Lod.FirstIndex, it_Lod.IndexCount));
+            }
+
+            uint32_t l_VertexCount = 0;
+            for (std::span<uint32_t> it_Range : l_Ranges)
+            {
+                l_VertexCount = std::max(l_VertexCount, CountReferencedRange(it_Range));
+            }
+
+            if (l_VertexCount > data.Vertices.size() - it_Submesh.BaseVertex)
+            {
+                continue;
+            }
+
+            l_Remap.assign(l_VertexCount, k_InvalidIndex);
+            uint32_t l_Next = 0;
+            for (std::span<uint32_t> it_Range : l_Ranges)
+            {
+                for (uint32_t it_Index : it_Range)
+                {
+                    if (l_Remap[it_Index] == k_InvalidIndex)
+                    {
+                        l_Remap[it_Index] = l_Next++;
+                    }
+                }
+            }
+
+            for (uint32_t& it_Slot : l_Remap)
+            {
+                if (it_Slot == k_InvalidIndex)
+                {
+                    it_Slot = l_Next++;
+                }
+            }
+
+            l_Reordered.resize(l_VertexCount);
+            for (uint32_t l_Vertex = 0; l_Vertex < l_VertexCount; ++l_Vertex)
+            {
+                l_Reordered[l_Remap[l_Vertex]] = data.Vertices[it_Submesh.BaseVertex + l_Vertex];
+            }
+
+            std::copy(l_Reordered.begin(), l_Reordered.end(), data.Vertices.begin() + it_Submesh.BaseVertex);
+            for (std::span<uint32_t> it_Range : l_Ranges)
+            {
+                for (uint32_t& it_Index : it_Range)
+                {
+                    it_Index = l_Remap[it_Index];
+                }
+            }
+        }
+    }
+
+    void OptimizeMesh(MeshData& data, const MeshOptimizeSettings& settings)
+    {
+        data.Diagnostics.SourceMetrics = MeasureMeshMetrics(data, settings.CacheSize);
+        if (!settings.Enabled)
+        {
+            data.Diagnostics.OptimizedMetrics = data.Diagnostics.SourceMetrics;
+
+            return;
+        }
+
+        std::vector<uint32_t> l_Optimized;
+        for (const Submesh& it_Submesh : data.Submeshes)
+        {
+            if (it_Submesh.BaseVertex >= data.Vertices.size())
+            {
+                continue;
+            }
+
+            const std::span<const MeshVertex> l_Vertices = std::span<const MeshVertex>(data.Vertices).subspan(it_Submesh.BaseVertex);
+            auto a_OptimizeRange = [&](uint32_t firstIndex, uint32_t indexCount)
+            {
+                const std::span<uint32_t> l_Range = std::span<uint32_t>(data.Indices).subspan(firstIndex, indexCount);
+                const uint32_t l_VertexCount = CountReferencedRange(l_Range);
+                if (l_VertexCount > l_Vertices.size())
+                {
+                    return;
+                }
+
+                OptimizeVertexCache(l_Range, l_VertexCount, l_Optimized);
+                std::copy(l_Optimized.begin(), l_Optimized.end(), l_Range.begin());
+                OptimizeOverdraw(l_Vertices, l_Range, settings.CacheSize, settings.OverdrawThreshold);
+            };
+
+            a_OptimizeRange(it_Submesh.FirstIndex, it_Submesh.IndexCount);
+            for (const SubmeshLod& it_Lod : it_Submesh.Lods)
+            {
+                a_OptimizeRange(it_Lod.FirstIndex, it_Lod.IndexCount);
+            }
+        }
+
+        OptimizeVertexFetch(data);
+
+        data.Diagnostics.OptimizedMetrics = MeasureMeshMetrics(data, settings.CacheSize);
+    }
+
+    MeshOptimizeMetrics MeasureMeshMetrics(const MeshData& data, uint32_t cacheSize)
+    {
+        uint64_t l_TotalTransformed = 0;
+        uint64_t l_TotalTriangles = 0;
+        uint64_t l_TotalVertices = 0;
+        uint64_t l_TotalCovered = 0;
+        uint64_t l_TotalShaded = 0;
+
+        for (const Submesh& it_Submesh : data.Submeshes)
+        {
+            if (it_Submesh.BaseVertex >= data.Vertices.size())
+            {
+                continue;
+            }
+
+            const std::span<const MeshVertex> l_Vertices = std::span<const MeshVertex>(data.Vertices).subspan(it_Submesh.BaseVertex);
+            const std::span<const uint32_t> l_Range = std::span<const uint32_t>(data.Indices).subspan(it_Submesh.FirstIndex, it_Submesh.IndexCount);
+
+            const VertexCacheStatistics l_Cache = AnalyzeVertexCache(l_Range, std::min(CountReferencedRange(l_Range), static_cast<uint32_t>(l_Vertices.size())), cacheSize);
+            l_TotalTransformed += l_Cache.VerticesTransformed;
+            l_TotalTriangles += l_Cache.Triangles;
+            l_TotalVertices += l_Cache.Vertices;
+
+            const OverdrawStatistics l_Overdraw = AnalyzeOverdraw(l_Vertices, l_Range);
+            l_TotalCovered += l_Overdraw.PixelsCovered;
+            l_TotalShaded += l_Overdraw.PixelsShaded;
+        }
+
+        MeshOptimizeMetrics l_Metrics;
+        l_Metrics.Acmr = l_TotalTriangles > 0 ? static_cast<float>(l_TotalTransformed) / static_cast<float>(l_TotalTriangles) : 0.0f;
+        l_Metrics.Atvr = l_TotalVertices > 0 ? static_cast<float>(l_TotalTransformed) / static_cast<float>(l_TotalVertices) : 0.0f;
+        l_Metrics.Overdraw = l_TotalCovered > 0 ? static_cast<float>(l_TotalShaded) / static_cast<float>(l_TotalCovered) : 0.0f;
+
+        return l_Metrics;
+    }
+}
\ No newline at end of file
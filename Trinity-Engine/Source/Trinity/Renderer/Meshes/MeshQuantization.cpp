@@ -0,0 +1,142 @@
+#include <Trinity/Renderer/Meshes/MeshQuantization.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/gtc/packing.hpp>
+
+namespace Trinity
+{
+    static uint16_t ToUnorm16(float value)
+    {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    static int16_t ToSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    static float FromSnorm16(int16_t value)
+    {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    // Folds the unit sphere onto the [-1, 1] square: the upper hemisphere maps to the inner diamond, the lower one to the corners
+    static glm::vec2 EncodeOctahedral(const glm::vec3& direction)
+    {
+        const float l_Sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (l_Sum <= 0.0f)
+        {
+            return glm::vec2(0.0f);
+        }
+
+        glm::vec2 l_Encoded = glm::vec2(direction.x, direction.y) / l_Sum;
+        if (direction.z < 0.0f)
+        {
+            const glm::vec2 l_Folded = glm::vec2(1.0f - std::abs(l_Encoded.y), 1.0f - std::abs(l_Encoded.x));
+            l_Encoded = glm::vec2(l_Encoded.x >= 0.0f ? l_Folded.x : -l_Folded.x, l_Encoded.y >= 0.0f ? l_Folded.y : -l_Folded.y);
+        }
+
+        return l_Encoded;
+    }
+
+    static glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+    {
+        glm::vec3 l_Direction(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        const float l_Fold = std::max(-l_Direction.z, 0.0f);
+        l_Direction.x += l_Direction.x >= 0.0f ? -l_Fold : l_Fold;
+        l_Direction.y += l_Direction.y >= 0.0f ? -l_Fold : l_Fold;
+
+        return glm::normalize(l_Direction);
+    }
+
+    static float AngleBetween(const glm::vec3& direction, const glm::vec3& decoded)
+    {
+        const float l_Length = glm::length(direction);
+        if (l_Length <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        return std::acos(std::clamp(glm::dot(direction / l_Length, decoded), -1.0f, 1.0f));
+    }
+
+    MeshQuantizationBox ComputeQuantizationBox(std::span<const MeshVertex> vertices)
+    {
+        MeshQuantizationBox l_Box;
+        if (vertices.empty())
+        {
+            return l_Box;
+        }
+
+        glm::vec3 l_Min(std::numeric_limits<float>::max());
+        glm::vec3 l_Max(std::numeric_limits<float>::lowest());
+        for (const MeshVertex& it_Vertex : vertices)
+        {
+            l_Min = glm::min(l_Min, it_Vertex.Position);
+            l_Max = glm::max(l_Max, it_Vertex.Position);
+        }
+
+        l_Box.Offset = l_Min;
+        l_Box.Scale = l_Max - l_Min;
+
+        return l_Box;
+    }
+
+    QuantizedMeshPosition QuantizePosition(const MeshVertex& vertex, const MeshQuantizationBox& box)
+    {
+        QuantizedMeshPosition l_Position{};
+        for (int l_Axis = 0; l_Axis < 3; ++l_Axis)
+        {
+            // A flat axis decodes to the offset whatever is stored
+            l_Position.Value[l_Axis] = box.Scale[l_Axis] > 0.0f ? ToUnorm16((vertex.Position[l_Axis] - box.Offset[l_Axis]) / box.Scale[l_Axis]) : 0;
+        }
+
+        l_Position.Value[3] = vertex.TangentSign < 0.0f ? 65535 : 0;
+
+        return l_Position;
+    }
+
+    QuantizedMeshVertexAttributes QuantizeAttributes(const MeshVertex& vertex)
+    {
+        const glm::vec2 l_Normal = EncodeOctahedral(vertex.Normal);
+        const glm::vec2 l_Tangent = EncodeOctahedral(vertex.Tangent);
+
+        QuantizedMeshVertexAttributes l_Attributes{};
+        l_Attributes.Normal[0] = ToSnorm16(l_Normal.x);
+        l_Attributes.Normal[1] = ToSnorm16(l_Normal.y);
+        l_Attributes.Tangent[0] = ToSnorm16(l_Tangent.x);
+        l_Attributes.Tangent[1] = ToSnorm16(l_Tangent.y);
+        l_Attributes.UV[0] = glm::packHalf1x16(vertex.UV.x);
+        l_Attributes.UV[1] = glm::packHalf1x16(vertex.UV.y);
+
+        return l_Attributes;
+    }
+
+    MeshQuantizationError MeasureQuantizationError(std::span<const MeshVertex> vertices)
+    {
+        MeshQuantizationError l_Error;
+
+        const MeshQuantizationBox l_Box = ComputeQuantizationBox(vertices);
+        for (const MeshVertex& it_Vertex : vertices)
+        {
+            const QuantizedMeshPosition l_Position = QuantizePosition(it_Vertex, l_Box);
+            const QuantizedMeshVertexAttributes l_Attributes = QuantizeAttributes(it_Vertex);
+
+            const glm::vec3 l_Unorm = glm::vec3(l_Position.Value[0], l_Position.Value[1], l_Position.Value[2]) / 65535.0f;
+            l_Error.Position = std::max(l_Error.Position, glm::length(l_Unorm * l_Box.Scale + l_Box.Offset - it_Vertex.Position));
+
+            const glm::vec3 l_Normal = DecodeOctahedral(glm::vec2(FromSnorm16(l_Attributes.Normal[0]), FromSnorm16(l_Attributes.Normal[1])));
+            const glm::vec3 l_Tangent = DecodeOctahedral(glm::vec2(FromSnorm16(l_Attributes.Tangent[0]), FromSnorm16(l_Attributes.Tangent[1])));
+            l_Error.Normal = std::max(l_Error.Normal, AngleBetween(it_Vertex.Normal, l_Normal));
+            l_Error.Tangent = std::max(l_Error.Tangent, AngleBetween(it_Vertex.Tangent, l_Tangent));
+
+            const glm::vec2 l_UV(glm::unpackHalf1x16(l_Attributes.UV[0]), glm::unpackHalf1x16(l_Attributes.UV[1]));
+            l_Error.UV = std::max(l_Error.UV, std::max(std::abs(l_UV.x - it_Vertex.UV.x), std::abs(l_UV.y - it_Vertex.UV.y)));
+        }
+
+        return l_Error;
+    }
+}
\ No newline at end of file
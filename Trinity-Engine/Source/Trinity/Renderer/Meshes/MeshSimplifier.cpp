@@ -0,0 +1,388 @@
+#include <Trinity/Renderer/Meshes/MeshSimplifier.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include <Trinity/Renderer/Meshes/MeshData.h>
+
+namespace Trinity
+{
+    namespace
+    {
+        // Symmetric 4x4 matrix whose form p^T Q p sums the squared distances from p to every plane added to it
+        struct Quadric
+        {
+            double XX = 0.0, XY = 0.0, XZ = 0.0, XW = 0.0;
+            double YY = 0.0, YZ = 0.0, YW = 0.0;
+            double ZZ = 0.0, ZW = 0.0;
+            double WW = 0.0;
+
+            void AddPlane(const glm::dvec3& normal, double distance)
+            {
+                XX += normal.x * normal.x; XY += normal.x * normal.y; XZ += normal.x * normal.z; XW += normal.x * distance;
+                YY += normal.y * normal.y; YZ += normal.y * normal.z; YW += normal.y * distance;
+                ZZ += normal.z * normal.z; ZW += normal.z * distance;
+                WW += distance * distance;
+            }
+
+            Quadric& operator+=(const Quadric& other)
+            {
+                XX += other.XX; XY += other.XY; XZ += other.XZ; XW += other.XW;
+                YY += other.YY; YZ += other.YZ; YW += other.YW;
+                ZZ += other.ZZ; ZW += other.ZW;
+                WW += other.WW;
+
+                return *this;
+            }
+
+            double Evaluate(const glm::dvec3& p) const
+            {
+                const double l_Error = p.x * (XX * p.x + 2.0 * (XY * p.y + XZ * p.z + XW)) + p.y * (YY * p.y + 2.0 * (YZ * p.z + YW)) + p.z * (ZZ * p.z + 2.0 * ZW) + WW;
+
+                return std::max(l_Error, 0.0);
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t From = 0;
+            uint32_t To = 0;
+            double Cost = 0.0;
+        };
+
+        // Exact position match; vertices split for a UV or normal seam share their position bit for bit
+        struct PositionKey
+        {
+            uint32_t Bits[3];
+
+            bool operator==(const PositionKey& other) const { return Bits[0] == other.Bits[0] && Bits[1] == other.Bits[1] && Bits[2] == other.Bits[2]; }
+        };
+
+        struct PositionKeyHash
+        {
+            size_t operator()(const PositionKey& key) const
+            {
+                return (static_cast<size_t>(key.Bits[0]) * 73856093u) ^ (static_cast<size_t>(key.Bits[1]) * 19349663u) ^ (static_cast<size_t>(key.Bits[2]) * 83492791u);
+            }
+        };
+
+        PositionKey MakePositionKey(const glm::vec3& position)
+        {
+            // Folds -0 into +0 so the two compare equal
+            const glm::vec3 l_Position = position + glm::vec3(0.0f);
+
+            PositionKey l_Key;
+            std::memcpy(l_Key.Bits, &l_Position, sizeof(l_Key.Bits));
+
+            return l_Key;
+        }
+
+        glm::vec3 TriangleNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+        {
+            return glm::cross(b - a, c - a);
+        }
+
+        // Vertices no collapse may move: those on an open border, where moving would shrink the outline, and those sharing their position with another
+        // vertex, where moving one copy would open the seam
+        std::vector<uint8_t> FindLockedVertices(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices, uint32_t vertexCount)
+        {
+            std::vector<uint32_t> l_Canonical(vertexCount);
+            std::vector<uint8_t> l_Locked(vertexCount, 0);
+            std::unordered_map<PositionKey, uint32_t, PositionKeyHash> l_Positions;
+            l_Positions.reserve(vertexCount);
+
+            for (uint32_t l_Vertex = 0; l_Vertex < vertexCount; ++l_Vertex)
+            {
+                auto [it_Entry, l_Inserted] = l_Positions.emplace(MakePositionKey(vertices[l_Vertex].Position), l_Vertex);
+                l_Canonical[l_Vertex] = it_Entry->second;
+                if (!l_Inserted)
+                {
+                    l_Locked[l_Vertex] = 1;
+                    l_Locked[it_Entry->second] = 1;
+                }
+            }
+
+            // Edges between welded positions, counted once per triangle using them; an edge only one triangle uses lies on a border
+            std::unordered_map<uint64_t, uint32_t> l_EdgeUses;
+            l_EdgeUses.reserve(indices.size());
+            for (size_t l_Index = 0; l_Index < indices.size(); l_Index += 3)
+            {
+                for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+                {
+                    const uint32_t l_A = l_Canonical[indices[l_Index + l_Corner]];
+                    const uint32_t l_B = l_Canonical[indices[l_Index + (l_Corner + 1) % 3]];
+                    ++l_EdgeUses[(static_cast<uint64_t>(std::min(l_A, l_B)) << 32) | std::max(l_A, l_B)];
+                }
+            }
+
+            for (size_t l_Index = 0; l_Index < indices.size(); l_Index += 3)
+            {
+                for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+                {
+                    const uint32_t l_A = indices[l_Index + l_Corner];
+                    const uint32_t l_B = indices[l_Index + (l_Corner + 1) % 3];
+                    const uint32_t l_CanonicalA = l_Canonical[l_A];
+                    const uint32_t l_CanonicalB = l_Canonical[l_B];
+                    if (l_EdgeUses[(static_cast<uint64_t>(std::min(l_CanonicalA, l_CanonicalB)) << 32) | std::max(l_CanonicalA, l_CanonicalB)] == 1)
+                    {
+                        l_Locked[l_A] = 1;
+                        l_Locked[l_B] = 1;
+                    }
+                }
+            }
+
+            return l_Locked;
+        }
+    }
+
+    float SimplifyMesh(std::span<const MeshVertex> vertices, std::span<const uint32_t> indices, uint32_t targetIndexCount, float maxError, std::vector<uint32_t>& outIndices)
+    {
+        outIndices.assign(indices.begin(), indices.end());
+        if (indices.size() <= targetIndexCount || indices.size() % 3 != 0)
+        {
+            return 0.0f;
+        }
+
+        const uint32_t l_VertexCount = *std::max_element(indices.begin(), indices.end()) + 1;
+        if (l_VertexCount > vertices.size())
+        {
+            return 0.0f;
+        }
+
+        const std::vector<uint8_t> l_Locked = FindLockedVertices(vertices, indices, l_VertexCount);
+
+        // Every vertex starts with the planes of the triangles around it; unweighted, so the square root of a cost bounds the distance to each of them
+        std::vector<Quadric> l_Quadrics(l_VertexCount);
+        for (size_t l_Index = 0; l_Index < indices.size(); l_Index += 3)
+        {
+            const glm::dvec3 l_A(vertices[indices[l_Index]].Position);
+            const glm::dvec3 l_B(vertices[indices[l_Index + 1]].Position);
+            const glm::dvec3 l_C(vertices[indices[l_Index + 2]].Position);
+            const glm::dvec3 l_Normal = glm::cross(l_B - l_A, l_C - l_A);
+            const double l_Length = glm::length(l_Normal);
+            if (l_Length <= 0.0)
+            {
+                continue;
+            }
+
+            const glm::dvec3 l_Unit = l_Normal / l_Length;
+            for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+            {
+                l_Quadrics[indices[l_Index + l_Corner]].AddPlane(l_Unit, -glm::dot(l_Unit, l_A));
+            }
+        }
+
+        const double l_MaxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+        double l_ReachedCost = 0.0;
+
+        std::vector<Collapse> l_Collapses;
+        std::vector<uint32_t> l_TriangleOffsets;
+        std::vector<uint32_t> l_VertexTriangles;
+        std::vector<uint32_t> l_Remap(l_VertexCount);
+        std::vector<uint8_t> l_Touched(l_VertexCount);
+
+        // Passes of independent collapses: each pass ranks the current edges by cost and takes the cheapest ones whose neighbourhoods do not overlap
+        while (outIndices.size() > targetIndexCount)
+        {
+            const size_t l_TriangleCount = outIndices.size() / 3;
+
+            l_Collapses.clear();
+            for (size_t l_Index = 0; l_Index < outIndices.size(); l_Index += 3)
+            {
+                for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+                {
+                    const uint32_t l_A = outIndices[l_Index + l_Corner];
+                    const uint32_t l_B = outIndices[l_Index + (l_Corner + 1) % 3];
+                    for (auto [l_From, l_To] : { std::pair{ l_A, l_B }, std::pair{ l_B, l_A } })
+                    {
+                        if (l_Locked[l_From] != 0)
+                        {
+                            continue;
+                        }
+
+                        Quadric l_Merged = l_Quadrics[l_From];
+                        l_Merged += l_Quadrics[l_To];
+                        const double l_Cost = l_Merged.Evaluate(glm::dvec3(vertices[l_To].Position));
+                        if (l_Cost <= l_MaxCost)
+                        {
+                            l_Collapses.push_back({ l_From, l_To, l_Cost });
+                        }
+                    }
+                }
+            }
+
+            if (l_Collapses.empty())
+            {
+                break;
+            }
+
+            std::sort(l_Collapses.begin(), l_Collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+            // Triangles around each vertex, for the flip test
+            l_TriangleOffsets.assign(l_VertexCount + 1, 0);
+            for (uint32_t it_Vertex : outIndices)
+            {
+                ++l_TriangleOffsets[it_Vertex + 1];
+            }
+
+            for (uint32_t l_Vertex = 0; l_Vertex < l_VertexCount; ++l_Vertex)
+            {
+                l_TriangleOffsets[l_Vertex + 1] += l_TriangleOffsets[l_Vertex];
+            }
+
+            l_VertexTriangles.resize(outIndices.size());
+            {
+                std::vector<uint32_t> l_Cursor(l_TriangleOffsets.begin(), l_TriangleOffsets.end() - 1);
+                for (size_t l_Index = 0; l_Index < outIndices.size(); ++l_Index)
+                {
+                    l_VertexTriangles[l_Cursor[outIndices[l_Index]]++] = static_cast<uint32_t>(l_Index / 3);
+                }
+            }
+
+            for (uint32_t l_Vertex = 0; l_Vertex < l_VertexCount; ++l_Vertex)
+            {
+                l_Remap[l_Vertex] = l_Vertex;
+            }
+
+            std::fill(l_Touched.begin(), l_Touched.end(), 0);
+
+            const size_t l_TrianglesWanted = (outIndices.size() - targetIndexCount + 2) / 3;
+            size_t l_TrianglesRemoved = 0;
+            for (const Collapse& it_Collapse : l_Collapses)
+            {
+                if (l_TrianglesRemoved >= l_TrianglesWanted)
+                {
+                    break;
+                }
+
+                if (l_Touched[it_Collapse.From] != 0 || l_Touched[it_Collapse.To] != 0)
+                {
+                    continue;
+                }
+
+                // Moving From onto To must not turn any surviving triangle around it inside out
+                const glm::vec3 l_Target = vertices[it_Collapse.To].Position;
+                bool l_Flips = false;
+                size_t l_Removes = 0;
+                for (uint32_t l_Slot = l_TriangleOffsets[it_Collapse.From]; l_Slot < l_TriangleOffsets[it_Collapse.From + 1] && !l_Flips; ++l_Slot)
+                {
+                    const uint32_t* l_Triangle = &outIndices[static_cast<size_t>(l_VertexTriangles[l_Slot]) * 3];
+                    if (l_Triangle[0] == it_Collapse.To || l_Triangle[1] == it_Collapse.To || l_Triangle[2] == it_Collapse.To)
+                    {
+                        ++l_Removes;
+                        continue;
+                    }
+
+                    glm::vec3 l_Corners[3];
+                    for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+                    {
+                        l_Corners[l_Corner] = vertices[l_Triangle[l_Corner]].Position;
+                    }
+
+                    const glm::vec3 l_Before = TriangleNormal(l_Corners[0], l_Corners[1], l_Corners[2]);
+                    for (uint32_t l_Corner = 0; l_Corner < 3; ++l_Corner)
+                    {
+                        if (l_Triangle[l_Corner] == it_Collapse.From)
+                        {
+                            l_Corners[l_Corner] = l_Target;
+                        }
+                    }
+
+                    l_Flips = glm::dot(l_Before, TriangleNormal(l_Corners[0], l_Corners[1], l_Corners[2])) <= 0.0f;
+                }
+
+                if (l_Flips)
+                {
+                    continue;
+                }
+
+                // The whole neighbourhood waits for the next pass, so the flip tests above stay valid for every collapse taken in this one
+                for (uint32_t l_Slot = l_TriangleOffsets[it_Collapse.From]; l_Slot < l_TriangleOffsets[it_Collapse.From + 1]; ++l_Slot)
+                {
+                    const uint32_t* l_Triangle = &outIndices[static_cast<size_t>(l_VertexTriangles[l_Slot]) * 3];
+                    l_Touched[l_Triangle[0]] = 1;
+                    l_Touched[l_Triangle[1]] = 1;
+                    l_Touched[l_Triangle[2]] = 1;
+                }
+
+                l_Remap[it_Collapse.From] = it_Collapse.To;
+                l_Quadrics[it_Collapse.To] += l_Quadrics[it_Collapse.From];
+                l_ReachedCost = std::max(l_ReachedCost, it_Collapse.Cost);
+                l_TrianglesRemoved += l_Removes;
+            }
+
+            if (l_TrianglesRemoved == 0)
+            {
+                break;
+            }
+
+            size_t l_Write = 0;
+            for (size_t l_Triangle = 0; l_Triangle < l_TriangleCount; ++l_Triangle)
+            {
+                const uint32_t l_A = l_Remap[outIndices[l_Triangle * 3]];
+                const uint32_t l_B = l_Remap[outIndices[l_Triangle * 3 + 1]];
+                const uint32_t l_C = l_Remap[outIndices[l_Triangle * 3 + 2]];
+                if (l_A != l_B && l_B != l_C && l_A != l_C)
+                {
+                    outIndices[l_Write++] = l_A;
+                    outIndices[l_Write++] = l_B;
+                    outIndices[l_Write++] = l_C;
+                }
+            }
+
+            outIndices.resize(l_Write);
+        }
+
+        return static_cast<float>(std::sqrt(l_ReachedCost));
+    }
+
+    void GenerateMeshLods(MeshData& data, const MeshLodSettings& settings)
+    {
+        std::vector<uint32_t> l_Source;
+        std::vector<uint32_t> l_Simplified;
+
+        for (Submesh& it_Submesh : data.Submeshes)
+        {
+            it_Submesh.Lods.clear();
+            if (it_Submesh.IndexCount < 3 || it_Submesh.BaseVertex >= data.Vertices.size())
+            {
+                continue;
+            }
+
+            // Copied out, since the levels are appended to the array the range lives in
+            l_Source.assign(data.Indices.begin() + it_Submesh.FirstIndex, data.Indices.begin() + it_Submesh.FirstIndex + it_Submesh.IndexCount);
+            const std::span<const MeshVertex> l_Vertices = std::span<const MeshVertex>(data.Vertices).subspan(it_Submesh.BaseVertex);
+            const float l_MaxError = settings.MaxError * it_Submesh.Bounds.Radius;
+
+            // Errors are kept non-decreasing along the chain, which the renderer's level selection relies on
+            uint32_t l_PreviousCount = it_Submesh.IndexCount;
+            for (float it_Ratio : settings.TargetRatios)
+            {
+                const uint32_t l_Target = static_cast<uint32_t>(static_cast<float>(it_Submesh.IndexCount / 3) * std::clamp(it_Ratio, 0.0f, 1.0f)) * 3;
+                if (l_Target >= l_PreviousCount)
+                {
+                    continue;
+                }
+
+                const float l_Error = SimplifyMesh(l_Vertices, l_Source, l_Target, l_MaxError, l_Simplified);
+
+                // Stuck on locked vertices or the error budget; coarser targets would come out the same
+                const float l_Kept = static_cast<float>(l_Simplified.size()) / static_cast<float>(l_PreviousCount);
+                if (l_Simplified.empty() || l_Kept > 1.0f - settings.MinReduction)
+                {
+                    break;
+                }
+
+                SubmeshLod& l_Lod = it_Submesh.Lods.emplace_back();
+                l_Lod.FirstIndex = static_cast<uint32_t>(data.Indices.size());
+                l_Lod.IndexCount = static_cast<uint32_t>(l_Simplified.size());
+                l_Lod.Error = it_Submesh.Lods.size() > 1 ? std::max(l_Error, it_Submesh.Lods[it_Submesh.Lods.size() - 2].Error) : l_Error;
+                data.Indices.insert(data.Indices.end(), l_Simplified.begin(), l_Simplified.end());
+
+                l_PreviousCount = l_Lod.IndexCount;
+            }
+        }
+    }
+}
\ No newline at end of file
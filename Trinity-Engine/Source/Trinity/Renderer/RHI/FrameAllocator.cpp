@@ -0,0 +1,92 @@
+#include <Trinity/Renderer/RHI/FrameAllocator.h>
+
+#include <algorithm>
+
+namespace Trinity
+{
+    void FrameAllocator::Reset(BufferHandle buffer, void* data, uint64_t capacity)
+    {
+        if (m_Capacity != 0)
+        {
+            ++m_Stats.Grows;
+        }
+
+        m_Buffer = buffer;
+        m_Data = static_cast<uint8_t*>(data);
+        m_Capacity = capacity;
+        m_Head = 0;
+        m_Used = 0;
+        m_FrameBytes = 0;
+        m_Spans.clear();
+
+        m_Stats.Capacity = capacity;
+        m_Stats.InFlightBytes = 0;
+    }
+
+    FrameAllocation FrameAllocator::Allocate(uint64_t size, uint64_t alignment)
+    {
+        if (m_Data == nullptr || size == 0 || size > m_Capacity)
+        {
+            return FrameAllocation{};
+        }
+
+        alignment = std::max<uint64_t>(alignment, 1);
+
+        // Everything between the tail and the head is owned by some frame, so the head can restart at zero whenever nothing is
+        if (m_Used == 0)
+        {
+            m_Head = 0;
+        }
+
+        uint64_t l_Offset = (m_Head + alignment - 1) / alignment * alignment;
+        uint64_t l_Consumed = l_Offset - m_Head + size;
+        if (l_Offset + size > m_Capacity)
+        {
+            // The tail of the ring is too short; skip it and start again at zero, charging the skipped bytes to this frame
+            l_Offset = 0;
+            l_Consumed = m_Capacity - m_Head + size;
+        }
+
+        if (m_Used + l_Consumed > m_Capacity)
+        {
+            return FrameAllocation{};
+        }
+
+        m_Head = l_Offset + size;
+        m_Used += l_Consumed;
+        m_FrameBytes += l_Consumed;
+
+        ++m_Stats.Allocations;
+        m_Stats.FrameBytes = m_FrameBytes;
+        m_Stats.PeakFrameBytes = std::max(m_Stats.PeakFrameBytes, m_FrameBytes);
+
+        FrameAllocation l_Allocation;
+        l_Allocation.Buffer = m_Buffer;
+        l_Allocation.Offset = l_Offset;
+        l_Allocation.Size = size;
+        l_Allocation.Data = m_Data + l_Offset;
+
+        return l_Allocation;
+    }
+
+    void FrameAllocator::BeginFrame(uint64_t frame, uint64_t retiredFrame)
+    {
+        if (m_FrameBytes != 0)
+        {
+            m_Spans.push_back({ m_Frame, m_FrameBytes });
+        }
+
+        while (!m_Spans.empty() && m_Spans.front().Frame <= retiredFrame)
+        {
+            m_Used -= m_Spans.front().Bytes;
+            m_Spans.pop_front();
+        }
+
+        m_Frame = frame;
+        m_FrameBytes = 0;
+
+        m_Stats.FrameBytes = 0;
+        m_Stats.InFlightBytes = m_Used;
+        m_Stats.Allocations = 0;
+    }
+}
\ No newline at end of file
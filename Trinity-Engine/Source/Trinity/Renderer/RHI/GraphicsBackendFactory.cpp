@@ -1,6 +1,7 @@
 #include <Trinity/Renderer/RHI/GraphicsBackendFactory.h>
 
 #include <Trinity/Core/Log.h>
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
 
 #if defined(TRINITY_ENABLE_VULKAN)
 #include <Trinity/Renderer/Backends/Vulkan/VulkanDevice.h>
@@ -33,7 +34,7 @@ namespace Trinity
             case GraphicsBackend::Vulkan:
             {
 #if defined(TRINITY_ENABLE_VULKAN)
-                auto l_Device = std::make_unique<VulkanDevice>(description.Window, description.ApplicationName, description.EnableValidation);
+                auto l_Device = std::make_unique<VulkanDevice>(description.Window, description.ApplicationName, description.EnableValidation, description.PipelineCachePath);
                 if (!l_Device->Initialize())
                 {
                     return nullptr;
@@ -41,7 +42,7 @@ namespace Trinity
 
                 return l_Device;
 #else
-                GraphicsBackendFactory: Vulkan backend not compiled in");
+                TR_CORE_ERROR("GraphicsBackendFactory: Vulkan backend not compiled in");
                 return nullptr;
 #endif
             }
@@ -52,6 +53,17 @@ namespace Trinity
             case GraphicsBackend::DirectX12:
                 return nullptr;
 
+            case GraphicsBackend::Null:
+            {
+                auto l_Device = std::make_unique<NullDevice>();
+                if (!l_Device->Initialize())
+                {
+                    return nullptr;
+                }
+
+                return l_Device;
+            }
+
             default:
                 return nullptr;
         }
@@ -0,0 +1,180 @@
+#include <Trinity/Renderer/Shaders/PipelineCompiler.h>
+
+#include <algorithm>
+
+#include <Trinity/Core/Timer.h>
+
+namespace Trinity
+{
+    static ShaderHandle CreateStage(GraphicsDevice& device, ShaderCompiler& shaderCompiler, const std::filesystem::path& searchDirectory, const PipelineShaderSource& source,
+        ShaderStage stage, std::string& outError)
+    {
+        ShaderCompileResult l_Result = shaderCompiler.Compile(searchDirectory, source.Module, source.EntryPoint, ShaderTargetFormat::SPIRV, source.Defines);
+        if (!l_Result.Success)
+        {
+            outError = source.Module + "." + source.EntryPoint + ": " + l_Result.Diagnostics;
+
+            return ShaderHandle{};
+        }
+
+        ShaderDescription l_Description;
+        l_Description.Stage = stage;
+        l_Description.Bytecode = std::move(l_Result.SPIRV);
+        l_Description.EntryPoint = source.EntryPoint;
+        l_Description.DebugName = source.Module + "." + source.EntryPoint;
+
+        ShaderHandle l_Shader = device.CreateShader(l_Description);
+        if (!l_Shader.IsValid())
+        {
+            outError = l_Description.DebugName + ": shader module creation failed";
+        }
+
+        return l_Shader;
+    }
+
+    PipelineCompiler::PipelineCompiler(GraphicsDevice& device, ShaderCompiler& shaderCompiler, JobSystem* jobSystem) : m_Device(device), m_ShaderCompiler(shaderCompiler), m_JobSystem(jobSystem)
+    {
+
+    }
+
+    PipelineCompiler::~PipelineCompiler()
+    {
+        Shutdown();
+    }
+
+    PipelineFuture PipelineCompiler::Compile(PipelineCompileRequest request)
+    {
+        PipelineFuture l_Future;
+        l_Future.m_State = std::make_shared<PipelineFuture::State>();
+        l_Future.m_State->Request = std::move(request);
+
+        if (m_JobSystem == nullptr || !m_JobSystem->IsInitialized())
+        {
+            Run(m_Device, m_ShaderCompiler, *l_Future.m_State);
+
+            return l_Future;
+        }
+
+        std::shared_ptr<PipelineFuture::State> l_State = l_Future.m_State;
+        GraphicsDevice* l_Device = &m_Device;
+        ShaderCompiler* l_ShaderCompiler = &m_ShaderCompiler;
+        l_State->Job = m_JobSystem->Schedule([l_State, l_Device, l_ShaderCompiler]()
+            {
+                Run(*l_Device, *l_ShaderCompiler, *l_State);
+            });
+
+        m_InFlight.push_back(std::move(l_State));
+
+        return l_Future;
+    }
+
+    void PipelineCompiler::Wait(const PipelineFuture& future)
+    {
+        if (!future.IsValid() || future.IsReady())
+        {
+            return;
+        }
+
+        m_JobSystem->Wait(future.m_State->Job);
+    }
+
+    void PipelineCompiler::Discard(PipelineFuture& future)
+    {
+        if (future.IsValid())
+        {
+            m_Discarded.push_back(std::move(future.m_State));
+        }
+
+        future = PipelineFuture{};
+    }
+
+    void PipelineCompiler::Collect()
+    {
+        std::erase_if(m_InFlight, [](const std::shared_ptr<PipelineFuture::State>& state) { return state->Ready.load(std::memory_order_acquire); });
+
+        std::erase_if(m_Discarded, [this](const std::shared_ptr<PipelineFuture::State>& state)
+            {
+                if (!state->Ready.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+
+                Destroy(state->Result);
+
+                return true;
+            });
+    }
+
+    void PipelineCompiler::Shutdown()
+    {
+        if (m_JobSystem != nullptr && m_JobSystem->IsInitialized())
+        {
+            for (const std::shared_ptr<PipelineFuture::State>& it_State : m_InFlight)
+            {
+                m_JobSystem->Wait(it_State->Job);
+            }
+        }
+
+        Collect();
+        m_InFlight.clear();
+    }
+
+    uint32_t PipelineCompiler::GetPendingCount() const
+    {
+        return static_cast<uint32_t>(std::count_if(m_InFlight.begin(), m_InFlight.end(), [](const std::shared_ptr<PipelineFuture::State>& state)
+            {
+                return !state->Ready.load(std::memory_order_acquire);
+            }));
+    }
+
+    void PipelineCompiler::Run(GraphicsDevice& device, ShaderCompiler& shaderCompiler, PipelineFuture::State& state)
+    {
+        Timer l_Timer;
+        const PipelineCompileRequest& l_Request = state.Request;
+        CompiledPipeline& l_Result = state.Result;
+
+        l_Result.VertexShader = CreateStage(device, shaderCompiler, l_Request.SearchDirectory, l_Request.Vertex, ShaderStage::Vertex, state.Error);
+        if (l_Result.VertexShader.IsValid())
+        {
+            l_Result.FragmentShader = CreateStage(device, shaderCompiler, l_Request.SearchDirectory, l_Request.Fragment, ShaderStage::Fragment, state.Error);
+        }
+
+        if (l_Result.VertexShader.IsValid() && l_Result.FragmentShader.IsValid())
+        {
+            PipelineDescription l_Description = l_Request.Description;
+            l_Description.VertexShader = l_Result.VertexShader;
+            l_Description.FragmentShader = l_Result.FragmentShader;
+
+            l_Result.Pipeline = device.CreatePipeline(l_Description);
+            if (!l_Result.Pipeline.IsValid())
+            {
+                state.Error = l_Description.DebugName + ": pipeline creation failed";
+            }
+        }
+
+        // Partial results stay in the future; destroying handles is main-thread work, done when the owner adopts or discards it
+        state.Success = l_Result.Pipeline.IsValid();
+        state.Milliseconds = l_Timer.ElapsedMilliseconds();
+        state.Ready.store(true, std::memory_order_release);
+    }
+
+    void PipelineCompiler::Destroy(CompiledPipeline& result)
+    {
+        if (result.Pipeline.IsValid())
+        {
+            m_Device.DestroyPipeline(result.Pipeline);
+        }
+
+        if (result.VertexShader.IsValid())
+        {
+            m_Device.DestroyShader(result.VertexShader);
+        }
+
+        if (result.FragmentShader.IsValid())
+        {
+            m_Device.DestroyShader(result.FragmentShader);
+        }
+
+        result = CompiledPipeline{};
+    }
+}
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <cctype>
 #include <cstdlib>
 #include <format>
+#include <mutex>
 
 #include <Trinity/Core/FileManagement.h>
 #include <Trinity/Core/Log.h>
@@ -405,6 +406,9 @@ namespace Trinity
     struct ShaderCompiler::Implementation
     {
         Slang::ComPtr<slang::IGlobalSession> GlobalSession;
+
+        // The global session is not thread-safe; compiles from several threads take turns, while cache hits never wait
+        std::mutex Mutex;
     };
 
     ShaderCompiler::ShaderCompiler() : m_Implementation(std::make_unique<Implementation>())
@@ -448,7 +452,8 @@ namespace Trinity
         }
     }
 
-    ShaderCompileResult ShaderCompiler::Compile(const std::filesystem::path& searchDirectory, const std::string& moduleName, const std::string& entryPoint, ShaderTargetFormat target)
+    ShaderCompileResult ShaderCompiler::Compile(const std::filesystem::path& searchDirectory, const std::string& moduleName, const std::string& entryPoint, ShaderTargetFormat target,
+        const std::vector<ShaderDefine>& defines)
     {
         ShaderCompileResult l_Result;
 
@@ -475,6 +480,10 @@ namespace Trinity
                 l_KeyInput.push_back('\n');
                 l_KeyInput.append(std::to_string(static_cast<int>(target)));
                 l_KeyInput.push_back('\n');
+                for (const ShaderDefine& it_Define : defines)
+                {
+                    l_KeyInput.append(it_Define.Name).append("=").append(it_Define.Value).push_back('\n');
+                }
                 l_KeyInput.append(k_CacheVersionTag);
 
                 l_CacheFile = m_CacheDirectory / std::format("{:016x}.tsc", HashFnv1a(l_KeyInput));
@@ -511,6 +520,8 @@ namespace Trinity
             return l_Result;
         };
 
+        std::lock_guard<std::mutex> l_Lock(m_Implementation->Mutex);
+
         slang::TargetDesc l_TargetDescription{};
         l_TargetDescription.format = ToSlangTarget(target);
         l_TargetDescription.profile = m_Implementation->GlobalSession->findProfile(TargetProfile(target));
@@ -538,6 +549,13 @@ namespace Trinity
             l_Options.push_back(l_EntryPointNameOption);
         }
 
+        std::vector<slang::PreprocessorMacroDesc> l_Macros;
+        l_Macros.reserve(defines.size());
+        for (const ShaderDefine& it_Define : defines)
+        {
+            l_Macros.push_back({ it_Define.Name.c_str(), it_Define.Value.c_str() });
+        }
+
         std::string l_SearchPath = searchDirectory.string();
         const char* l_SearchPaths[] = { l_SearchPath.c_str() };
 
@@ -548,6 +566,8 @@ namespace Trinity
         l_SessionDescription.searchPathCount = 1;
         l_SessionDescription.compilerOptionEntries = l_Options.data();
         l_SessionDescription.compilerOptionEntryCount = static_cast<uint32_t>(l_Options.size());
+        l_SessionDescription.preprocessorMacros = l_Macros.empty() ? nullptr : l_Macros.data();
+        l_SessionDescription.preprocessorMacroCount = static_cast<SlangInt>(l_Macros.size());
 
         Slang::ComPtr<slang::ISession> l_Session;
         if (SLANG_FAILED(m_Implementation->GlobalSession->createSession(l_SessionDescription, l_Session.writeRef())))
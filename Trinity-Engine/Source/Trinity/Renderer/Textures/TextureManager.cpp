@@ -90,6 +90,15 @@ namespace Trinity
             return false;
         }
 
+        // White registers first so it owns slot 0, which is what a zero-initialized TextureIndices block samples
+        if (m_Device.GetCapabilities().SupportsBindless)
+        {
+            for (TextureHandle it_Fallback : { m_White, m_Black, m_Normal, m_Error })
+            {
+                m_Device.RegisterBindlessTexture(it_Fallback, m_DefaultSampler);
+            }
+        }
+
 
 
         return true;
@@ -166,6 +175,30 @@ namespace Trinity
 
         m_Cache[l_Key] = l_Handle;
 
+        if (m_Device.GetCapabilities().SupportsBindless)
+        {
+            m_Device.RegisterBindlessTexture(l_Handle, m_DefaultSampler);
+        }
+
         return l_Handle;
     }
+
+    uint32_t TextureManager::GetBindlessIndex(TextureHandle texture)
+    {
+        if (!m_Device.GetCapabilities().SupportsBindless)
+        {
+            return 0;
+        }
+
+        // Registration is idempotent, so textures created outside Load are picked up on first use
+        uint32_t l_Index = m_Device.RegisterBindlessTexture(texture, m_DefaultSampler);
+        if (l_Index != k_InvalidBindlessIndex)
+        {
+            return l_Index;
+        }
+
+        l_Index = m_Device.RegisterBindlessTexture(m_White, m_DefaultSampler);
+
+        return l_Index != k_InvalidBindlessIndex ? l_Index : 0;
+    }
 }
\ No newline at end of file
@@ -1,16 +1,44 @@
 #include <Trinity/Scene/Scene.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 
 #include <Trinity/Scene/Entity.h>
 #include <Trinity/Scene/Components/IDComponent.h>
 #include <Trinity/Scene/Components/NameComponent.h>
 #include <Trinity/Scene/Components/TransformComponent.h>
 #include <Trinity/Scene/Components/HierarchyComponent.h>
+#include <Trinity/Scene/Components/WorldTransformComponent.h>
 #include <Trinity/Scene/Components/CameraComponent.h>
 
 namespace Trinity
 {
+    static uint64_t NextSceneInstanceId()
+    {
+        static std::atomic<uint64_t> s_Next{ 0 };
+
+        return s_Next.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    Scene::Scene() : m_InstanceId(NextSceneInstanceId())
+    {
+        m_Registry.on_construct<TransformComponent>().connect<&Scene::OnTransformConstructed>(*this);
+        m_Registry.on_update<TransformComponent>().connect<&Scene::OnTransformChanged>(*this);
+        m_Registry.on_destroy<TransformComponent>().connect<&Scene::OnTransformDestroyed>(*this);
+        m_Registry.on_construct<HierarchyComponent>().connect<&Scene::OnTransformChanged>(*this);
+        m_Registry.on_update<HierarchyComponent>().connect<&Scene::OnTransformChanged>(*this);
+    }
+
+    Scene::~Scene()
+    {
+        m_Registry.on_construct<TransformComponent>().disconnect<&Scene::OnTransformConstructed>(*this);
+        m_Registry.on_update<TransformComponent>().disconnect<&Scene::OnTransformChanged>(*this);
+        m_Registry.on_destroy<TransformComponent>().disconnect<&Scene::OnTransformDestroyed>(*this);
+        m_Registry.on_construct<HierarchyComponent>().disconnect<&Scene::OnTransformChanged>(*this);
+        m_Registry.on_update<HierarchyComponent>().disconnect<&Scene::OnTransformChanged>(*this);
+    }
+
     Entity Scene::CreateEntity(const std::string& name)
     {
         return CreateEntityWithUUID(UUID(), name);
@@ -60,6 +88,7 @@ namespace Trinity
     void Scene::Clear()
     {
         m_Registry.clear();
+        m_InstanceId = NextSceneInstanceId();
     }
 
     void Scene::SetParent(Entity child, Entity parent)
@@ -90,6 +119,11 @@ namespace Trinity
         }
 
         m_Registry.get<HierarchyComponent>(l_Child).Parent = l_NewParent;
+
+        if (auto* l_World = m_Registry.try_get<WorldTransformComponent>(l_Child))
+        {
+            l_World->Dirty = true;
+        }
     }
 
     glm::mat4 Scene::GetWorldMatrix(entt::entity entity)
@@ -112,6 +146,88 @@ namespace Trinity
         return l_Local;
     }
 
+    void Scene::UpdateWorldTransforms()
+    {
+        auto l_View = m_Registry.view<TransformComponent, WorldTransformComponent>();
+        for (entt::entity it_Root : l_View)
+        {
+            // Children are reached through their parent so the parent's matrix is always current when they are visited
+            if (const auto* l_Hierarchy = m_Registry.try_get<HierarchyComponent>(it_Root); l_Hierarchy != nullptr && l_Hierarchy->Parent != entt::null && m_Registry.all_of<WorldTransformComponent>(l_Hierarchy->Parent))
+            {
+                continue;
+            }
+
+            m_TransformStack.clear();
+            m_TransformStack.emplace_back(it_Root, false);
+
+            while (!m_TransformStack.empty())
+            {
+                auto [l_Entity, l_ParentChanged] = m_TransformStack.back();
+                m_TransformStack.pop_back();
+
+                // Children of an entity without a cached matrix fail the parent check above, so the view visits them as roots of their own
+                WorldTransformComponent* l_World = m_Registry.try_get<WorldTransformComponent>(l_Entity);
+                if (l_World == nullptr)
+                {
+                    continue;
+                }
+
+                const TransformComponent* l_Transform = m_Registry.try_get<TransformComponent>(l_Entity);
+                const HierarchyComponent* l_Hierarchy = m_Registry.try_get<HierarchyComponent>(l_Entity);
+
+                // A missing transform is an identity local matrix, as in GetWorldMatrix, so the subtree below keeps updating
+                bool l_Changed = l_ParentChanged || l_World->Dirty;
+                if (l_Transform != nullptr)
+                {
+                    l_Changed = l_Changed || l_World->Translation != l_Transform->Translation || l_World->Rotation != l_Transform->Rotation || l_World->Scale != l_Transform->Scale;
+                }
+
+                if (l_Changed)
+                {
+                    glm::mat4 l_Local = l_Transform != nullptr ? l_Transform->GetLocalMatrix() : glm::mat4(1.0f);
+
+                    const WorldTransformComponent* l_ParentWorld = nullptr;
+                    if (l_Hierarchy != nullptr && l_Hierarchy->Parent != entt::null)
+                    {
+                        l_ParentWorld = m_Registry.try_get<WorldTransformComponent>(l_Hierarchy->Parent);
+                    }
+
+                    l_World->World = l_ParentWorld != nullptr ? l_ParentWorld->World * l_Local : l_Local;
+                    if (l_Transform != nullptr)
+                    {
+                        l_World->Translation = l_Transform->Translation;
+                        l_World->Rotation = l_Transform->Rotation;
+                        l_World->Scale = l_Transform->Scale;
+                    }
+
+                    l_World->Dirty = false;
+                    l_World->StableUpdates = 0;
+                }
+                else if (l_World->StableUpdates != UINT32_MAX)
+                {
+                    ++l_World->StableUpdates;
+                }
+
+                if (l_Hierarchy != nullptr)
+                {
+                    for (entt::entity it_Child : l_Hierarchy->Children)
+                    {
+                        m_TransformStack.emplace_back(it_Child, l_Changed);
+                    }
+                }
+            }
+        }
+    }
+
+    const glm::mat4& Scene::GetCachedWorldMatrix(entt::entity entity) const
+    {
+        static const glm::mat4 s_Identity(1.0f);
+
+        const WorldTransformComponent* l_World = m_Registry.try_get<WorldTransformComponent>(entity);
+
+        return l_World != nullptr ? l_World->World : s_Identity;
+    }
+
     Entity Scene::GetPrimaryCameraEntity()
     {
         auto l_View = m_Registry.view<CameraComponent>();
@@ -125,4 +241,35 @@ namespace Trinity
 
         return Entity();
     }
+
+    void Scene::OnTransformConstructed(entt::registry& registry, entt::entity entity)
+    {
+        registry.emplace_or_replace<WorldTransformComponent>(entity);
+    }
+
+    void Scene::OnTransformChanged(entt::registry& registry, entt::entity entity)
+    {
+        if (auto* l_World = registry.try_get<WorldTransformComponent>(entity))
+        {
+            l_World->Dirty = true;
+        }
+    }
+
+    void Scene::OnTransformDestroyed(entt::registry& registry, entt::entity entity)
+    {
+        registry.remove<WorldTransformComponent>(entity);
+
+        // The children become roots of their own, and their cached matrices still include this entity's
+        if (const auto* l_Hierarchy = registry.try_get<HierarchyComponent>(entity))
+        {
+            for (entt::entity it_Child : l_Hierarchy->Children)
+            {
+                // Clearing the registry destroys entities in no particular order
+                if (registry.valid(it_Child))
+                {
+                    OnTransformChanged(registry, it_Child);
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
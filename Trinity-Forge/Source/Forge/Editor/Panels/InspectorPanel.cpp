@@ -56,7 +56,7 @@ namespace Trinity
         return l_Result;
     }
 
-    static void DrawMaterialTextureParameter(AssetDatabase& assetDatabase, Material& material, const char* label, const char* parameterName)
+    static bool DrawMaterialTextureParameter(AssetDatabase& assetDatabase, Material& material, const char* label, const char* parameterName)
     {
         UUID l_Texture = UUID(0);
         if (const MaterialParameter* l_TextureParameter = material.FindParameter(parameterName))
@@ -67,11 +67,14 @@ namespace Trinity
         const AssetMetadata* l_TextureMeta = static_cast<uint64_t>(l_Texture) != 0 ? assetDatabase.GetMetadata(l_Texture) : nullptr;
         std::string l_TextureLabel = l_TextureMeta != nullptr ? l_TextureMeta->SourcePath : "(none)";
 
+        bool l_Changed = false;
+
         if (ImGui::BeginCombo(label, l_TextureLabel.c_str()))
         {
             if (ImGui::Selectable("(none)", static_cast<uint64_t>(l_Texture) == 0))
             {
                 material.SetParameter(parameterName, MaterialParameter::MakeTexture(UUID(0)));
+                l_Changed = true;
             }
 
             for (UUID it_Texture : assetDatabase.GetAssetsOfType(AssetType::Texture))
@@ -86,11 +89,14 @@ namespace Trinity
                 if (ImGui::Selectable(l_Meta->SourcePath.c_str(), l_Selected) && !l_Selected)
                 {
                     material.SetParameter(parameterName, MaterialParameter::MakeTexture(it_Texture));
+                    l_Changed = true;
                 }
             }
 
             ImGui::EndCombo();
         }
+
+        return l_Changed;
     }
 
     static void DrawMaterialEditor(Engine& engine, AssetDatabase& assetDatabase, UUID material)
@@ -102,6 +108,7 @@ namespace Trinity
         }
 
         std::shared_ptr<Material> l_Material = assetDatabase.ResolveMaterial(material);
+        bool l_Changed = false;
 
         glm::vec4 l_Factor = glm::vec4(1.0f);
         if (const MaterialParameter* l_FactorParameter = l_Material->FindParameter(Material::BaseColorFactor))
@@ -112,6 +119,7 @@ namespace Trinity
         if (ImGui::ColorEdit4("Base Color", &l_Factor.x))
         {
             l_Material->SetParameter(Material::BaseColorFactor, MaterialParameter::MakeVec4(l_Factor));
+            l_Changed = true;
         }
 
         UUID l_Texture = UUID(0);
@@ -128,6 +136,7 @@ namespace Trinity
             if (ImGui::Selectable("(none)", static_cast<uint64_t>(l_Texture) == 0))
             {
                 l_Material->SetParameter(Material::BaseColorTexture, MaterialParameter::MakeTexture(UUID(0)));
+                l_Changed = true;
             }
 
             for (UUID it_Texture : assetDatabase.GetAssetsOfType(AssetType::Texture))
@@ -142,6 +151,7 @@ namespace Trinity
                 if (ImGui::Selectable(l_Meta->SourcePath.c_str(), l_Selected) && !l_Selected)
                 {
                     l_Material->SetParameter(Material::BaseColorTexture, MaterialParameter::MakeTexture(it_Texture));
+                    l_Changed = true;
                 }
             }
 
@@ -157,6 +167,7 @@ namespace Trinity
         if (ImGui::SliderFloat("Metallic", &l_Metallic, 0.0f, 1.0f))
         {
             l_Material->SetParameter(Material::MetallicFactor, MaterialParameter::MakeFloat(l_Metallic));
+            l_Changed = true;
         }
 
         float l_Roughness = 0.5f;
@@ -168,10 +179,11 @@ namespace Trinity
         if (ImGui::SliderFloat("Roughness", &l_Roughness, 0.0f, 1.0f))
         {
             l_Material->SetParameter(Material::RoughnessFactor, MaterialParameter::MakeFloat(l_Roughness));
+            l_Changed = true;
         }
 
-        DrawMaterialTextureParameter(assetDatabase, *l_Material, "Metallic Roughness Texture", Material::MetallicRoughnessTexture);
-        DrawMaterialTextureParameter(assetDatabase, *l_Material, "Normal Texture", Material::NormalTexture);
+        l_Changed |= DrawMaterialTextureParameter(assetDatabase, *l_Material, "Metallic Roughness Texture", Material::MetallicRoughnessTexture);
+        l_Changed |= DrawMaterialTextureParameter(assetDatabase, *l_Material, "Normal Texture", Material::NormalTexture);
 
         float l_NormalScale = 1.0f;
         if (const MaterialParameter* l_Parameter = l_Material->FindParameter(Material::NormalScale))
@@ -182,6 +194,7 @@ namespace Trinity
         if (ImGui::DragFloat("Normal Scale", &l_NormalScale, 0.01f, 0.0f, 4.0f))
         {
             l_Material->SetParameter(Material::NormalScale, MaterialParameter::MakeFloat(l_NormalScale));
+            l_Changed = true;
         }
 
         glm::vec3 l_Emissive = glm::vec3(0.0f);
@@ -193,6 +206,7 @@ namespace Trinity
         if (ImGui::ColorEdit3("Emissive", &l_Emissive.x))
         {
             l_Material->SetParameter(Material::EmissiveFactor, MaterialParameter::MakeVec3(l_Emissive));
+            l_Changed = true;
         }
 
         float l_EmissiveStrength = 1.0f;
@@ -204,9 +218,16 @@ namespace Trinity
         if (ImGui::DragFloat("Emissive Strength", &l_EmissiveStrength, 0.05f, 0.0f, 100.0f))
         {
             l_Material->SetParameter(Material::EmissiveStrength, MaterialParameter::MakeFloat(l_EmissiveStrength));
+            l_Changed = true;
         }
 
-        DrawMaterialTextureParameter(assetDatabase, *l_Material, "Emissive Texture", Material::EmissiveTexture);
+        l_Changed |= DrawMaterialTextureParameter(assetDatabase, *l_Material, "Emissive Texture", Material::EmissiveTexture);
+
+        // The editor mutates the cached Material in place, so the renderer's compiled block has to be rebuilt explicitly
+        if (l_Changed)
+        {
+            assetDatabase.InvalidateMaterial(material);
+        }
 
         if (ImGui::SmallButton("Save##Material"))
         {
@@ -44,6 +44,57 @@ namespace Trinity
             return;
         }
 
+        const bool l_BindlessSupported = m_Engine.GetDevice().GetCapabilities().SupportsBindless;
+        bool l_Bindless = m_Engine.GetRenderer().IsBindlessActive();
+        ImGui::BeginDisabled(!l_BindlessSupported);
+        if (ImGui::Checkbox("Bindless Textures", &l_Bindless))
+        {
+            m_Engine.GetRenderer().SetBindlessEnabled(l_Bindless);
+        }
+        ImGui::EndDisabled();
+
+        if (!l_BindlessSupported && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        {
+            ImGui::SetTooltip("Device does not support descriptor indexing");
+        }
+
+        bool l_Caching = m_Engine.GetRenderer().GetRenderGraph().IsCachingEnabled();
+        if (ImGui::Checkbox("Cache Compiled Graph", &l_Caching))
+        {
+            m_Engine.GetRenderer().SetRenderGraphCachingEnabled(l_Caching);
+        }
+
+        bool l_ShadowCaching = m_Engine.GetRenderer().IsShadowCachingEnabled();
+        if (ImGui::Checkbox("Cache Shadow Map", &l_ShadowCaching))
+        {
+            m_Engine.GetRenderer().SetShadowCachingEnabled(l_ShadowCaching);
+        }
+
+        bool l_ShadowLayers = m_Engine.GetRenderer().AreShadowCasterLayersEnabled();
+        if (ImGui::Checkbox("Static Shadow Layer", &l_ShadowLayers))
+        {
+            m_Engine.GetRenderer().SetShadowCasterLayersEnabled(l_ShadowLayers);
+        }
+
+        float l_ShadowDistance = m_Engine.GetRenderer().GetShadowDistance();
+        if (ImGui::DragFloat("Shadow Distance", &l_ShadowDistance, 1.0f, 10.0f, 1000.0f))
+        {
+            m_Engine.GetRenderer().SetShadowDistance(l_ShadowDistance);
+        }
+
+        bool l_DepthPrepass = m_Engine.GetRenderer().IsDepthPrepassEnabled();
+        if (ImGui::Checkbox("Depth Pre-Pass", &l_DepthPrepass))
+        {
+            m_Engine.GetRenderer().SetDepthPrepassEnabled(l_DepthPrepass);
+        }
+
+        bool l_Overdraw = m_Engine.GetRenderer().IsOverdrawVisualizationEnabled();
+        if (ImGui::Checkbox("Overdraw View", &l_Overdraw))
+        {
+            m_Engine.GetRenderer().SetOverdrawVisualizationEnabled(l_Overdraw);
+        }
+
+        ImGui::Spacing();
         DrawPasses();
 
         ImGui::Spacing();
@@ -55,19 +106,26 @@ namespace Trinity
 
     void RenderGraphPanel::DrawPasses()
     {
-        const std::vector<RenderGraph::PassInfo>& l_Passes = m_Engine.GetRenderer().GetRenderGraph().GetPasses();
-
-        ImGui::Text("Passes: %d", static_cast<int>(l_Passes.size()));
+        const RenderGraph& l_Graph = m_Engine.GetRenderer().GetRenderGraph();
+        const std::vector<RenderGraph::PassInfo>& l_Passes = l_Graph.GetPasses();
+        const RenderGraphStats& l_Stats = l_Graph.GetStats();
+
+        ImGui::Text("Passes: %u (%u culled)", l_Stats.Passes, l_Stats.CulledPasses);
+        ImGui::Text("Barriers: %u in %u batches", l_Stats.Barriers, l_Stats.BarrierBatches);
+        ImGui::Text("Plan: %s (%llu compilations)", l_Stats.Reused ? "reused" : "rebuilt", static_cast<unsigned long long>(l_Stats.Compilations));
+        ImGui::Text("Transients: %u in %u heaps, %.2f MB (%.2f MB unaliased)", l_Stats.TransientTextures, l_Stats.TransientHeaps, static_cast<double>(l_Stats.TransientMemory) / (1024.0 * 1024.0),
+            static_cast<double>(l_Stats.TransientMemoryUnaliased) / (1024.0 * 1024.0));
         ImGui::TextDisabled("Resource transitions are derived automatically from declared reads/writes.");
         ImGui::Separator();
 
         ImGuiTableFlags l_Flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
-        if (ImGui::BeginTable("##RenderGraphPasses", 4, l_Flags))
+        if (ImGui::BeginTable("##RenderGraphPasses", 5, l_Flags))
         {
             ImGui::TableSetupColumn("#", ImGuiTableColumnFlags_WidthFixed, 28.0f);
             ImGui::TableSetupColumn("Pass");
             ImGui::TableSetupColumn("Reads");
             ImGui::TableSetupColumn("Writes");
+            ImGui::TableSetupColumn("Barriers", ImGuiTableColumnFlags_WidthFixed, 60.0f);
             ImGui::TableHeadersRow();
 
             for (size_t l_Index = 0; l_Index < l_Passes.size(); ++l_Index)
@@ -80,7 +138,26 @@ namespace Trinity
                 ImGui::Text("%d", static_cast<int>(l_Index));
 
                 ImGui::TableSetColumnIndex(1);
-                ImGui::TextUnformatted(l_Pass.Name.c_str());
+                if (l_Pass.Culled)
+                {
+                    ImGui::TextDisabled("%s (culled)", l_Pass.Name.c_str());
+                }
+                else
+                {
+                    ImGui::TextUnformatted(l_Pass.Name.c_str());
+                }
+
+                if (!l_Pass.DependsOn.empty() && ImGui::IsItemHovered())
+                {
+                    std::string l_Tooltip = "Depends on:";
+                    for (const std::string& it_Dependency : l_Pass.DependsOn)
+                    {
+                        l_Tooltip += "\n  " + it_Dependency;
+                    }
+
+                    ImGui::SetTooltip("%s", l_Tooltip.c_str());
+                }
+
                 if (!l_Pass.Managed)
                 {
                     ImGui::SameLine();
@@ -112,6 +189,16 @@ namespace Trinity
                         ImGui::TextUnformatted(it_Write.c_str());
                     }
                 }
+
+                ImGui::TableSetColumnIndex(4);
+                if (l_Pass.Culled)
+                {
+                    ImGui::TextDisabled("-");
+                }
+                else
+                {
+                    ImGui::Text("%u", l_Pass.Barriers);
+                }
             }
 
             ImGui::EndTable();
@@ -538,11 +538,59 @@ namespace Trinity
             std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.DrawCalls);
             l_Rows.emplace_back("Draw Calls", l_Buffer);
 
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.Instances);
+            l_Rows.emplace_back("Instances", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.Culled);
+            l_Rows.emplace_back("Culled", l_Buffer);
+
             std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.ShadowDrawCalls);
             l_Rows.emplace_back("Shadow Draws", l_Buffer);
 
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u (%u instances)", l_Stats.PrepassDrawCalls, l_Stats.PrepassInstances);
+            l_Rows.emplace_back("Pre-Pass Draws", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.ShadowCulled);
+            l_Rows.emplace_back("Shadow Culled", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%llu KB (%llu KB saved)", static_cast<unsigned long long>(l_Stats.VertexFetchBytes / 1024), static_cast<unsigned long long>(l_Stats.VertexFetchBytesSaved / 1024));
+            l_Rows.emplace_back("Vertex Fetch", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u (%u cached, %u static reused)", l_Stats.ShadowUpdates, l_Stats.ShadowCacheHits, l_Stats.ShadowStaticCacheHits);
+            l_Rows.emplace_back("Shadow Updates", l_Buffer);
+
             std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.Triangles);
             l_Rows.emplace_back("Triangles", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u (%u coarser in shadows)", l_Stats.LodPackets, l_Stats.ShadowLodPackets);
+            l_Rows.emplace_back("LOD Packets", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u (max %u / cluster)", l_Stats.Lights, l_Stats.MaxLightsPerCluster);
+            l_Rows.emplace_back("Clustered Lights", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.Binds);
+            l_Rows.emplace_back("Binds", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.BindsSkipped);
+            l_Rows.emplace_back("Binds Saved", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u", l_Stats.StateChanges);
+            l_Rows.emplace_back("State Changes", l_Buffer);
+
+            DescriptorCacheStats l_Descriptors = m_Engine.GetDevice().GetDescriptorCacheStats();
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%llu / %llu", static_cast<unsigned long long>(l_Descriptors.Hits), static_cast<unsigned long long>(l_Descriptors.Misses));
+            l_Rows.emplace_back("Descriptor Hit/Miss", l_Buffer);
+
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u (%u pools)", l_Descriptors.LiveSets, l_Descriptors.Pools);
+            l_Rows.emplace_back("Descriptor Sets", l_Buffer);
+
+            PipelineCacheStats l_Pipelines = m_Engine.GetDevice().GetPipelineCacheStats();
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%u in %.1f ms (%u compiling)", l_Pipelines.PipelinesCreated, l_Pipelines.CreationMilliseconds, l_Stats.PendingPipelines);
+            l_Rows.emplace_back("Pipelines", l_Buffer);
+
+            FrameAllocatorStats l_FrameHeap = m_Engine.GetDevice().GetFrameAllocatorStats();
+            std::snprintf(l_Buffer, sizeof(l_Buffer), "%llu / %llu KB", static_cast<unsigned long long>(l_FrameHeap.PeakFrameBytes / 1024), static_cast<unsigned long long>(l_FrameHeap.Capacity / 1024));
+            l_Rows.emplace_back("Frame Heap", l_Buffer);
         }
 
         float l_LineHeight = ImGui::GetTextLineHeightWithSpacing();
@@ -264,7 +264,7 @@ namespace Trinity
         for (entt::entity it_Entity : l_Boxes)
         {
             const BoxCollider2DComponent& l_Collider = l_Boxes.get<BoxCollider2DComponent>(it_Entity);
-            glm::mat4 l_World4 = l_Scene.GetWorldMatrix(it_Entity);
+            const glm::mat4& l_World4 = l_Scene.GetCachedWorldMatrix(it_Entity);
             uint32_t l_Color = l_BodyColor(it_Entity, l_Collider.IsTrigger);
 
             glm::vec2 l_Min = l_Collider.Offset - l_Collider.HalfExtents;
@@ -286,7 +286,7 @@ namespace Trinity
         for (entt::entity it_Entity : l_Circles)
         {
             const CircleCollider2DComponent& l_Collider = l_Circles.get<CircleCollider2DComponent>(it_Entity);
-            glm::mat4 l_World4 = l_Scene.GetWorldMatrix(it_Entity);
+            const glm::mat4& l_World4 = l_Scene.GetCachedWorldMatrix(it_Entity);
             uint32_t l_Color = l_BodyColor(it_Entity, l_Collider.IsTrigger);
 
             // The physics circle takes the larger world axis scale, so the outline is a true circle even under non-uniform scale
@@ -0,0 +1,316 @@
+#include <Bench/BenchCommon.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace
+{
+    std::atomic<uint64_t> s_Allocations{ 0 };
+
+    void AppendQuoted(std::string& text, std::string_view value)
+    {
+        text += '"';
+        for (char it_Character : value)
+        {
+            if (it_Character == '"' || it_Character == '\\')
+            {
+                text += '\\';
+            }
+
+            text += it_Character;
+        }
+
+        text += '"';
+    }
+}
+
+// Every heap allocation in the process goes through here, the aligned and nothrow forms included, so the report can state what a steady frame allocates
+static void* CountedAllocate(size_t size, size_t alignment) noexcept
+{
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    size = size != 0 ? size : 1;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        return std::malloc(size);
+    }
+
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+static void CountedFree(void* memory, size_t alignment) noexcept
+{
+#ifdef _WIN32
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        _aligned_free(memory);
+
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+
+    std::free(memory);
+}
+
+static void* CountedAllocateOrThrow(size_t size, size_t alignment)
+{
+    if (void* l_Memory = CountedAllocate(size, alignment))
+    {
+        return l_Memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size)
+{
+    return CountedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size)
+{
+    return CountedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return CountedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return CountedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept
+{
+    CountedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    CountedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    CountedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    CountedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    CountedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    CountedFree(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept
+{
+    CountedFree(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* memory, std::align_val_t alignment) noexcept
+{
+    CountedFree(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept
+{
+    CountedFree(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept
+{
+    CountedFree(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    CountedFree(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    CountedFree(memory, static_cast<size_t>(alignment));
+}
+
+namespace Trinity
+{
+    uint64_t GetAllocationCount()
+    {
+        return s_Allocations.load(std::memory_order_relaxed);
+    }
+
+    BenchReport::BenchReport(std::string_view scenario)
+    {
+        m_Text = "{";
+        m_Empty.push_back(true);
+        Add("benchmark", scenario);
+    }
+
+    void BenchReport::BeginField(std::string_view name)
+    {
+        m_Text += m_Empty.back() ? "\n" : ",\n";
+        m_Text.append(m_Empty.size() * 2, ' ');
+        AppendQuoted(m_Text, name);
+        m_Text += ": ";
+        m_Empty.back() = false;
+    }
+
+    void BenchReport::BeginObject(std::string_view name)
+    {
+        BeginField(name);
+        m_Text += '{';
+        m_Empty.push_back(true);
+    }
+
+    void BenchReport::EndObject()
+    {
+        const bool l_Empty = m_Empty.back();
+        m_Empty.pop_back();
+        if (!l_Empty)
+        {
+            m_Text += '\n';
+            m_Text.append(m_Empty.size() * 2, ' ');
+        }
+
+        m_Text += '}';
+    }
+
+    void BenchReport::Add(std::string_view name, double value)
+    {
+        char l_Buffer[64];
+        std::snprintf(l_Buffer, sizeof(l_Buffer), "%.6f", std::isfinite(value) ? value : 0.0);
+        BeginField(name);
+        m_Text += l_Buffer;
+    }
+
+    void BenchReport::Add(std::string_view name, uint64_t value)
+    {
+        BeginField(name);
+        m_Text += std::to_string(value);
+    }
+
+    void BenchReport::Add(std::string_view name, bool value)
+    {
+        BeginField(name);
+        m_Text += value ? "true" : "false";
+    }
+
+    void BenchReport::Add(std::string_view name, std::string_view value)
+    {
+        BeginField(name);
+        AppendQuoted(m_Text, value);
+    }
+
+    void BenchReport::AddDistribution(std::string_view name, std::vector<double>& samples)
+    {
+        double l_Mean = 0.0;
+        double l_P50 = 0.0;
+        double l_P99 = 0.0;
+        if (!samples.empty())
+        {
+            double l_Sum = 0.0;
+            for (double it_Sample : samples)
+            {
+                l_Sum += it_Sample;
+            }
+
+            // Nearest-rank percentiles
+            std::sort(samples.begin(), samples.end());
+            const size_t l_Count = samples.size();
+            l_Mean = l_Sum / static_cast<double>(l_Count);
+            l_P50 = samples[std::min(l_Count - 1, static_cast<size_t>(std::ceil(0.50 * static_cast<double>(l_Count))) - 1)];
+            l_P99 = samples[std::min(l_Count - 1, static_cast<size_t>(std::ceil(0.99 * static_cast<double>(l_Count))) - 1)];
+        }
+
+        BeginObject(name);
+        Add("mean", l_Mean);
+        Add("p50", l_P50);
+        Add("p99", l_P99);
+        EndObject();
+    }
+
+    void BenchReport::Fail(const char* format, ...)
+    {
+        std::fputs("FAIL: ", stderr);
+
+        va_list l_Arguments;
+        va_start(l_Arguments, format);
+        std::vfprintf(stderr, format, l_Arguments);
+        va_end(l_Arguments);
+
+        std::fputc('\n', stderr);
+        m_Ok = false;
+    }
+
+    bool BenchReport::Write(const std::string& path)
+    {
+        Add("ok", m_Ok);
+        while (!m_Empty.empty())
+        {
+            EndObject();
+        }
+
+        m_Text += '\n';
+
+        FILE* l_File = path.empty() ? stdout : std::fopen(path.c_str(), "w");
+        if (l_File == nullptr)
+        {
+            std::fprintf(stderr, "FAIL: cannot write %s\n", path.c_str());
+
+            return false;
+        }
+
+        std::fputs(m_Text.c_str(), l_File);
+        if (l_File != stdout)
+        {
+            std::fclose(l_File);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Trinity
+{
+    // Heap allocations made by the whole process so far; every form of operator new is counted, so a scenario can diff it around the code it measures
+    uint64_t GetAllocationCount();
+
+    inline double NanosecondsPer(float seconds, uint64_t count)
+    {
+        return count != 0 ? static_cast<double>(seconds) * 1.0e9 / static_cast<double>(count) : 0.0;
+    }
+
+    // SplitMix64: the same scenes on every platform and standard library, which the <random> distributions do not promise
+    class BenchRandom
+    {
+    public:
+        explicit BenchRandom(uint64_t seed) : m_State(seed)
+        {
+
+        }
+
+        uint64_t Next()
+        {
+            uint64_t l_Value = (m_State += 0x9E3779B97F4A7C15ull);
+            l_Value = (l_Value ^ (l_Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            l_Value = (l_Value ^ (l_Value >> 27)) * 0x94D049BB133111EBull;
+
+            return l_Value ^ (l_Value >> 31);
+        }
+
+        uint32_t Below(uint32_t bound) { return bound != 0 ? static_cast<uint32_t>(Next() % bound) : 0; }
+        float Range(float minimum, float maximum) { return minimum + (maximum - minimum) * static_cast<float>(Next() >> 40) / static_cast<float>(1ull << 24); }
+
+    private:
+        uint64_t m_State;
+    };
+
+    // The JSON document a scenario fills in. Fields land in the order they are added; a failed check is reported on stderr, recorded in the document's "ok"
+    // field and turns the exit code non-zero
+    class BenchReport
+    {
+    public:
+        explicit BenchReport(std::string_view scenario);
+
+        void BeginObject(std::string_view name);
+        void EndObject();
+
+        void Add(std::string_view name, double value);
+        void Add(std::string_view name, uint64_t value);
+        void Add(std::string_view name, uint32_t value) { Add(name, static_cast<uint64_t>(value)); }
+        void Add(std::string_view name, bool value);
+        void Add(std::string_view name, std::string_view value);
+        void Add(std::string_view name, const char* value) { Add(name, std::string_view(value)); }
+
+        // Mean, median and 99th percentile; sorts the samples
+        void AddDistribution(std::string_view name, std::vector<double>& samples);
+
+        void Fail(const char* format, ...);
+        bool IsOk() const { return m_Ok; }
+
+        // Closes the document and writes it to path, or to stdout when path is empty
+        bool Write(const std::string& path);
+
+    private:
+        void BeginField(std::string_view name);
+
+    private:
+        std::string m_Text;
+        std::vector<bool> m_Empty;
+        bool m_Ok = true;
+    };
+
+    // Arguments left after the scenario name and the shared options; each scenario parses its own and returns false on a usage error
+    using BenchArguments = std::vector<const char*>;
+
+    bool RunRendererScenario(const BenchArguments& arguments, BenchReport& report);
+    bool RunJobScenario(const BenchArguments& arguments, BenchReport& report);
+    bool RunCullScenario(const BenchArguments& arguments, BenchReport& report);
+    bool RunClusterScenario(const BenchArguments& arguments, BenchReport& report);
+    bool RunGraphScenario(const BenchArguments& arguments, BenchReport& report);
+    bool RunFrameHeapScenario(const BenchArguments& arguments, BenchReport& report);
+    bool RunMeshScenario(const BenchArguments& arguments, BenchReport& report);
+}
@@ -0,0 +1,158 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Renderer/Culling/LightClusters.h>
+#include <Trinity/Core/JobSystem.h>
+#include <Trinity/Core/Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint32_t k_Iterations = 100;
+        constexpr uint32_t k_LightCounts[] = { 256, 1024, 4096 };
+    }
+
+    // Point and spot lights with 2-12 m ranges scattered through a 200 m box around a camera looking down -Z
+    static std::vector<GpuLight> MakeLights(uint32_t count)
+    {
+        BenchRandom l_Random(4321);
+
+        std::vector<GpuLight> l_Lights(count);
+        for (uint32_t l_Index = 0; l_Index < count; ++l_Index)
+        {
+            GpuLight& l_Light = l_Lights[l_Index];
+            float l_Type = (l_Index % 4 == 0) ? 2.0f : 1.0f;
+            glm::vec3 l_Direction = glm::normalize(glm::vec3(l_Random.Range(-1.0f, 1.0f), -1.0f, l_Random.Range(-1.0f, 1.0f)));
+
+            l_Light.PositionType = glm::vec4(l_Random.Range(-100.0f, 100.0f), l_Random.Range(-10.0f, 10.0f), l_Random.Range(-100.0f, 100.0f), l_Type);
+            l_Light.DirectionRange = glm::vec4(l_Direction, l_Random.Range(2.0f, 12.0f));
+            l_Light.ColorIntensity = glm::vec4(1.0f, 0.9f, 0.8f, 10.0f);
+            l_Light.SpotAngles = glm::vec4(0.95f, 0.85f, 0.0f, 0.0f);
+        }
+
+        return l_Lights;
+    }
+
+    static float BenchBuild(LightClusterBinner& binner, const glm::mat4& view, const glm::mat4& projection, const std::vector<GpuLight>& lights, JobSystem* jobs)
+    {
+        // One warm-up build sizes the scratch storage and the grid so the timed loop measures steady-state frames
+        binner.Build(view, projection, 0.1f, 300.0f, lights, jobs);
+
+        Timer l_Timer;
+        for (uint32_t l_Iteration = 0; l_Iteration < k_Iterations; ++l_Iteration)
+        {
+            binner.Build(view, projection, 0.1f, 300.0f, lights, jobs);
+        }
+
+        return l_Timer.Elapsed();
+    }
+
+    // Looks a light up the way Mesh.slang does for the pixel its centre lands on: SV_Position through the renderer's flipped viewport, then tile and slice. The light
+    // sits above and left of the view axis and is small enough to cover only its own row, so a grid mirrored top to bottom misses it
+    static void CheckShaderLookup(const glm::mat4& view, const glm::mat4& projection, BenchReport& report)
+    {
+        const glm::vec2 l_Target(1920.0f, 1080.0f);
+
+        GpuLight l_Light{};
+        l_Light.PositionType = glm::vec4(-6.0f, 6.0f, -20.0f, 1.0f);
+        l_Light.DirectionRange = glm::vec4(0.0f, -1.0f, 0.0f, 0.5f);
+        l_Light.ColorIntensity = glm::vec4(1.0f);
+
+        LightClusterBinner l_Binner;
+        l_Binner.Build(view, projection, 0.1f, 300.0f, { l_Light }, nullptr);
+
+        const glm::vec4 l_ViewPosition = view * glm::vec4(glm::vec3(l_Light.PositionType), 1.0f);
+        const glm::vec4 l_Clip = projection * l_ViewPosition;
+        const glm::vec2 l_Ndc = glm::vec2(l_Clip) / l_Clip.w;
+        const glm::vec2 l_Pixel((l_Ndc.x * 0.5f + 0.5f) * l_Target.x, (0.5f - l_Ndc.y * 0.5f) * l_Target.y);
+
+        const uint32_t l_TilesX = l_Binner.GetTilesX();
+        const uint32_t l_TilesY = l_Binner.GetTilesY();
+        const glm::vec2 l_SliceScaleBias = l_Binner.GetSliceScaleBias();
+        const uint32_t l_Slice = static_cast<uint32_t>(std::clamp(std::log(-l_ViewPosition.z) * l_SliceScaleBias.x + l_SliceScaleBias.y, 0.0f, static_cast<float>(l_Binner.GetSlices() - 1)));
+        const uint32_t l_TileX = std::min(static_cast<uint32_t>(l_Pixel.x * static_cast<float>(l_TilesX) / l_Target.x), l_TilesX - 1);
+        const uint32_t l_TileY = std::min(static_cast<uint32_t>(l_Pixel.y * static_cast<float>(l_TilesY) / l_Target.y), l_TilesY - 1);
+
+        const std::vector<LightClusterRange>& l_Ranges = l_Binner.GetRanges();
+        const LightClusterRange& l_Range = l_Ranges[(l_Slice * l_TilesY + l_TileY) * l_TilesX + l_TileX];
+        const LightClusterRange& l_Mirrored = l_Ranges[(l_Slice * l_TilesY + (l_TilesY - 1 - l_TileY)) * l_TilesX + l_TileX];
+        if (l_Range.Count != 1 || l_Binner.GetIndices()[l_Range.Offset] != 0)
+        {
+            report.Fail("the light is missing from the cluster the shader reads at pixel (%.0f, %.0f): tile (%u, %u), slice %u", l_Pixel.x, l_Pixel.y, l_TileX, l_TileY, l_Slice);
+        }
+
+        if (l_Mirrored.Count != 0)
+        {
+            report.Fail("the light was binned into row %u, the mirror of the row %u the shader reads", l_TilesY - 1 - l_TileY, l_TileY);
+        }
+
+        report.BeginObject("shaderLookup");
+        report.Add("tileX", l_TileX);
+        report.Add("tileY", l_TileY);
+        report.Add("slice", l_Slice);
+        report.EndObject();
+    }
+
+    bool RunClusterScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        if (!arguments.empty())
+        {
+            std::fprintf(stderr, "unknown option %s\n", arguments.front());
+            return false;
+        }
+
+        JobSystem l_Jobs;
+        if (!l_Jobs.Initialize())
+        {
+            report.Fail("the job system did not initialize");
+            return true;
+        }
+
+        glm::mat4 l_View = glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 2.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 l_Projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+
+        LightClusterBinner l_Serial;
+        LightClusterBinner l_Parallel;
+        report.Add("tilesX", l_Serial.GetTilesX());
+        report.Add("tilesY", l_Serial.GetTilesY());
+        report.Add("slices", l_Serial.GetSlices());
+        report.Add("workers", l_Jobs.GetWorkerCount());
+
+        CheckShaderLookup(l_View, l_Projection, report);
+
+        for (uint32_t it_Count : k_LightCounts)
+        {
+            std::vector<GpuLight> l_Lights = MakeLights(it_Count);
+
+            float l_SerialSeconds = BenchBuild(l_Serial, l_View, l_Projection, l_Lights, nullptr);
+            float l_ParallelSeconds = BenchBuild(l_Parallel, l_View, l_Projection, l_Lights, &l_Jobs);
+
+            if (l_Serial.GetIndices() != l_Parallel.GetIndices())
+            {
+                report.Fail("%u lights: the job build binned differently from the serial build", it_Count);
+            }
+
+            const LightClusterStats& l_Stats = l_Parallel.GetStats();
+            report.BeginObject("lights" + std::to_string(it_Count));
+            report.Add("indices", l_Stats.Indices);
+            report.Add("occupiedClusters", l_Stats.OccupiedClusters);
+            report.Add("maxPerCluster", l_Stats.MaxPerCluster);
+            report.Add("serialMillisecondsPerBuild", static_cast<double>(l_SerialSeconds) * 1000.0 / k_Iterations);
+            report.Add("jobsMillisecondsPerBuild", static_cast<double>(l_ParallelSeconds) * 1000.0 / k_Iterations);
+            report.Add("speedup", l_ParallelSeconds > 0.0f ? static_cast<double>(l_SerialSeconds / l_ParallelSeconds) : 0.0);
+            report.EndObject();
+        }
+
+        l_Jobs.Shutdown();
+
+        return true;
+    }
+}
@@ -0,0 +1,101 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Renderer/Culling/Frustum.h>
+#include <Trinity/Renderer/Meshes/MeshBounds.h>
+#include <Trinity/Core/Timer.h>
+
+#include <cstdio>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint32_t k_InstanceCount = 100000;
+        constexpr uint32_t k_Iterations = 200;
+    }
+
+    bool RunCullScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        if (!arguments.empty())
+        {
+            std::fprintf(stderr, "unknown option %s\n", arguments.front());
+            return false;
+        }
+
+        // Unit cubes scattered through a 400 m box around a camera looking down -Z, roughly the visible fraction of an open level
+        MeshBounds l_CubeBounds;
+        l_CubeBounds.Min = glm::vec3(-0.5f);
+        l_CubeBounds.Max = glm::vec3(0.5f);
+        l_CubeBounds.Radius = 0.8660254f;
+
+        BenchRandom l_Random(1234);
+
+        std::vector<glm::mat4> l_Transforms;
+        l_Transforms.reserve(k_InstanceCount);
+        for (uint32_t l_Index = 0; l_Index < k_InstanceCount; ++l_Index)
+        {
+            const glm::vec3 l_Position(l_Random.Range(-200.0f, 200.0f), l_Random.Range(-200.0f, 200.0f), l_Random.Range(-200.0f, 200.0f));
+            glm::mat4 l_Transform = glm::translate(glm::mat4(1.0f), l_Position);
+            l_Transforms.push_back(glm::scale(l_Transform, glm::vec3(l_Random.Range(0.5f, 4.0f))));
+        }
+
+        glm::mat4 l_View = glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 2.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 l_Projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+        Frustum l_Frustum = Frustum::FromViewProjection(l_Projection * l_View);
+
+        SphereBatch l_Spheres;
+        l_Spheres.Reserve(k_InstanceCount);
+
+        Timer l_Timer;
+        for (const glm::mat4& it_Transform : l_Transforms)
+        {
+            l_Spheres.Push(l_CubeBounds.TransformSphere(it_Transform));
+        }
+        float l_GatherSeconds = l_Timer.Elapsed();
+
+        std::vector<uint8_t> l_ScalarVisibility;
+        std::vector<uint8_t> l_VectorVisibility;
+
+        uint32_t l_ScalarVisible = 0;
+        l_Timer.Reset();
+        for (uint32_t l_Iteration = 0; l_Iteration < k_Iterations; ++l_Iteration)
+        {
+            l_ScalarVisible = FrustumCuller::CullScalar(l_Frustum, l_Spheres, l_ScalarVisibility);
+        }
+        float l_ScalarSeconds = l_Timer.Elapsed();
+
+        uint32_t l_VectorVisible = 0;
+        l_Timer.Reset();
+        for (uint32_t l_Iteration = 0; l_Iteration < k_Iterations; ++l_Iteration)
+        {
+            l_VectorVisible = FrustumCuller::Cull(l_Frustum, l_Spheres, l_VectorVisibility);
+        }
+        float l_VectorSeconds = l_Timer.Elapsed();
+
+        // The vector path is only an optimization; it has to agree with the scalar reference sphere for sphere
+        if (l_ScalarVisible != l_VectorVisible || l_ScalarVisibility != l_VectorVisibility)
+        {
+            report.Fail("%s culling kept %u spheres where the scalar path kept %u", FrustumCuller::GetInstructionSet(), l_VectorVisible, l_ScalarVisible);
+        }
+
+        const uint64_t l_Tests = static_cast<uint64_t>(k_InstanceCount) * k_Iterations;
+        report.Add("instances", k_InstanceCount);
+        report.Add("visible", l_VectorVisible);
+        report.Add("gatherMilliseconds", static_cast<double>(l_GatherSeconds) * 1000.0);
+        report.BeginObject("scalar");
+        report.Add("millisecondsPerPass", static_cast<double>(l_ScalarSeconds) * 1000.0 / k_Iterations);
+        report.Add("nanosecondsPerInstance", NanosecondsPer(l_ScalarSeconds, l_Tests));
+        report.EndObject();
+        report.BeginObject("vector");
+        report.Add("instructionSet", FrustumCuller::GetInstructionSet());
+        report.Add("millisecondsPerPass", static_cast<double>(l_VectorSeconds) * 1000.0 / k_Iterations);
+        report.Add("nanosecondsPerInstance", NanosecondsPer(l_VectorSeconds, l_Tests));
+        report.Add("speedup", l_VectorSeconds > 0.0f ? static_cast<double>(l_ScalarSeconds / l_VectorSeconds) : 0.0);
+        report.EndObject();
+
+        return true;
+    }
+}
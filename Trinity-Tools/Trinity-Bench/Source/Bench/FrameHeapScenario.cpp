@@ -0,0 +1,99 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint64_t k_EarlySize = 256;
+        constexpr uint8_t k_EarlyPattern = 0xA5;
+    }
+
+    // The renderer fills its frame uniform and instance data before the cluster and debug-line uploads that can overflow the heap, then binds all of them. Those
+    // early allocations must still resolve, and still hold what was written, after the heap grows under them
+    bool RunFrameHeapScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        if (!arguments.empty())
+        {
+            std::fprintf(stderr, "unknown option %s\n", arguments.front());
+            return false;
+        }
+
+        NullDevice l_Device;
+        if (!l_Device.Initialize())
+        {
+            report.Fail("the null device did not initialize");
+            return true;
+        }
+
+        NullCommandList l_CommandList(l_Device);
+        l_CommandList.Begin();
+
+        const FrameAllocation l_Early = l_Device.AllocateFrameMemory(k_EarlySize, BufferUsage::Uniform);
+        if (l_Early.IsValid())
+        {
+            std::memset(l_Early.Data, k_EarlyPattern, k_EarlySize);
+        }
+
+        const FrameAllocatorStats l_Before = l_Device.GetFrameAllocatorStats();
+        const FrameAllocation l_Overflow = l_Device.AllocateFrameMemory(l_Before.Capacity + 1, BufferUsage::Storage);
+        const FrameAllocatorStats l_After = l_Device.GetFrameAllocatorStats();
+
+        if (!l_Early.IsValid() || !l_Overflow.IsValid() || l_After.Grows != l_Before.Grows + 1 || l_Overflow.Buffer == l_Early.Buffer)
+        {
+            report.Fail("an allocation larger than the heap did not grow it mid-frame");
+        }
+        else
+        {
+            const NullBufferResource* l_Heap = l_Device.GetBuffer(l_Early.Buffer);
+            if (l_Heap == nullptr)
+            {
+                report.Fail("growing the heap destroyed the buffer earlier allocations of the frame name");
+            }
+            else
+            {
+                const uint8_t* l_Bytes = l_Heap->Storage->data() + l_Early.Offset;
+                bool l_Intact = l_Bytes == l_Early.Data;
+                for (uint64_t l_Index = 0; l_Intact && l_Index < k_EarlySize; ++l_Index)
+                {
+                    l_Intact = l_Bytes[l_Index] == k_EarlyPattern;
+                }
+
+                if (!l_Intact)
+                {
+                    report.Fail("the early allocation no longer resolves to the bytes written through it");
+                }
+            }
+        }
+
+        l_CommandList.BindDynamicUniformBuffer(0, 0, l_Early);
+        l_CommandList.BindDynamicStorageBuffer(0, 1, l_Overflow);
+        l_CommandList.End();
+        l_Device.Submit(l_CommandList);
+        l_Device.CollectGarbage();
+
+        const NullDeviceStats& l_Stats = l_Device.GetStats();
+        if (l_Stats.Commands.InvalidHandles != 0)
+        {
+            report.Fail("%llu binds of the grown frame referenced a destroyed heap", static_cast<unsigned long long>(l_Stats.Commands.InvalidHandles));
+        }
+
+        // Once the frame is closed nothing names the outgrown heap, so holding on to it longer would be a leak
+        if (l_Early.IsValid() && l_Early.Buffer != l_Overflow.Buffer && l_Device.IsAlive(l_Early.Buffer))
+        {
+            report.Fail("the outgrown heap was still alive after its frame closed");
+        }
+
+        report.Add("initialCapacity", l_Before.Capacity);
+        report.Add("grownCapacity", l_After.Capacity);
+        report.Add("grows", l_After.Grows);
+
+        l_Device.Shutdown();
+
+        return true;
+    }
+}
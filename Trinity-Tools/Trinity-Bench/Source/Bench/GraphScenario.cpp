@@ -0,0 +1,253 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Renderer/Graph/RenderGraph.h>
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
+#include <Trinity/Core/Timer.h>
+
+#include <cstdio>
+
+#include <glm/glm.hpp>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint32_t k_WarmupFrames = 16;
+        constexpr uint32_t k_Frames = 10000;
+        constexpr uint32_t k_BackBufferCount = 3;
+
+        struct FrameResult
+        {
+            float Milliseconds = 0.0f;
+            uint64_t Allocations = 0;
+        };
+    }
+
+    static TextureDescription DescribeTarget(const char* name, Format format, TextureUsage usage)
+    {
+        TextureDescription l_Description;
+        l_Description.Width = 1920;
+        l_Description.Height = 1080;
+        l_Description.Format = format;
+        l_Description.Usage = usage;
+        l_Description.DebugName = name;
+
+        return l_Description;
+    }
+
+    // The editor's frame as Renderer::RenderFrame declares it: shadow, scene, culled depth visualization, post-process into the viewport and the UI composite.
+    // The captures match the real passes in size so the callbacks exercise the same inline storage
+    static void DeclareFrame(RenderGraph& graph, TextureHandle backBuffer, TextureHandle shadowMap, const glm::mat4& lightViewProjection, uint64_t& executed)
+    {
+        graph.Reset();
+        TextureHandle l_SceneColor = graph.CreateTransient(DescribeTarget("SceneColor", Format::RGBA16_SFLOAT, TextureUsage::Sampled | TextureUsage::RenderTarget));
+        TextureHandle l_SceneDepth = graph.CreateTransient(DescribeTarget("SceneDepth", Format::D32_SFLOAT, TextureUsage::DepthStencil | TextureUsage::Sampled));
+        TextureHandle l_DepthVis = graph.CreateTransient(DescribeTarget("DepthVis", Format::RGBA8_UNORM, TextureUsage::Sampled | TextureUsage::RenderTarget));
+        TextureHandle l_ViewportColor = graph.CreateTransient(DescribeTarget("ViewportColor", Format::BGRA8_UNORM, TextureUsage::Sampled | TextureUsage::RenderTarget));
+
+        graph.Import(backBuffer, ResourceState::Undefined, "BackBuffer");
+        graph.Import(shadowMap, ResourceState::Undefined, "ShadowMap");
+        {
+            RenderGraphPass& l_Pass = graph.AddPass("Shadow");
+            l_Pass.Depth = shadowMap;
+            l_Pass.Width = 2048;
+            l_Pass.Height = 2048;
+
+            bool l_Active = true;
+            l_Pass.Execute = [&executed, lightViewProjection, l_Active](CommandList&)
+                {
+                    executed += l_Active && lightViewProjection[3][3] != 0.0f ? 1 : 0;
+                };
+        }
+
+        {
+            RenderGraphPass& l_Pass = graph.AddPass("Scene");
+            l_Pass.Reads.push_back(shadowMap);
+
+            RenderGraphColorTarget l_Color;
+            l_Color.Target = l_SceneColor;
+            l_Color.Clear = true;
+            l_Pass.Colors.push_back(l_Color);
+
+            l_Pass.Depth = l_SceneDepth;
+            l_Pass.Width = 1920;
+            l_Pass.Height = 1080;
+            l_Pass.Execute = [&executed](CommandList&) { ++executed; };
+        }
+
+        {
+            RenderGraphPass& l_Pass = graph.AddPass("DepthVisualize");
+            l_Pass.Reads.push_back(l_SceneDepth);
+
+            RenderGraphColorTarget l_Color;
+            l_Color.Target = l_DepthVis;
+            l_Pass.Colors.push_back(l_Color);
+
+            l_Pass.ManageRendering = false;
+            l_Pass.Execute = [&executed](CommandList&) { ++executed; };
+        }
+
+        {
+            RenderGraphPass& l_Pass = graph.AddPass("PostProcess");
+            l_Pass.Reads.push_back(l_SceneColor);
+
+            RenderGraphColorTarget l_Color;
+            l_Color.Target = l_ViewportColor;
+            l_Pass.Colors.push_back(l_Color);
+
+            l_Pass.ManageRendering = false;
+            l_Pass.Execute = [&executed](CommandList&) { ++executed; };
+        }
+
+        {
+            RenderGraphPass& l_Pass = graph.AddPass("Composite");
+            l_Pass.Reads.push_back(l_ViewportColor);
+
+            RenderGraphColorTarget l_Color;
+            l_Color.Target = backBuffer;
+            l_Color.Clear = true;
+            l_Pass.Colors.push_back(l_Color);
+
+            l_Pass.Width = 1920;
+            l_Pass.Height = 1080;
+            l_Pass.Execute = [&executed](CommandList&) { ++executed; };
+        }
+
+        graph.SetPresent(backBuffer);
+    }
+
+    static FrameResult RunFrames(RenderGraph& graph, NullDevice& device, NullCommandList& commandList, const TextureHandle* backBuffers, TextureHandle shadowMap, uint32_t frames,
+        uint64_t& executed)
+    {
+        const glm::mat4 l_LightViewProjection(1.0f);
+
+        FrameResult l_Result;
+        const uint64_t l_AllocationsBefore = GetAllocationCount();
+        Timer l_Timer;
+
+        for (uint32_t l_Frame = 0; l_Frame < frames; ++l_Frame)
+        {
+            // Swapchain images rotate every frame, so a cache keyed on handles rather than topology would miss every time
+            DeclareFrame(graph, backBuffers[l_Frame % k_BackBufferCount], shadowMap, l_LightViewProjection, executed);
+            graph.Compile();
+
+            commandList.Begin();
+            graph.Execute(commandList);
+            commandList.End();
+            device.Submit(commandList);
+        }
+
+        l_Result.Milliseconds = l_Timer.ElapsedMilliseconds();
+        l_Result.Allocations = GetAllocationCount() - l_AllocationsBefore;
+
+        return l_Result;
+    }
+
+    bool RunGraphScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        if (!arguments.empty())
+        {
+            std::fprintf(stderr, "unknown option %s\n", arguments.front());
+            return false;
+        }
+
+        NullDevice l_Device;
+        if (!l_Device.Initialize())
+        {
+            report.Fail("the null device did not initialize");
+            return true;
+        }
+
+        NullCommandList l_CommandList(l_Device);
+        uint64_t l_Executed = 0;
+
+        TextureHandle l_BackBuffers[k_BackBufferCount];
+        for (TextureHandle& it_BackBuffer : l_BackBuffers)
+        {
+            it_BackBuffer = l_Device.CreateTexture(DescribeTarget("BackBuffer", Format::BGRA8_SRGB, TextureUsage::RenderTarget));
+        }
+
+        TextureDescription l_ShadowDescription = DescribeTarget("ShadowMap", Format::D32_SFLOAT, TextureUsage::DepthStencil | TextureUsage::Sampled);
+        l_ShadowDescription.Width = 2048;
+        l_ShadowDescription.Height = 2048;
+        const TextureHandle l_ShadowMap = l_Device.CreateTexture(l_ShadowDescription);
+
+        RenderGraph l_Graph;
+        l_Graph.Initialize(l_Device);
+
+        // Warm-up sizes every pooled vector, the recorded command stream included, and places the transients, as the first frames after startup or a resize do
+        RunFrames(l_Graph, l_Device, l_CommandList, l_BackBuffers, l_ShadowMap, k_WarmupFrames, l_Executed);
+
+        const RenderGraphStats& l_Stats = l_Graph.GetStats();
+        report.BeginObject("graph");
+        report.Add("passes", l_Stats.Passes);
+        report.Add("culledPasses", l_Stats.CulledPasses);
+        report.Add("barriers", l_Stats.Barriers);
+        report.Add("barrierBatches", l_Stats.BarrierBatches);
+        report.Add("transientTextures", l_Stats.TransientTextures);
+        report.Add("transientHeaps", l_Stats.TransientHeaps);
+        report.Add("commandsPerFrame", static_cast<uint64_t>(l_CommandList.GetCommands().size()));
+        report.EndObject();
+
+        const NullDeviceStats& l_Submitted = l_Device.GetStats();
+        const uint64_t l_CompilationsBefore = l_Stats.Compilations;
+        const uint64_t l_BarriersBefore = l_Submitted.Commands.Barriers;
+        FrameResult l_Cached = RunFrames(l_Graph, l_Device, l_CommandList, l_BackBuffers, l_ShadowMap, k_Frames, l_Executed);
+        const uint64_t l_CachedCompilations = l_Stats.Compilations - l_CompilationsBefore;
+        const uint64_t l_CachedBarriers = l_Submitted.Commands.Barriers - l_BarriersBefore;
+
+        l_Graph.SetCachingEnabled(false);
+        const uint64_t l_UncachedBarriersBefore = l_Submitted.Commands.Barriers;
+        FrameResult l_Uncached = RunFrames(l_Graph, l_Device, l_CommandList, l_BackBuffers, l_ShadowMap, k_Frames, l_Executed);
+        const uint64_t l_UncachedBarriers = l_Submitted.Commands.Barriers - l_UncachedBarriersBefore;
+
+        report.Add("frames", k_Frames);
+        report.BeginObject("cached");
+        report.Add("millisecondsPerFrame", static_cast<double>(l_Cached.Milliseconds) / k_Frames);
+        report.Add("allocationsPerFrame", static_cast<double>(l_Cached.Allocations) / k_Frames);
+        report.Add("compilations", l_CachedCompilations);
+        report.EndObject();
+        report.BeginObject("uncached");
+        report.Add("millisecondsPerFrame", static_cast<double>(l_Uncached.Milliseconds) / k_Frames);
+        report.Add("allocationsPerFrame", static_cast<double>(l_Uncached.Allocations) / k_Frames);
+        report.Add("slowdown", l_Cached.Milliseconds > 0.0f ? static_cast<double>(l_Uncached.Milliseconds / l_Cached.Milliseconds) : 0.0);
+        report.EndObject();
+        report.Add("passCallbacks", l_Executed);
+        report.Add("renderPasses", l_Submitted.Commands.RenderPasses);
+        report.Add("submissions", l_Submitted.Submissions);
+
+        const uint64_t l_InvalidHandles = l_Submitted.Commands.InvalidHandles;
+
+        l_Graph.Shutdown();
+
+        for (TextureHandle it_BackBuffer : l_BackBuffers)
+        {
+            l_Device.DestroyTexture(it_BackBuffer);
+        }
+
+        l_Device.DestroyTexture(l_ShadowMap);
+        l_Device.Shutdown();
+
+        if (l_Cached.Allocations != 0)
+        {
+            report.Fail("steady-state frames allocated %llu times", static_cast<unsigned long long>(l_Cached.Allocations));
+        }
+
+        if (l_CachedCompilations != 0)
+        {
+            report.Fail("the plan was rebuilt %llu times with an unchanged topology", static_cast<unsigned long long>(l_CachedCompilations));
+        }
+
+        if (l_CachedBarriers != l_UncachedBarriers)
+        {
+            report.Fail("cached frames recorded %llu barriers, rebuilt frames %llu", static_cast<unsigned long long>(l_CachedBarriers), static_cast<unsigned long long>(l_UncachedBarriers));
+        }
+
+        if (l_InvalidHandles != 0)
+        {
+            report.Fail("%llu commands referenced destroyed textures", static_cast<unsigned long long>(l_InvalidHandles));
+        }
+
+        return true;
+    }
+}
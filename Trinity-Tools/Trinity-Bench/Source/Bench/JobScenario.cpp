@@ -0,0 +1,182 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Core/JobSystem.h>
+#include <Trinity/Core/Timer.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint32_t k_JobCount = 100000;
+        constexpr uint32_t k_ChainLength = 10000;
+        constexpr uint32_t k_RangeSize = 1u << 22;
+    }
+
+    // Schedule from the main thread, then wait on all: the per-job cost of allocation, queueing, and completion.
+    static void BenchSpawn(JobSystem& jobs, BenchReport& report)
+    {
+        std::atomic<uint32_t> l_Counter{ 0 };
+        std::vector<JobHandle> l_Handles;
+        l_Handles.reserve(k_JobCount);
+
+        jobs.ResetStats();
+        Timer l_Timer;
+        for (uint32_t l_Index = 0; l_Index < k_JobCount; ++l_Index)
+        {
+            l_Handles.push_back(jobs.Schedule([&l_Counter]() { l_Counter.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        float l_SpawnSeconds = l_Timer.Elapsed();
+
+        jobs.Wait(l_Handles);
+        float l_TotalSeconds = l_Timer.Elapsed();
+
+        if (l_Counter.load() != k_JobCount)
+        {
+            report.Fail("spawn ran %u of %u jobs", l_Counter.load(), k_JobCount);
+        }
+
+        JobSystemStats l_Stats = jobs.GetStats();
+        report.BeginObject("spawn");
+        report.Add("scheduleNanosecondsPerJob", NanosecondsPer(l_SpawnSeconds, k_JobCount));
+        report.Add("totalNanosecondsPerJob", NanosecondsPer(l_TotalSeconds, k_JobCount));
+        report.Add("stolen", l_Stats.Stolen);
+        report.Add("executed", l_Stats.Executed);
+        report.EndObject();
+    }
+
+    // One worker fans out children into its own deque; every child another thread runs was stolen.
+    static void BenchSteal(JobSystem& jobs, BenchReport& report)
+    {
+        std::atomic<uint32_t> l_Counter{ 0 };
+
+        jobs.ResetStats();
+        Timer l_Timer;
+        JobHandle l_Root = jobs.Schedule([&jobs, &l_Counter]()
+            {
+                std::vector<JobHandle> l_Children;
+                l_Children.reserve(k_JobCount);
+                for (uint32_t l_Index = 0; l_Index < k_JobCount; ++l_Index)
+                {
+                    l_Children.push_back(jobs.Schedule([&l_Counter]() { l_Counter.fetch_add(1, std::memory_order_relaxed); }));
+                }
+
+                jobs.Wait(l_Children);
+            });
+        jobs.Wait(l_Root);
+        float l_Seconds = l_Timer.Elapsed();
+
+        if (l_Counter.load() != k_JobCount)
+        {
+            report.Fail("steal ran %u of %u jobs", l_Counter.load(), k_JobCount);
+        }
+
+        JobSystemStats l_Stats = jobs.GetStats();
+        report.BeginObject("steal");
+        report.Add("nanosecondsPerJob", NanosecondsPer(l_Seconds, k_JobCount));
+        report.Add("stolen", l_Stats.Stolen);
+        report.Add("executed", l_Stats.Executed);
+        report.EndObject();
+    }
+
+    // A chain of continuations measures completion-to-dispatch latency; waiting on a finished handle measures the fast path.
+    static void BenchWait(JobSystem& jobs, BenchReport& report)
+    {
+        std::atomic<uint32_t> l_Counter{ 0 };
+
+        Timer l_Timer;
+        JobHandle l_Tail = jobs.Schedule([&l_Counter]() { l_Counter.fetch_add(1, std::memory_order_relaxed); });
+        for (uint32_t l_Index = 1; l_Index < k_ChainLength; ++l_Index)
+        {
+            l_Tail = jobs.Then(l_Tail, [&l_Counter]() { l_Counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        jobs.Wait(l_Tail);
+        float l_ChainSeconds = l_Timer.Elapsed();
+
+        if (l_Counter.load() != k_ChainLength)
+        {
+            report.Fail("the continuation chain ran %u of %u jobs", l_Counter.load(), k_ChainLength);
+        }
+
+        l_Timer.Reset();
+        for (uint32_t l_Index = 0; l_Index < k_JobCount; ++l_Index)
+        {
+            jobs.Wait(l_Tail);
+        }
+        float l_WaitSeconds = l_Timer.Elapsed();
+
+        report.BeginObject("wait");
+        report.Add("chainLength", k_ChainLength);
+        report.Add("nanosecondsPerContinuation", NanosecondsPer(l_ChainSeconds, k_ChainLength));
+        report.Add("nanosecondsPerCompletedWait", NanosecondsPer(l_WaitSeconds, k_JobCount));
+        report.EndObject();
+    }
+
+    // ParallelFor over a trivially cheap body isolates the scheduling overhead against the serial loop.
+    static void BenchParallelFor(JobSystem& jobs, BenchReport& report)
+    {
+        std::vector<float> l_Values(k_RangeSize, 1.0f);
+
+        Timer l_Timer;
+        for (uint32_t l_Index = 0; l_Index < k_RangeSize; ++l_Index)
+        {
+            l_Values[l_Index] = l_Values[l_Index] * 0.5f + 1.0f;
+        }
+        float l_SerialSeconds = l_Timer.Elapsed();
+
+        report.BeginObject("parallelFor");
+        report.Add("elements", k_RangeSize);
+        report.Add("serialMilliseconds", static_cast<double>(l_SerialSeconds) * 1000.0);
+        for (uint32_t l_Grain : { 256u, 4096u, 65536u })
+        {
+            l_Timer.Reset();
+            jobs.ParallelFor(k_RangeSize, l_Grain, [&l_Values](uint32_t begin, uint32_t end)
+                {
+                    for (uint32_t l_Index = begin; l_Index < end; ++l_Index)
+                    {
+                        l_Values[l_Index] = l_Values[l_Index] * 0.5f + 1.0f;
+                    }
+                });
+            float l_ParallelSeconds = l_Timer.Elapsed();
+
+            report.Add("grain" + std::to_string(l_Grain) + "Milliseconds", static_cast<double>(l_ParallelSeconds) * 1000.0);
+        }
+        report.EndObject();
+
+        if (l_Values[0] != l_Values[k_RangeSize - 1])
+        {
+            report.Fail("parallel_for skipped part of its range");
+        }
+    }
+
+    bool RunJobScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        if (!arguments.empty())
+        {
+            std::fprintf(stderr, "unknown option %s\n", arguments.front());
+            return false;
+        }
+
+        JobSystem l_Jobs;
+        if (!l_Jobs.Initialize())
+        {
+            report.Fail("the job system did not initialize");
+            return true;
+        }
+
+        report.Add("workers", l_Jobs.GetWorkerCount());
+
+        BenchSpawn(l_Jobs, report);
+        BenchSteal(l_Jobs, report);
+        BenchWait(l_Jobs, report);
+        BenchParallelFor(l_Jobs, report);
+
+        l_Jobs.Shutdown();
+
+        return true;
+    }
+}
@@ -0,0 +1,202 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Renderer/Meshes/MeshImporter.h>
+#include <Trinity/Renderer/Meshes/MeshData.h>
+#include <Trinity/Core/Timer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace Trinity
+{
+    namespace
+    {
+        struct MeshSettings
+        {
+            std::filesystem::path Root;
+            MeshImportSettings Import;
+        };
+
+        // Triangle-weighted running sums, so the totals weigh each mesh by its size rather than counting them equally
+        struct MeshTotals
+        {
+            uint32_t Meshes = 0;
+            uint32_t Failed = 0;
+            double Triangles = 0.0;
+            double Vertices = 0.0;
+            double SourceAcmr = 0.0;
+            double OptimizedAcmr = 0.0;
+            double SourceAtvr = 0.0;
+            double OptimizedAtvr = 0.0;
+            double SourceOverdraw = 0.0;
+            double OptimizedOverdraw = 0.0;
+            float Seconds = 0.0f;
+        };
+    }
+
+    static bool ParseMeshArguments(const BenchArguments& arguments, MeshSettings& outSettings)
+    {
+        for (size_t l_Index = 0; l_Index < arguments.size(); ++l_Index)
+        {
+            const char* l_Name = arguments[l_Index];
+            if (std::strcmp(l_Name, "--no-optimize") == 0) { outSettings.Import.Optimization.Enabled = false; continue; }
+            if (std::strcmp(l_Name, "--no-lods") == 0) { outSettings.Import.Lods.TargetRatios.clear(); continue; }
+
+            if (std::strncmp(l_Name, "--", 2) != 0)
+            {
+                outSettings.Root = l_Name;
+                continue;
+            }
+
+            if (l_Index + 1 >= arguments.size())
+            {
+                std::fprintf(stderr, "missing value for %s\n", l_Name);
+                return false;
+            }
+
+            const char* l_Value = arguments[++l_Index];
+            if (std::strcmp(l_Name, "--cache") == 0) { outSettings.Import.Optimization.CacheSize = std::max(static_cast<uint32_t>(std::strtoul(l_Value, nullptr, 10)), 3u); }
+            else if (std::strcmp(l_Name, "--threshold") == 0) { outSettings.Import.Optimization.OverdrawThreshold = static_cast<float>(std::atof(l_Value)); }
+            else
+            {
+                std::fprintf(stderr, "unknown option %s\n", l_Name);
+                return false;
+            }
+        }
+
+        if (outSettings.Root.empty())
+        {
+            std::fprintf(stderr, "the meshes scenario needs a folder or file\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    // Every file under root the importer has a reader for, sorted so runs over the same folder line up
+    static std::vector<std::filesystem::path> CollectMeshes(const std::filesystem::path& root, const MeshImporter& importer)
+    {
+        std::vector<std::filesystem::path> l_Paths;
+        std::error_code l_Error;
+        if (std::filesystem::is_regular_file(root, l_Error))
+        {
+            l_Paths.push_back(root);
+
+            return l_Paths;
+        }
+
+        for (std::filesystem::recursive_directory_iterator it_Entry(root, std::filesystem::directory_options::skip_permission_denied, l_Error), l_End; it_Entry != l_End; it_Entry.increment(l_Error))
+        {
+            if (l_Error)
+            {
+                break;
+            }
+
+            if (it_Entry->is_regular_file(l_Error) && importer.IsExtensionSupported(it_Entry->path()))
+            {
+                l_Paths.push_back(it_Entry->path());
+            }
+        }
+
+        std::sort(l_Paths.begin(), l_Paths.end());
+
+        return l_Paths;
+    }
+
+    static void AddMetrics(BenchReport& report, const char* name, double source, double optimized)
+    {
+        report.BeginObject(name);
+        report.Add("source", source);
+        report.Add("optimized", optimized);
+        report.EndObject();
+    }
+
+    bool RunMeshScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        MeshSettings l_Settings;
+        if (!ParseMeshArguments(arguments, l_Settings))
+        {
+            return false;
+        }
+
+        report.Add("cacheSize", l_Settings.Import.Optimization.CacheSize);
+        report.Add("overdrawThreshold", static_cast<double>(l_Settings.Import.Optimization.OverdrawThreshold));
+        report.Add("optimize", l_Settings.Import.Optimization.Enabled);
+
+        MeshImporter l_Importer;
+        const std::vector<std::filesystem::path> l_Paths = CollectMeshes(l_Settings.Root, l_Importer);
+        if (l_Paths.empty())
+        {
+            report.Fail("no meshes found under %s", l_Settings.Root.string().c_str());
+            return true;
+        }
+
+        MeshTotals l_Totals;
+        report.BeginObject("meshes");
+        for (const std::filesystem::path& it_Path : l_Paths)
+        {
+            const std::string l_Name = it_Path == l_Settings.Root ? it_Path.filename().string() : std::filesystem::relative(it_Path, l_Settings.Root).generic_string();
+
+            Timer l_Timer;
+            std::optional<MeshData> l_Data = l_Importer.Import(it_Path, l_Settings.Import);
+            const float l_Seconds = l_Timer.Elapsed();
+            if (!l_Data)
+            {
+                report.Fail("%s failed to import", l_Name.c_str());
+                ++l_Totals.Failed;
+                continue;
+            }
+
+            uint32_t l_Triangles = 0;
+            for (const Submesh& it_Submesh : l_Data->Submeshes)
+            {
+                l_Triangles += it_Submesh.IndexCount / 3;
+            }
+
+            const MeshOptimizeMetrics& l_Source = l_Data->Diagnostics.SourceMetrics;
+            const MeshOptimizeMetrics& l_Optimized = l_Data->Diagnostics.OptimizedMetrics;
+            report.BeginObject(l_Name);
+            report.Add("triangles", l_Triangles);
+            report.Add("vertices", static_cast<uint64_t>(l_Data->Vertices.size()));
+            AddMetrics(report, "acmr", l_Source.Acmr, l_Optimized.Acmr);
+            AddMetrics(report, "atvr", l_Source.Atvr, l_Optimized.Atvr);
+            AddMetrics(report, "overdraw", l_Source.Overdraw, l_Optimized.Overdraw);
+            report.Add("importMilliseconds", static_cast<double>(l_Seconds) * 1000.0);
+            report.EndObject();
+
+            const double l_Weight = static_cast<double>(l_Triangles);
+            ++l_Totals.Meshes;
+            l_Totals.Triangles += l_Weight;
+            l_Totals.Vertices += static_cast<double>(l_Data->Vertices.size());
+            l_Totals.SourceAcmr += l_Source.Acmr * l_Weight;
+            l_Totals.OptimizedAcmr += l_Optimized.Acmr * l_Weight;
+            l_Totals.SourceAtvr += l_Source.Atvr * l_Weight;
+            l_Totals.OptimizedAtvr += l_Optimized.Atvr * l_Weight;
+            l_Totals.SourceOverdraw += l_Source.Overdraw * l_Weight;
+            l_Totals.OptimizedOverdraw += l_Optimized.Overdraw * l_Weight;
+            l_Totals.Seconds += l_Seconds;
+        }
+        report.EndObject();
+
+        const double l_Scale = l_Totals.Triangles > 0.0 ? 1.0 / l_Totals.Triangles : 0.0;
+        report.BeginObject("total");
+        report.Add("meshes", l_Totals.Meshes);
+        report.Add("failed", l_Totals.Failed);
+        report.Add("triangles", l_Totals.Triangles);
+        report.Add("vertices", l_Totals.Vertices);
+        AddMetrics(report, "acmr", l_Totals.SourceAcmr * l_Scale, l_Totals.OptimizedAcmr * l_Scale);
+        AddMetrics(report, "atvr", l_Totals.SourceAtvr * l_Scale, l_Totals.OptimizedAtvr * l_Scale);
+        AddMetrics(report, "overdraw", l_Totals.SourceOverdraw * l_Scale, l_Totals.OptimizedOverdraw * l_Scale);
+        report.Add("importMilliseconds", static_cast<double>(l_Totals.Seconds) * 1000.0);
+        report.EndObject();
+
+        return true;
+    }
+}
@@ -0,0 +1,427 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Renderer/RHI/GraphicsBackendFactory.h>
+#include <Trinity/Renderer/Backends/Null/NullDevice.h>
+#include <Trinity/Renderer/Backends/Null/NullSwapchain.h>
+#include <Trinity/Renderer/Frontend/Renderer.h>
+#include <Trinity/Renderer/Meshes/Mesh.h>
+#include <Trinity/Renderer/Meshes/MeshData.h>
+#include <Trinity/Platform/Backends/SDL3/SDLFileSystem.h>
+#include <Trinity/Assets/AssetDatabase.h>
+#include <Trinity/Audio/Frontend/AudioEngine.h>
+#include <Trinity/Scene/Scene.h>
+#include <Trinity/Scene/Entity.h>
+#include <Trinity/Scene/Components/TransformComponent.h>
+#include <Trinity/Scene/Components/MeshRendererComponent.h>
+#include <Trinity/Scene/Components/LightComponent.h>
+#include <Trinity/Core/JobSystem.h>
+#include <Trinity/Core/Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Trinity
+{
+    namespace
+    {
+        constexpr uint32_t k_Width = 1920;
+        constexpr uint32_t k_Height = 1080;
+        constexpr float k_EntitySpacing = 4.0f;
+
+        // Material asset IDs no file backs; each compiles to its own engine-default block, which is all sorting and batching look at
+        constexpr uint64_t k_MaterialBase = 0x7B000000ull;
+
+        struct RendererSettings
+        {
+            uint32_t Entities = 10000;
+            uint32_t Depth = 3;
+            uint32_t Meshes = 32;
+            uint32_t Materials = 64;
+            uint32_t Lights = 128;
+            uint32_t Frames = 300;
+            uint32_t WarmupFrames = 30;
+            uint32_t Workers = 0;
+            uint64_t Seed = 1;
+
+            // Fraction of hierarchy roots that move every frame, dirtying their whole subtree
+            float Moving = 0.1f;
+        };
+
+        struct BenchScene
+        {
+            std::vector<std::shared_ptr<Mesh>> Meshes;
+            std::vector<entt::entity> MovingRoots;
+            uint32_t MeshEntities = 0;
+        };
+
+        // Per-frame samples of every measured stage, reserved up front so recording them does not show up as frame allocations
+        struct BenchSamples
+        {
+            std::vector<double> Frame;
+            std::vector<double> Transforms;
+            std::vector<double> Extract;
+            std::vector<double> Sort;
+            std::vector<double> Cull;
+            std::vector<double> Record;
+        };
+    }
+
+    static bool ParseRendererArguments(const BenchArguments& arguments, RendererSettings& outSettings)
+    {
+        for (size_t l_Index = 0; l_Index < arguments.size(); ++l_Index)
+        {
+            const char* l_Name = arguments[l_Index];
+            if (l_Index + 1 >= arguments.size())
+            {
+                std::fprintf(stderr, "missing value for %s\n", l_Name);
+                return false;
+            }
+
+            const char* l_Value = arguments[++l_Index];
+            const uint32_t l_Number = static_cast<uint32_t>(std::strtoul(l_Value, nullptr, 10));
+
+            if (std::strcmp(l_Name, "--entities") == 0) { outSettings.Entities = l_Number; }
+            else if (std::strcmp(l_Name, "--depth") == 0) { outSettings.Depth = std::max(l_Number, 1u); }
+            else if (std::strcmp(l_Name, "--meshes") == 0) { outSettings.Meshes = std::max(l_Number, 1u); }
+            else if (std::strcmp(l_Name, "--materials") == 0) { outSettings.Materials = std::max(l_Number, 1u); }
+            else if (std::strcmp(l_Name, "--lights") == 0) { outSettings.Lights = l_Number; }
+            else if (std::strcmp(l_Name, "--frames") == 0) { outSettings.Frames = std::max(l_Number, 1u); }
+            else if (std::strcmp(l_Name, "--warmup") == 0) { outSettings.WarmupFrames = l_Number; }
+            else if (std::strcmp(l_Name, "--workers") == 0) { outSettings.Workers = l_Number; }
+            else if (std::strcmp(l_Name, "--seed") == 0) { outSettings.Seed = std::strtoull(l_Value, nullptr, 10); }
+            else if (std::strcmp(l_Name, "--moving") == 0) { outSettings.Moving = std::clamp(static_cast<float>(std::atof(l_Value)), 0.0f, 1.0f); }
+            else
+            {
+                std::fprintf(stderr, "unknown option %s\n", l_Name);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // A UV sphere; the tessellation steps with the index so the meshes differ in index count as real assets do
+    static MeshData BuildSphere(uint32_t index)
+    {
+        const uint32_t l_Segments = 8 + (index % 5) * 4;
+        const uint32_t l_Rings = l_Segments / 2;
+
+        MeshData l_Data;
+        for (uint32_t l_Ring = 0; l_Ring <= l_Rings; ++l_Ring)
+        {
+            const float l_Phi = glm::pi<float>() * static_cast<float>(l_Ring) / static_cast<float>(l_Rings);
+            for (uint32_t l_Segment = 0; l_Segment <= l_Segments; ++l_Segment)
+            {
+                const float l_Theta = glm::two_pi<float>() * static_cast<float>(l_Segment) / static_cast<float>(l_Segments);
+
+                MeshVertex& l_Vertex = l_Data.Vertices.emplace_back();
+                l_Vertex.Normal = glm::vec3(std::sin(l_Phi) * std::cos(l_Theta), std::cos(l_Phi), std::sin(l_Phi) * std::sin(l_Theta));
+                l_Vertex.Position = l_Vertex.Normal * 0.5f;
+                l_Vertex.Tangent = glm::vec3(-std::sin(l_Theta), 0.0f, std::cos(l_Theta));
+                l_Vertex.UV = glm::vec2(static_cast<float>(l_Segment) / static_cast<float>(l_Segments), static_cast<float>(l_Ring) / static_cast<float>(l_Rings));
+            }
+        }
+
+        for (uint32_t l_Ring = 0; l_Ring < l_Rings; ++l_Ring)
+        {
+            for (uint32_t l_Segment = 0; l_Segment < l_Segments; ++l_Segment)
+            {
+                const uint32_t l_A = l_Ring * (l_Segments + 1) + l_Segment;
+                const uint32_t l_B = l_A + l_Segments + 1;
+                l_Data.Indices.insert(l_Data.Indices.end(), { l_A, l_B, l_A + 1, l_A + 1, l_B, l_B + 1 });
+            }
+        }
+
+        Submesh& l_Submesh = l_Data.Submeshes.emplace_back();
+        l_Submesh.IndexCount = static_cast<uint32_t>(l_Data.Indices.size());
+        l_Submesh.Name = "Sphere";
+        l_Data.MaterialSlots.emplace_back().Name = "Default";
+        ComputeMeshBounds(l_Data);
+
+        return l_Data;
+    }
+
+    // Entities are created level by level in rotation, each non-root parented to a random entity one level up, so the hierarchy is exactly the requested depth with
+    // a random fan-out. Roots are spread over a square field; children sit near their parent
+    static bool GenerateScene(const RendererSettings& settings, GraphicsDevice& device, Scene& scene, BenchScene& outScene)
+    {
+        BenchRandom l_Random(settings.Seed);
+
+        for (uint32_t l_Index = 0; l_Index < settings.Meshes; ++l_Index)
+        {
+            auto l_Mesh = std::make_shared<Mesh>(device);
+            if (!l_Mesh->Upload(BuildSphere(l_Index)))
+            {
+                return false;
+            }
+
+            outScene.Meshes.push_back(std::move(l_Mesh));
+        }
+
+        const uint32_t l_Roots = std::max((settings.Entities + settings.Depth - 1) / settings.Depth, 1u);
+        const float l_Field = std::sqrt(static_cast<float>(l_Roots)) * k_EntitySpacing;
+        const uint32_t l_MovingStride = settings.Moving > 0.0f ? std::max(static_cast<uint32_t>(1.0f / settings.Moving), 1u) : 0;
+
+        std::vector<std::vector<Entity>> l_Levels(settings.Depth);
+        for (uint32_t l_Index = 0; l_Index < settings.Entities; ++l_Index)
+        {
+            const uint32_t l_Level = l_Index % settings.Depth;
+            Entity l_Entity = scene.CreateEntityWithUUID(UUID(l_Index + 1), "Bench");
+
+            TransformComponent& l_Transform = l_Entity.GetComponent<TransformComponent>();
+            if (l_Level == 0)
+            {
+                l_Transform.Translation = glm::vec3(l_Random.Range(-l_Field, l_Field) * 0.5f, 0.0f, l_Random.Range(-l_Field, l_Field) * 0.5f);
+
+                const uint32_t l_Root = static_cast<uint32_t>(l_Levels[0].size());
+                if (l_MovingStride != 0 && l_Root % l_MovingStride == 0)
+                {
+                    outScene.MovingRoots.push_back(l_Entity.GetHandle());
+                }
+            }
+            else
+            {
+                l_Transform.Translation = glm::vec3(l_Random.Range(-1.5f, 1.5f), l_Random.Range(0.5f, 1.5f), l_Random.Range(-1.5f, 1.5f));
+
+                const std::vector<Entity>& l_Parents = l_Levels[l_Level - 1];
+                scene.SetParent(l_Entity, l_Parents[l_Random.Below(static_cast<uint32_t>(l_Parents.size()))]);
+            }
+
+            l_Transform.Scale = glm::vec3(l_Random.Range(0.5f, 1.5f));
+            l_Transform.Rotation = glm::angleAxis(l_Random.Range(0.0f, glm::two_pi<float>()), glm::vec3(0.0f, 1.0f, 0.0f));
+
+            MeshRendererComponent l_Renderer;
+            l_Renderer.MeshReference = outScene.Meshes[l_Random.Below(settings.Meshes)];
+            l_Renderer.Materials.push_back(UUID(k_MaterialBase + l_Random.Below(settings.Materials)));
+            l_Entity.AddComponent<MeshRendererComponent>(std::move(l_Renderer));
+
+            l_Levels[l_Level].push_back(l_Entity);
+            ++outScene.MeshEntities;
+        }
+
+        Entity l_Sun = scene.CreateEntityWithUUID(UUID(settings.Entities + 1), "Sun");
+        l_Sun.GetComponent<TransformComponent>().Rotation = glm::quat(glm::vec3(-0.9f, 0.4f, 0.0f));
+        l_Sun.AddComponent<LightComponent>().Intensity = 3.0f;
+
+        for (uint32_t l_Index = 0; l_Index < settings.Lights; ++l_Index)
+        {
+            Entity l_Light = scene.CreateEntityWithUUID(UUID(settings.Entities + 2 + l_Index), "Light");
+            l_Light.GetComponent<TransformComponent>().Translation = glm::vec3(l_Random.Range(-l_Field, l_Field) * 0.5f, l_Random.Range(1.0f, 6.0f), l_Random.Range(-l_Field, l_Field) * 0.5f);
+
+            LightComponent& l_Component = l_Light.AddComponent<LightComponent>();
+            l_Component.Type = LightType::Point;
+            l_Component.Color = glm::vec3(l_Random.Range(0.5f, 1.0f), l_Random.Range(0.5f, 1.0f), l_Random.Range(0.5f, 1.0f));
+            l_Component.Intensity = l_Random.Range(1.0f, 10.0f);
+            l_Component.Range = l_Random.Range(6.0f, 20.0f);
+        }
+
+        return true;
+    }
+
+    bool RunRendererScenario(const BenchArguments& arguments, BenchReport& report)
+    {
+        RendererSettings l_Settings;
+        if (!ParseRendererArguments(arguments, l_Settings))
+        {
+            return false;
+        }
+
+        std::unique_ptr<JobSystem> l_JobSystem;
+        if (l_Settings.Workers > 0)
+        {
+            l_JobSystem = std::make_unique<JobSystem>();
+            l_JobSystem->Initialize(l_Settings.Workers);
+        }
+
+        GraphicsDeviceDescription l_DeviceDescription;
+        l_DeviceDescription.ApplicationName = "Trinity-Bench";
+        std::unique_ptr<GraphicsDevice> l_Device = GraphicsBackendFactory::Create(GraphicsBackend::Null, l_DeviceDescription);
+        if (l_Device == nullptr)
+        {
+            report.Fail("the null graphics device did not initialize");
+            return true;
+        }
+
+        NullDevice& l_NullDevice = static_cast<NullDevice&>(*l_Device);
+
+        SwapchainDescription l_SwapchainDescription;
+        l_SwapchainDescription.Width = k_Width;
+        l_SwapchainDescription.Height = k_Height;
+        l_SwapchainDescription.PreferredFormat = Format::BGRA8_UNORM;
+        std::unique_ptr<Swapchain> l_Swapchain = l_Device->CreateSwapchain(l_SwapchainDescription);
+
+        SDLFileSystem l_FileSystem;
+        l_FileSystem.SetApplicationName("Trinity-Bench");
+        AudioEngine l_AudioEngine;
+
+        {
+            Renderer l_Renderer(*l_Device, *l_Swapchain, l_FileSystem, l_JobSystem.get());
+            if (!l_Renderer.Initialize())
+            {
+                report.Fail("the renderer did not initialize; the shaders must sit next to the executable");
+                return true;
+            }
+
+            AssetDatabase l_AssetDatabase(l_FileSystem, l_Renderer.GetMeshLibrary(), l_Renderer.GetTextureManager(), l_AudioEngine);
+            l_AssetDatabase.Initialize();
+
+            Scene l_Scene;
+            BenchScene l_BenchScene;
+            if (!GenerateScene(l_Settings, *l_Device, l_Scene, l_BenchScene))
+            {
+                report.Fail("mesh upload failed");
+                return true;
+            }
+
+            // Looks down across the field from one edge, so a realistic share of it is culled
+            const float l_Field = std::sqrt(static_cast<float>(std::max(l_Settings.Entities / l_Settings.Depth, 1u))) * k_EntitySpacing;
+            Camera l_Camera;
+            l_Camera.SetPerspective(glm::radians(60.0f), static_cast<float>(k_Width) / static_cast<float>(k_Height), 0.1f, std::max(l_Field * 1.5f, 100.0f));
+            l_Camera.LookAt(glm::vec3(0.0f, l_Field * 0.15f + 5.0f, l_Field * 0.5f + 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+            BenchSamples l_Samples;
+            for (std::vector<double>* it_Samples : { &l_Samples.Frame, &l_Samples.Transforms, &l_Samples.Extract, &l_Samples.Sort, &l_Samples.Cull, &l_Samples.Record })
+            {
+                it_Samples->reserve(l_Settings.Frames);
+            }
+
+            const uint32_t l_TotalFrames = l_Settings.WarmupFrames + l_Settings.Frames;
+            uint64_t l_Allocations = 0;
+            uint64_t l_RenderAllocations = 0;
+            RenderStats l_LastStats;
+
+            for (uint32_t l_Frame = 0; l_Frame < l_TotalFrames; ++l_Frame)
+            {
+                if (l_Frame == l_Settings.WarmupFrames)
+                {
+                    l_NullDevice.ResetStats();
+                }
+
+                const glm::quat l_Spin = glm::angleAxis(0.01f * static_cast<float>(l_Frame), glm::vec3(0.0f, 1.0f, 0.0f));
+                for (entt::entity it_Root : l_BenchScene.MovingRoots)
+                {
+                    l_Scene.GetRegistry().get<TransformComponent>(it_Root).Rotation = l_Spin;
+                }
+
+                const uint64_t l_AllocationsBefore = GetAllocationCount();
+
+                Timer l_FrameTimer;
+                l_Scene.UpdateWorldTransforms();
+                const double l_TransformMilliseconds = l_FrameTimer.ElapsedMilliseconds();
+                const uint64_t l_RenderAllocationsBefore = GetAllocationCount();
+                l_Renderer.RenderFrame(l_Scene, l_AssetDatabase, l_Camera);
+                const double l_FrameMilliseconds = l_FrameTimer.ElapsedMilliseconds();
+
+                const uint64_t l_AllocationsAfter = GetAllocationCount();
+                if (l_Frame < l_Settings.WarmupFrames)
+                {
+                    continue;
+                }
+
+                const RenderStats& l_Stats = l_Renderer.GetStats();
+                l_Samples.Frame.push_back(l_FrameMilliseconds);
+                l_Samples.Transforms.push_back(l_TransformMilliseconds);
+                l_Samples.Extract.push_back(l_Stats.ExtractMilliseconds);
+                l_Samples.Sort.push_back(l_Stats.SortMilliseconds);
+                l_Samples.Cull.push_back(l_Stats.CullMilliseconds);
+                l_Samples.Record.push_back(l_Stats.RecordMilliseconds);
+                l_Allocations += l_AllocationsAfter - l_AllocationsBefore;
+                l_RenderAllocations += l_AllocationsAfter - l_RenderAllocationsBefore;
+                l_LastStats = l_Stats;
+            }
+
+            if (l_LastStats.PendingPipelines != 0 || l_LastStats.DrawCalls == 0)
+            {
+                report.Fail("the measured frames drew nothing (%u pipelines still compiling)", l_LastStats.PendingPipelines);
+            }
+
+            // Once warm, a frame reuses every container, cached plan and pooled job, so any allocation inside RenderFrame is a regression
+            if (l_RenderAllocations != 0)
+            {
+                report.Fail("Renderer::RenderFrame allocated %llu times over %u measured frames", static_cast<unsigned long long>(l_RenderAllocations), l_Settings.Frames);
+            }
+
+            const NullDeviceStats& l_DeviceStats = l_NullDevice.GetStats();
+            if (l_DeviceStats.Commands.InvalidHandles != 0)
+            {
+                report.Fail("%llu commands referenced destroyed resources", static_cast<unsigned long long>(l_DeviceStats.Commands.InvalidHandles));
+            }
+
+            const double l_Frames = static_cast<double>(l_Settings.Frames);
+            const NullCommandStats& l_Commands = l_DeviceStats.Commands;
+
+            report.Add("backend", "null");
+            report.BeginObject("scene");
+            report.Add("entities", l_Settings.Entities);
+            report.Add("depth", l_Settings.Depth);
+            report.Add("meshes", l_Settings.Meshes);
+            report.Add("materials", l_Settings.Materials);
+            report.Add("lights", l_Settings.Lights);
+            report.Add("moving", static_cast<double>(l_Settings.Moving));
+            report.Add("seed", l_Settings.Seed);
+            report.EndObject();
+            report.Add("frames", l_Settings.Frames);
+            report.Add("warmupFrames", l_Settings.WarmupFrames);
+            report.Add("workers", l_Settings.Workers);
+
+            report.BeginObject("milliseconds");
+            report.AddDistribution("frame", l_Samples.Frame);
+            report.AddDistribution("transforms", l_Samples.Transforms);
+            report.AddDistribution("extract", l_Samples.Extract);
+            report.AddDistribution("sort", l_Samples.Sort);
+            report.AddDistribution("cull", l_Samples.Cull);
+            report.AddDistribution("record", l_Samples.Record);
+            report.EndObject();
+
+            report.Add("allocationsPerFrame", static_cast<double>(l_Allocations) / l_Frames);
+            report.Add("renderFrameAllocationsPerFrame", static_cast<double>(l_RenderAllocations) / l_Frames);
+
+            report.BeginObject("lastFrame");
+            report.Add("packets", l_LastStats.Packets);
+            report.Add("culled", l_LastStats.Culled);
+            report.Add("drawCalls", l_LastStats.DrawCalls);
+            report.Add("instances", l_LastStats.Instances);
+            report.Add("shadowDrawCalls", l_LastStats.ShadowDrawCalls);
+            report.Add("shadowCulled", l_LastStats.ShadowCulled);
+            report.Add("binds", l_LastStats.Binds);
+            report.Add("stateChanges", l_LastStats.StateChanges);
+            report.Add("lights", l_LastStats.Lights);
+            report.Add("shadowUpdates", l_LastStats.ShadowUpdates);
+            report.Add("shadowCacheHits", l_LastStats.ShadowCacheHits);
+            report.Add("shadowStaticCacheHits", l_LastStats.ShadowStaticCacheHits);
+            report.EndObject();
+
+            report.BeginObject("commandsPerFrame");
+            report.Add("renderPasses", static_cast<double>(l_Commands.RenderPasses) / l_Frames);
+            report.Add("pipelineBinds", static_cast<double>(l_Commands.PipelineBinds) / l_Frames);
+            report.Add("resourceBinds", static_cast<double>(l_Commands.ResourceBinds) / l_Frames);
+            report.Add("pushConstants", static_cast<double>(l_Commands.PushConstants) / l_Frames);
+            report.Add("draws", static_cast<double>(l_Commands.Draws) / l_Frames);
+            report.Add("barriers", static_cast<double>(l_Commands.Barriers) / l_Frames);
+            report.EndObject();
+
+            l_BenchScene.Meshes.clear();
+            l_Renderer.ReleaseScene(l_Scene);
+            l_Scene.Clear();
+        }
+
+        l_Swapchain.reset();
+        l_Device->Shutdown();
+
+        if (l_JobSystem != nullptr)
+        {
+            l_JobSystem->Shutdown();
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,141 @@
+#include <Bench/BenchCommon.h>
+
+#include <Trinity/Core/Log.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+using namespace Trinity;
+
+namespace
+{
+    struct Scenario
+    {
+        const char* Name;
+        bool (*Run)(const BenchArguments&, BenchReport&);
+    };
+
+    constexpr Scenario k_Scenarios[] =
+    {
+        { "renderer", RunRendererScenario },
+        { "jobs", RunJobScenario },
+        { "cull", RunCullScenario },
+        { "clusters", RunClusterScenario },
+        { "graph", RunGraphScenario },
+        { "frameheap", RunFrameHeapScenario },
+        { "meshes", RunMeshScenario },
+    };
+}
+
+static void PrintUsage()
+{
+    std::fprintf(stderr,
+        "usage: Trinity-Bench [scenario] [options]\n"
+        "  --output PATH   write the JSON report to PATH instead of stdout\n"
+        "\n"
+        "renderer (default): CPU cost of Renderer::RenderFrame on the null backend over a generated scene\n"
+        "  --entities N    mesh entities in the scene (10000)\n"
+        "  --depth D       hierarchy depth, 1 keeps every entity a root (3)\n"
+        "  --meshes M      distinct meshes (32)\n"
+        "  --materials K   distinct materials (64)\n"
+        "  --lights L      point lights, plus one directional sun (128)\n"
+        "  --frames F      measured frames (300)\n"
+        "  --warmup W      frames rendered before measuring (30)\n"
+        "  --moving F      fraction of roots animated every frame (0.1)\n"
+        "  --workers N     job system workers for light binning; 0 runs single-threaded (0)\n"
+        "  --seed S        scene generator seed (1)\n"
+        "\n"
+        "jobs: job system spawn, steal, wait and parallel_for overhead\n"
+        "cull: scalar against vector frustum culling of bounding spheres\n"
+        "clusters: serial against job-system light cluster binning\n"
+        "graph: render graph declare, compile and execute with and without plan caching\n"
+        "frameheap: frame allocations made before the heap grows mid-frame stay valid until the frame closes\n"
+        "\n"
+        "meshes <folder or file>: post-transform cache and overdraw metrics of imported meshes\n"
+        "  --cache N       simulated post-transform cache entries (16)\n"
+        "  --threshold T   ACMR the overdraw pass may give up, as a multiple of the cache-optimized order (1.05)\n"
+        "  --no-optimize   report the source order only\n"
+        "  --no-lods       skip level generation\n");
+}
+
+int main(int argc, char** argv)
+{
+    // The scenario name comes first; the shared options are taken out wherever they appear and the rest goes to the scenario
+    const Scenario* l_Scenario = &k_Scenarios[0];
+    int l_First = 1;
+    if (argc > 1 && std::strncmp(argv[1], "--", 2) != 0)
+    {
+        l_Scenario = nullptr;
+        for (const Scenario& it_Scenario : k_Scenarios)
+        {
+            if (std::strcmp(argv[1], it_Scenario.Name) == 0)
+            {
+                l_Scenario = &it_Scenario;
+            }
+        }
+
+        // The mesh scenario's positional path is the only other bare argument, so an unknown name is a usage error rather than a guess
+        if (l_Scenario == nullptr)
+        {
+            std::fprintf(stderr, "unknown scenario %s\n", argv[1]);
+            PrintUsage();
+            return 2;
+        }
+
+        l_First = 2;
+    }
+
+    std::string l_Output;
+    BenchArguments l_Arguments;
+    for (int l_Index = l_First; l_Index < argc; ++l_Index)
+    {
+        if (std::strcmp(argv[l_Index], "--help") == 0)
+        {
+            PrintUsage();
+            return 2;
+        }
+
+        if (std::strcmp(argv[l_Index], "--output") == 0)
+        {
+            if (l_Index + 1 >= argc)
+            {
+                std::fprintf(stderr, "missing value for --output\n");
+                PrintUsage();
+                return 2;
+            }
+
+            l_Output = argv[++l_Index];
+            continue;
+        }
+
+        l_Arguments.push_back(argv[l_Index]);
+    }
+
+    Log::Initialize();
+
+    // Engine logging moves to stderr and drops to warnings, so stdout carries nothing but the report
+    auto l_LogSink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+    for (std::shared_ptr<spdlog::logger>* it_Logger : { &Log::GetCoreLogger(), &Log::GetClientLogger() })
+    {
+        (*it_Logger)->sinks().assign({ l_LogSink });
+        (*it_Logger)->set_level(spdlog::level::warn);
+    }
+
+    BenchReport l_Report(l_Scenario->Name);
+    if (!l_Scenario->Run(l_Arguments, l_Report))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    if (!l_Report.Write(l_Output))
+    {
+        return 1;
+    }
+
+    return l_Report.IsOk() ? 0 : 1;
+}